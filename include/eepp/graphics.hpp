@@ -17,6 +17,7 @@
 #include <eepp/graphics/fonttruetype.hpp>
 #include <eepp/graphics/framebuffer.hpp>
 #include <eepp/graphics/framebuffermanager.hpp>
+#include <eepp/graphics/framebufferpool.hpp>
 #include <eepp/graphics/globalbatchrenderer.hpp>
 #include <eepp/graphics/globaltextureatlas.hpp>
 #include <eepp/graphics/glyphdrawable.hpp>
@@ -6,6 +6,7 @@
 #include <eepp/graphics/font.hpp>
 #include <eepp/graphics/primitives.hpp>
 #include <eepp/graphics/text.hpp>
+#include <eepp/system/clock.hpp>
 #include <eepp/window/inputtextbuffer.hpp>
 
 namespace EE { namespace Window {
@@ -134,6 +135,13 @@ class EE_API Console : protected LogReaderInterface {
 	/** Activate/Deactive fps rendering */
 	void showFps( const bool& Show );
 
+	/** @return If the console is rendering the profiler zones overlay. */
+	const bool& isShowingProfiler() const;
+
+	/** Activate/Deactive the profiler zones overlay rendering. Activating it also enables the
+	 * profiler recording. */
+	void showProfiler( const bool& show );
+
 	FontStyleConfig getFontStyleConfig() const;
 
 	void setFontStyleConfig( const FontStyleConfig& fontStyleConfig );
@@ -191,7 +199,10 @@ class EE_API Console : protected LogReaderInterface {
 	bool mExpand;
 	bool mFading;
 	bool mShowFps;
+	bool mShowProfiler;
 	bool mCurSide;
+	Text mProfilerText;
+	Clock mProfilerClock;
 
 	void createDefaultCommands();
 
@@ -236,6 +247,9 @@ class EE_API Console : protected LogReaderInterface {
 	/** Internal Callback for default command ( showfps ) */
 	void cmdShowFps( const std::vector<String>& params );
 
+	/** Internal Callback for default command ( profiler ) */
+	void cmdProfiler( const std::vector<String>& params );
+
 	/** Internal Callback for default command ( gettexturememory ) */
 	void cmdGetTextureMemory( const std::vector<String>& params );
 
@@ -0,0 +1,90 @@
+#ifndef EE_GRAPHICSCFRAMEBUFFERPOOL_HPP
+#define EE_GRAPHICSCFRAMEBUFFERPOOL_HPP
+
+#include <eepp/core/noncopyable.hpp>
+#include <eepp/graphics/base.hpp>
+#include <list>
+#include <unordered_map>
+
+namespace EE { namespace Graphics {
+
+class FrameBuffer;
+
+/** @brief Keeps a set of reusable frame buffers under a memory budget.
+**	Frame buffers are acquired for a minimum size and returned to the pool once they are not needed
+**	anymore. Released frame buffers are kept idle to be reused by later requests, and the least
+**	recently released ones are destroyed when the idle memory exceeds its limit.
+*/
+class EE_API FrameBufferPool : NonCopyable {
+  public:
+	static FrameBufferPool* New( const size_t& memoryLimit = 64 * 1024 * 1024,
+								 const size_t& idleMemoryLimit = 16 * 1024 * 1024 );
+
+	FrameBufferPool( const size_t& memoryLimit = 64 * 1024 * 1024,
+					 const size_t& idleMemoryLimit = 16 * 1024 * 1024 );
+
+	/** Destroys every frame buffer created by the pool, including the ones not released. */
+	~FrameBufferPool();
+
+	/** @return A frame buffer of at least the requested size, or NULL if creating it would exceed
+	 * the memory limit. */
+	FrameBuffer* acquire( const Sizei& size );
+
+	/** @brief Returns a frame buffer acquired from the pool. */
+	void release( FrameBuffer* frameBuffer );
+
+	/** @brief Destroys every idle frame buffer. */
+	void clearIdle();
+
+	/** @return The maximum memory in bytes used by the frame buffers of the pool. */
+	const size_t& getMemoryLimit() const;
+
+	void setMemoryLimit( const size_t& memoryLimit );
+
+	/** @return The maximum memory in bytes kept by the idle frame buffers. */
+	const size_t& getIdleMemoryLimit() const;
+
+	void setIdleMemoryLimit( const size_t& idleMemoryLimit );
+
+	/** @return The size in pixels the frame buffer dimensions are rounded up to, so frame buffers
+	 * can be reused by requests of similar size. */
+	const Uint32& getSizeGranularity() const;
+
+	void setSizeGranularity( const Uint32& granularity );
+
+	/** @return The memory in bytes used by every frame buffer of the pool. */
+	const size_t& getMemoryUsage() const;
+
+	/** @return The memory in bytes used by the idle frame buffers. */
+	const size_t& getIdleMemoryUsage() const;
+
+	/** @return The number of frame buffers acquired and not released. */
+	size_t getActiveCount() const;
+
+	/** @return The number of idle frame buffers. */
+	size_t getIdleCount() const;
+
+  protected:
+	struct Entry {
+		FrameBuffer* frameBuffer;
+		size_t memory;
+	};
+
+	size_t mMemoryLimit;
+	size_t mIdleMemoryLimit;
+	size_t mMemoryUsage;
+	size_t mIdleMemoryUsage;
+	Uint32 mGranularity;
+	std::unordered_map<FrameBuffer*, size_t> mActive;
+	std::list<Entry> mIdle; // Sorted by release time, oldest first.
+
+	void evictIdle( const size_t& idleMemoryLimit );
+
+	void evictUntilFits( const size_t& memory );
+
+	void destroy( const Entry& entry );
+};
+
+}} // namespace EE::Graphics
+
+#endif
@@ -17,6 +17,45 @@ class RendererGL;
 class RendererGL3;
 class RendererGL3CP;
 class RendererGLES2;
+class RendererNull;
+
+/** @brief Counters of the work submitted to the graphics library during a frame. */
+struct RendererFrameStats {
+	Uint64 drawCalls{0};	 ///< Number of drawArrays and drawElements calls.
+	Uint64 vertices{0};		 ///< Number of vertices (or indices) drawn.
+	Uint64 bytesUploaded{0}; ///< Bytes of vertex data uploaded into buffer objects.
+	Uint64 textureBinds{0};	 ///< Number of texture bind calls.
+	Uint64 shaderChanges{0}; ///< Number of shader program switches.
+	Uint64 blendChanges{0};	 ///< Number of blend function and equation changes.
+	Uint64 stateChanges{0};	 ///< Number of enable, disable, scissor and viewport calls.
+	Uint64 clears{0};		 ///< Number of clear calls.
+	Uint64 uniformUploads{0};	///< Number of shader uniform values uploaded.
+	Uint64 filteredUniforms{0}; ///< Uniform uploads skipped, the program already had the value.
+	/** Texture binds, shader and blend changes skipped because the state was already set. */
+	Uint64 filteredStateChanges{0};
+};
+
+/** @brief Kind of command recorded in the renderer frame log. */
+enum class RendererCommandType : Uint32 {
+	Clear,
+	DrawArrays,
+	DrawElements,
+	BindTexture,
+	SetShader,
+	BlendFunc,
+	Enable,
+	Disable,
+	Scissor,
+	Viewport,
+	UploadVertexData
+};
+
+/** @brief A command recorded in the renderer frame log. The meaning of the parameters follows the
+ * arguments of the command (for example: mode, first and count for DrawArrays). */
+struct RendererCommand {
+	RendererCommandType type;
+	Int32 params[4];
+};
 
 /** @brief This class is an abstraction of some OpenGL functionality.
  *	eepp has 4 different rendering pipelines: OpenGL 2, OpenGL 3, OpenGL 3 Core Profile and OpenGL
@@ -258,11 +297,55 @@ class EE_API Renderer {
 
 	Color readPixel( int x, int y );
 
+	/** @return The counters of the frame in progress. */
+	const RendererFrameStats& getFrameStats() const;
+
+	/** @return The counters of the last completed frame. */
+	const RendererFrameStats& getLastFrameStats() const;
+
+	/** @brief Completes the current frame: the frame counters and the frame log become the last
+	 * frame ones and a new frame starts. It's called by Window::display. */
+	void endFrame();
+
+	/** @return If every command submitted is being recorded in the frame log. */
+	const bool& isFrameLogEnabled() const;
+
+	/** @brief Enables or disables the frame log recording. The frame log keeps every command
+	 * submitted in a frame, it's intended for tests and debugging. */
+	void setFrameLogEnabled( const bool& enabled );
+
+	/** @return The commands recorded during the last completed frame (only when the frame log is
+	 * enabled). */
+	const std::vector<RendererCommand>& getLastFrameLog() const;
+
+	/** @return If this is the null renderer: every command is accounted in the frame counters and
+	 * the frame log but nothing is sent to the graphics library. */
+	const bool& isNullRenderer() const;
+
+	/** @brief Creates a texture from the pixels given, or replaces the contents of reuseTexture if
+	 * it isn't zero.
+	 * @param flags SOIL flags used to create the texture.
+	 * @return The texture handle, zero on failure. */
+	unsigned int createTexture( const Uint8* pixels, int* width, int* height, int channels,
+								unsigned int reuseTexture, unsigned int flags );
+
+	void deleteTextures( int n, const unsigned int* textures );
+
+	/** @brief Forgets the shader program and blend state known by the renderer, so the next
+	 * changes are sent even if they look redundant. Needed after changing that state with direct
+	 * GL calls. */
+	void invalidateStateCache();
+
   protected:
+	friend class ShaderProgram;
+	friend class TextureFactory;
+
 	static Renderer* sSingleton;
 
 	enum RendererStateFlags { RSF_LINE_SMOOTH = 0, RSF_POLYGON_MODE };
 
+	static const unsigned int InvalidState = 0xFFFFFFFF;
+
 	Uint32 mExtensions;
 	Uint32 mStateFlags;
 	bool mQuadsSupported;
@@ -272,6 +355,26 @@ class EE_API Renderer {
 
 	ClippingMask* mClippingMask;
 
+	RendererFrameStats mFrameStats;
+	RendererFrameStats mLastFrameStats;
+	bool mFrameLogEnabled;
+	std::vector<RendererCommand> mFrameLog;
+	std::vector<RendererCommand> mLastFrameLog;
+	unsigned int mCurProgram; ///< Shadow of the GL state, InvalidState when unknown
+	unsigned int mCurBlendFunc[4];
+	unsigned int mCurBlendEquation[2];
+	bool mNullRenderer;
+	int mViewport[4]; ///< Last viewport set, reported by getViewport on the null renderer
+	unsigned int mLastNullTexture;
+
+	/** Sets the current program unless it's already set */
+	void useProgram( unsigned int program );
+
+	void recordCommand( const RendererCommandType& type, Int32 param0 = 0, Int32 param1 = 0,
+						Int32 param2 = 0, Int32 param3 = 0 );
+
+	void recordUpload( const Uint32& bytes );
+
   private:
 	void writeExtension( Uint8 Pos, Uint32 BitWrite );
 };
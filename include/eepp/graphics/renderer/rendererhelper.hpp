@@ -47,7 +47,9 @@ enum GraphicsLibraryVersion {
 	/// OpenGL ES 2
 	GLv_ES2,
 	/// Selects the most appropriate graphics library version for each platform.
-	GLv_default
+	GLv_default,
+	/// Null renderer, doesn't use any graphics library ( headless mode )
+	GLv_null
 };
 
 }} // namespace EE::Graphics
@@ -0,0 +1,56 @@
+#ifndef EE_GRAPHICS_RENDERERNULL_HPP
+#define EE_GRAPHICS_RENDERERNULL_HPP
+
+#include <eepp/graphics/renderer/rendererglshader.hpp>
+
+namespace EE { namespace Graphics {
+
+/** @brief A renderer that doesn't need a graphics context. It keeps the matrix stacks, the frame
+ * counters and the frame log but doesn't send anything to the graphics library and doesn't
+ * rasterize anything. Used by the null window backend to run the engine headless ( tests,
+ * benchmarks and servers ). */
+class EE_API RendererNull : public RendererGLShader {
+  public:
+	RendererNull();
+
+	~RendererNull();
+
+	GraphicsLibraryVersion version();
+
+	std::string versionStr();
+
+	void init();
+
+	void pointSize( float size );
+
+	float pointSize();
+
+	void clientActiveTexture( unsigned int texture );
+
+	void enableClientState( unsigned int array );
+
+	void disableClientState( unsigned int array );
+
+	void vertexPointer( int size, unsigned int type, int stride, const void* pointer,
+						unsigned int allocate );
+
+	void colorPointer( int size, unsigned int type, int stride, const void* pointer,
+					   unsigned int allocate );
+
+	void texCoordPointer( int size, unsigned int type, int stride, const void* pointer,
+						  unsigned int allocate );
+
+	void clip2DPlaneEnable( const Int32& x, const Int32& y, const Int32& Width,
+							const Int32& Height );
+
+	void clip2DPlaneDisable();
+
+	void clipPlane( unsigned int plane, const double* equation );
+
+  protected:
+	float mPointSize;
+};
+
+}} // namespace EE::Graphics
+
+#endif
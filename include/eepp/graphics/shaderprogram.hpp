@@ -3,6 +3,7 @@
 
 #include <eepp/graphics/base.hpp>
 #include <eepp/graphics/shader.hpp>
+#include <unordered_map>
 
 namespace EE { namespace Graphics {
 
@@ -74,9 +75,14 @@ class EE_API ShaderProgram {
 	/** Clear the locations */
 	void invalidateLocations();
 
+	/** Forgets the uniform values known by the program, so the next values are uploaded even if
+	 * they didn't change. Needed after setting uniforms of the program with direct GL calls. */
+	void invalidateUniforms();
+
 	/** Sets the uniform with the given name to the given value and returns true.
 	 * If there is no uniform with such name then false is returned.
 	 * Note that the program has to be bound before this method can be used.
+	 * The value is not uploaded if the uniform already has it.
 	 */
 	bool setUniform( const std::string& Name, float Value );
 
@@ -152,13 +158,28 @@ class EE_API ShaderProgram {
 	std::string mLinkLog;
 
 	std::vector<Shader*> mShaders;
-	std::map<std::string, Int32> mUniformLocations;
-	std::map<std::string, Int32> mAttributeLocations;
+	std::unordered_map<std::string, Int32> mUniformLocations;
+	std::unordered_map<std::string, Int32> mAttributeLocations;
+
+	/** Last value uploaded to an uniform, a mat4 at most */
+	struct UniformValue {
+		Uint32 size; ///< 0 if unknown
+		Uint8 data[64];
+	};
+
+	std::vector<UniformValue> mUniformValues; ///< Indexed by location
 
 	ShaderProgramReloadCb mReloadCb;
 
 	void init();
 
+	/** Reads the locations of every active uniform */
+	void readUniformLocations();
+
+	/** Stores the value of the uniform
+	 * @return False if the uniform already had the value, so it doesn't need to be uploaded. */
+	bool updateUniform( const Int32& location, const void* value, const Uint32& size );
+
 	void addToManager( const std::string& Name );
 
 	void removeFromManager();
@@ -311,6 +311,13 @@ class EE_API Texture : public DrawableResource, public Image, private NonCopyabl
 	/** return The reference coordinate type. */
 	const CoordinateType& getCoordinateType() const;
 
+	/** @return True if the texture was evicted from the video memory by the texture memory
+	 * budget. It will be reloaded the next time it's binded. */
+	bool isEvicted() const;
+
+	/** @return True if the texture can be reloaded from its file or pack source. */
+	bool hasReloadSource() const;
+
 	/** Sets the default coordinate type. This value is not forced when binded, but used as a
 	reference for binding in the case of textures with a reference coordinate type. */
 	void setCoordinateType( const CoordinateType& coordinateType );
@@ -321,10 +328,21 @@ class EE_API Texture : public DrawableResource, public Image, private NonCopyabl
 		TEX_FLAG_MODIFIED = ( 1 << 1 ),
 		TEX_FLAG_COMPRESSED = ( 1 << 2 ),
 		TEX_FLAG_LOCKED = ( 1 << 3 ),
-		TEX_FLAG_GRABED = ( 1 << 4 )
+		TEX_FLAG_GRABED = ( 1 << 4 ),
+		TEX_FLAG_EVICTED = ( 1 << 5 )
+	};
+
+	/** The origin of a texture loaded from a file or a pack, used to reload it after an
+	 * eviction. */
+	struct ReloadSource {
+		std::string path;
+		std::string packPath; ///< Empty if the texture was loaded from the file system.
+		bool compress;
+		Image::FormatConfiguration formatConfiguration;
 	};
 
 	friend class TextureFactory;
+	friend class TextureLoader;
 
 	Texture();
 
@@ -357,11 +375,20 @@ class EE_API Texture : public DrawableResource, public Image, private NonCopyabl
 
 	int mInternalFormat;
 
+	ReloadSource* mReloadSource;
+	Uint64 mLastUse;
+	Uint64 mReloadRetryFrame; ///< A failed reload is not tried again before this frame.
+	Uint32 mReloadFailures;
+
 	void applyClampMode();
 
 	Uint8* iLock( const bool& ForceRGBA, const bool& KeepFormat );
 
 	void iTextureFilter( const Filter& filter );
+
+	/** Makes the texture resident again (if evicted) and forgets its reload source, since the
+	 * contents are going to differ from it. */
+	void onContentsModified();
 };
 
 }} // namespace EE::Graphics
@@ -5,13 +5,30 @@
 #include <eepp/graphics/texture.hpp>
 #include <list>
 
+#include <atomic>
 #include <eepp/system/mutex.hpp>
 #include <eepp/system/pack.hpp>
 #include <eepp/system/singleton.hpp>
+#include <eepp/system/threadpool.hpp>
+#include <memory>
+#include <unordered_map>
 using namespace EE::System;
 
 namespace EE { namespace Graphics {
 
+class TextureLoader;
+
+/** @brief Counters of the texture memory budget residency. */
+struct TextureCacheStats {
+	Uint64 hits{0};				///< Number of binds of resident textures.
+	Uint64 misses{0};			///< Number of binds of evicted textures.
+	Uint64 evictions{0};		///< Number of textures evicted from the video memory.
+	Uint64 evictedBytes{0};		///< Video memory released by the evictions.
+	Uint64 reloads{0};			///< Number of evicted textures reloaded.
+	Uint64 failedReloads{0};	///< Number of evicted textures that could not be reloaded.
+	Uint64 placeholderBinds{0}; ///< Number of placeholder binds while a reload was in flight.
+};
+
 /** @brief The Texture Manager Class. Here we do all the textures stuff. (Singleton Class) */
 class EE_API TextureFactory : protected Mutex {
 	SINGLETON_DECLARE_HEADERS( TextureFactory )
@@ -249,8 +266,58 @@ class EE_API TextureFactory : protected Mutex {
 
 	const Texture::CoordinateType& getLastCoordinateType() const;
 
+	/** @brief Sets the texture memory budget in bytes ( 0 means no budget, the default ).
+	 * When the memory used by the textures exceeds the budget the least recently drawn textures
+	 * are evicted: its video memory is released, and they are reloaded from its file, pack or local
+	 * copy the next time they are binded. Textures drawn in the current frame, locked textures and
+	 * textures without a source to reload from ( render targets, textures created from memory or
+	 * modified after loading ) are never evicted. A texture that fails to reload stays evicted, and
+	 * the reload is tried again after a number of frames that doubles on every failure.
+	 */
+	void setMemoryBudget( const size_t& bytes );
+
+	/** @return The texture memory budget in bytes ( 0 if there's no budget ). */
+	const size_t& getMemoryBudget() const;
+
+	/** @brief Sets a texture to bind in place of an evicted texture while it's being reloaded.
+	 * With a placeholder the evicted textures are decoded in a worker thread and uploaded once
+	 * decoded, otherwise they are reloaded synchronously when binded.
+	 */
+	void setPlaceholderTexture( Texture* texture );
+
+	/** @return The placeholder texture of the evicted textures ( if any ). */
+	Texture* getPlaceholderTexture() const;
+
+	/** @brief Evicts the least recently drawn textures until the texture memory fits the budget.
+	 */
+	void enforceMemoryBudget();
+
+	/** @brief Releases the video memory of a texture, it will be reloaded when needed.
+	 * @return True if the texture was evicted.
+	 */
+	bool evict( Texture* texture );
+
+	/** @brief Reloads synchronously an evicted texture. */
+	void makeResident( Texture* texture );
+
+	/** @brief Finishes the reloads in flight and enforces the memory budget. It's called by
+	 * Window::display. */
+	void endFrame();
+
+	/** @return The texture residency counters. */
+	const TextureCacheStats& getCacheStats() const;
+
+	/** @brief Resets the texture residency counters. */
+	void resetCacheStats();
+
   protected:
 	friend class Texture;
+	friend class TextureLoader;
+
+	struct PendingReload {
+		std::shared_ptr<TextureLoader> loader;
+		std::shared_ptr<std::atomic<bool>> decoded;
+	};
 
 	TextureFactory();
 
@@ -270,9 +337,34 @@ class EE_API TextureFactory : protected Mutex {
 
 	bool mErasing;
 
+	size_t mMemoryBudget;
+
+	Uint64 mFrame;
+
+	Texture* mPlaceholder;
+
+	TextureCacheStats mCacheStats;
+
+	std::unordered_map<Uint32, PendingReload> mPendingReloads;
+
+	std::unique_ptr<ThreadPool> mReloadPool;
+
 	const bool& isErasing() const;
 
 	void removeReference( Texture* Tex );
+
+	bool isEvictable( Texture* texture ) const;
+
+	std::shared_ptr<TextureLoader> createReloader( Texture* texture );
+
+	const Texture* reloadForBind( Texture* texture );
+
+	void uploadReload( Texture* texture, TextureLoader* loader );
+
+	void onReloadFailed( Texture* texture );
+
+	void onTextureReloaded( Texture* texture, const Uint32& handle, const unsigned int& width,
+							const unsigned int& height, const Uint32& memSize );
 };
 
 }} // namespace EE::Graphics
@@ -132,11 +132,14 @@ class EE_API TextureLoader {
 	Uint32 mSize;
 
 	RGB* mColorKey;
+	Texture* mReloadTexture;
 	Image::FormatConfiguration mFormatConfiguration;
 
 	void reset();
 
   private:
+	friend class TextureFactory;
+
 	bool mLoaded;
 	bool mTexLoaded;
 	bool mDirectUpload;
@@ -145,12 +148,14 @@ class EE_API TextureLoader {
 
 	Clock mTE;
 
+	void decode();
 	void loadFile();
 	void loadFromFile();
 	void loadFromMemory();
 	void loadFromPack();
 	void loadFromPixels();
 	void loadFromStream();
+	void setReloadSource();
 };
 
 }} // namespace EE::Graphics
@@ -31,7 +31,14 @@
 #include <eepp/graphics/image.hpp>
 #include <eepp/graphics/packerhelper.hpp>
 #include <eepp/graphics/texture.hpp>
+#include <functional>
 #include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace EE { namespace System {
+class ThreadPool;
+}} // namespace EE::System
 
 namespace EE { namespace Graphics {
 
@@ -47,6 +54,16 @@ using namespace Private;
  */
 class EE_API TexturePacker {
   public:
+	/** @brief The algorithm used to place the images inside the texture atlas. */
+	enum class PackingHeuristic : Uint32 {
+		Guillotine,				  ///< Guillotine free list ( the default ).
+		MaxRectsBestShortSideFit, ///< MaxRects, minimizes the shorter leftover side.
+		MaxRectsBestLongSideFit,  ///< MaxRects, minimizes the longer leftover side.
+		MaxRectsBestAreaFit,	  ///< MaxRects, minimizes the leftover area.
+		MaxRectsBottomLeft,		  ///< MaxRects, places the images at the bottom-left most position.
+		SkylineBottomLeft		  ///< Skyline, places the images at the lowest skyline position.
+	};
+
 	static TexturePacker* New();
 
 	/** Creates a new instance of the texture packer indicating the maximum size of the texture
@@ -181,6 +198,44 @@ class EE_API TexturePacker {
 	 * atlas. */
 	const std::string& getFilepath() const;
 
+	/** Sets the algorithm used to place the images. MaxRects and Skyline pack tighter and faster
+	 * than the Guillotine packer, and try every atlas size concurrently. */
+	void setPackingHeuristic( const PackingHeuristic& heuristic );
+
+	const PackingHeuristic& getPackingHeuristic() const;
+
+	/** Sets the number of threads used to read, decode, trim and hash the images and to compose
+	 * the atlases. 0 uses one thread per CPU core ( the default ), 1 disables the multithreading.
+	 */
+	void setThreadCount( const Uint32& threadCount );
+
+	const Uint32& getThreadCount() const;
+
+	/** Enables the trimming of the transparent borders of the images before packing them. The
+	 * texture regions keep the trimmed area offset, so they are drawn in the same position. */
+	void setTrimTransparentBorders( const bool& trim );
+
+	const bool& getTrimTransparentBorders() const;
+
+	/** @brief Enables the incremental packing from a previously saved texture atlas.
+	 *	The images that are still present and whose content hash didn't change keep their
+	 *	placement ( and their pixels are copied from the previous atlas image ), only the new or
+	 *	changed images are inserted in the free space left. If they don't fit the atlas is packed
+	 *	from scratch.
+	 *	The Guillotine packer can't start from a partially filled atlas, so with that heuristic the
+	 *	new images are inserted with MaxRects ( best short side fit ). A repack from scratch always
+	 *	uses the configured heuristic.
+	 *	@param textureAtlasPath The previous texture atlas file path ( the .eta file ).
+	 *	@return False if the texture atlas couldn't be read or it's not compatible.
+	 */
+	bool setPreviousTextureAtlas( const std::string& textureAtlasPath );
+
+	/** @return The number of images that kept its placement from the previous texture atlas. */
+	Uint32 getReusedCount() const;
+
+	/** @return The ratio of the atlas area used by the images ( after packing ). */
+	Float getOccupancy() const;
+
   protected:
 	enum PackStrategy { PackBig, PackTiny, PackFail };
 
@@ -207,6 +262,14 @@ class EE_API TexturePacker {
 	bool mKeepExtensions;
 	bool mScalableSVG;
 	Image::SaveType mFormat;
+	PackingHeuristic mHeuristic;
+	Uint32 mThreadCount;
+	bool mTrim;
+	std::unique_ptr<System::ThreadPool> mThreadPool;
+	std::string mPreviousImagePath;
+	Sizei mPreviousSize;
+	std::unordered_map<std::string, sTextureRegionHdr> mPreviousRegions;
+	std::unordered_map<const TexturePackerTex*, sTextureRegionHdr> mReused;
 
 	TexturePacker* getChild() const;
 
@@ -249,6 +312,29 @@ class EE_API TexturePacker {
 
 	bool addPackerTex( TexturePackerTex* TPack );
 
+	void addPackerTexs( std::vector<TexturePackerTex*>& texs );
+
+	Image::FormatConfiguration getImageFormatConfiguration() const;
+
+	System::ThreadPool* getThreadPool();
+
+	void parallelFor( const size_t& count, const std::function<void( size_t )>& func );
+
+	void prepareTextures();
+
+	Int32 packGuillotine();
+
+	Int32 packBins();
+
+	Uint32 packBin( const Sizei& size, const std::vector<TexturePackerTex*>& texs,
+					std::vector<sTextureRegionHdr>& placements, const bool& stopOnFailure ) const;
+
+	void matchPreviousRegions( const std::vector<TexturePackerTex*>& texs );
+
+	void createBinChild();
+
+	void copySettings( TexturePacker* packer ) const;
+
 	void reset();
 
 	Uint32 getAtlasNumChannels();
@@ -39,6 +39,27 @@ struct sMapHdr {
 	Uint32 LightsCount;
 };
 
+//! Follows the sMapHdr in the chunked map format. The tiles of the tiled layers are stored in
+//! square chunks, every chunk keeps the tile type index of every tile of every tiled layer ( 0
+//! means no tile, N means the tile type N - 1 ), so chunks can be read independently.
+struct sMapChunkedHdr {
+	Uint32 Version;
+	Uint32 ChunkSize;
+	Uint32 ChunkCountX;
+	Uint32 ChunkCountY;
+	Uint32 TileTypeCount;
+	Uint32 IndexSize;		 //! Bytes per tile index ( 2 or 4 )
+	Uint64 ChunkIndexOffset; //! Offset of the sMapChunkHdr array ( relative to the map start )
+	Uint64 TileTypesOffset;	 //! Offset of the sMapTileGOHdr array ( relative to the map start )
+};
+
+//! One per chunk, in row-major order.
+struct sMapChunkHdr {
+	Uint64 Offset; //! Offset of the chunk data ( relative to the map start ), 0 for empty chunks
+	Uint32 Size;
+	Uint32 Flags;
+};
+
 struct sLayerHdr {
 	char Name[LAYER_NAME_SIZE];
 	Uint32 Type;
@@ -105,6 +126,11 @@ enum EE_GAMEOBJECT_TYPE {
 
 enum EE_LAYER_TYPE { MAP_LAYER_TILED, MAP_LAYER_OBJECT };
 
+enum EE_MAP_CHUNK_FLAGS { MAP_CHUNK_FLAG_COMPRESSED = ( 1 << 0 ) };
+
+#define MAP_CHUNKED_VERSION ( 1 )
+#define MAP_DEFAULT_CHUNK_SIZE ( 32 )
+
 enum EE_MAP_FLAGS {
 	MAP_FLAG_CLAMP_BORDERS = ( 1 << 0 ),
 	MAP_FLAG_CLIP_AREA = ( 1 << 1 ),
@@ -21,10 +21,12 @@ namespace EE { namespace Maps {
 
 namespace Private {
 class UIMapNew;
-}
+class TileMapChunkStreamer;
+} // namespace Private
 
 #define EE_MAP_LAYER_UNKNOWN eeINDEX_NOT_FOUND
 #define EE_MAP_MAGIC ( ( 'E' << 0 ) | ( 'E' << 8 ) | ( 'M' << 16 ) | ( 'P' << 24 ) )
+#define EE_MAP_CHUNKED_MAGIC ( ( 'E' << 0 ) | ( 'E' << 8 ) | ( 'M' << 16 ) | ( 'C' << 24 ) )
 
 class EE_API TileMap {
   public:
@@ -64,6 +66,44 @@ class EE_API TileMap {
 
 	virtual void saveToStream( IOStream& IOS );
 
+	/** Saves the map in the chunked format, even if the map is not set as chunked.
+	 *	@param compress Compress every chunk that gets smaller compressed. */
+	bool saveToStreamChunked( IOStream& IOS, const bool& compress = true );
+
+	bool saveToFileChunked( const std::string& path, const bool& compress = true );
+
+	/** Sets the size in tiles of the map chunks, must be a power of two. It can only be changed
+	 *	while the map has no layers ( the chunked maps set it on load ). */
+	void setChunkSize( const Uint32& chunkSize );
+
+	const Uint32& getChunkSize() const;
+
+	/** Sets if the map is saved in the chunked format by saveToFile and saveToStream. Maps loaded
+	 *	from a chunked file are chunked. Disabling it loads every chunk of a streamed map. */
+	void setChunked( const bool& chunked, const bool& compress = true );
+
+	const bool& isChunked() const;
+
+	/** Sets the number of chunks around the visible area that are kept loaded when the map is
+	 *	streamed. */
+	void setStreamingDistance( const Uint32& distance );
+
+	const Uint32& getStreamingDistance() const;
+
+	/** @return True if the tiles of the map are being streamed from a chunked map file. Only the
+	 *	chunks around the visible area are loaded, the rest are loaded by a worker thread when the
+	 *	view gets close to them. */
+	bool isStreaming() const;
+
+	/** @return The number of chunks of the streamed map that are loaded. */
+	Uint32 getLoadedChunkCount() const;
+
+	/** @return The number of chunks of the streamed map that are being loaded. */
+	const Uint32& getPendingChunkCount() const;
+
+	/** Requests the chunks needed by the current view and blocks until they are loaded. */
+	void waitForChunks();
+
 	virtual void draw();
 
 	virtual void update();
@@ -234,6 +274,9 @@ class EE_API TileMap {
 
   protected:
 	friend class EE::Maps::Private::UIMapNew;
+	friend class TileMapLayer;
+
+	enum ChunkState : Uint8 { CHUNK_UNLOADED, CHUNK_LOADING, CHUNK_LOADED, CHUNK_MODIFIED };
 
 	class ForcedHeaders {
 	  public:
@@ -286,6 +329,17 @@ class EE_API TileMap {
 	Uint32 mLastObjId;
 	PolyObjMap mPolyObjs;
 	ForcedHeaders* mForcedHeaders;
+	Uint32 mChunkSize;
+	Sizei mChunkCount;
+	bool mChunked;
+	bool mChunkCompression;
+	Uint32 mStreamingDistance;
+	Private::TileMapChunkStreamer* mStreamer;
+	std::vector<Uint8> mChunkStates;
+	std::vector<Uint32> mActiveChunks;
+	Uint32 mPendingChunks;
+	Rect mStreamingRect;
+	std::string mStreamPath;
 
 	virtual GameObject* createGameObject( const Uint32& Type, const Uint32& Flags, MapLayer* Layer,
 										  const Uint32& DataId = 0 );
@@ -311,6 +365,34 @@ class EE_API TileMap {
 	void createLightManager();
 
 	virtual void onMapLoaded();
+
+	void writeHeaders( IOStream& IOS, std::vector<std::string>& TextureAtlases );
+
+	void writeObjectLayers( IOStream& IOS );
+
+	void writeLights( IOStream& IOS );
+
+	sMapHdr createMapHeader( const std::vector<std::string>& TextureAtlases );
+
+	bool createStreamer( IOStream& IOS, const ios_size& start, const sMapChunkedHdr& header,
+						 const std::string& path );
+
+	/** Loads every chunk that is not resident and releases the streamer. */
+	void stopStreaming();
+
+	void updateStreaming();
+
+	bool collectChunks();
+
+	void loadChunk( const Uint32& chunkIndex );
+
+	void installChunk( const Uint32& chunkIndex, const std::vector<Uint32>& tiles );
+
+	Uint32 getChunkIndex( const Vector2i& TilePos ) const;
+
+	/** Called by the tiled layers before a tile is modified, so a streamed chunk is loaded before
+	 *	modifying it and it's never unloaded after. */
+	void onTileModified( const Vector2i& TilePos );
 };
 
 }} // namespace EE::Maps
@@ -3,6 +3,7 @@
 
 #include <eepp/maps/gameobject.hpp>
 #include <eepp/maps/maplayer.hpp>
+#include <vector>
 
 namespace EE { namespace Maps {
 
@@ -28,11 +29,19 @@ class EE_API TileMapLayer : public MapLayer {
 
 	Vector2f getPosFromTilePos( const Vector2i& TilePos );
 
+	/** @return True if the chunk has any tile storage allocated. */
+	bool isChunkAllocated( const Uint32& chunkIndex ) const;
+
   protected:
 	friend class TileMap;
 
-	GameObject*** mTiles;
+	//! The tiles are stored in square chunks of the map chunk size, allocated when the first tile
+	//! is added to them, so the empty areas of the map don't use memory.
+	std::vector<GameObject**> mChunks;
 	Sizei mSize;
+	Sizei mChunkCount;
+	Uint32 mChunkShift;
+	Int32 mChunkMask;
 	Vector2i mCurTile;
 
 	TileMapLayer( TileMap* map, Sizei size, Uint32 flags, std::string name = "",
@@ -41,6 +50,20 @@ class EE_API TileMapLayer : public MapLayer {
 	void allocateLayer();
 
 	void deallocateLayer();
+
+	inline GameObject* getTile( const Int32& x, const Int32& y ) const {
+		GameObject** chunk = mChunks[( y >> mChunkShift ) * mChunkCount.x + ( x >> mChunkShift )];
+		return NULL != chunk ? chunk[( ( y & mChunkMask ) << mChunkShift ) + ( x & mChunkMask )]
+							 : NULL;
+	}
+
+	GameObject*& getTileRef( const Int32& x, const Int32& y );
+
+	/** Sets the tile object without notifying the map about the modification. */
+	void placeGameObject( GameObject* obj, const Vector2i& TilePos );
+
+	/** Deletes every tile object of the chunk and releases its storage. */
+	void releaseChunk( const Uint32& chunkIndex );
 };
 
 }} // namespace EE::Maps
@@ -3,11 +3,15 @@
 
 #include <eepp/network/ftp.hpp>
 #include <eepp/network/http.hpp>
+#include <eepp/network/httpcache.hpp>
 #include <eepp/network/ipaddress.hpp>
 #include <eepp/network/packet.hpp>
+#include <eepp/network/packetpool.hpp>
 #include <eepp/network/socket.hpp>
 #include <eepp/network/sockethandle.hpp>
+#include <eepp/network/socketpoller.hpp>
 #include <eepp/network/socketselector.hpp>
+#include <eepp/network/ssl/sslsessioncache.hpp>
 #include <eepp/network/ssl/sslsocket.hpp>
 #include <eepp/network/tcplistener.hpp>
 #include <eepp/network/tcpsocket.hpp>
@@ -23,6 +23,8 @@ using namespace EE::System;
 
 namespace EE { namespace Network {
 
+class HttpCache;
+
 /** @brief A HTTP client */
 class EE_API Http : NonCopyable {
   public:
@@ -450,6 +452,45 @@ class EE_API Http : NonCopyable {
 	Response downloadRequest( const Request& request, std::string writePath,
 							  Time timeout = Time::Zero );
 
+	/** @brief Parameters of a ranged download
+	**	@see downloadRangedRequest */
+	struct RangedDownloadOptions {
+		RangedDownloadOptions() :
+			connections( 4 ), minPartSize( 1024 * 1024 ), retries( 3 ) {}
+
+		/** Maximum number of concurrent connections */
+		size_t connections;
+		/** Minimum size of each part, small files are split in fewer parts */
+		Uint64 minPartSize;
+		/** Number of times a part is requested again after a failure, from where it stopped */
+		unsigned int retries;
+		/** Expected MD5 of the file as an hex string, empty to skip the check */
+		std::string md5;
+	};
+
+	/** @brief Downloads a file splitting it in parts that are requested concurrently.
+	**  The server is probed first with a HEAD request. If it accepts byte ranges and reports the
+	**  size of the file, each part is requested with its own connection and written at its
+	**  offset in the destination file. Otherwise the file is downloaded with a single stream,
+	**  like downloadRequest.
+	**  The progress is kept in a state file next to the destination ( writePath + ".download" ),
+	**  so a download that fails, is cancelled or is interrupted by the end of the process is
+	**  resumed by calling it again with the same path, as long as the remote file didn't change.
+	**  Only files that the server identifies with an ETag or Last-Modified are resumed.
+	**  The state file is removed once the file is complete.
+	**  The progress callback of the request is called from the calling thread with the bytes
+	**  received by all the parts.
+	**  @param request Request to send, the Range field is set for each part
+	**  @param writePath The path of the file to write the downloaded content
+	**  @param options Number of connections, retries and the expected checksum
+	**  @param timeout Maximum time to wait for each connection
+	**  @return The response to the probe, with Ok status if the file is complete and its size
+	**  and checksum match. If the checksum doesn't match the file is removed and the status is
+	**  InvalidResponse. */
+	Response downloadRangedRequest( const Request& request, const std::string& writePath,
+									const RangedDownloadOptions& options = RangedDownloadOptions(),
+									Time timeout = Time::Zero );
+
 	/** Definition of the async callback response */
 	typedef std::function<void( const Http&, Http::Request&, Http::Response& )>
 		AsyncResponseCallback;
@@ -636,6 +677,14 @@ class EE_API Http : NonCopyable {
 		const Request::FieldTable& headers = Request::FieldTable(), const std::string& body = "",
 		const bool& validateCertificate = true, const URI& proxy = URI() );
 
+	/** @brief Sets the response cache used by every HTTP client ( disabled by default ).
+	**	The cache must outlive the requests, set it to NULL before destroying it.
+	**	@see HttpCache */
+	static void setCache( HttpCache* cache );
+
+	/** @return The response cache, NULL if disabled */
+	static HttpCache* getCache();
+
   private:
 	class AsyncRequest : public Thread {
 	  public:
@@ -703,6 +752,7 @@ class EE_API Http : NonCopyable {
 	};
 
 	friend class AsyncRequest;
+	friend class HttpCache;
 	ThreadLocalPtr<HttpConnection> mConnection; ///< Connection to the host
 	IpAddress mHost;							///< Web host address
 	std::string mHostName;						///< Web host name
@@ -716,6 +766,10 @@ class EE_API Http : NonCopyable {
 	void removeOldThreads();
 
 	Request prepareFields( const Http::Request& request );
+
+	/** Sends the request to the server, adding the validators of a cached response if any */
+	Response download( const Request& request, IOStream& writeTo, Time timeout,
+					   const Request::FieldTable& validators );
 };
 
 }} // namespace EE::Network
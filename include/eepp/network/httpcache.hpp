@@ -0,0 +1,144 @@
+#ifndef EE_NETWORKCHTTPCACHE_HPP
+#define EE_NETWORKCHTTPCACHE_HPP
+
+#include <eepp/core/noncopyable.hpp>
+#include <eepp/network/http.hpp>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace EE { namespace Network {
+
+/** @brief Disk cache for the HTTP responses
+**	Stores the body of the GET responses in a directory, with an index that is kept in memory and
+**	saved with them so the cache survives between runs. Fresh responses are served without any
+**	request, stale ones are revalidated with the server using their ETag or Last-Modified.
+**	@see Http::setCache */
+class EE_API HttpCache : NonCopyable {
+  public:
+	/** @brief Cache counters */
+	struct Stats {
+		Uint64 hits;		  ///< Fresh responses served without contacting the server
+		Uint64 revalidations; ///< Stale responses confirmed by the server ( 304 Not Modified )
+		Uint64 misses;		  ///< Responses downloaded from the server
+		Uint64 stores;		  ///< Responses added to the cache
+		Uint64 evictions;	  ///< Responses removed to keep the cache size under the limit
+		Uint64 bytesSaved;	  ///< Body bytes served from the cache instead of downloaded
+	};
+
+	/** @param directory Directory where the responses are stored, it's created if needed. Two
+	**	caches must not share the same directory.
+	**	@param maxSize Maximum size of the stored bodies in bytes. The least recently used
+	**	responses are removed first. */
+	HttpCache( const std::string& directory, Uint64 maxSize = 64 * 1024 * 1024 );
+
+	/** Saves the index of the cache. The stored responses are kept for the next run. */
+	~HttpCache();
+
+	const std::string& getDirectory() const;
+
+	void setMaxSize( Uint64 maxSize );
+
+	Uint64 getMaxSize() const;
+
+	/** @return The size of the stored bodies in bytes */
+	Uint64 getSize() const;
+
+	/** @return The number of stored responses */
+	size_t getCount() const;
+
+	/** @return True if there's a stored response for the url
+	**	@param url The full url of the resource ( scheme, host, port and path ) */
+	bool contains( const std::string& url ) const;
+
+	/** @brief Removes the stored response of an url */
+	void remove( const std::string& url );
+
+	/** @brief Removes every stored response */
+	void clear();
+
+	/** @brief Saves the index of the cache to disk.
+	**	The index is saved when responses are added or removed, this only saves the usage order. */
+	void flush();
+
+	Stats getStats() const;
+
+	void resetStats();
+
+  protected:
+	friend class Http;
+
+	struct Entry {
+		std::string url;
+		Uint64 id;
+		Uint64 size;
+		Int64 expires; ///< Unix time when the response becomes stale
+		Http::Response::FieldTable fields;
+	};
+
+	typedef std::list<Entry> EntryList;
+
+	mutable std::mutex mMutex;
+	std::string mDirectory;
+	Uint64 mMaxSize;
+	Uint64 mSize;
+	Uint64 mNextId;
+	bool mDirty;
+	EntryList mEntries; ///< Most recently used first
+	std::unordered_map<std::string, EntryList::iterator> mIndex;
+	Stats mStats;
+
+	/** @return True if the request can be answered from the cache */
+	static bool isCacheable( const Http::Request& request );
+
+	/** @brief Answers a request from the cache, revalidating or downloading it when needed */
+	Http::Response fetch( Http& http, const Http::Request& request, IOStream& writeTo,
+						  Time timeout );
+
+	bool find( const std::string& url, Entry& entry );
+
+	Uint64 allocateId();
+
+	void store( const std::string& url, Uint64 id, Uint64 size, Int64 expires,
+				const Http::Response::FieldTable& fields );
+
+	void update( const std::string& url, Int64 expires, const Http::Response::FieldTable& fields );
+
+	bool readBody( const Entry& entry, IOStream& writeTo );
+
+	void removeEntry( EntryList::iterator it );
+
+	std::string getEntryPath( Uint64 id ) const;
+
+	std::string getTempPath( Uint64 id ) const;
+
+	void load();
+
+	void save();
+
+	static Int64 getExpiration( const Http::Response::FieldTable& fields, Int64 now );
+};
+
+}} // namespace EE::Network
+
+#endif
+
+/**
+@class EE::Network::HttpCache
+
+The cache is disabled by default, it's enabled for every HTTP client of the process with
+Http::setCache:
+
+@code
+HttpCache cache( Sys::getConfigPath( "myapp" ) + "http-cache" );
+Http::setCache( &cache );
+
+// The first time the response is downloaded, the next ones are read from the cache until they
+// expire, and then only downloaded again if the server has a newer version.
+Http::Response response = Http::get( "https://example.com/image.png" );
+@endcode
+
+Only GET requests are cached. Responses with "Cache-Control: no-store" are not stored, and the ones
+with "Cache-Control: no-cache" are revalidated every time. A request with "Cache-Control: no-store"
+skips the cache, and one with "Cache-Control: no-cache" forces the revalidation.
+*/
@@ -0,0 +1,43 @@
+#ifndef EE_NETWORKCPACKETPOOL_HPP
+#define EE_NETWORKCPACKETPOOL_HPP
+
+#include <eepp/core.hpp>
+#include <eepp/core/noncopyable.hpp>
+#include <mutex>
+#include <vector>
+
+namespace EE { namespace Network {
+
+class Packet;
+
+/** @brief Pool of reusable packets
+**  Released packets are cleared but keep their memory, so acquiring a packet for a message of a
+**  similar size doesn't allocate. */
+class EE_API PacketPool : NonCopyable {
+  public:
+	/** @param maxFreePackets Maximum number of released packets kept by the pool, the packets
+	**  released over this number are destroyed. */
+	PacketPool( std::size_t maxFreePackets = 256 );
+
+	/** Destroys the free packets. The acquired packets not released must be destroyed by their
+	**  owners. */
+	~PacketPool();
+
+	/** @return An empty packet, owned by the caller until it's released */
+	Packet* acquire();
+
+	/** @brief Give back a packet acquired from the pool */
+	void release( Packet* packet );
+
+	/** @return The number of free packets kept by the pool */
+	std::size_t getFreeCount() const;
+
+  protected:
+	std::vector<Packet*> mFree;
+	std::size_t mMaxFreePackets;
+	mutable std::mutex mMutex;
+};
+
+}} // namespace EE::Network
+
+#endif // EE_NETWORKCPACKETPOOL_HPP
@@ -8,6 +8,7 @@
 
 namespace EE { namespace Network {
 class SocketSelector;
+class SocketPoller;
 
 /** @brief Base class for all the socket types */
 class EE_API Socket : NonCopyable {
@@ -82,6 +83,7 @@ class EE_API Socket : NonCopyable {
 
   protected:
 	friend class SocketSelector;
+	friend class SocketPoller;
 	// Member data
 	Type mType;			  ///< Type of the socket (TCP or UDP)
 	SocketHandle mSocket; ///< Socket descriptor
@@ -0,0 +1,200 @@
+#ifndef EE_NETWORKCSOCKETPOLLER_HPP
+#define EE_NETWORKCSOCKETPOLLER_HPP
+
+#include <eepp/core.hpp>
+#include <eepp/core/noncopyable.hpp>
+#include <eepp/network/sockethandle.hpp>
+#include <eepp/system/clock.hpp>
+#include <eepp/system/time.hpp>
+#include <unordered_map>
+#include <vector>
+using namespace EE::System;
+
+namespace EE { namespace Network {
+
+class Socket;
+
+namespace Private {
+class PollerImpl;
+}
+
+/** @brief Multiplexer that waits for readiness on a large number of sockets.
+**	Unlike SocketSelector it has no FD_SETSIZE limit and the cost of a wait doesn't depend on the
+**	number of sockets watched ( on Linux ). */
+class EE_API SocketPoller : NonCopyable {
+  public:
+	/** @brief How the readiness of a socket is reported */
+	enum Mode {
+		LevelTriggered, ///< Reported on every wait while the socket stays ready
+		EdgeTriggered	///< Reported only when the socket becomes ready ( epoll only )
+	};
+
+	/** @brief Readiness events */
+	enum EventFlags {
+		Read = 1 << 0,	 ///< Data available to receive, or a pending connection on a listener
+		Write = 1 << 1,	 ///< The socket can send without blocking
+		Hangup = 1 << 2, ///< The peer closed the connection
+		Error = 1 << 3,	 ///< An error is pending on the socket
+		Timeout = 1 << 4 ///< The socket had no activity during its timeout
+	};
+
+	/** @brief A ready socket, returned in batches by wait */
+	struct Event {
+		Socket* socket;
+		void* userData;
+		Uint32 events; ///< Combination of EventFlags
+	};
+
+	/** @param mode Readiness notification mode. Where it's not supported ( anything but epoll )
+	**	the poller falls back to level-triggered, see getMode.
+	**	@param maxEvents Maximum number of events returned by each wait
+	**	@param timerResolution Granularity of the socket timeouts
+	**	@param timerSlots Number of slots in the timer wheel. Timeouts longer than
+	**	timerResolution * timerSlots need more than one turn of the wheel. */
+	SocketPoller( Mode mode = LevelTriggered, size_t maxEvents = 1024,
+				  Time timerResolution = Milliseconds( 10 ), Uint32 timerSlots = 512 );
+
+	~SocketPoller();
+
+	/** @return The mode actually used by the poller */
+	Mode getMode() const;
+
+	/** @brief Add a new socket to the poller
+	**	This function keeps a weak reference to the socket, so you have to make sure that the
+	**	socket is not destroyed while it is stored in the poller.
+	**	@param socket Socket to watch
+	**	@param events Combination of Read and Write to watch. Hangup and Error are always reported.
+	**	@param userData Pointer returned with the socket events
+	**	@return False if the socket is not valid or it's already added */
+	bool add( Socket& socket, Uint32 events = Read, void* userData = NULL );
+
+	/** @brief Change the events watched for a socket already added */
+	bool modify( Socket& socket, Uint32 events );
+
+	/** @brief Remove a socket from the poller, pending events and timeouts included */
+	void remove( Socket& socket );
+
+	/** @brief Remove all the sockets from the poller */
+	void clear();
+
+	/** @return True if the socket is in the poller */
+	bool contains( Socket& socket ) const;
+
+	/** @return The number of sockets watched */
+	size_t getSocketCount() const;
+
+	void setUserData( Socket& socket, void* userData );
+
+	void* getUserData( Socket& socket ) const;
+
+	/** @brief Set an inactivity timeout for a socket
+	**	A Timeout event is reported when the socket doesn't get any readiness event during the
+	**	timeout. The timeout is rearmed by the next readiness event of the socket.
+	**	@param timeout Inactivity timeout, Time::Zero disables it */
+	void setTimeout( Socket& socket, const Time& timeout );
+
+	/** @brief Wait until one or more sockets are ready or timed out
+	**	@param timeout Maximum time to wait, (use Time::Zero for infinity)
+	**	@return The number of events available in getEvents */
+	size_t wait( Time timeout = Time::Zero );
+
+	/** @return The events collected by the last wait */
+	const std::vector<Event>& getEvents() const;
+
+  protected:
+	struct Entry {
+		Socket* socket;
+		void* userData;
+		Uint32 events;
+		Uint64 timeout;		 ///< Inactivity timeout in ticks, 0 if disabled
+		Uint64 lastActivity; ///< Tick of the last readiness event
+		Uint32 timerId;		 ///< Invalidates the timers scheduled before a setTimeout
+		bool timerArmed;
+	};
+
+	struct Timer {
+		SocketHandle handle;
+		Uint32 timerId;
+		Uint64 deadline;
+	};
+
+	Private::PollerImpl* mImpl;
+	Mode mMode;
+	size_t mMaxEvents;
+	std::unordered_map<SocketHandle, Entry> mEntries;
+	std::vector<Event> mEvents;
+	std::vector<Timer> mReschedule;
+	Clock mClock;
+	Int64 mResolution;
+	std::vector<std::vector<Timer>> mWheel;
+	Uint64 mTick;
+	size_t mArmedTimers;
+	Uint32 mTimerId;
+
+	Entry* getEntry( Socket& socket );
+
+	const Entry* getEntry( Socket& socket ) const;
+
+	Uint64 getCurrentTick() const;
+
+	void schedule( SocketHandle handle, Entry& entry, Uint64 deadline );
+
+	void expireTimers( Uint64 now );
+};
+
+}} // namespace EE::Network
+
+#endif // EE_NETWORKCSOCKETPOLLER_HPP
+
+/**
+@class EE::Network::SocketPoller
+
+The socket poller is a scalable alternative to SocketSelector. It uses epoll on Linux and
+Android, poll() on other Unix platforms and WSAPoll on Windows.
+
+Instead of testing every socket after a wait, the poller returns the batch of sockets that are
+ready, with the user data given when they were added. Sockets can also have an inactivity timeout,
+kept in a timer wheel so that thousands of them cost nothing until they expire.
+
+Usage example:
+@code
+TcpListener listener;
+listener.listen( 55001 );
+
+SocketPoller poller;
+poller.add( listener );
+
+while ( running ) {
+	poller.wait();
+
+	for ( const auto& event : poller.getEvents() ) {
+		if ( event.socket == &listener ) {
+			TcpSocket* client = new TcpSocket;
+
+			if ( listener.accept( *client ) == Socket::Done ) {
+				poller.add( *client, SocketPoller::Read, client );
+				poller.setTimeout( *client, Seconds( 30 ) );
+			} else {
+				delete client;
+			}
+		} else {
+			TcpSocket* client = static_cast<TcpSocket*>( event.userData );
+
+			if ( event.events & ( SocketPoller::Hangup | SocketPoller::Timeout ) ) {
+				poller.remove( *client );
+				delete client;
+			} else if ( event.events & SocketPoller::Read ) {
+				Packet packet;
+				client->receive( packet );
+				...
+			}
+		}
+	}
+}
+@endcode
+
+In edge-triggered mode a socket is reported only once until it becomes ready again, so it must be
+non-blocking and read until it returns Socket::NotReady.
+
+@see EE::Network::SocketSelector
+*/
@@ -0,0 +1,115 @@
+#ifndef EE_NETWORKCSSLSESSIONCACHE_HPP
+#define EE_NETWORKCSSLSESSIONCACHE_HPP
+
+#include <eepp/core.hpp>
+#include <eepp/system/clock.hpp>
+#include <eepp/system/singleton.hpp>
+#include <eepp/system/time.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+using namespace EE::System;
+
+namespace EE { namespace Network { namespace SSL {
+
+/** @brief Handshake counters of the TLS connections of the process */
+struct SSLHandshakeStats {
+	Uint64 fullHandshakes;	   ///< Handshakes that negotiated a new session
+	Uint64 resumedHandshakes;  ///< Handshakes that resumed a cached session
+	Uint64 failedHandshakes;   ///< Handshakes that didn't complete
+	Time fullHandshakeTime;	   ///< Time spent in the full handshakes
+	Time resumedHandshakeTime; ///< Time spent in the resumed handshakes
+	Uint64 cacheHits;		   ///< Connections that found a session to resume
+	Uint64 cacheMisses;		   ///< Connections that didn't find a session to resume
+};
+
+/** @brief Process-wide cache of the TLS sessions negotiated by the SSL sockets.
+**	Sessions are kept by host and port, and every new SSLSocket connection to the same host and
+**	port tries to resume the last session instead of doing a full handshake. */
+class EE_API SSLSessionCache {
+	SINGLETON_DECLARE_HEADERS( SSLSessionCache )
+
+  public:
+	/** A backend session, released by its backend when the last reference goes away */
+	typedef std::shared_ptr<void> Session;
+
+	~SSLSessionCache();
+
+	/** @brief Enables or disables the session resumption ( enabled by default ).
+	**	Disabling it also clears the cached sessions. */
+	void setEnabled( bool enabled );
+
+	bool isEnabled() const;
+
+	/** @brief Sets the maximum number of cached sessions, the least recently used are dropped
+	**	first ( 64 by default ). */
+	void setCapacity( size_t capacity );
+
+	size_t getCapacity() const;
+
+	/** @brief Sets how long a session is kept since it was negotiated ( 5 minutes by default ).
+	**	The server can reject a session before that, in that case a full handshake is done. */
+	void setLifetime( const Time& lifetime );
+
+	const Time& getLifetime() const;
+
+	/** @return The number of cached sessions */
+	size_t getSize() const;
+
+	/** @brief Forgets the session of a host */
+	void remove( const std::string& hostname, unsigned short port );
+
+	/** @brief Forgets every cached session */
+	void clear();
+
+	/** @return The handshake counters since the start or the last resetStats */
+	SSLHandshakeStats getStats() const;
+
+	void resetStats();
+
+  protected:
+	friend class OpenSSLSocket;
+	friend class MbedTLSSocket;
+
+	struct Entry {
+		std::string key;
+		Session session;
+		Time created;
+		bool validateCertificate;
+		bool validateHostname;
+	};
+
+	typedef std::list<Entry> EntryList;
+
+	mutable std::mutex mMutex;
+	bool mEnabled;
+	size_t mCapacity;
+	Time mLifetime;
+	Clock mClock;
+	EntryList mEntries; ///< Most recently used first
+	std::unordered_map<std::string, EntryList::iterator> mIndex;
+	SSLHandshakeStats mStats;
+
+	SSLSessionCache();
+
+	/** @return The session to resume for a new connection, or an empty session.
+	**	A session negotiated without validating the peer is never used for a connection that
+	**	validates it, since the validation is skipped on resumption. */
+	Session find( const std::string& hostname, unsigned short port, bool validateCertificate,
+				  bool validateHostname );
+
+	/** @brief Keeps the session negotiated by a connection, replacing the previous one */
+	void store( const std::string& hostname, unsigned short port, Session session,
+				bool validateCertificate, bool validateHostname );
+
+	void addHandshake( bool succeeded, bool resumed, const Time& time );
+
+	static std::string getKey( const std::string& hostname, unsigned short port );
+
+	void removeEntry( EntryList::iterator it );
+};
+
+}}} // namespace EE::Network::SSL
+
+#endif
@@ -57,6 +57,13 @@ class EE_API SSLSocket : public TcpSocket {
 
 	void tcpDisconnect();
 
+	/** @return True if the last connection resumed a cached session instead of doing a full
+	**	handshake. @see SSLSessionCache */
+	bool isSessionResumed() const;
+
+	/** @return The time spent in the handshake of the last connection */
+	Time getHandshakeTime() const;
+
 	Status tcpReceive( void* data, std::size_t size, std::size_t& received );
 
 	Status tcpSend( const void* data, std::size_t size, std::size_t& sent );
@@ -93,6 +93,7 @@ class EE_API TcpSocket : public Socket {
 
 	/** @brief Send a formatted packet of data to the remote peer
 	 *
+	 **  The packet size and data are gathered in a single system call, without copying them.
 	 **  In non-blocking mode, if this function returns sf::Socket::Partial,
 	 **  you \em must retry sending the same unmodified packet before sending
 	 **  anything else in order to guarantee the packet arrives at the remote
@@ -113,6 +114,34 @@ class EE_API TcpSocket : public Socket {
 	**  @see Send */
 	virtual Status receive( Packet& packet );
 
+	/** @brief Append a formatted packet to the send queue
+	**  The packet is copied to the queue, so it can be reused right away. The queued packets are
+	**  sent together by flush, coalescing many small packets in a single system call. The queue
+	**  memory is kept between flushes.
+	**  @param packet Packet to queue
+	**  @see flush */
+	void queue( Packet& packet );
+
+	/** @brief Send the queued packets
+	**  In non-blocking mode, if this function returns Partial the data not sent stays in the
+	**  queue, and it will be sent first by the next flush.
+	**  @return Status code
+	**  @see queue */
+	Status flush();
+
+	/** @return The number of bytes waiting in the send queue */
+	std::size_t getQueuedSize() const;
+
+	/** @brief Set the maximum size of the packets received
+	**  A packet announcing a bigger size makes receive fail with Error and disconnects the
+	**  socket, since the stream can't be resynchronized after it. 0 means no limit ( the
+	**  default ).
+	**  @param maxPacketSize Maximum packet size in bytes */
+	void setMaxPacketSize( const std::size_t& maxPacketSize );
+
+	/** @return The maximum size of the packets received, 0 if there's no limit */
+	const std::size_t& getMaxPacketSize() const;
+
 	/** Set the send timeout. Only callable after connect ( after the socket
 	 ** has been initialized ). */
 	void setSendTimeout( SocketHandle sock, const Time& timeout );
@@ -135,6 +164,9 @@ class EE_API TcpSocket : public Socket {
 
 	// Member data
 	PendingPacket mPendingPacket; ///< Temporary data of the packet currently being received
+	std::vector<char> mSendQueue; ///< Framed packets waiting to be flushed
+	std::size_t mSendQueuePos;	  ///< Bytes of the send queue already sent
+	std::size_t mMaxPacketSize;	  ///< Maximum size of the packets received, 0 for no limit
 };
 
 }} // namespace EE::Network
@@ -16,7 +16,15 @@ class EE_API UdpSocket : public Socket {
 	// Constants
 	enum {
 		MaxDatagramSize =
-			65507 ///< The maximum number of bytes that can be sent in a single UDP datagram
+			65507, ///< The maximum number of bytes that can be sent in a single UDP datagram
+		MaxBatchSize = 64 ///< The maximum number of datagrams received by a batched receive
+	};
+
+	/** @brief A packet and its peer, for the batched send and receive */
+	struct Datagram {
+		Packet* packet;
+		IpAddress remoteAddress;
+		unsigned short remotePort;
 	};
 
 	static UdpSocket* New();
@@ -101,6 +109,26 @@ class EE_API UdpSocket : public Socket {
 	**  @see Send */
 	Status receive( Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort );
 
+	/** @brief Send a batch of formatted packets, each one to its own peer
+	**  On Linux the whole batch is sent with a single system call ( sendmmsg ), on the other
+	**  platforms the datagrams are sent one by one.
+	**  @param datagrams Packets to send and their destinations
+	**  @param count	 Number of datagrams
+	**  @param sent		 This variable is filled with the number of datagrams sent
+	**  @return Status code, Partial if the socket is non-blocking and only some datagrams were
+	**  sent */
+	Status send( const Datagram* datagrams, std::size_t count, std::size_t& sent );
+
+	/** @brief Receive a batch of formatted packets
+	**  In blocking mode, this function waits for the first datagram and then takes the datagrams
+	**  already queued, up to count and MaxBatchSize, with a single system call ( recvmmsg ) on
+	**  Linux. On the other platforms a single datagram is received.
+	**  @param datagrams Packets to fill, and the peers that sent them
+	**  @param count	 Maximum number of datagrams to receive
+	**  @param received	 This variable is filled with the number of datagrams received
+	**  @return Status code */
+	Status receive( Datagram* datagrams, std::size_t count, std::size_t& received );
+
 	/** Set the send timeout. Only callable after bind ( after the socket
 	 ** has been initialized ). */
 	void setSendTimeout( SocketHandle sock, const Time& timeout );
@@ -112,6 +140,7 @@ class EE_API UdpSocket : public Socket {
   private:
 	// Member data
 	std::vector<char> mBuffer; ///< Temporary buffer holding the received data in Receive(Packet)
+	std::vector<char> mBatchBuffer; ///< Temporary buffers of the batched receive
 };
 
 }} // namespace EE::Network
@@ -9,6 +9,7 @@ using namespace EE::System;
 namespace EE { namespace Scene {
 
 class Node;
+class ActionManager;
 
 class EE_API Action {
   public:
@@ -16,6 +17,18 @@ class EE_API Action {
 
 	typedef std::function<void( Action*, const ActionType& )> ActionCallback;
 
+	/** Actions are allocated from pools of same sized blocks, so creating and destroying many
+	 * actions does not go through the general purpose allocator every time. */
+	static void* operator new( std::size_t size );
+
+	static void operator delete( void* ptr, std::size_t size );
+
+	/** The class allocation functions hide the global ones, the placement forms are kept so
+	 * actions can still be constructed into caller provided storage. */
+	static void* operator new( std::size_t size, void* ptr );
+
+	static void operator delete( void* ptr, void* place );
+
 	Action();
 
 	virtual ~Action();
@@ -39,6 +52,11 @@ class EE_API Action {
 	/** The total action time. */
 	virtual Time getTotalTime() = 0;
 
+	/** @return The time left until the action needs to be updated again. Time::Zero means that
+	 * the action must be updated every frame (animations). Used to sleep the main loop while
+	 * the only pending actions are waiting. */
+	virtual Time getNextDeadline();
+
 	/** Clones the action. */
 	virtual Action* clone() const;
 
@@ -90,6 +108,7 @@ class EE_API Action {
 
   protected:
 	friend class Node;
+	friend class ActionManager;
 	typedef std::map<ActionType, std::map<Uint32, ActionCallback>> ActionCallbackMap;
 
 	Node* mNode;
@@ -98,6 +117,10 @@ class EE_API Action {
 	Uint32 mNumCallBacks;
 	Uint32 mId;
 	ActionCallbackMap mCallbacks;
+	ActionManager* mManager;
+	size_t mManagerIndex;
+	size_t mTargetIndexSlot;
+	size_t mTagIndexSlot;
 
 	virtual void onStart();
 
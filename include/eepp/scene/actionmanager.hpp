@@ -4,7 +4,8 @@
 #include <eepp/config.hpp>
 #include <eepp/system/mutex.hpp>
 #include <eepp/system/time.hpp>
-#include <list>
+#include <unordered_map>
+#include <vector>
 using namespace EE::System;
 
 namespace EE { namespace Scene {
@@ -12,6 +13,11 @@ namespace EE { namespace Scene {
 class Action;
 class Node;
 
+/** @brief Owns and updates the running actions.
+**	Actions are stored contiguously in the order they were added, and indexed by target and tag so
+**	the queries and removals by target or tag do not scan every action. Actions removed or finished
+**	during an update are compacted out in a single pass at the end of the update.
+*/
 class EE_API ActionManager {
   public:
 	static ActionManager* New();
@@ -40,6 +46,10 @@ class EE_API ActionManager {
 
 	void update( const Time& time );
 
+	/** Gets the earliest deadline of the running actions.
+	 * @return False if there are no running actions. */
+	bool getNextDeadline( Time& deadline );
+
 	std::size_t count() const;
 
 	bool isEmpty() const;
@@ -47,9 +57,22 @@ class EE_API ActionManager {
 	void clear();
 
   protected:
-	std::list<Action*> mActions;
-	std::list<Action*> mActionsRemoveList;
+	friend class Action;
+
+	std::vector<Action*> mActions; // Removed actions leave a NULL until the next compaction.
+	std::vector<Action*> mActionsRemoveList;
+	std::unordered_map<Node*, std::vector<Action*>> mTargetIndex;
+	std::unordered_map<Uint32, std::vector<Action*>> mTagIndex; // Untagged actions not indexed.
+	std::size_t mRemovedCount;
 	bool mUpdating;
+
+	void unindexAction( Action* action );
+
+	void onActionTagChange( Action* action, const Uint32& oldTag );
+
+	void onActionTargetChange( Action* action, Node* oldTarget );
+
+	void compact();
 };
 
 }} // namespace EE::Scene
@@ -23,6 +23,8 @@ class EE_API Delay : public Action {
 
 	Time getTotalTime() override;
 
+	Time getNextDeadline() override;
+
 	Action* clone() const override;
 
 	Action* reverse() const override;
@@ -35,6 +35,8 @@ class EE_API Spawn : public Action {
 
 	Time getTotalTime() override;
 
+	Time getNextDeadline() override;
+
 	Action* clone() const override;
 
 	Action* reverse() const override;
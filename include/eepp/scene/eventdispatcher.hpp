@@ -114,6 +114,9 @@ class EE_API EventDispatcher {
 	Node* mNodeWasDragging;
 	Node* mNodeDragging;
 	Time mElapsed;
+	Vector2f mOverFindPos;		///< Cursor position of the last search of the mouse over node
+	Uint64 mOverFindGeneration; ///< Hit-test generation of the scene in the last search
+	bool mOverFindValid;
 
 	virtual void inputCallback( InputEvent* event );
 };
@@ -26,6 +26,9 @@ namespace EE { namespace Scene {
 class Action;
 class ActionManager;
 class SceneNode;
+namespace Private {
+class HitTestIndex;
+}
 }} // namespace EE::Scene
 using namespace EE::Scene;
 
@@ -62,7 +65,9 @@ enum NodeFlags {
 	NODE_FLAG_LAYOUT = ( 1 << 26 ),
 
 	NODE_FLAG_LOADING = ( 1 << 27 ),
-	NODE_FLAG_FREE_USE = ( 1 << 28 )
+	NODE_FLAG_RENDER_CACHE = ( 1 << 28 ),
+	NODE_FLAG_FREE_USE = ( 1 << 29 ),
+	NODE_FLAG_TRANSFORM_DIRTY = ( 1 << 30 )
 };
 
 class EE_API Node : public Transformable {
@@ -312,6 +317,8 @@ class EE_API Node : public Transformable {
 
 	Transform getLocalTransform() const;
 
+	/** @return The transform from the node to the world, cached until the node or any of its
+	**	parents change */
 	Transform getGlobalTransform() const;
 
 	Transform getNodeToWorldTransform() const;
@@ -385,6 +392,10 @@ class EE_API Node : public Transformable {
 
 	bool isClosing() const;
 
+	/** @return The topmost enabled and visible node under the point, searching this node and its
+	**	children. Nodes with many children keep a grid of their bounds and only test the children
+	**	whose world bounds contain the point, so an override must never find a node outside its
+	**	own world bounds. */
 	virtual Node* overFind( const Vector2f& Point );
 
 	/** This removes the node from its parent. Never use this unless you know what you are doing. */
@@ -402,9 +413,15 @@ class EE_API Node : public Transformable {
 
 	Uint32 forceTextInput( const TextInputEvent& Event );
 
+	/** @return The number of times that a node recalculated its world transform, screen position
+	**	or world polygon since the start. Useful to measure the cost of moving a subtree. */
+	static Uint64 getTransformUpdateCount();
+
   protected:
 	typedef std::map<Uint32, std::map<Uint32, EventCallback>> EventsMap;
 	friend class EventDispatcher;
+	friend class SceneNode;
+	friend class Private::HitTestIndex;
 
 	std::string mId;
 	String::HashType mIdHash;
@@ -419,12 +436,17 @@ class EE_API Node : public Transformable {
 	Node* mChildLast; //! Pointer to the last child added
 	Node* mNext;	  //! Pointer to the next child of the father
 	Node* mPrev;	  //! Pointer to the prev child of the father
+	Uint32 mChildCount;
+	Private::HitTestIndex* mHitTestIndex; //! Hit-test grid of the children, when there are many
 	Uint32 mNodeFlags;
 	BlendMode mBlend;
 	Uint16 mNumCallBacks;
 
 	mutable Polygon2f mPoly;
 	mutable Rectf mWorldBounds;
+	mutable Transform mWorldTransform;
+	Transform mScreenTransform; ///< Rotation and scale of the node and its parents on screen
+	bool mScreenTransformed;	///< False if mScreenTransform is the identity
 	Vector2f mCenter;
 
 	EventsMap mEvents;
@@ -502,6 +524,8 @@ class EE_API Node : public Transformable {
 
 	void clipEnd();
 
+	bool isOutsideCullRect( const Rectf& cullRect );
+
 	void updateScreenPos();
 
 	virtual void setInternalSize( const Sizef& size );
@@ -534,6 +558,9 @@ class EE_API Node : public Transformable {
 
 	void setDirty();
 
+	/** Marks the node and its children dirty because a parent changed */
+	void invalidateTransform();
+
 	void setChildsDirty();
 
 	void clipSmartEnable( const Int32& x, const Int32& y, const Uint32& Width,
@@ -10,6 +10,10 @@ using namespace EE::System;
 namespace EE { namespace UI {
 class UISceneNode;
 }} // namespace EE::UI
+
+namespace EE { namespace Window {
+class Window;
+}} // namespace EE::Window
 using namespace EE::UI;
 
 namespace EE { namespace Scene {
@@ -43,11 +47,40 @@ class EE_API SceneManager {
 
 	Time getElapsed() const;
 
+	/** Gets the time left until the earliest update deadline requested by the scenes (running
+	 * actions, animations, blinking carets, etc).
+	 * @return False if no scene is waiting for a deadline. */
+	bool getNextDeadline( Time& timeLeft ) const;
+
+	/** Sleeps until the next input event of the window or the earliest update deadline of the
+	 * scenes, whatever happens first. Deadlines due on the next frame are delayed until the frame
+	 * interval since the last update is consumed, so animations run at most at the frame rate.
+	 * Used by on-demand main loops, that only update the scenes when something happens and only
+	 * redraw them when they are invalidated.
+	 * @param maxWait The maximum time to wait. Time::Zero waits without limit. */
+	void waitForNextDeadline( EE::Window::Window* window, const Time& maxWait = Time::Zero );
+
+	/** @return The minimum time between two scene updates when waiting for the next deadline. */
+	const Time& getFrameInterval() const;
+
+	/** Sets the minimum time between two scene updates when waiting for the next deadline.
+	 * Defaults to 1/60 seconds. */
+	void setFrameInterval( const Time& frameInterval );
+
+	/** @return The number of times per second that the scenes were updated, measured over the
+	 * last second or since the last update if it was longer ago. An idle on-demand main loop
+	 * reports values close to zero. */
+	Float getWakeUpsPerSecond() const;
+
   protected:
 	Clock mClock;
 	UISceneNode* mUISceneNode;
 	bool mIsShootingDown;
 	std::vector<SceneNode*> mSceneNodes;
+	Time mFrameInterval;
+	Clock mWakeUpsClock;
+	Uint32 mWakeUps;
+	Float mWakeUpsPerSecond;
 };
 
 }} // namespace EE::Scene
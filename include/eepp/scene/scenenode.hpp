@@ -2,9 +2,11 @@
 #define EE_SCENENODE_HPP
 
 #include <eepp/scene/node.hpp>
+#include <eepp/system/clock.hpp>
 #include <eepp/system/translator.hpp>
 #include <eepp/window/cursor.hpp>
 #include <unordered_set>
+#include <vector>
 
 namespace EE { namespace Graphics {
 class FrameBuffer;
@@ -45,6 +47,28 @@ class EE_API SceneNode : public Node {
 
 	void disableDrawInvalidation();
 
+	/** @brief Enables the dirty region redraw.
+	**	When the scene node renders into a frame buffer with draw invalidation enabled, only the
+	**	union of the bounds of the nodes invalidated since the last frame is cleared and redrawn,
+	**	instead of the whole frame buffer. Nodes must draw inside their bounds (or inside a clipped
+	**	parent) for the region to be accurate, so it is disabled by default.
+	*/
+	void setUseDirtyRegions( bool use );
+
+	bool usesDirtyRegions() const;
+
+	virtual void invalidate( Node* invalidator );
+
+	/** @brief Pushes a rectangle ( in screen coordinates ) used to cull the clipped nodes drawn
+	**	until it is popped. By default the rectangle is intersected with the current one.
+	*/
+	void pushCullRect( const Rectf& rect, bool intersect = true );
+
+	void popCullRect();
+
+	/** @return The current cull rectangle or NULL if there is none. */
+	const Rectf* getCullRect() const;
+
 	EE::Window::Window* getWindow();
 
 	FrameBuffer* getFrameBuffer() const;
@@ -109,14 +133,37 @@ class EE_API SceneNode : public Node {
 
 	void removeMouseOverNode( Node* node );
 
+	/** @brief Signals that the node under the cursor could have changed.
+	**	The nodes call it when they move, resize, change their visibility or their children. A
+	**	node with a custom overFind must call it when anything else changes its result. */
+	void invalidateHitTest();
+
+	/** @return A counter increased by each invalidateHitTest. The event dispatcher only searches
+	**	the node under the cursor again when the counter or the cursor position change. */
+	const Uint64& getHitTestGeneration() const;
+
 	const bool& getUpdateAllChilds() const;
 
 	void setUpdateAllChilds( const bool& updateAllChilds );
 
 	const Float& getDPI() const;
 
+	/** Requests the scene to be updated again in at most the given time. The on-demand main loop
+	 * sleeps until the earliest deadline requested by the scenes or the next input event. Nodes
+	 * that change over time without running actions (blinking carets, animated sprites, etc)
+	 * must request their next deadline on every update. Time::Zero requests an update on the
+	 * next frame. */
+	void setUpdateDeadline( const Time& timeFromNow );
+
+	/** @return True if an update deadline is pending. */
+	bool hasUpdateDeadline() const;
+
+	/** @return The time left until the earliest update deadline requested. */
+	Time getTimeToUpdateDeadline() const;
+
   protected:
 	friend class Node;
+	friend class EventDispatcher;
 	typedef std::unordered_set<Node*> CloseList;
 
 	EE::Window::Window* mWindow;
@@ -141,7 +188,18 @@ class EE_API SceneNode : public Node {
 	std::unordered_set<Node*> mScheduledUpdate;
 	std::unordered_set<Node*> mScheduledUpdateRemove;
 	std::unordered_set<Node*> mMouseOverNodes;
+	std::unordered_set<Node*> mDirtyNodes;
+	std::vector<Rectf> mCullRects;
+	Rectf mDirtyRegion;
+	bool mUseDirtyRegions;
+	bool mDirtyRegionFull;
+	bool mDirtyRegionEmpty;
+	bool mDirtyRegionClipped;
 	Float mDPI;
+	Clock mDeadlineClock;
+	Time mUpdateDeadline;
+	bool mHasUpdateDeadline;
+	Uint64 mHitTestGeneration;
 
 	virtual void onSizeChange();
 
@@ -168,6 +226,20 @@ class EE_API SceneNode : public Node {
 	void drawFrameBuffer();
 
 	Sizei getFrameBufferSize();
+
+	void addDirtyRect( const Rectf& rect );
+
+	void removeDirtyNode( Node* node );
+
+	void resetDirtyRegion();
+
+	Rectf getDirtyRegion();
+
+	/** Forgets the mouse over nodes of the last frame, before searching them again */
+	void resetMouseOverNodes();
+
+	/** Flags again the mouse over nodes of the last frame, when the search is skipped */
+	void restoreMouseOverNodes();
 };
 
 }} // namespace EE::Scene
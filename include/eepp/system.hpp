@@ -15,7 +15,9 @@
 #include <eepp/system/iostreamdeflate.hpp>
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/system/iostreaminflate.hpp>
+#include <eepp/system/iostreammapped.hpp>
 #include <eepp/system/iostreampak.hpp>
+#include <eepp/system/iostreamreadahead.hpp>
 #include <eepp/system/iostreamstring.hpp>
 #include <eepp/system/iostreamzip.hpp>
 #include <eepp/system/lock.hpp>
@@ -26,6 +28,7 @@
 #include <eepp/system/pack.hpp>
 #include <eepp/system/packmanager.hpp>
 #include <eepp/system/pak.hpp>
+#include <eepp/system/profiler.hpp>
 #include <eepp/system/rc4.hpp>
 #include <eepp/system/resourceloader.hpp>
 #include <eepp/system/resourcemanager.hpp>
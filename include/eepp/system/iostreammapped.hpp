@@ -0,0 +1,68 @@
+#ifndef EE_SYSTEMCIOSTREAMMAPPED_HPP
+#define EE_SYSTEMCIOSTREAMMAPPED_HPP
+
+#include <eepp/system/iostream.hpp>
+#include <string>
+
+namespace EE { namespace System {
+
+/** @brief A read-only file stream backed by a memory mapping of the file.
+**	The file contents are exposed as a zero-copy view with getData(), so loaders that accept
+**	memory buffers can parse the file without reading it into an intermediate buffer.
+**	On platforms without memory mapping support the file is read into memory once.
+*/
+class EE_API IOStreamMapped : public IOStream {
+  public:
+	/** The expected access pattern, used as a hint to the kernel paging. */
+	enum class AccessHint { Normal, Sequential, Random, WillNeed };
+
+	static IOStreamMapped* New( const std::string& path,
+								const AccessHint& hint = AccessHint::Sequential );
+
+	/** @brief Maps a file from the file system
+	**	@param path File to map
+	**	@param hint The expected access pattern of the mapped memory
+	**/
+	IOStreamMapped( const std::string& path, const AccessHint& hint = AccessHint::Sequential );
+
+	virtual ~IOStreamMapped();
+
+	ios_size read( char* data, ios_size size );
+
+	/** Mapped streams are read-only, nothing is written. */
+	ios_size write( const char* data, ios_size size );
+
+	ios_size seek( ios_size position );
+
+	ios_size tell();
+
+	ios_size getSize();
+
+	bool isOpen();
+
+	/** @return The file contents, or NULL if the file is not open or empty. */
+	const char* getData() const;
+
+	/** @brief Changes the access pattern hint of the mapped memory. */
+	void setAccessHint( const AccessHint& hint );
+
+	/** @return True if the contents are mapped, false if they were read into memory. */
+	bool isMapped() const;
+
+	void close();
+
+  protected:
+	const char* mData;
+	ios_size mSize;
+	ios_size mPos;
+	bool mOpen;
+	bool mMapped;
+#if EE_PLATFORM == EE_PLATFORM_WIN
+	void* mFile;
+	void* mMapping;
+#endif
+};
+
+}} // namespace EE::System
+
+#endif
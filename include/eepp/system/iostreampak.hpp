@@ -8,7 +8,9 @@ namespace EE { namespace System {
 
 class IOStreamFile;
 
-/** @brief An implementation for a zip file steam */
+/** @brief An implementation for a PAK file steam
+**	Reads from the memory-mapped PAK when available, otherwise from its own file handle.
+*/
 class EE_API IOStreamPak : public IOStream {
   public:
 	static IOStreamPak* New( Pak* pack, const std::string& path, bool writeMode = false );
@@ -36,6 +38,7 @@ class EE_API IOStreamPak : public IOStream {
 
   protected:
 	IOStreamFile* mFile;
+	const char* mData;
 	Pak::pakEntry mEntry;
 	Int32 mPos;
 	bool mOpen;
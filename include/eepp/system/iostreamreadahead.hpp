@@ -0,0 +1,85 @@
+#ifndef EE_SYSTEMCIOSTREAMREADAHEAD_HPP
+#define EE_SYSTEMCIOSTREAMREADAHEAD_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <eepp/system/iostream.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace EE { namespace System {
+
+class Thread;
+
+/** @brief A read-only buffered stream that reads ahead of the consumer on a worker thread.
+**	The source stream is read in chunks on a worker thread while the previous chunks are being
+**	consumed, so large sequential reads overlap the I/O with the processing of the data.
+**	The source stream must not be used directly while it's being read by the read-ahead stream.
+*/
+class EE_API IOStreamReadAhead : public IOStream {
+  public:
+	/** @brief Opens a file and reads it ahead. */
+	static IOStreamReadAhead* New( const std::string& path, const size_t& chunkSize = EE_1MB,
+								   const size_t& chunksAhead = 2 );
+
+	static IOStreamReadAhead* New( IOStream* stream, bool ownStream = false,
+								   const size_t& chunkSize = EE_1MB,
+								   const size_t& chunksAhead = 2 );
+
+	/** @param stream The source stream, read from the current position.
+	**	@param ownStream Whether the source stream is released with the read-ahead stream.
+	**	@param chunkSize The size in bytes of each read from the source stream.
+	**	@param chunksAhead The maximum number of chunks read ahead of the consumer.
+	*/
+	IOStreamReadAhead( IOStream* stream, bool ownStream = false, const size_t& chunkSize = EE_1MB,
+					   const size_t& chunksAhead = 2 );
+
+	virtual ~IOStreamReadAhead();
+
+	ios_size read( char* data, ios_size size );
+
+	/** Read-ahead streams are read-only, nothing is written. */
+	ios_size write( const char* data, ios_size size );
+
+	/** @brief Seeks inside the current chunk without I/O, otherwise restarts the read-ahead from
+	** the new position. */
+	ios_size seek( ios_size position );
+
+	ios_size tell();
+
+	ios_size getSize();
+
+	bool isOpen();
+
+  protected:
+	typedef std::vector<char> Chunk;
+
+	IOStream* mStream;
+	bool mOwnStream;
+	size_t mChunkSize;
+	size_t mChunksAhead;
+	ios_size mSize;
+	ios_size mPos;
+	Chunk mCurrent;
+	size_t mCurrentPos;
+	std::deque<Chunk> mReady;
+	std::vector<Chunk> mFree;
+	bool mEof;
+	bool mStop;
+	Thread* mThread;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+
+	void readAhead();
+
+	void startReadAhead();
+
+	void stopReadAhead();
+
+	bool nextChunk();
+};
+
+}} // namespace EE::System
+
+#endif
@@ -2,14 +2,20 @@
 #define EE_SYS_IOSTREAMZIP_HPP
 
 #include <eepp/system/iostream.hpp>
+#include <eepp/system/zip.hpp>
 
 struct zip;
 struct zip_file;
 
 namespace EE { namespace System {
-class Zip;
 
-/** @brief An implementation for a zip file steam */
+struct ZipInflateData;
+
+/** @brief An implementation for a zip file steam
+**	Entries are read from the memory-mapped zip file when possible. Deflated entries keep
+**	decompression checkpoints every megabyte, so seeking back restarts from the nearest checkpoint
+**	instead of decompressing the entry from the start.
+*/
 class EE_API IOStreamZip : public IOStream {
   public:
 	static IOStreamZip* New( Zip* pack, const std::string& path );
@@ -39,6 +45,13 @@ class EE_API IOStreamZip : public IOStream {
 	struct zip* mZip;
 	struct zip_file* mFile;
 	ios_size mPos;
+	const Uint8* mData;
+	Zip::Entry mEntry;
+	ZipInflateData* mInflate;
+
+	ios_size inflateRead( char* data, ios_size size );
+
+	void inflateSeek( ios_size position );
 };
 
 }} // namespace EE::System
@@ -1,11 +1,16 @@
 #ifndef EECLOG_H
 #define EECLOG_H
 
+#include <atomic>
+#include <condition_variable>
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/system/mutex.hpp>
 #include <eepp/system/singleton.hpp>
 #include <eepp/system/sys.hpp>
+#include <eepp/system/thread.hpp>
 #include <list>
+#include <mutex>
+#include <vector>
 
 namespace EE { namespace System {
 
@@ -27,6 +32,12 @@ enum class LogLevel : int {
 	Assert,	  ///< Asserted critical condition.
 };
 
+/** @brief Defines what happens when a message is written while the asynchronous queue is full. */
+enum class LogQueuePolicy : int {
+	Block, ///< The writing thread waits until the background writer makes room.
+	Drop,  ///< The message is not sent to the console or the file and it is counted as dropped.
+};
+
 /** @brief Global log file. The engine will log everything in this file. */
 class EE_API Log : protected Mutex {
 	SINGLETON_DECLARE_HEADERS( Log )
@@ -100,6 +111,43 @@ class EE_API Log : protected Mutex {
 	 * logged. */
 	void setLogLevelThreshold( const LogLevel& logLevelThreshold );
 
+	/** @return True if the console and file output is done from a background writer thread. */
+	bool isAsync() const;
+
+	/** @brief Enables or disables the asynchronous output mode.
+	**	When enabled, writes only append the message to the in-memory buffer, notify the log
+	**	readers and queue the message. A background thread writes the queued messages to the
+	**	terminal and to the log file in batches, flushing once per batch.
+	**	Disabling it waits until every queued message has been written. */
+	void setAsync( bool async );
+
+	/** @return The maximum number of messages waiting to be written by the background writer. */
+	const size_t& getAsyncQueueCapacity() const;
+
+	/** @brief Sets the maximum number of messages waiting to be written by the background writer.
+	 */
+	void setAsyncQueueCapacity( const size_t& capacity );
+
+	/** @return The policy applied when the asynchronous queue is full. */
+	const LogQueuePolicy& getAsyncQueuePolicy() const;
+
+	/** @brief Sets the policy applied when the asynchronous queue is full. */
+	void setAsyncQueuePolicy( const LogQueuePolicy& policy );
+
+	/** @return The number of messages dropped because the asynchronous queue was full. */
+	Uint64 getDroppedCount() const;
+
+	/** @brief Blocks until every queued message has been written and flushes the log file. */
+	void flush();
+
+	/** @return The maximum size in bytes of the in-memory log buffer. 0 means unlimited. */
+	const size_t& getMaxBufferSize() const;
+
+	/** @brief Sets the maximum size in bytes of the in-memory log buffer (the one returned by
+	**	getBuffer()). When the buffer grows beyond the limit the oldest lines are discarded.
+	**	0 means unlimited (the default). */
+	void setMaxBufferSize( const size_t& maxBufferSize );
+
 	static void debug( const std::string& text ) {
 		Log::instance()->writel( LogLevel::Debug, text );
 	}
@@ -171,12 +219,32 @@ class EE_API Log : protected Mutex {
 #endif
 	IOStreamFile* mFS;
 	std::list<LogReaderInterface*> mReaders;
+	size_t mMaxBufferSize{0};
+	std::atomic<bool> mAsync{false};
+	Thread* mWriterThread{NULL};
+	Uint32 mWriterThreadId{0};
+	std::vector<std::string> mQueue;
+	size_t mQueueCapacity{4096};
+	LogQueuePolicy mQueuePolicy{LogQueuePolicy::Block};
+	Uint64 mDroppedCount{0};
+	bool mWriterBusy{false};
+	bool mWriterStop{false};
+	mutable std::mutex mQueueMutex;
+	std::condition_variable mQueueCond;
 
 	void openFS();
 
 	void closeFS();
 
 	void writeToReaders( const std::string& text );
+
+	void appendToBuffer( const std::string& text );
+
+	void output( std::string&& text );
+
+	void writeOutput( const std::string& text, bool flush );
+
+	void writerThreadFunc();
 };
 
 }} // namespace EE::System
@@ -77,6 +77,11 @@ class EE_API Pack : protected Mutex {
 	/** Open a file stream for reading */
 	virtual IOStream* getFileStream( const std::string& path ) = 0;
 
+	/** Gets a zero-copy view of a file stored uncompressed in the pack file.
+	 * The view is valid until the pack is modified or closed.
+	 * @return False if the file can't be viewed without extracting it. */
+	virtual bool getFileView( const std::string& path, const Uint8*& data, size_t& size );
+
   protected:
 	bool mIsOpen;
 
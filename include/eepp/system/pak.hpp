@@ -2,11 +2,17 @@
 #define EE_SYSTEMCPAK_HPP
 
 #include <eepp/system/iostreamfile.hpp>
+#include <eepp/system/iostreammapped.hpp>
 #include <eepp/system/pack.hpp>
+#include <unordered_map>
 
 namespace EE { namespace System {
 
-/** @brief Quake 2 PAK handler */
+/** @brief Quake 2 PAK handler
+**	The directory is indexed by file name when the PAK is opened, and the PAK is memory-mapped so
+**	files are read from the mapped view without locking the pack. Concurrent reads are safe as
+**	long as the pack isn't modified at the same time.
+*/
 class EE_API Pak : public Pack {
   public:
 	static Pak* New();
@@ -76,6 +82,9 @@ class EE_API Pak : public Pack {
 
 	IOStream* getFileStream( const std::string& path );
 
+	/** Gets a zero-copy view of a file in the pakFile ( files are always stored uncompressed ). */
+	bool getFileView( const std::string& path, const Uint8*& data, size_t& size );
+
   protected:
 	friend class IOStreamPak;
 
@@ -101,8 +110,17 @@ class EE_API Pak : public Pack {
 
 	pakFile mPak;
 	std::vector<pakEntry> mPakFiles;
+	std::unordered_map<std::string, Uint32> mPakIndex;
+	IOStreamMapped* mMapped;
 
 	pakEntry getPackEntry( Uint32 index );
+
+	void indexEntry( const Uint32& index );
+
+	void mapPack();
+
+	/** @return The mapped data of the entry, or NULL if the PAK couldn't be mapped. */
+	const Uint8* getEntryData( const pakEntry& entry ) const;
 };
 
 }} // namespace EE::System
@@ -0,0 +1,123 @@
+#ifndef EE_SYSTEM_PROFILER_HPP
+#define EE_SYSTEM_PROFILER_HPP
+
+#include <atomic>
+#include <eepp/config.hpp>
+#include <eepp/core/noncopyable.hpp>
+#include <eepp/system/singleton.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace EE { namespace System {
+
+/** @brief Lightweight scoped-zone profiler.
+**	Zones are recorded with the EE_PROFILE_SCOPE( "name" ) macro. Each thread records its zones
+**	into its own fixed-size ring buffer, so recording never contends with other threads. The
+**	recorded zones can be aggregated or exported to the Chrome trace event format (loadable in
+**	chrome://tracing and Perfetto).
+**	The macro only generates code when the library is built with EE_PROFILER defined (premake
+**	option --with-profiler), and recording must also be enabled at runtime with setEnabled().
+*/
+class EE_API Profiler : NonCopyable {
+	SINGLETON_DECLARE_HEADERS( Profiler )
+
+  public:
+	struct Event {
+		const char* name; ///< Zone name, must be a string literal or outlive the profiler.
+		Uint64 start;	  ///< Start time in microseconds.
+		Uint64 duration;  ///< Duration in microseconds.
+		Uint32 threadId;  ///< Id of the thread that recorded the zone.
+	};
+
+	struct ZoneStats {
+		const char* name;
+		Uint64 calls;
+		Uint64 totalTime; ///< Microseconds.
+		Uint64 maxTime;	  ///< Microseconds.
+	};
+
+	/** @return True if the zones are being recorded. */
+	static bool isActive() { return sActive.load( std::memory_order_relaxed ); }
+
+	/** @return The current time in microseconds used for the zone timestamps. */
+	static Uint64 now();
+
+	~Profiler();
+
+	/** @return True if the zones are being recorded. */
+	bool isEnabled() const;
+
+	/** @brief Enables or disables the zone recording at runtime. */
+	void setEnabled( bool enabled );
+
+	/** @return The maximum number of zones kept per thread. When the limit is reached the oldest
+	 * zones are overwritten. */
+	const size_t& getMaxEventsPerThread() const;
+
+	/** @brief Sets the maximum number of zones kept per thread. Applies to buffers created after
+	 * the call and to existing buffers after clear(). */
+	void setMaxEventsPerThread( const size_t& maxEvents );
+
+	/** @brief Discards every recorded zone. */
+	void clear();
+
+	/** @brief Records a zone. Usually called through EE_PROFILE_SCOPE. */
+	void addEvent( const char* name, const Uint64& start, const Uint64& end );
+
+	/** @return A snapshot of every recorded zone, sorted by start time. */
+	std::vector<Event> getEvents() const;
+
+	/** @return The recorded zones aggregated by name, sorted by total time (descending). */
+	std::vector<ZoneStats> getZoneStats() const;
+
+	/** @return The recorded zones in the Chrome trace event JSON format. */
+	std::string toChromeTrace() const;
+
+	/** @brief Saves the recorded zones in the Chrome trace event JSON format. */
+	bool saveChromeTrace( const std::string& path ) const;
+
+  protected:
+	struct ThreadBuffer;
+
+	static std::atomic<bool> sActive;
+
+	size_t mMaxEventsPerThread{1 << 16};
+	Uint32 mGeneration{0};
+	mutable std::mutex mBuffersMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+
+	Profiler();
+
+	ThreadBuffer* getThreadBuffer();
+};
+
+/** @brief Records the lifetime of the scope as a profiler zone. Use EE_PROFILE_SCOPE. */
+class ProfilerScope : NonCopyable {
+  public:
+	explicit ProfilerScope( const char* name ) :
+		mName( name ), mStart( Profiler::isActive() ? Profiler::now() : 0 ) {}
+
+	~ProfilerScope() {
+		if ( mStart != 0 && Profiler::isActive() )
+			Profiler::instance()->addEvent( mName, mStart, Profiler::now() );
+	}
+
+  protected:
+	const char* mName;
+	Uint64 mStart;
+};
+
+}} // namespace EE::System
+
+#ifdef EE_PROFILER
+#define EE_PROFILE_CONCAT_IMPL( a, b ) a##b
+#define EE_PROFILE_CONCAT( a, b ) EE_PROFILE_CONCAT_IMPL( a, b )
+#define EE_PROFILE_SCOPE( name ) \
+	::EE::System::ProfilerScope EE_PROFILE_CONCAT( eeProfilerScope, __LINE__ )( name )
+#else
+#define EE_PROFILE_SCOPE( name )
+#endif
+
+#endif
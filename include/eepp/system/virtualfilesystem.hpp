@@ -6,6 +6,7 @@
 #include <eepp/system/iostream.hpp>
 #include <eepp/system/pack.hpp>
 #include <eepp/system/singleton.hpp>
+#include <unordered_map>
 
 namespace EE { namespace System {
 
@@ -53,6 +54,7 @@ class EE_API VirtualFileSystem : protected Container<Pack> {
 	void removePackFromDirectory( Pack* resource, vfsDirectory& directory );
 
 	vfsDirectory mRoot;
+	std::unordered_map<std::string, Pack*> mFileIndex; //! Pack of each file path.
 };
 
 class EE_API VFS {
@@ -2,12 +2,19 @@
 #define EE_SYSTEMCZIP_HPP
 
 #include <eepp/system/pack.hpp>
+#include <unordered_map>
 
 struct zip;
 
 namespace EE { namespace System {
 
-/** @brief Zip files package manager. */
+class IOStreamMapped;
+
+/** @brief Zip files package manager.
+**	The entries are indexed by name when the zip file is opened, and the zip file is
+**	memory-mapped so stored and deflated entries are read from the mapped view without locking the
+**	pack. Concurrent reads are safe as long as the pack isn't modified at the same time.
+*/
 class EE_API Zip : public Pack {
   public:
 	static Zip* New();
@@ -74,14 +81,40 @@ class EE_API Zip : public Pack {
 
 	IOStream* getFileStream( const std::string& path );
 
+	/** Gets a zero-copy view of a file stored uncompressed in the zip file. */
+	bool getFileView( const std::string& path, const Uint8*& data, size_t& size );
+
   protected:
 	friend class IOStreamZip;
 
+	struct Entry {
+		Int32 index;
+		Uint64 offset; //! Offset of the entry data in the mapped zip file, 0 if not mapped
+		Uint64 compressedSize;
+		Uint64 size;
+		Uint16 method;
+		Uint32 crc;
+	};
+
 	struct zip* mZip;
 
 	std::string mZipPath;
 
+	std::unordered_map<std::string, Entry> mEntries;
+
+	IOStreamMapped* mMapped;
+
 	struct zip* getZip();
+
+	void indexEntries();
+
+	const Entry* getEntry( const std::string& path ) const;
+
+	/** @return The stored or compressed data of the entry in the mapped zip file. */
+	const Uint8* getEntryData( const Entry& entry ) const;
+
+	/** Reads the entry from the mapped zip file into data ( entry.size bytes ). */
+	bool readEntry( const Entry& entry, Uint8* data ) const;
 };
 
 }} // namespace EE::System
@@ -47,6 +47,7 @@ enum class PropertyId : Uint32 {
 	LayoutToTopOf = String::hash( "layout-to-top-of" ),
 	LayoutToBottomOf = String::hash( "layout-to-bottom-of" ),
 	Clip = String::hash( "clip" ),
+	RenderCache = String::hash( "render-cache" ),
 	Rotation = String::hash( "rotation" ),
 	Scale = String::hash( "scale" ),
 	RotationOriginPointX = String::hash( "rotation-origin-point-x" ),
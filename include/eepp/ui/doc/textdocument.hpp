@@ -5,6 +5,7 @@
 #include <eepp/system/clock.hpp>
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/system/pack.hpp>
+#include <eepp/system/threadpool.hpp>
 #include <eepp/system/time.hpp>
 #include <eepp/ui/doc/syntaxdefinition.hpp>
 #include <eepp/ui/doc/textdocumentline.hpp>
@@ -13,6 +14,7 @@
 #include <eepp/ui/doc/undostack.hpp>
 #include <functional>
 #include <map>
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
@@ -30,6 +32,11 @@ class EE_API TextDocument {
 
 	enum class LineEnding { LF, CRLF };
 
+	enum class FindReplaceType { Normal, LuaPattern };
+
+	typedef std::function<void( std::vector<TextRange> matches, Uint64 changeId )>
+		FindAllCallback;
+
 	class EE_API Client {
 	  public:
 		virtual ~Client();
@@ -255,6 +262,33 @@ class EE_API TextDocument {
 	TextPosition replace( String search, const String& replace, TextPosition from = {0, 0},
 						  const bool& caseSensitive = true, TextRange restrictRange = TextRange() );
 
+	/** Finds every occurrence of text in the document, or inside restrictRange when valid, in a
+	 * single pass. Lines are scanned in place and matches never span more than one line.
+	 * @param wholeWord Only returns the matches delimited by non-word characters.
+	 * @param type FindReplaceType::LuaPattern interprets text as a Lua pattern. */
+	std::vector<TextRange> findAll( const String& text, const bool& caseSensitive = true,
+									const bool& wholeWord = false,
+									const FindReplaceType& type = FindReplaceType::Normal,
+									TextRange restrictRange = TextRange() ) const;
+
+	/** Runs findAll on a worker thread over a snapshot of the document lines, so the document can
+	 * keep being edited while searching. onFinish is called from the worker thread with the
+	 * matches and the change id of the snapshot, compare it against getCurrentChangeId() to know
+	 * if the matches are still valid. */
+	void findAllAsync( const String& text, const FindAllCallback& onFinish,
+					   const bool& caseSensitive = true, const bool& wholeWord = false,
+					   const FindReplaceType& type = FindReplaceType::Normal,
+					   TextRange restrictRange = TextRange() );
+
+	/** Replaces every occurrence found by findAll in a single transaction: the lines containing
+	 * matches are rewritten at once, the change is undone in a single step and the clients are
+	 * notified once. Lua pattern replacements are literal, captures are not expanded.
+	 * @return The number of occurrences replaced. */
+	int replaceAll( const String& text, const String& replace, const bool& caseSensitive = true,
+					const bool& wholeWord = false,
+					const FindReplaceType& type = FindReplaceType::Normal,
+					TextRange restrictRange = TextRange() );
+
 	String getIndentString();
 
 	const Uint32& getIndentWidth() const;
@@ -363,6 +397,7 @@ class EE_API TextDocument {
 	std::map<std::string, DocumentCommand> mCommands;
 	String mNonWordChars;
 	Client* mActiveClient{nullptr};
+	std::unique_ptr<ThreadPool> mSearchPool;
 
 	void initializeCommands();
 
@@ -0,0 +1,122 @@
+#ifndef EE_UI_UICOMPILEDLAYOUT_HPP
+#define EE_UI_UICOMPILEDLAYOUT_HPP
+
+#include <eepp/core/noncopyable.hpp>
+#include <eepp/system/iostream.hpp>
+#include <eepp/ui/css/stylesheet.hpp>
+#include <eepp/ui/css/stylesheetproperty.hpp>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace pugi {
+class xml_document;
+class xml_node;
+} // namespace pugi
+
+using namespace EE::System;
+using namespace EE::UI::CSS;
+
+namespace EE { namespace UI {
+
+/** @brief A XML layout compiled into a compact representation that can be instantiated without
+**	parsing XML.
+**	The layout is stored as a flat pre-order list of nodes with interned tag names. Widget
+**	attributes are stored as property ids with their values, and are resolved (shorthands
+**	expanded) once when the layout is compiled or loaded. The `<style>` blocks are parsed once and
+**	kept as style sheets.
+**	Elements whose children are not widgets (list box items, menus, etc) are loaded by their own
+**	widgets from the XML, so they are kept as XML fragments and instantiated through the XML path.
+**	The compiled layout can be saved to a binary file and keeps the hash of the source it was
+**	compiled from, so stale compiled layouts can be detected.
+**	@see UISceneNode::loadLayoutFromCompiled
+*/
+class EE_API UICompiledLayout : NonCopyable {
+  public:
+	enum NodeType : Uint32 { Widget, Style, Xml };
+
+	struct Node {
+		NodeType type;
+		Uint32 id; ///< Tag index for widgets, string index for styles and XML fragments.
+		Uint32 childCount;
+		Uint32 attributeStart;
+		Uint32 attributeCount;
+	};
+
+	struct Attribute {
+		Uint32 propertyId;
+		Uint32 value; ///< String index.
+	};
+
+	/** @return The hash used to identify the layout sources. */
+	static Uint64 hash( const void* data, const size_t& size );
+
+	UICompiledLayout();
+
+	~UICompiledLayout();
+
+	/** @brief Compiles the node and its siblings. */
+	bool compile( const pugi::xml_node& node, const Uint64& sourceHash = 0 );
+
+	/** @brief Parses and compiles a XML layout. */
+	bool compileFromMemory( const void* buffer, const size_t& bufferSize );
+
+	bool compileFromString( const std::string& layoutString );
+
+	/** @brief Loads a compiled layout saved with save. */
+	bool loadFromStream( IOStream& stream );
+
+	bool loadFromFile( const std::string& path );
+
+	bool loadFromMemory( const void* buffer, const size_t& bufferSize );
+
+	bool save( IOStream& stream ) const;
+
+	bool saveToFile( const std::string& path ) const;
+
+	void clear();
+
+	bool isEmpty() const;
+
+	/** @return The hash of the source the layout was compiled from. */
+	const Uint64& getSourceHash() const;
+
+	const std::vector<Node>& getNodes() const;
+
+	const std::vector<std::string>& getTags() const;
+
+	/** @return The resolved properties of the widget node at the index. */
+	const std::vector<StyleSheetProperty>& getProperties( const size_t& nodeIndex ) const;
+
+	/** @return The parsed style sheet of the style node at the index. */
+	const CSS::StyleSheet& getStyleSheet( const size_t& nodeIndex ) const;
+
+	/** @return The first node of the XML fragment node at the index. */
+	pugi::xml_node getXmlNode( const size_t& nodeIndex ) const;
+
+	/** @return The index of the node following the subtree of the node at the index. */
+	size_t skipNode( size_t nodeIndex ) const;
+
+  protected:
+	Uint64 mSourceHash;
+	std::vector<std::string> mStrings;
+	std::vector<std::string> mTags;
+	std::vector<Node> mNodes;
+	std::vector<Attribute> mAttributes;
+	std::map<size_t, std::vector<StyleSheetProperty>> mProperties;
+	std::map<size_t, CSS::StyleSheet> mStyleSheets;
+	std::map<size_t, std::unique_ptr<pugi::xml_document>> mXmlDocuments;
+	std::map<std::string, Uint32> mStringIndex;
+
+	Uint32 compileNodes( const pugi::xml_node& node );
+
+	Uint32 addString( const std::string& str );
+
+	Uint32 addTag( const std::string& tag );
+
+	void resolve();
+};
+
+}} // namespace EE::UI
+
+#endif
@@ -5,10 +5,14 @@
 #include <eepp/system/translator.hpp>
 #include <eepp/ui/css/stylesheet.hpp>
 #include <eepp/ui/keyboardshortcut.hpp>
+#include <functional>
 #include <list>
+#include <memory>
+#include <unordered_map>
 
 namespace EE { namespace Graphics {
 class Font;
+class FrameBufferPool;
 }} // namespace EE::Graphics
 
 namespace EE { namespace UI {
@@ -21,9 +25,21 @@ class UIWindow;
 class UIWidget;
 class UILayout;
 class UIIcon;
+class UICompiledLayout;
+
+namespace Private {
+class UIDirtyQueue;
+}
 
 class EE_API UISceneNode : public SceneNode {
   public:
+	/** @brief Counters of an invalidation queue ( styles, style states or layouts ) */
+	struct InvalidationStats {
+		Uint64 requested; ///< Invalidations requested
+		Uint64 queued;	  ///< Requests that queued the node, the rest were already covered
+		Uint64 processed; ///< Nodes updated, the ones covered by an ancestor queued later are not
+	};
+
 	static UISceneNode* New( EE::Window::Window* window = NULL );
 
 	explicit UISceneNode( EE::Window::Window* window = NULL );
@@ -63,6 +79,30 @@ class EE_API UISceneNode : public SceneNode {
 
 	UIWidget* loadLayoutNodes( pugi::xml_node node, Node* parent );
 
+	/** @brief Instantiates a compiled layout. Avoids parsing the XML and the inline properties.
+	 * @see UICompiledLayout */
+	UIWidget* loadLayoutFromCompiled( const UICompiledLayout& layout, Node* parent = NULL );
+
+	/** @brief Enables the compiled layouts cache (disabled by default).
+	 * When enabled, the layouts loaded from files, strings, memory, streams and packs are compiled
+	 * the first time and the following loads of the same source (identified by its hash) are
+	 * instantiated from the compiled layout. */
+	void setLayoutCacheEnabled( bool enabled );
+
+	bool isLayoutCacheEnabled() const;
+
+	/** @brief Sets a directory where the compiled layouts are saved, so they can be reused
+	 * between runs. An empty path (default) keeps the compiled layouts only in memory. */
+	void setLayoutCachePath( const std::string& path );
+
+	const std::string& getLayoutCachePath() const;
+
+	void clearLayoutCache();
+
+	/** @return The compiled layout of the XML layout source, compiling it if is not cached. */
+	std::shared_ptr<UICompiledLayout> getCompiledLayout( const void* buffer,
+														  const size_t& bufferSize );
+
 	void setStyleSheet( const CSS::StyleSheet& styleSheet );
 
 	void setStyleSheet( const std::string& inlineStyleSheet );
@@ -81,6 +121,10 @@ class EE_API UISceneNode : public SceneNode {
 
 	UIThemeManager* getUIThemeManager() const;
 
+	/** @return The pool of frame buffers used by the render cached widgets. Its memory limits can
+	 * be configured from here. */
+	FrameBufferPool* getFrameBufferPool();
+
 	UIWidget* getRoot() const;
 
 	bool getVerbose() const;
@@ -103,6 +147,14 @@ class EE_API UISceneNode : public SceneNode {
 
 	const bool& isUpdatingLayouts() const;
 
+	InvalidationStats getStyleInvalidationStats() const;
+
+	InvalidationStats getStyleStateInvalidationStats() const;
+
+	InvalidationStats getLayoutInvalidationStats() const;
+
+	void resetInvalidationStats();
+
 	UIIconThemeManager* getUIIconThemeManager() const;
 
 	UIIcon* findIcon( const std::string& iconName );
@@ -147,13 +199,16 @@ class EE_API UISceneNode : public SceneNode {
 	bool mUpdatingLayouts;
 	UIThemeManager* mUIThemeManager;
 	UIIconThemeManager* mUIIconThemeManager;
+	FrameBufferPool* mFrameBufferPool;
+	bool mLayoutCacheEnabled;
+	std::string mLayoutCachePath;
+	std::unordered_map<Uint64, std::shared_ptr<UICompiledLayout>> mLayoutCache;
 	std::vector<Font*> mFontFaces;
 	KeyBindings mKeyBindings;
 	std::map<std::string, KeyBindingCommand> mKeyBindingCommands;
-	std::unordered_set<UIWidget*> mDirtyStyle;
-	std::unordered_set<UIWidget*> mDirtyStyleState;
-	std::unordered_map<UIWidget*, bool> mDirtyStyleStateCSSAnimations;
-	std::unordered_set<UILayout*> mDirtyLayouts;
+	Private::UIDirtyQueue* mDirtyStyle;
+	Private::UIDirtyQueue* mDirtyStyleState;
+	Private::UIDirtyQueue* mDirtyLayouts;
 	std::vector<std::pair<Float, std::string>> mTimes;
 
 	virtual void resizeNode( EE::Window::Window* win );
@@ -190,6 +245,10 @@ class EE_API UISceneNode : public SceneNode {
 
 	std::vector<UIWidget*> loadNode( pugi::xml_node node, Node* parent );
 
+	size_t loadCompiledNode( const UICompiledLayout& layout, size_t index, Node* parent,
+							 const std::vector<std::function<UIWidget*()>>& creators,
+							 std::vector<UIWidget*>* rootWidgets );
+
 	virtual Uint32 onKeyDown( const KeyEvent& event );
 
 	void onWidgetDelete( Node* node );
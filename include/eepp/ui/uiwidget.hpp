@@ -10,6 +10,10 @@ namespace pugi {
 class xml_node;
 }
 
+namespace EE { namespace Graphics {
+class FrameBuffer;
+}} // namespace EE::Graphics
+
 namespace EE { namespace UI { namespace CSS {
 class PropertyDefinition;
 }}} // namespace EE::UI::CSS
@@ -105,6 +109,10 @@ class EE_API UIWidget : public UINode {
 
 	virtual void loadFromXmlNode( const pugi::xml_node& node );
 
+	/** @brief Applies the inline properties of a compiled layout node.
+	 * @see UICompiledLayout */
+	virtual void loadFromProperties( const std::vector<StyleSheetProperty>& properties );
+
 	void notifyLayoutAttrChange();
 
 	void notifyLayoutAttrChangeParent();
@@ -241,6 +249,22 @@ class EE_API UIWidget : public UINode {
 
 	UIWidget* getNextTabWidget() const;
 
+	/** @brief Enables the render cache of the widget ( layer promotion ).
+	**	The widget and its childs are rendered once into a frame buffer acquired from the scene node
+	**	frame buffer pool, and then drawn as a single quad until a node inside the widget
+	**	invalidates its draw. The cached content is clipped to the widget bounds. It can also be
+	**	enabled from CSS with the property "render-cache".
+	*/
+	void setRenderCache( bool enabled );
+
+	bool isRenderCached() const;
+
+	virtual bool isDrawInvalidator() const;
+
+	virtual void invalidate( Node* invalidator );
+
+	virtual void nodeDraw();
+
   protected:
 	friend class UIManager;
 	friend class UISceneNode;
@@ -250,6 +274,7 @@ class EE_API UIWidget : public UINode {
 	UITheme* mTheme;
 	UIStyle* mStyle;
 	UITooltip* mTooltip;
+	FrameBuffer* mRenderCache;
 	Rect mDistToBorder;
 	Rectf mLayoutMargin;
 	Rectf mLayoutMarginPx;
@@ -337,6 +362,12 @@ class EE_API UIWidget : public UINode {
 	void reloadFontFamily();
 
 	UIWidget* getNextWidget() const;
+
+	bool updateRenderCache();
+
+	void drawRenderCache();
+
+	void releaseRenderCache();
 };
 
 }} // namespace EE::UI
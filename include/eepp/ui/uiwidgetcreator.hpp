@@ -16,6 +16,10 @@ class EE_API UIWidgetCreator {
 
 	static UIWidget* createFromName( std::string widgetName );
 
+	/** @return The function that creates the widget with the name, or an empty function if there is
+	 * no widget with that name. Useful to resolve the name once and create many widgets. */
+	static RegisterWidgetCb getWidgetCreator( std::string widgetName );
+
 	static void addCustomWidgetCallback( std::string widgetName, const CustomWidgetCb& cb );
 
 	static void removeCustomWidgetCallback( std::string widgetName );
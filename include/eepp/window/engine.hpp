@@ -152,6 +152,9 @@ class EE_API Engine {
 	EE::Window::Window* createSDL2Window( const WindowSettings& Settings,
 										  const ContextSettings& Context );
 
+	EE::Window::Window* createNullWindow( const WindowSettings& Settings,
+										  const ContextSettings& Context );
+
 	EE::Window::Window* createDefaultWindow( const WindowSettings& Settings,
 											 const ContextSettings& Context );
 
@@ -28,6 +28,10 @@ class EE_API Input {
 	 */
 	virtual void waitEvent( const Time& timeout = Time::Zero ) = 0;
 
+	/** Wakes up the thread blocked in waitEvent, if any. Can be called from any thread. Does
+	 * nothing by default, the backends that block in waitEvent implement it. */
+	virtual void wakeUp() {}
+
 	/** @return If the mouse and keyboard are grabed. */
 	virtual bool grabInput() = 0;
 
@@ -29,7 +29,7 @@ enum WindowStyle {
 #endif
 };
 
-enum class WindowBackend : Uint32 { SDL2, Default };
+enum class WindowBackend : Uint32 { SDL2, Null, Default };
 
 #ifndef EE_SCREEN_KEYBOARD_ENABLED
 #if EE_PLATFORM == EE_PLATFORM_ANDROID || EE_PLATFORM == EE_PLATFORM_IOS
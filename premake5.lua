@@ -8,6 +8,7 @@ newoption { trigger = "with-mojoal", description = "Compile with mojoAL as OpenA
 newoption { trigger = "use-frameworks", description = "In macOS it will try to link the external libraries from its frameworks. For example, instead of linking against SDL2 it will link against SDL2.framework." }
 newoption { trigger = "windows-vc-build", description = "This is used to build the framework in Visual Studio downloading its external dependencies and making them available to the VS project without having to install them manually." }
 newoption { trigger = "with-emscripten-pthreads", description = "Enables emscripten build to use posix threads" }
+newoption { trigger = "with-profiler", description = "Enables the EE_PROFILE_SCOPE profiler zones" }
 newoption {
 	trigger = "with-backend",
 	description = "Select the backend to use for window and input handling.\n\t\t\tIf no backend is selected or if the selected is not installed the script will search for a backend present in the system, and will use it.",
@@ -179,7 +180,7 @@ function build_base_cpp_configuration( package_name )
 		end
 end
 
-function build_link_configuration( package_name, use_ee_icon )
+function build_link_configuration( package_name, use_ee_icon, static_eepp )
 	incdirs { "include" }
 	local extension = "";
 
@@ -190,7 +191,7 @@ function build_link_configuration( package_name, use_ee_icon )
 	end
 
 	if package_name ~= "eepp" and package_name ~= "eepp-static" then
-		if not _OPTIONS["with-static-eepp"] then
+		if not _OPTIONS["with-static-eepp"] and not static_eepp then
 			links { "eepp-shared" }
 		else
 			links { "eepp-static" }
@@ -309,6 +310,10 @@ function parse_args()
 	if _OPTIONS["with-gles1"] then
 		defines { "EE_GLES1", "SOIL_GLES1" }
 	end
+
+	if _OPTIONS["with-profiler"] then
+		defines { "EE_PROFILER" }
+	end
 end
 
 function add_static_links()
@@ -482,6 +487,7 @@ function build_eepp( build_name )
 			"src/eepp/graphics/*.cpp",
 			"src/eepp/graphics/renderer/*.cpp",
 			"src/eepp/window/*.cpp",
+			"src/eepp/window/backend/null/*.cpp",
 			"src/eepp/network/*.cpp",
 			"src/eepp/network/ssl/*.cpp",
 			"src/eepp/network/http/*.cpp",
@@ -870,6 +876,41 @@ workspace "eepp"
 		includedirs { "src/thirdparty" }
 		build_link_configuration( "eepp-ui-perf-test", true )
 
+	project "eepp-benchmarks"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/tests/benchmarks/*.cpp", "src/tests/unit_tests/unittest.cpp" }
+		build_link_configuration( "eepp-benchmarks", false )
+
+	project "eepp-unit-tests"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/tests/unit_tests/*.cpp", "src/tools/codeeditor/ignorematcher.cpp" }
+		includedirs { "src/thirdparty/mbedtls/include" }
+		-- The TLS tests run a local server built with the same backend as the library
+		if _OPTIONS["with-openssl"] then
+			if os.istarget("windows") then
+				links { get_backend_link_name( "libssl" ), get_backend_link_name( "libcrypto" ) }
+			else
+				links { get_backend_link_name( "ssl" ), get_backend_link_name( "crypto" ) }
+			end
+			defines { "EE_OPENSSL" }
+		else
+			links { "mbedtls-static" }
+			defines { "EE_MBEDTLS" }
+		end
+		build_link_configuration( "eepp-unit-tests", false )
+
+	project "eepp-mock-gl-tests"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/tests/mock_gl_tests/*.cpp", "src/tests/unit_tests/unittest.cpp" }
+		-- The GL entry points loaded by GLEW are replaced by mocks, through the renderer headers.
+		-- GLEW is built static and its entry points aren't exported by the shared library, so the
+		-- tests link the static one.
+		includedirs { "src", "src/thirdparty" }
+		build_link_configuration( "eepp-mock-gl-tests", false, true )
+
 if os.isfile("external_projects.lua") then
 	dofile("external_projects.lua")
 end
@@ -3,6 +3,7 @@
 #include <eepp/graphics/renderer/openglext.hpp>
 #include <eepp/graphics/renderer/renderer.hpp>
 #include <eepp/graphics/texture.hpp>
+#include <eepp/system/profiler.hpp>
 
 namespace EE { namespace Graphics {
 
@@ -117,6 +118,8 @@ void BatchRenderer::flush() {
 	if ( mNumVertex == 0 )
 		return;
 
+	EE_PROFILE_SCOPE( "BatchRenderer::flush" );
+
 	if ( GlobalBatchRenderer::instance() != this )
 		GlobalBatchRenderer::instance()->draw();
 
@@ -879,7 +882,8 @@ Float BatchRenderer::getLineWidth() {
 	float lw = 1;
 
 #if EE_PLATFORM != EE_PLATFORM_EMSCRIPTEN
-	glGetFloatv( GL_LINE_WIDTH, &lw );
+	if ( !GLi->isNullRenderer() )
+		glGetFloatv( GL_LINE_WIDTH, &lw );
 #endif
 
 	return lw;
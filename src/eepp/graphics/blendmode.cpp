@@ -99,6 +99,10 @@ bool operator!=( const BlendMode& left, const BlendMode& right ) {
 
 void BlendMode::setMode( const BlendMode& mode, bool force ) {
 	if ( sLastBlend != mode || force ) {
+		// Forcing means the GL state may not be the one known by the renderer.
+		if ( force )
+			GLi->invalidateStateCache();
+
 		GLi->enable( GL_BLEND );
 
 		if ( GLi->isExtension( EEGL_EXT_blend_func_separate ) ) {
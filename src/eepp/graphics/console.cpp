@@ -6,6 +6,7 @@
 #include <eepp/graphics/renderer/renderer.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/lock.hpp>
+#include <eepp/system/profiler.hpp>
 #include <eepp/window/cursormanager.hpp>
 #include <eepp/window/engine.hpp>
 #include <eepp/window/input.hpp>
@@ -44,6 +45,7 @@ Console::Console( EE::Window::Window* window ) :
 	mExpand( false ),
 	mFading( false ),
 	mShowFps( false ),
+	mShowProfiler( false ),
 	mCurSide( false ) {
 	mFontStyleConfig.FontColor = Color( 0xCFCFCFFF );
 
@@ -83,6 +85,7 @@ Console::Console( Font* font, const bool& MakeDefaultCommands, const bool& Attac
 	mExpand( false ),
 	mFading( false ),
 	mShowFps( false ),
+	mShowProfiler( false ),
 	mCurSide( false ) {
 	mFontStyleConfig.FontColor = Color( 0xCFCFCFFF );
 
@@ -320,6 +323,29 @@ void Console::draw( const Time& elapsedTime ) {
 		text.draw( mWindow->getWidth() - text.getTextWidth() - 15, 6 );
 		text.setFillColor( OldColor1 );
 	}
+
+	if ( mShowProfiler && NULL != mFontStyleConfig.Font ) {
+		if ( mProfilerText.getString().empty() ||
+			 mProfilerClock.getElapsedTime() > Milliseconds( 500 ) ) {
+			std::vector<Profiler::ZoneStats> zones( Profiler::instance()->getZoneStats() );
+			std::string str;
+
+			for ( size_t i = 0; i < zones.size() && i < 16; i++ ) {
+				str += String::format( "%s: %llu calls, %.2f ms avg, %.2f ms max\n",
+									   zones[i].name, (unsigned long long)zones[i].calls,
+									   zones[i].totalTime / 1000.0 / zones[i].calls,
+									   zones[i].maxTime / 1000.0 );
+			}
+
+			mProfilerText.setStyleConfig( mFontStyleConfig );
+			mProfilerText.setFillColor( Color::White );
+			mProfilerText.setString( str.empty() ? "No profiler zones recorded" : str );
+			mProfilerClock.restart();
+		}
+
+		mProfilerText.draw( mWindow->getWidth() - mProfilerText.getTextWidth() - 15,
+							6 + mFontSize * 1.5f );
+	}
 }
 
 void Console::setLineHeight( const Float& LineHeight ) {
@@ -813,6 +839,7 @@ void Console::createDefaultCommands() {
 	addCommand( "ls", cb::Make1( this, &Console::cmdDir ) );
 	addCommand( "showfps", cb::Make1( this, &Console::cmdShowFps ) );
 	addCommand( "gettexturememory", cb::Make1( this, &Console::cmdGetTextureMemory ) );
+	addCommand( "profiler", cb::Make1( this, &Console::cmdProfiler ) );
 	addCommand( "hide", cb::Make1( this, &Console::cmdHideConsole ) );
 }
 
@@ -1018,6 +1045,32 @@ void Console::cmdShowFps( const std::vector<String>& params ) {
 	privPushText( "Valid parameters are 0 ( hide ) or 1 ( show )." );
 }
 
+void Console::cmdProfiler( const std::vector<String>& params ) {
+	if ( params.size() >= 2 ) {
+		Profiler* profiler = Profiler::instance();
+
+		if ( params[1] == "0" || params[1] == "1" ) {
+			profiler->setEnabled( params[1] == "1" );
+			return;
+		} else if ( params[1] == "overlay" && params.size() >= 3 ) {
+			showProfiler( params[2] == "1" );
+			return;
+		} else if ( params[1] == "clear" ) {
+			profiler->clear();
+			return;
+		} else if ( params[1] == "save" && params.size() >= 3 ) {
+			if ( profiler->saveChromeTrace( params[2].toUtf8() ) )
+				privPushText( "Profiler trace saved to " + params[2] );
+			else
+				privPushText( "Couldn't save the profiler trace to " + params[2] );
+			return;
+		}
+	}
+
+	privPushText( "Valid parameters are 0 ( stop recording ), 1 ( start recording ), overlay 0|1, "
+				  "clear and save <path> ( Chrome trace JSON )." );
+}
+
 void Console::cmdHideConsole( const std::vector<String>& params ) {
 	fadeOut();
 }
@@ -1034,6 +1087,18 @@ void Console::showFps( const bool& Show ) {
 	mShowFps = Show;
 }
 
+const bool& Console::isShowingProfiler() const {
+	return mShowProfiler;
+}
+
+void Console::showProfiler( const bool& show ) {
+	mShowProfiler = show;
+	mProfilerText.setString( "" );
+
+	if ( show )
+		Profiler::instance()->setEnabled( true );
+}
+
 FontStyleConfig Console::getFontStyleConfig() const {
 	return mFontStyleConfig;
 }
@@ -1,5 +1,6 @@
 #include <eepp/graphics/framebuffermanager.hpp>
 #include <eepp/graphics/renderer/openglext.hpp>
+#include <eepp/graphics/renderer/renderer.hpp>
 
 namespace EE { namespace Graphics { namespace Private {
 
@@ -15,9 +16,10 @@ void FrameBufferManager::reload() {
 }
 
 FrameBuffer* FrameBufferManager::getCurrentlyBound() {
-	int curFB;
+	int curFB = 0;
 
-	glGetIntegerv( GL_FRAMEBUFFER_BINDING, &curFB );
+	if ( !GLi->isNullRenderer() )
+		glGetIntegerv( GL_FRAMEBUFFER_BINDING, &curFB );
 
 	if ( 0 != curFB ) {
 		for ( auto& fb : mResources ) {
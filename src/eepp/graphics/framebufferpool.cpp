@@ -0,0 +1,156 @@
+#include <eepp/graphics/framebuffer.hpp>
+#include <eepp/graphics/framebufferpool.hpp>
+
+namespace EE { namespace Graphics {
+
+FrameBufferPool* FrameBufferPool::New( const size_t& memoryLimit, const size_t& idleMemoryLimit ) {
+	return eeNew( FrameBufferPool, ( memoryLimit, idleMemoryLimit ) );
+}
+
+FrameBufferPool::FrameBufferPool( const size_t& memoryLimit, const size_t& idleMemoryLimit ) :
+	mMemoryLimit( memoryLimit ),
+	mIdleMemoryLimit( idleMemoryLimit ),
+	mMemoryUsage( 0 ),
+	mIdleMemoryUsage( 0 ),
+	mGranularity( 32 ) {}
+
+FrameBufferPool::~FrameBufferPool() {
+	clearIdle();
+
+	for ( auto& active : mActive )
+		eeDelete( active.first );
+
+	mActive.clear();
+	mMemoryUsage = 0;
+}
+
+FrameBuffer* FrameBufferPool::acquire( const Sizei& size ) {
+	if ( size.getWidth() <= 0 || size.getHeight() <= 0 )
+		return NULL;
+
+	// Reuse the smallest idle frame buffer that fits the requested size.
+	auto best = mIdle.end();
+
+	for ( auto it = mIdle.begin(); it != mIdle.end(); ++it ) {
+		FrameBuffer* frameBuffer = it->frameBuffer;
+
+		if ( frameBuffer->getWidth() >= size.getWidth() &&
+			 frameBuffer->getHeight() >= size.getHeight() &&
+			 ( best == mIdle.end() || it->memory < best->memory ) )
+			best = it;
+	}
+
+	if ( best != mIdle.end() ) {
+		FrameBuffer* frameBuffer = best->frameBuffer;
+		mIdleMemoryUsage -= best->memory;
+		mActive[frameBuffer] = best->memory;
+		mIdle.erase( best );
+		return frameBuffer;
+	}
+
+	Uint32 width = ( ( size.getWidth() + mGranularity - 1 ) / mGranularity ) * mGranularity;
+	Uint32 height = ( ( size.getHeight() + mGranularity - 1 ) / mGranularity ) * mGranularity;
+	size_t memory = (size_t)width * height * 4;
+
+	evictUntilFits( memory );
+
+	if ( mMemoryUsage + memory > mMemoryLimit )
+		return NULL;
+
+	FrameBuffer* frameBuffer = FrameBuffer::New( width, height, false, false, false );
+
+	if ( !frameBuffer->created() ) {
+		eeDelete( frameBuffer );
+		return NULL;
+	}
+
+	mMemoryUsage += memory;
+	mActive[frameBuffer] = memory;
+
+	return frameBuffer;
+}
+
+void FrameBufferPool::release( FrameBuffer* frameBuffer ) {
+	auto it = mActive.find( frameBuffer );
+
+	if ( it == mActive.end() )
+		return;
+
+	mIdle.push_back( {frameBuffer, it->second} );
+	mIdleMemoryUsage += it->second;
+	mActive.erase( it );
+
+	if ( mIdleMemoryUsage > mIdleMemoryLimit )
+		evictIdle( mIdleMemoryLimit );
+}
+
+void FrameBufferPool::clearIdle() {
+	evictIdle( 0 );
+}
+
+void FrameBufferPool::evictIdle( const size_t& idleMemoryLimit ) {
+	while ( !mIdle.empty() && mIdleMemoryUsage > idleMemoryLimit ) {
+		Entry entry( mIdle.front() );
+		mIdle.pop_front();
+		mIdleMemoryUsage -= entry.memory;
+		destroy( entry );
+	}
+}
+
+void FrameBufferPool::evictUntilFits( const size_t& memory ) {
+	while ( !mIdle.empty() && mMemoryUsage + memory > mMemoryLimit ) {
+		Entry entry( mIdle.front() );
+		mIdle.pop_front();
+		mIdleMemoryUsage -= entry.memory;
+		destroy( entry );
+	}
+}
+
+void FrameBufferPool::destroy( const Entry& entry ) {
+	mMemoryUsage -= entry.memory;
+	eeDelete( entry.frameBuffer );
+}
+
+const size_t& FrameBufferPool::getMemoryLimit() const {
+	return mMemoryLimit;
+}
+
+void FrameBufferPool::setMemoryLimit( const size_t& memoryLimit ) {
+	mMemoryLimit = memoryLimit;
+	evictUntilFits( 0 );
+}
+
+const size_t& FrameBufferPool::getIdleMemoryLimit() const {
+	return mIdleMemoryLimit;
+}
+
+void FrameBufferPool::setIdleMemoryLimit( const size_t& idleMemoryLimit ) {
+	mIdleMemoryLimit = idleMemoryLimit;
+	evictIdle( mIdleMemoryLimit );
+}
+
+const Uint32& FrameBufferPool::getSizeGranularity() const {
+	return mGranularity;
+}
+
+void FrameBufferPool::setSizeGranularity( const Uint32& granularity ) {
+	mGranularity = eemax<Uint32>( 1, granularity );
+}
+
+const size_t& FrameBufferPool::getMemoryUsage() const {
+	return mMemoryUsage;
+}
+
+const size_t& FrameBufferPool::getIdleMemoryUsage() const {
+	return mIdleMemoryUsage;
+}
+
+size_t FrameBufferPool::getActiveCount() const {
+	return mActive.size();
+}
+
+size_t FrameBufferPool::getIdleCount() const {
+	return mIdle.size();
+}
+
+}} // namespace EE::Graphics
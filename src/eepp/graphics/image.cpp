@@ -6,6 +6,7 @@
 #include <eepp/graphics/pixeldensity.hpp>
 #include <eepp/graphics/stbi_iocb.hpp>
 #include <eepp/system/filesystem.hpp>
+#include <eepp/system/iostreammapped.hpp>
 #include <eepp/system/log.hpp>
 #include <eepp/system/pack.hpp>
 #include <eepp/system/packmanager.hpp>
@@ -435,7 +436,16 @@ Image::Image( std::string Path, const unsigned int& forceChannels,
 	mFormatConfiguration( formatConfiguration ) {
 	int w, h, c;
 	Pack* tPack = NULL;
-	Uint8* data = stbi_load( Path.c_str(), &w, &h, &c, mChannels );
+	Uint8* data = NULL;
+
+	{
+		// Decode straight from the mapped file contents.
+		IOStreamMapped file( Path );
+
+		if ( NULL != file.getData() )
+			data = stbi_load_from_memory( reinterpret_cast<const stbi_uc*>( file.getData() ),
+										  (int)file.getSize(), &w, &h, &c, mChannels );
+	}
 
 	if ( NULL != data ) {
 		mPixels = data;
@@ -5,6 +5,7 @@
 #include <eepp/graphics/renderer/renderergl3.hpp>
 #include <eepp/graphics/renderer/renderergl3cp.hpp>
 #include <eepp/graphics/renderer/renderergles2.hpp>
+#include <eepp/graphics/renderer/renderernull.hpp>
 #include <eepp/system/sys.hpp>
 
 namespace EE { namespace Graphics {
@@ -68,6 +69,10 @@ Renderer* Renderer::createSingleton( GraphicsLibraryVersion ver ) {
 #endif
 
 	switch ( ver ) {
+		case GLv_null: {
+			sSingleton = eeNew( RendererNull, () );
+			break;
+		}
 		case GLv_ES2: {
 #if defined( EE_GL3_ENABLED ) || defined( EE_GLES2 )
 			sSingleton = eeNew( RendererGLES2, () );
@@ -137,8 +142,13 @@ Renderer::Renderer() :
 	mQuadVertexs( 4 ),
 	mLineWidth( 1 ),
 	mCurVAO( 0 ),
-	mClippingMask( eeNew( ClippingMask, () ) ) {
+	mClippingMask( eeNew( ClippingMask, () ) ),
+	mFrameLogEnabled( false ),
+	mNullRenderer( false ),
+	mLastNullTexture( 0 ) {
 	GLi = this;
+	mViewport[0] = mViewport[1] = mViewport[2] = mViewport[3] = 0;
+	invalidateStateCache();
 }
 
 Renderer::~Renderer() {
@@ -167,6 +177,8 @@ void Renderer::writeExtension( Uint8 Pos, Uint32 BitWrite ) {
 }
 
 void Renderer::init() {
+	invalidateStateCache();
+
 #ifdef EE_GLEW_AVAILABLE
 	glewExperimental = 1;
 
@@ -281,6 +293,9 @@ void Renderer::init() {
 }
 
 bool Renderer::isExtension( const std::string& name ) {
+	if ( mNullRenderer )
+		return false;
+
 #ifdef EE_GLEW_AVAILABLE
 	return 0 != glewIsSupported( name.c_str() );
 #else
@@ -313,6 +328,9 @@ bool Renderer::shadersSupported() {
 std::string Renderer::getExtensions() {
 	std::string exts;
 
+	if ( mNullRenderer )
+		return exts;
+
 #if defined( EE_X11_PLATFORM ) || EE_PLATFORM == EE_PLATFORM_WIN || \
 	EE_PLATFORM == EE_PLATFORM_MACOSX
 	if ( GLv_3 == version() || GLv_3CP == version() ) {
@@ -353,66 +371,136 @@ std::string Renderer::getExtensions() {
 }
 
 void Renderer::viewport( int x, int y, int width, int height ) {
-	glViewport( x, y, width, height );
+	recordCommand( RendererCommandType::Viewport, x, y, width, height );
+	mFrameStats.stateChanges++;
+	mViewport[0] = x;
+	mViewport[1] = y;
+	mViewport[2] = width;
+	mViewport[3] = height;
+
+	if ( !mNullRenderer )
+		glViewport( x, y, width, height );
 }
 
 void Renderer::disable( unsigned int cap ) {
-	glDisable( cap );
+	recordCommand( RendererCommandType::Disable, cap );
+	mFrameStats.stateChanges++;
+
+	if ( !mNullRenderer )
+		glDisable( cap );
 }
 
 void Renderer::enable( unsigned int cap ) {
-	glEnable( cap );
+	recordCommand( RendererCommandType::Enable, cap );
+	mFrameStats.stateChanges++;
+
+	if ( !mNullRenderer )
+		glEnable( cap );
 }
 
 const char* Renderer::getString( unsigned int name ) {
+	if ( mNullRenderer )
+		return NULL;
+
 	return (const char*)glGetString( name );
 }
 
 void Renderer::clear( unsigned int mask ) {
-	glClear( mask );
+	recordCommand( RendererCommandType::Clear, mask );
+	mFrameStats.clears++;
+
+	if ( !mNullRenderer )
+		glClear( mask );
 }
 
 void Renderer::clearColor( float red, float green, float blue, float alpha ) {
-	glClearColor( red, green, blue, alpha );
+	if ( !mNullRenderer )
+		glClearColor( red, green, blue, alpha );
 }
 
 void Renderer::scissor( int x, int y, int width, int height ) {
-	glScissor( x, y, width, height );
+	recordCommand( RendererCommandType::Scissor, x, y, width, height );
+	mFrameStats.stateChanges++;
+
+	if ( !mNullRenderer )
+		glScissor( x, y, width, height );
 }
 
 void Renderer::polygonMode( unsigned int face, unsigned int mode ) {
 #ifndef EE_GLES
-	glPolygonMode( face, mode );
+	if ( !mNullRenderer )
+		glPolygonMode( face, mode );
 #endif
 }
 
 void Renderer::drawArrays( unsigned int mode, int first, int count ) {
-	glDrawArrays( mode, first, count );
+	recordCommand( RendererCommandType::DrawArrays, mode, first, count );
+	mFrameStats.drawCalls++;
+	mFrameStats.vertices += count;
+
+	if ( !mNullRenderer )
+		glDrawArrays( mode, first, count );
 }
 
 void Renderer::drawElements( unsigned int mode, int count, unsigned int type,
 							 const void* indices ) {
-	glDrawElements( mode, count, type, indices );
+	recordCommand( RendererCommandType::DrawElements, mode, count, type );
+	mFrameStats.drawCalls++;
+	mFrameStats.vertices += count;
+
+	if ( !mNullRenderer )
+		glDrawElements( mode, count, type, indices );
 }
 
 void Renderer::bindTexture( unsigned int target, unsigned int texture ) {
 	if ( GLv_3CP == version() && 0 == texture )
 		return;
-	glBindTexture( target, texture );
+	recordCommand( RendererCommandType::BindTexture, target, texture );
+	mFrameStats.textureBinds++;
+
+	if ( !mNullRenderer )
+		glBindTexture( target, texture );
 }
 
 void Renderer::activeTexture( unsigned int texture ) {
-	glActiveTexture( texture );
+	if ( !mNullRenderer )
+		glActiveTexture( texture );
 }
 
 void Renderer::blendFunc( unsigned int sfactor, unsigned int dfactor ) {
-	glBlendFunc( sfactor, dfactor );
+	if ( mCurBlendFunc[0] == sfactor && mCurBlendFunc[1] == dfactor &&
+		 mCurBlendFunc[2] == sfactor && mCurBlendFunc[3] == dfactor ) {
+		mFrameStats.filteredStateChanges++;
+		return;
+	}
+
+	mCurBlendFunc[0] = mCurBlendFunc[2] = sfactor;
+	mCurBlendFunc[1] = mCurBlendFunc[3] = dfactor;
+	recordCommand( RendererCommandType::BlendFunc, sfactor, dfactor, sfactor, dfactor );
+	mFrameStats.blendChanges++;
+
+	if ( !mNullRenderer )
+		glBlendFunc( sfactor, dfactor );
 }
 
 void Renderer::blendFuncSeparate( unsigned int sfactorRGB, unsigned int dfactorRGB,
 								  unsigned int sfactorAlpha, unsigned int dfactorAlpha ) {
 	static pglBlendFuncSeparate eeglBlendFuncSeparate = NULL;
 
+	if ( mCurBlendFunc[0] == sfactorRGB && mCurBlendFunc[1] == dfactorRGB &&
+		 mCurBlendFunc[2] == sfactorAlpha && mCurBlendFunc[3] == dfactorAlpha ) {
+		mFrameStats.filteredStateChanges++;
+		return;
+	}
+
+	mCurBlendFunc[0] = sfactorRGB;
+	mCurBlendFunc[1] = dfactorRGB;
+	mCurBlendFunc[2] = sfactorAlpha;
+	mCurBlendFunc[3] = dfactorAlpha;
+	recordCommand( RendererCommandType::BlendFunc, sfactorRGB, dfactorRGB, sfactorAlpha,
+				   dfactorAlpha );
+	mFrameStats.blendChanges++;
+
 	if ( NULL == eeglBlendFuncSeparate )
 		eeglBlendFuncSeparate = (pglBlendFuncSeparate)getProcAddress( "glBlendFuncSeparate" );
 
@@ -423,6 +511,15 @@ void Renderer::blendFuncSeparate( unsigned int sfactorRGB, unsigned int dfactorR
 void Renderer::blendEquationSeparate( unsigned int modeRGB, unsigned int modeAlpha ) {
 	static pglBlendEquationSeparate eeglBlendEquationSeparate = NULL;
 
+	if ( mCurBlendEquation[0] == modeRGB && mCurBlendEquation[1] == modeAlpha ) {
+		mFrameStats.filteredStateChanges++;
+		return;
+	}
+
+	mCurBlendEquation[0] = modeRGB;
+	mCurBlendEquation[1] = modeAlpha;
+	mFrameStats.blendChanges++;
+
 	if ( NULL == eeglBlendEquationSeparate )
 		eeglBlendEquationSeparate =
 			(pglBlendEquationSeparate)getProcAddress( "glBlendEquationSeparate" );
@@ -444,12 +541,22 @@ void Renderer::blitFrameBuffer( int srcX0, int srcY0, int srcX1, int srcY1, int
 }
 
 void Renderer::setShader( ShaderProgram* Shader ) {
-#ifdef EE_SHADERS_SUPPORTED
-	if ( NULL != Shader ) {
-		glUseProgram( Shader->getHandler() );
-	} else {
-		glUseProgram( 0 );
+	useProgram( NULL != Shader ? Shader->getHandler() : 0 );
+}
+
+void Renderer::useProgram( unsigned int program ) {
+	if ( mCurProgram == program ) {
+		mFrameStats.filteredStateChanges++;
+		return;
 	}
+
+	mCurProgram = program;
+	recordCommand( RendererCommandType::SetShader, program );
+	mFrameStats.shaderChanges++;
+
+#ifdef EE_SHADERS_SUPPORTED
+	if ( !mNullRenderer )
+		glUseProgram( program );
 #endif
 }
 
@@ -479,7 +586,8 @@ void Renderer::lineWidth( float width ) {
 		if ( GLv_3CP != version() )
 #endif
 		{
-			glLineWidth( width );
+			if ( !mNullRenderer )
+				glLineWidth( width );
 		}
 		mLineWidth = width;
 	}
@@ -495,7 +603,8 @@ void Renderer::polygonMode() {
 }
 
 void Renderer::pixelStorei( unsigned int pname, int param ) {
-	glPixelStorei( pname, param );
+	if ( !mNullRenderer )
+		glPixelStorei( pname, param );
 }
 
 void Renderer::polygonMode( const PrimitiveFillMode& Mode ) {
@@ -548,6 +657,11 @@ std::string Renderer::getShadingLanguageVersion() {
 }
 
 void Renderer::getViewport( int* viewport ) {
+	if ( mNullRenderer ) {
+		memcpy( viewport, mViewport, sizeof( mViewport ) );
+		return;
+	}
+
 	glGetIntegerv( GL_VIEWPORT, viewport );
 }
 
@@ -594,19 +708,23 @@ Vector3f Renderer::unProjectCurrent( const Vector3f& point ) {
 }
 
 void Renderer::stencilFunc( unsigned int func, int ref, unsigned int mask ) {
-	glStencilFunc( func, ref, mask );
+	if ( !mNullRenderer )
+		glStencilFunc( func, ref, mask );
 }
 
 void Renderer::stencilOp( unsigned int fail, unsigned int zfail, unsigned int zpass ) {
-	glStencilOp( fail, zfail, zpass );
+	if ( !mNullRenderer )
+		glStencilOp( fail, zfail, zpass );
 }
 
 void Renderer::stencilMask( unsigned int mask ) {
-	glStencilMask( mask );
+	if ( !mNullRenderer )
+		glStencilMask( mask );
 }
 
 void Renderer::colorMask( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha ) {
-	glColorMask( red, green, blue, alpha );
+	if ( !mNullRenderer )
+		glColorMask( red, green, blue, alpha );
 }
 
 const int& Renderer::quadVertexs() const {
@@ -620,6 +738,9 @@ ClippingMask* Renderer::getClippingMask() const {
 void* Renderer::getProcAddress( std::string proc ) {
 	void* addr = NULL;
 
+	if ( mNullRenderer )
+		return addr;
+
 #ifdef EE_GLES
 	if ( version() == GLv_ES1 )
 		addr = SOIL_GL_GetProcAddress( ( proc + "OES" ).c_str() );
@@ -635,6 +756,11 @@ void* Renderer::getProcAddress( std::string proc ) {
 }
 
 void Renderer::readPixels( int x, int y, unsigned int width, unsigned int height, void* pixels ) {
+	if ( mNullRenderer ) {
+		memset( pixels, 0, width * height * 4 );
+		return;
+	}
+
 	glReadPixels( x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels );
 }
 
@@ -767,7 +893,8 @@ void Renderer::deleteFramebuffers( int n, const unsigned int* framebuffers ) {
 void Renderer::bindVertexArray( unsigned int array ) {
 #if !defined( EE_GLES )
 	if ( mCurVAO != array ) {
-		glBindVertexArray( array );
+		if ( !mNullRenderer )
+			glBindVertexArray( array );
 
 		mCurVAO = array;
 	}
@@ -776,13 +903,15 @@ void Renderer::bindVertexArray( unsigned int array ) {
 
 void Renderer::deleteVertexArrays( int n, const unsigned int* arrays ) {
 #if !defined( EE_GLES )
-	glDeleteVertexArrays( n, arrays );
+	if ( !mNullRenderer )
+		glDeleteVertexArrays( n, arrays );
 #endif
 }
 
 void Renderer::genVertexArrays( int n, unsigned int* arrays ) {
 #if !defined( EE_GLES )
-	glGenVertexArrays( n, arrays );
+	if ( !mNullRenderer )
+		glGenVertexArrays( n, arrays );
 #endif
 }
 
@@ -790,4 +919,76 @@ const bool& Renderer::quadsSupported() const {
 	return mQuadsSupported;
 }
 
+const RendererFrameStats& Renderer::getFrameStats() const {
+	return mFrameStats;
+}
+
+const RendererFrameStats& Renderer::getLastFrameStats() const {
+	return mLastFrameStats;
+}
+
+void Renderer::endFrame() {
+	mLastFrameStats = mFrameStats;
+	mFrameStats = RendererFrameStats();
+
+	if ( mFrameLogEnabled ) {
+		mLastFrameLog.swap( mFrameLog );
+		mFrameLog.clear();
+	}
+}
+
+const bool& Renderer::isFrameLogEnabled() const {
+	return mFrameLogEnabled;
+}
+
+void Renderer::setFrameLogEnabled( const bool& enabled ) {
+	mFrameLogEnabled = enabled;
+
+	if ( !enabled ) {
+		mFrameLog.clear();
+		mLastFrameLog.clear();
+	}
+}
+
+const std::vector<RendererCommand>& Renderer::getLastFrameLog() const {
+	return mLastFrameLog;
+}
+
+const bool& Renderer::isNullRenderer() const {
+	return mNullRenderer;
+}
+
+unsigned int Renderer::createTexture( const Uint8* pixels, int* width, int* height, int channels,
+									  unsigned int reuseTexture, unsigned int flags ) {
+	if ( mNullRenderer )
+		return 0 != reuseTexture ? reuseTexture : ++mLastNullTexture;
+
+	return SOIL_create_OGL_texture( pixels, width, height, channels, reuseTexture, flags );
+}
+
+void Renderer::deleteTextures( int n, const unsigned int* textures ) {
+	if ( !mNullRenderer )
+		glDeleteTextures( n, textures );
+}
+
+void Renderer::invalidateStateCache() {
+	mCurProgram = InvalidState;
+
+	for ( Uint32 i = 0; i < 4; i++ )
+		mCurBlendFunc[i] = InvalidState;
+
+	mCurBlendEquation[0] = mCurBlendEquation[1] = InvalidState;
+}
+
+void Renderer::recordCommand( const RendererCommandType& type, Int32 param0, Int32 param1,
+							  Int32 param2, Int32 param3 ) {
+	if ( mFrameLogEnabled )
+		mFrameLog.push_back( {type, {param0, param1, param2, param3}} );
+}
+
+void Renderer::recordUpload( const Uint32& bytes ) {
+	recordCommand( RendererCommandType::UploadVertexData, bytes );
+	mFrameStats.bytesUploaded += bytes;
+}
+
 }} // namespace EE::Graphics
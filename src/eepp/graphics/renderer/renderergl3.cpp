@@ -166,7 +166,7 @@ void RendererGL3::setShader( ShaderProgram* Shader ) {
 		mTextureUnits[i] = mCurShader->getAttributeLocation( EEGL3_TEXTUREUNIT_NAMES[i] );
 	}
 
-	glUseProgram( mCurShader->getHandler() );
+	useProgram( mCurShader->getHandler() );
 
 	if ( -1 != mAttribsLoc[EEGL_VERTEX_ARRAY] )
 		enableClientState( GL_VERTEX_ARRAY );
@@ -422,10 +422,12 @@ void RendererGL3::clip2DPlaneEnable( const Int32& x, const Int32& y, const Int32
 	GLi->enable( GL_CLIP_PLANE2 );
 	GLi->enable( GL_CLIP_PLANE3 );
 
-	glUniform4fv( mPlanes[0], 1, static_cast<const float*>( &vclip_left[0] ) );
-	glUniform4fv( mPlanes[1], 1, static_cast<const float*>( &vclip_right[0] ) );
-	glUniform4fv( mPlanes[2], 1, static_cast<const float*>( &vclip_top[0] ) );
-	glUniform4fv( mPlanes[3], 1, static_cast<const float*>( &vclip_bottom[0] ) );
+	mCurShader->setUniform( mPlanes[0], vclip_left.x, vclip_left.y, vclip_left.z, vclip_left.w );
+	mCurShader->setUniform( mPlanes[1], vclip_right.x, vclip_right.y, vclip_right.z,
+							vclip_right.w );
+	mCurShader->setUniform( mPlanes[2], vclip_top.x, vclip_top.y, vclip_top.z, vclip_top.w );
+	mCurShader->setUniform( mPlanes[3], vclip_bottom.x, vclip_bottom.y, vclip_bottom.z,
+							vclip_bottom.w );
 }
 
 void RendererGL3::clip2DPlaneDisable() {
@@ -450,7 +452,7 @@ void RendererGL3::clipPlane( unsigned int plane, const double* equation ) {
 	} else {
 		std::string planeNum( "dgl_ClipPlane[" + String::toString( nplane ) + "]" );
 
-		location = glGetUniformLocation( mCurShader->getHandler(), (GLchar*)&planeNum[0] );
+		location = mCurShader->getUniformLocation( planeNum );
 	}
 
 	glm::vec4 teq( equation[0], equation[1], equation[2], equation[3] );
@@ -459,7 +461,8 @@ void RendererGL3::clipPlane( unsigned int plane, const double* equation ) {
 		  glm::inverse( mStack->mModelViewMatrix
 							.top() ); /// Apply the inverse of the model view matrix to the equation
 
-	glUniform4f( location, (float)teq[0], (float)teq[1], (float)teq[2], (float)teq[3] );
+	mCurShader->setUniform( location, (float)teq[0], (float)teq[1], (float)teq[2],
+							(float)teq[3] );
 }
 
 float RendererGL3::pointSize() {
@@ -0,0 +1,74 @@
+#include <eepp/graphics/renderer/openglext.hpp>
+#include <eepp/graphics/renderer/renderernull.hpp>
+
+namespace EE { namespace Graphics {
+
+RendererNull::RendererNull() : RendererGLShader(), mPointSize( 1.f ) {
+	mNullRenderer = true;
+	// There's no shader to upload the matrices to
+	mProjectionMatrix_id = -1;
+	mModelViewMatrix_id = -1;
+	mTextureMatrix_id = -1;
+	matrixMode( GL_MODELVIEW );
+}
+
+RendererNull::~RendererNull() {}
+
+GraphicsLibraryVersion RendererNull::version() {
+	return GLv_null;
+}
+
+std::string RendererNull::versionStr() {
+	return "Null";
+}
+
+void RendererNull::init() {
+	// No extension is reported, so the engine falls back to the simplest code paths ( no shaders,
+	// no vertex buffer objects and no frame buffer objects ).
+	mExtensions = 0;
+	invalidateStateCache();
+}
+
+void RendererNull::pointSize( float size ) {
+	mPointSize = size;
+}
+
+float RendererNull::pointSize() {
+	return mPointSize;
+}
+
+void RendererNull::clientActiveTexture( unsigned int ) {}
+
+void RendererNull::enableClientState( unsigned int ) {}
+
+void RendererNull::disableClientState( unsigned int ) {}
+
+void RendererNull::vertexPointer( int, unsigned int, int, const void*, unsigned int allocate ) {
+	recordUpload( allocate );
+}
+
+void RendererNull::colorPointer( int, unsigned int, int, const void*, unsigned int allocate ) {
+	recordUpload( allocate );
+}
+
+void RendererNull::texCoordPointer( int, unsigned int, int, const void*, unsigned int allocate ) {
+	recordUpload( allocate );
+}
+
+void RendererNull::clip2DPlaneEnable( const Int32&, const Int32&, const Int32&, const Int32& ) {
+	enable( GL_CLIP_PLANE0 );
+	enable( GL_CLIP_PLANE1 );
+	enable( GL_CLIP_PLANE2 );
+	enable( GL_CLIP_PLANE3 );
+}
+
+void RendererNull::clip2DPlaneDisable() {
+	disable( GL_CLIP_PLANE0 );
+	disable( GL_CLIP_PLANE1 );
+	disable( GL_CLIP_PLANE2 );
+	disable( GL_CLIP_PLANE3 );
+}
+
+void RendererNull::clipPlane( unsigned int, const double* ) {}
+
+}} // namespace EE::Graphics
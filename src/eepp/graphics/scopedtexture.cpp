@@ -6,7 +6,8 @@ namespace EE { namespace Graphics { namespace Private {
 
 ScopedTexture::ScopedTexture( int textureBind ) :
 	mTextureBinded( 0 ), mTextureToBind( textureBind ) {
-	glGetIntegerv( GL_TEXTURE_BINDING_2D, &mTextureBinded );
+	if ( !GLi->isNullRenderer() )
+		glGetIntegerv( GL_TEXTURE_BINDING_2D, &mTextureBinded );
 
 	if ( mTextureToBind > 0 && mTextureBinded != mTextureToBind )
 		GLi->bindTexture( GL_TEXTURE_2D, mTextureToBind );
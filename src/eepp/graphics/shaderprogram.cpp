@@ -1,3 +1,4 @@
+#include <cstring>
 #include <eepp/graphics/globalbatchrenderer.hpp>
 #include <eepp/graphics/renderer/openglext.hpp>
 #include <eepp/graphics/renderer/renderer.hpp>
@@ -7,6 +8,9 @@
 
 namespace EE { namespace Graphics {
 
+// Uniforms with higher locations are always uploaded.
+static const Int32 MaxCachedLocation = 1024;
+
 ShaderProgram* ShaderProgram::New( const std::string& name ) {
 	return eeNew( ShaderProgram, ( name ) );
 }
@@ -150,6 +154,10 @@ ShaderProgram::~ShaderProgram() {
 #ifdef EE_SHADERS_SUPPORTED
 		glDeleteProgram( getHandler() );
 #endif
+
+		// The handle can be reused by the next program created.
+		if ( NULL != GLi && GLi->mCurProgram == getHandler() )
+			GLi->mCurProgram = Renderer::InvalidState;
 	}
 
 	mUniformLocations.clear();
@@ -181,6 +189,7 @@ void ShaderProgram::init() {
 		mValid = false;
 		mUniformLocations.clear();
 		mAttributeLocations.clear();
+		mUniformValues.clear();
 	} else {
 		Log::error( "ShaderProgram::init() %s: Couldn't create program.", mName.c_str() );
 	}
@@ -259,11 +268,50 @@ bool ShaderProgram::link() {
 
 		mUniformLocations.clear();
 		mAttributeLocations.clear();
+		mUniformValues.clear();
+
+		readUniformLocations();
 	}
 
 	return mValid;
 }
 
+void ShaderProgram::readUniformLocations() {
+#ifdef EE_SHADERS_SUPPORTED
+	Int32 count = 0, maxLength = 0;
+	glGetProgramiv( getHandler(), GL_ACTIVE_UNIFORMS, &count );
+	glGetProgramiv( getHandler(), GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength );
+
+	if ( count <= 0 || maxLength <= 0 )
+		return;
+
+	std::vector<GLchar> buffer( maxLength + 1 );
+
+	for ( Int32 i = 0; i < count; i++ ) {
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+
+		glGetActiveUniform( getHandler(), i, maxLength + 1, &length, &size, &type, &buffer[0] );
+
+		if ( length <= 0 )
+			continue;
+
+		std::string name( &buffer[0], length );
+		Int32 location = glGetUniformLocation( getHandler(), name.c_str() );
+
+		if ( -1 == location )
+			continue;
+
+		mUniformLocations[name] = location;
+
+		// Arrays are reported as "name[0]", but they are usually requested by their name.
+		if ( name.size() > 3 && name.compare( name.size() - 3, 3, "[0]" ) == 0 )
+			mUniformLocations[name.substr( 0, name.size() - 3 )] = location;
+	}
+#endif
+}
+
 void ShaderProgram::bind() const {
 	GlobalBatchRenderer::instance()->draw();
 
@@ -280,21 +328,24 @@ Int32 ShaderProgram::getUniformLocation( const std::string& Name ) {
 	if ( !mValid )
 		return -1;
 
-	std::map<std::string, Int32>::iterator it = mUniformLocations.find( Name );
-	if ( it == mUniformLocations.end() ) {
+	auto it = mUniformLocations.find( Name );
+
+	if ( it != mUniformLocations.end() )
+		return it->second;
+
+	Int32 Location = -1;
 #ifdef EE_SHADERS_SUPPORTED
-		Int32 Location = glGetUniformLocation( getHandler(), Name.c_str() );
-		mUniformLocations[Name] = Location;
+	Location = glGetUniformLocation( getHandler(), Name.c_str() );
 #endif
-	}
-	return mUniformLocations[Name];
+	mUniformLocations[Name] = Location;
+	return Location;
 }
 
 Int32 ShaderProgram::getAttributeLocation( const std::string& Name ) {
 	if ( !mValid )
 		return -1;
 
-	std::map<std::string, Int32>::iterator it = mAttributeLocations.find( Name );
+	auto it = mAttributeLocations.find( Name );
 	if ( it == mAttributeLocations.end() ) {
 #ifdef EE_SHADERS_SUPPORTED
 		Int32 Location = glGetAttribLocation( getHandler(), Name.c_str() );
@@ -307,6 +358,34 @@ Int32 ShaderProgram::getAttributeLocation( const std::string& Name ) {
 void ShaderProgram::invalidateLocations() {
 	mUniformLocations.clear();
 	mAttributeLocations.clear();
+	mUniformValues.clear();
+}
+
+void ShaderProgram::invalidateUniforms() {
+	mUniformValues.clear();
+}
+
+bool ShaderProgram::updateUniform( const Int32& location, const void* value,
+								   const Uint32& size ) {
+	if ( location < 0 || location >= MaxCachedLocation || size > sizeof( UniformValue::data ) ) {
+		GLi->mFrameStats.uniformUploads++;
+		return true;
+	}
+
+	if ( location >= (Int32)mUniformValues.size() )
+		mUniformValues.resize( location + 1, UniformValue{0, {}} );
+
+	UniformValue& uniform = mUniformValues[location];
+
+	if ( uniform.size == size && memcmp( uniform.data, value, size ) == 0 ) {
+		GLi->mFrameStats.filteredUniforms++;
+		return false;
+	}
+
+	uniform.size = size;
+	memcpy( uniform.data, value, size );
+	GLi->mFrameStats.uniformUploads++;
+	return true;
 }
 
 bool ShaderProgram::setUniform( const std::string& Name, float Value ) {
@@ -332,7 +411,8 @@ bool ShaderProgram::setUniform( const std::string& Name, Int32 Value ) {
 bool ShaderProgram::setUniform( const Int32& Location, Int32 Value ) {
 	if ( -1 != Location ) {
 #ifdef EE_SHADERS_SUPPORTED
-		glUniform1i( Location, Value );
+		if ( updateUniform( Location, &Value, sizeof( Value ) ) )
+			glUniform1i( Location, Value );
 #endif
 
 		return true;
@@ -344,7 +424,8 @@ bool ShaderProgram::setUniform( const Int32& Location, Int32 Value ) {
 bool ShaderProgram::setUniform( const Int32& Location, float Value ) {
 	if ( -1 != Location ) {
 #ifdef EE_SHADERS_SUPPORTED
-		glUniform1f( Location, Value );
+		if ( updateUniform( Location, &Value, sizeof( Value ) ) )
+			glUniform1f( Location, Value );
 #endif
 
 		return true;
@@ -356,7 +437,8 @@ bool ShaderProgram::setUniform( const Int32& Location, float Value ) {
 bool ShaderProgram::setUniform( const Int32& Location, Vector2ff Value ) {
 	if ( -1 != Location ) {
 #ifdef EE_SHADERS_SUPPORTED
-		glUniform2fv( Location, 1, reinterpret_cast<float*>( &Value ) );
+		if ( updateUniform( Location, &Value, sizeof( Value ) ) )
+			glUniform2fv( Location, 1, reinterpret_cast<float*>( &Value ) );
 #endif
 
 		return true;
@@ -368,7 +450,8 @@ bool ShaderProgram::setUniform( const Int32& Location, Vector2ff Value ) {
 bool ShaderProgram::setUniform( const Int32& Location, Vector3ff Value ) {
 	if ( -1 != Location ) {
 #ifdef EE_SHADERS_SUPPORTED
-		glUniform3fv( Location, 1, reinterpret_cast<float*>( &Value ) );
+		if ( updateUniform( Location, &Value, sizeof( Value ) ) )
+			glUniform3fv( Location, 1, reinterpret_cast<float*>( &Value ) );
 #endif
 
 		return true;
@@ -380,7 +463,10 @@ bool ShaderProgram::setUniform( const Int32& Location, Vector3ff Value ) {
 bool ShaderProgram::setUniform( const Int32& Location, float x, float y, float z, float w ) {
 	if ( -1 != Location ) {
 #ifdef EE_SHADERS_SUPPORTED
-		glUniform4f( Location, x, y, z, w );
+		float value[4] = {x, y, z, w};
+
+		if ( updateUniform( Location, value, sizeof( value ) ) )
+			glUniform4f( Location, x, y, z, w );
 #endif
 
 		return true;
@@ -392,7 +478,8 @@ bool ShaderProgram::setUniform( const Int32& Location, float x, float y, float z
 bool ShaderProgram::setUniformMatrix( const Int32& Location, const float* Value ) {
 	if ( -1 != Location ) {
 #ifdef EE_SHADERS_SUPPORTED
-		glUniformMatrix4fv( Location, 1, false, Value );
+		if ( updateUniform( Location, Value, sizeof( float ) * 16 ) )
+			glUniformMatrix4fv( Location, 1, false, Value );
 #endif
 
 		return true;
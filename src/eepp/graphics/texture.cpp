@@ -23,7 +23,11 @@ Uint32 Texture::getMaximumSize() {
 
 	if ( !checked ) {
 		checked = true;
-		glGetIntegerv( GL_MAX_TEXTURE_SIZE, &size );
+
+		if ( GLi->isNullRenderer() )
+			size = 16384;
+		else
+			glGetIntegerv( GL_MAX_TEXTURE_SIZE, &size );
 	}
 
 	return static_cast<Uint32>( size );
@@ -39,7 +43,11 @@ Texture::Texture() :
 	mFlags( 0 ),
 	mClampMode( ClampMode::ClampToEdge ),
 	mFilter( Filter::Linear ),
-	mCoordinateType( CoordinateType::Normalized ) {
+	mCoordinateType( CoordinateType::Normalized ),
+	mReloadSource( NULL ),
+	mLastUse( 0 ),
+	mReloadRetryFrame( 0 ),
+	mReloadFailures( 0 ) {
 	if ( NULL == sBR ) {
 		sBR = GlobalBatchRenderer::instance();
 	}
@@ -54,7 +62,11 @@ Texture::Texture( const Texture& Copy ) :
 	mImgHeight( Copy.mImgHeight ),
 	mFlags( Copy.mFlags ),
 	mClampMode( Copy.mClampMode ),
-	mFilter( Copy.mFilter ) {
+	mFilter( Copy.mFilter ),
+	mReloadSource( NULL ),
+	mLastUse( 0 ),
+	mReloadRetryFrame( 0 ),
+	mReloadFailures( 0 ) {
 	mWidth = Copy.mWidth;
 	mHeight = Copy.mHeight;
 	mChannels = Copy.mChannels;
@@ -68,7 +80,11 @@ Texture::Texture( const Uint32& texture, const unsigned int& width, const unsign
 				  const bool& UseMipmap, const unsigned int& Channels, const std::string& filepath,
 				  const Texture::ClampMode& ClampMode, const bool& CompressedTexture,
 				  const Uint32& MemSize, const Uint8* data ) :
-	DrawableResource( Drawable::TEXTURE ) {
+	DrawableResource( Drawable::TEXTURE ),
+	mReloadSource( NULL ),
+	mLastUse( 0 ),
+	mReloadRetryFrame( 0 ),
+	mReloadFailures( 0 ) {
 	create( texture, width, height, imgwidth, imgheight, UseMipmap, Channels, filepath, ClampMode,
 			CompressedTexture, MemSize, data );
 }
@@ -79,6 +95,8 @@ Texture::~Texture() {
 	if ( !TextureFactory::instance()->isErasing() ) {
 		TextureFactory::instance()->removeReference( this );
 	}
+
+	eeSAFE_DELETE( mReloadSource );
 }
 
 void Texture::deleteTexture() {
@@ -90,7 +108,7 @@ void Texture::deleteTexture() {
 		if ( threaded )
 			Engine::instance()->getCurrentWindow()->setGLContextThread();
 
-		glDeleteTextures( 1, &Texture );
+		GLi->deleteTextures( 1, &Texture );
 
 		if ( threaded )
 			Engine::instance()->getCurrentWindow()->unsetGLContextThread();
@@ -142,6 +160,9 @@ Uint8* Texture::iLock( const bool& ForceRGBA, const bool& KeepFormat ) {
 	bool threaded = Engine::instance()->isSharedGLContextEnabled() &&
 					Thread::getCurrentThreadId() != Engine::instance()->getMainThreadId();
 
+	if ( mFlags & TEX_FLAG_EVICTED )
+		TextureFactory::instance()->makeResident( this );
+
 #ifndef EE_GLES
 	if ( !( mFlags & TEX_FLAG_LOCKED ) ) {
 		if ( threaded )
@@ -152,15 +173,20 @@ Uint8* Texture::iLock( const bool& ForceRGBA, const bool& KeepFormat ) {
 
 		ScopedTexture saver( mTexture );
 
-		Int32 width = 0, height = 0;
-		glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width );
-		glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height );
+		// The null renderer doesn't keep the texture contents, a blank image is returned
+		bool nullRenderer = GLi->isNullRenderer();
+		Int32 width = mWidth, height = mHeight;
+
+		if ( !nullRenderer ) {
+			glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width );
+			glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height );
+		}
 
 		mWidth = (unsigned int)width;
 		mHeight = (unsigned int)height;
 		int size = mWidth * mHeight * mChannels;
 
-		if ( KeepFormat && ( mFlags & TEX_FLAG_COMPRESSED ) ) {
+		if ( !nullRenderer && KeepFormat && ( mFlags & TEX_FLAG_COMPRESSED ) ) {
 			glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT,
 									  &mInternalFormat );
 			glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size );
@@ -168,7 +194,9 @@ Uint8* Texture::iLock( const bool& ForceRGBA, const bool& KeepFormat ) {
 
 		allocate( (unsigned int)size );
 
-		if ( KeepFormat && ( mFlags & TEX_FLAG_COMPRESSED ) ) {
+		if ( nullRenderer ) {
+			memset( &mPixels[0], 0, size );
+		} else if ( KeepFormat && ( mFlags & TEX_FLAG_COMPRESSED ) ) {
 			glGetCompressedTexImage( GL_TEXTURE_2D, 0, reinterpret_cast<Uint8*>( &mPixels[0] ) );
 		} else {
 			Uint32 Channel = GL_RGBA;
@@ -239,14 +267,16 @@ bool Texture::unlock( const bool& KeepData, const bool& Modified ) {
 		unsigned int NTexId = 0;
 
 		if ( Modified || ( mFlags & TEX_FLAG_MODIFIED ) ) {
+			eeSAFE_DELETE( mReloadSource );
+
 			ScopedTexture saver( mTexture );
 
 			Uint32 flags = ( mFlags & TEX_FLAG_MIPMAP ) ? SOIL_FLAG_MIPMAPS : 0;
 			flags = ( mClampMode == ClampMode::ClampRepeat ) ? ( flags | SOIL_FLAG_TEXTURE_REPEATS )
 															 : flags;
 
-			NTexId = SOIL_create_OGL_texture( reinterpret_cast<Uint8*>( &mPixels[0] ), &width,
-											  &height, mChannels, mTexture, flags );
+			NTexId = GLi->createTexture( reinterpret_cast<Uint8*>( &mPixels[0] ), &width, &height,
+										 mChannels, mTexture, flags );
 
 			iTextureFilter( mFilter );
 
@@ -320,9 +350,10 @@ void Texture::setFilter( const Filter& filter ) {
 }
 
 void Texture::iTextureFilter( const Filter& filter ) {
-	if ( mTexture ) {
-		mFilter = filter;
+	// Evicted textures keep the filter, it's applied when reloaded.
+	mFilter = filter;
 
+	if ( mTexture && !GLi->isNullRenderer() ) {
 		bool threaded = Engine::instance()->isSharedGLContextEnabled() &&
 						Thread::getCurrentThreadId() != Engine::instance()->getMainThreadId();
 
@@ -433,7 +464,7 @@ void Texture::setClampMode( const Texture::ClampMode& clampmode ) {
 }
 
 void Texture::applyClampMode() {
-	if ( mTexture ) {
+	if ( mTexture && !GLi->isNullRenderer() ) {
 		ScopedTexture saver( mTexture );
 
 		if ( mClampMode == ClampMode::ClampRepeat ) {
@@ -456,6 +487,10 @@ const Uint32& Texture::getTextureId() const {
 }
 
 void Texture::reload() {
+	// Evicted textures are reloaded on demand by the texture factory.
+	if ( mFlags & TEX_FLAG_EVICTED )
+		return;
+
 	if ( hasLocalCopy() ) {
 		Int32 width = (Int32)mWidth;
 		Int32 height = (Int32)mHeight;
@@ -474,16 +509,16 @@ void Texture::reload() {
 															 : flags;
 
 			if ( ( mFlags & TEX_FLAG_COMPRESSED ) ) {
-				if ( isGrabed() )
-					mTexture = SOIL_create_OGL_texture( reinterpret_cast<Uint8*>( &mPixels[0] ),
-														&width, &height, mChannels, mTexture,
-														flags | SOIL_FLAG_COMPRESS_TO_DXT );
+				if ( isGrabed() || GLi->isNullRenderer() )
+					mTexture = GLi->createTexture( reinterpret_cast<Uint8*>( &mPixels[0] ), &width,
+												   &height, mChannels, mTexture,
+												   flags | SOIL_FLAG_COMPRESS_TO_DXT );
 				else
 					glCompressedTexImage2D( mTexture, 0, mInternalFormat, width, height, 0, mSize,
 											&mPixels[0] );
 			} else {
-				mTexture = SOIL_create_OGL_texture( reinterpret_cast<Uint8*>( &mPixels[0] ), &width,
-													&height, mChannels, mTexture, flags );
+				mTexture = GLi->createTexture( reinterpret_cast<Uint8*>( &mPixels[0] ), &width,
+											   &height, mChannels, mTexture, flags );
 
 				TextureFactory::instance()->mMemSize -= mSize;
 
@@ -538,6 +573,8 @@ static unsigned int convertPixelFormatToGLFormat( Image::PixelFormat pf ) {
 
 void Texture::update( const Uint8* pixels, Uint32 width, Uint32 height, Uint32 x, Uint32 y,
 					  PixelFormat pf ) {
+	onContentsModified();
+
 	if ( NULL != pixels && mTexture && x + width <= mWidth && y + height <= mHeight ) {
 		bool threaded = Engine::instance()->isSharedGLContextEnabled() &&
 						Thread::getCurrentThreadId() != Engine::instance()->getMainThreadId();
@@ -548,9 +585,10 @@ void Texture::update( const Uint8* pixels, Uint32 width, Uint32 height, Uint32 x
 		{
 			ScopedTexture saver( mTexture );
 
-			glTexSubImage2D( GL_TEXTURE_2D, 0, x, y, width, height,
-							 (unsigned int)convertPixelFormatToGLFormat( pf ), GL_UNSIGNED_BYTE,
-							 pixels );
+			if ( !GLi->isNullRenderer() )
+				glTexSubImage2D( GL_TEXTURE_2D, 0, x, y, width, height,
+								 (unsigned int)convertPixelFormatToGLFormat( pf ),
+								 GL_UNSIGNED_BYTE, pixels );
 
 			if ( hasLocalCopy() ) {
 				Image image( pixels, width, height, mChannels );
@@ -576,6 +614,8 @@ void Texture::update( Image* image, Uint32 x, Uint32 y ) {
 }
 
 void Texture::replace( Image* image ) {
+	onContentsModified();
+
 	bool threaded = Engine::instance()->isSharedGLContextEnabled() &&
 					Thread::getCurrentThreadId() != Engine::instance()->getMainThreadId();
 
@@ -591,8 +631,8 @@ void Texture::replace( Image* image ) {
 
 		Int32 width = (Int32)image->getWidth();
 		Int32 height = (Int32)image->getHeight();
-		mTexture = SOIL_create_OGL_texture( image->getPixelsPtr(), &width, &height,
-											image->getChannels(), mTexture, flags );
+		mTexture = GLi->createTexture( image->getPixelsPtr(), &width, &height,
+									   image->getChannels(), mTexture, flags );
 		mWidth = mImgWidth = width;
 		mHeight = mImgHeight = height;
 		mChannels = image->getChannels();
@@ -614,6 +654,21 @@ void Texture::replace( Image* image ) {
 	onResourceChange();
 }
 
+bool Texture::isEvicted() const {
+	return 0 != ( mFlags & TEX_FLAG_EVICTED );
+}
+
+bool Texture::hasReloadSource() const {
+	return NULL != mReloadSource;
+}
+
+void Texture::onContentsModified() {
+	if ( mFlags & TEX_FLAG_EVICTED )
+		TextureFactory::instance()->makeResident( this );
+
+	eeSAFE_DELETE( mReloadSource );
+}
+
 const String::HashType& Texture::getHashName() const {
 	return mId;
 }
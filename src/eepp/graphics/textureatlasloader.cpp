@@ -486,6 +486,9 @@ bool TextureAtlasLoader::updateTextureAtlas( std::string TextureAtlasPath, std::
 				(Texture::Filter)mTexGrHdr.TextureFilter,
 				mTexGrHdr.Flags & HDR_TEXTURE_ATLAS_ALLOW_FLIPPING );
 
+			// Keeps the placement of the unchanged images, only the new ones are packed.
+			tp.setPreviousTextureAtlas( TextureAtlasPath );
+
 			tp.addTexturesPath( ImagesPath );
 
 			if ( tp.packTextures() <= 0 ) {
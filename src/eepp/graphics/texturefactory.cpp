@@ -1,23 +1,33 @@
 #include <SOIL2/src/SOIL2/SOIL2.h>
 #include <SOIL2/src/SOIL2/stb_image.h>
+#include <algorithm>
 #include <eepp/graphics/renderer/openglext.hpp>
 #include <eepp/graphics/renderer/renderer.hpp>
 #include <eepp/graphics/texture.hpp>
 #include <eepp/graphics/texturefactory.hpp>
 #include <eepp/graphics/textureloader.hpp>
 #include <eepp/system/filesystem.hpp>
+#include <eepp/system/lock.hpp>
 #include <eepp/system/log.hpp>
+#include <eepp/system/packmanager.hpp>
 #include <jpeg-compressor/jpge.h>
 
 namespace EE { namespace Graphics {
 
+// A failed reload is tried again after this many frames, doubled on every consecutive failure.
+static const Uint64 RELOAD_RETRY_FRAMES = 30;
+static const Uint32 RELOAD_RETRY_MAX_DOUBLINGS = 6;
+
 SINGLETON_DECLARE_IMPLEMENTATION( TextureFactory )
 
 TextureFactory::TextureFactory() :
 	mCurrentTexture( EE_MAX_TEXTURE_UNITS ),
 	mMemSize( 0 ),
 	mLastCoordinateType( Texture::CoordinateType::Normalized ),
-	mErasing( false ) {
+	mErasing( false ),
+	mMemoryBudget( 0 ),
+	mFrame( 1 ),
+	mPlaceholder( NULL ) {
 	mTextures.clear();
 	mTextures.push_back( NULL );
 }
@@ -27,6 +37,9 @@ const Texture::CoordinateType& TextureFactory::getLastCoordinateType() const {
 }
 
 TextureFactory::~TextureFactory() {
+	mReloadPool.reset();
+	mPendingReloads.clear();
+
 	unloadTextures();
 }
 
@@ -115,6 +128,7 @@ Uint32 TextureFactory::pushTexture( const std::string& Filepath, const Uint32& T
 	Tex->create( TexId, Width, Height, ImgWidth, ImgHeight, Mipmap, Channels, FPath, ClampMode,
 				 CompressTexture, MemSize );
 	Tex->setTextureId( Pos );
+	Tex->mLastUse = mFrame;
 
 	if ( LocalCopy ) {
 		Tex->lock();
@@ -145,6 +159,15 @@ Uint32 TextureFactory::findFreeSlot() {
 void TextureFactory::bind( const Texture* texture, Texture::CoordinateType coordinateType,
 						   const Uint32& TextureUnit, const bool& forceRebind ) {
 	if ( NULL != texture ) {
+		if ( texture->mFlags & Texture::TEX_FLAG_EVICTED ) {
+			mCacheStats.misses++;
+			texture = reloadForBind( const_cast<Texture*>( texture ) );
+		} else {
+			mCacheStats.hits++;
+		}
+
+		const_cast<Texture*>( texture )->mLastUse = mFrame;
+
 		if ( mCurrentTexture[TextureUnit] != (Int32)texture->getHandle() || forceRebind ) {
 			if ( TextureUnit && GLi->isExtension( EEGL_ARB_multitexture ) )
 				setActiveTextureUnit( TextureUnit );
@@ -155,6 +178,8 @@ void TextureFactory::bind( const Texture* texture, Texture::CoordinateType coord
 
 			if ( TextureUnit && GLi->isExtension( EEGL_ARB_multitexture ) )
 				setActiveTextureUnit( 0 );
+		} else {
+			GLi->mFrameStats.filteredStateChanges++;
 		}
 
 		if ( coordinateType == Texture::CoordinateType::Pixels ) {
@@ -220,7 +245,13 @@ bool TextureFactory::remove( Uint32 TexId ) {
 }
 
 void TextureFactory::removeReference( Texture* Tex ) {
-	mMemSize -= Tex->getMemSize();
+	if ( !Tex->isEvicted() )
+		mMemSize -= Tex->getMemSize();
+
+	mPendingReloads.erase( Tex->getTextureId() );
+
+	if ( mPlaceholder == Tex )
+		mPlaceholder = NULL;
 
 	int glTexId = Tex->getHandle();
 
@@ -276,7 +307,7 @@ void TextureFactory::grabTextures() {
 	for ( Uint32 i = 1; i < mTextures.size(); i++ ) {
 		Texture* Tex = getTexture( i );
 
-		if ( Tex && !Tex->hasLocalCopy() ) {
+		if ( Tex && !Tex->hasLocalCopy() && !Tex->isEvicted() ) {
 			Tex->lock();
 			Tex->setGrabed( true );
 		}
@@ -340,4 +371,255 @@ Texture* TextureFactory::getByHash( const String::HashType& hash ) {
 	return NULL;
 }
 
+void TextureFactory::setMemoryBudget( const size_t& bytes ) {
+	mMemoryBudget = bytes;
+
+	enforceMemoryBudget();
+}
+
+const size_t& TextureFactory::getMemoryBudget() const {
+	return mMemoryBudget;
+}
+
+void TextureFactory::setPlaceholderTexture( Texture* texture ) {
+	mPlaceholder = texture;
+}
+
+Texture* TextureFactory::getPlaceholderTexture() const {
+	return mPlaceholder;
+}
+
+bool TextureFactory::isEvictable( Texture* texture ) const {
+	return NULL != texture && 0 != texture->mTexture && texture != mPlaceholder &&
+		   !( texture->mFlags & ( Texture::TEX_FLAG_EVICTED | Texture::TEX_FLAG_LOCKED |
+								  Texture::TEX_FLAG_GRABED ) ) &&
+		   ( texture->hasReloadSource() ||
+			 ( texture->hasLocalCopy() && !( texture->mFlags & Texture::TEX_FLAG_COMPRESSED ) ) );
+}
+
+void TextureFactory::enforceMemoryBudget() {
+	if ( 0 == mMemoryBudget || mMemSize <= mMemoryBudget )
+		return;
+
+	std::vector<Texture*> candidates;
+
+	for ( Uint32 i = 1; i < mTextures.size(); i++ ) {
+		Texture* tex = mTextures[i];
+
+		// The textures drawn in the current frame stay resident, evicting them would make every
+		// frame reload its own working set.
+		if ( NULL != tex && tex->mLastUse < mFrame && isEvictable( tex ) )
+			candidates.push_back( tex );
+	}
+
+	std::sort( candidates.begin(), candidates.end(),
+			   []( const Texture* a, const Texture* b ) { return a->mLastUse < b->mLastUse; } );
+
+	for ( auto& tex : candidates ) {
+		if ( mMemSize <= mMemoryBudget )
+			break;
+
+		evict( tex );
+	}
+}
+
+bool TextureFactory::evict( Texture* texture ) {
+	if ( !isEvictable( texture ) )
+		return false;
+
+	Lock l( *this );
+
+	unsigned int handle = static_cast<unsigned int>( texture->mTexture );
+
+	GLi->deleteTextures( 1, &handle );
+
+	for ( Uint32 i = 0; i < EE_MAX_TEXTURE_UNITS; i++ ) {
+		if ( mCurrentTexture[i] == (Int32)handle )
+			mCurrentTexture[i] = 0;
+	}
+
+	mMemSize -= texture->getMemSize();
+	mCacheStats.evictions++;
+	mCacheStats.evictedBytes += texture->getMemSize();
+
+	texture->mTexture = 0;
+	texture->mFlags |= Texture::TEX_FLAG_EVICTED;
+
+	return true;
+}
+
+std::shared_ptr<TextureLoader> TextureFactory::createReloader( Texture* texture ) {
+	Texture::ReloadSource* source = texture->mReloadSource;
+	std::shared_ptr<TextureLoader> loader;
+
+	if ( source->packPath.empty() ) {
+		loader = std::make_shared<TextureLoader>( source->path, texture->getMipmap(),
+												  texture->getClampMode(), source->compress );
+	} else {
+		Pack* pack = PackManager::instance()->getPackByPath( source->packPath );
+
+		if ( NULL == pack )
+			return loader;
+
+		loader = std::make_shared<TextureLoader>( pack, source->path, texture->getMipmap(),
+												  texture->getClampMode(), source->compress );
+	}
+
+	loader->setFormatConfiguration( source->formatConfiguration );
+	loader->mReloadTexture = texture;
+
+	return loader;
+}
+
+void TextureFactory::makeResident( Texture* texture ) {
+	if ( NULL == texture || !texture->isEvicted() )
+		return;
+
+	mPendingReloads.erase( texture->getTextureId() );
+
+	if ( texture->hasLocalCopy() ) {
+		lock();
+		texture->mFlags &= ~Texture::TEX_FLAG_EVICTED;
+		mMemSize += texture->getMemSize();
+		mCacheStats.reloads++;
+		unlock();
+
+		texture->reload();
+	} else if ( texture->hasReloadSource() ) {
+		std::shared_ptr<TextureLoader> loader( createReloader( texture ) );
+
+		if ( loader ) {
+			loader->decode();
+			uploadReload( texture, loader.get() );
+		} else {
+			onReloadFailed( texture );
+		}
+	}
+
+	texture->mLastUse = mFrame;
+}
+
+const Texture* TextureFactory::reloadForBind( Texture* texture ) {
+	// The source of a failed reload could be back later ( a pack not mounted yet, a file being
+	// rewritten ), but it's not tried again on every bind.
+	if ( mFrame < texture->mReloadRetryFrame )
+		return NULL != mPlaceholder ? mPlaceholder : texture;
+
+	if ( NULL == mPlaceholder || texture->hasLocalCopy() || !texture->hasReloadSource() ) {
+		makeResident( texture );
+		return texture;
+	}
+
+	auto it = mPendingReloads.find( texture->getTextureId() );
+
+	if ( it == mPendingReloads.end() ) {
+		PendingReload pending;
+		pending.loader = createReloader( texture );
+
+		if ( !pending.loader ) {
+			onReloadFailed( texture );
+			return texture;
+		}
+
+		pending.decoded = std::make_shared<std::atomic<bool>>( false );
+
+		if ( !mReloadPool )
+			mReloadPool = ThreadPool::createUnique( 1 );
+
+		std::shared_ptr<TextureLoader> loader( pending.loader );
+		std::shared_ptr<std::atomic<bool>> decoded( pending.decoded );
+
+		// Only the decoding runs in the worker, the upload is done in the rendering thread.
+		mReloadPool->run(
+			[loader, decoded]() {
+				loader->decode();
+				*decoded = true;
+			},
+			nullptr );
+
+		mPendingReloads[texture->getTextureId()] = pending;
+	} else if ( *it->second.decoded ) {
+		std::shared_ptr<TextureLoader> loader( it->second.loader );
+
+		mPendingReloads.erase( it );
+
+		uploadReload( texture, loader.get() );
+
+		return texture;
+	}
+
+	mCacheStats.placeholderBinds++;
+
+	return mPlaceholder;
+}
+
+void TextureFactory::uploadReload( Texture* texture, TextureLoader* loader ) {
+	loader->loadFromPixels();
+
+	if ( 0 == loader->getId() )
+		onReloadFailed( texture );
+}
+
+void TextureFactory::onReloadFailed( Texture* texture ) {
+	mCacheStats.failedReloads++;
+
+	Log::warning( "Texture %s could not be reloaded after its eviction.",
+				  texture->getFilepath().c_str() );
+
+	texture->mReloadRetryFrame =
+		mFrame + ( RELOAD_RETRY_FRAMES
+				   << eemin( texture->mReloadFailures, RELOAD_RETRY_MAX_DOUBLINGS ) );
+	texture->mReloadFailures++;
+}
+
+void TextureFactory::onTextureReloaded( Texture* texture, const Uint32& handle,
+										const unsigned int& width, const unsigned int& height,
+										const Uint32& memSize ) {
+	lock();
+
+	texture->mTexture = handle;
+	texture->mWidth = width;
+	texture->mHeight = height;
+	texture->mSize = memSize;
+	texture->mFlags &= ~Texture::TEX_FLAG_EVICTED;
+	texture->mLastUse = mFrame;
+	texture->mReloadRetryFrame = 0;
+	texture->mReloadFailures = 0;
+
+	mMemSize += memSize;
+	mCacheStats.reloads++;
+
+	unlock();
+
+	texture->iTextureFilter( texture->mFilter );
+}
+
+void TextureFactory::endFrame() {
+	// Upload the textures decoded in the background, so they are drawn in the next frame.
+	for ( auto it = mPendingReloads.begin(); it != mPendingReloads.end(); ) {
+		if ( *it->second.decoded ) {
+			std::shared_ptr<TextureLoader> loader( it->second.loader );
+			Texture* texture = loader->mReloadTexture;
+
+			it = mPendingReloads.erase( it );
+
+			uploadReload( texture, loader.get() );
+		} else {
+			++it;
+		}
+	}
+
+	enforceMemoryBudget();
+
+	mFrame++;
+}
+
+const TextureCacheStats& TextureFactory::getCacheStats() const {
+	return mCacheStats;
+}
+
+void TextureFactory::resetCacheStats() {
+	mCacheStats = TextureCacheStats();
+}
+
 }} // namespace EE::Graphics
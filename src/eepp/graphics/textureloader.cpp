@@ -44,6 +44,7 @@ TextureLoader::TextureLoader( IOStream& Stream, const bool& Mipmap,
 	mImagePtr( NULL ),
 	mSize( 0 ),
 	mColorKey( NULL ),
+	mReloadTexture( NULL ),
 	mLoaded( false ),
 	mTexLoaded( false ),
 	mDirectUpload( false ),
@@ -71,6 +72,7 @@ TextureLoader::TextureLoader( const std::string& Filepath, const bool& Mipmap,
 	mImagePtr( NULL ),
 	mSize( 0 ),
 	mColorKey( NULL ),
+	mReloadTexture( NULL ),
 	mLoaded( false ),
 	mTexLoaded( false ),
 	mDirectUpload( false ),
@@ -98,6 +100,7 @@ TextureLoader::TextureLoader( const unsigned char* ImagePtr, const unsigned int&
 	mImagePtr( ImagePtr ),
 	mSize( Size ),
 	mColorKey( NULL ),
+	mReloadTexture( NULL ),
 	mLoaded( false ),
 	mTexLoaded( false ),
 	mDirectUpload( false ),
@@ -125,6 +128,7 @@ TextureLoader::TextureLoader( Pack* Pack, const std::string& FilePackPath, const
 	mImagePtr( NULL ),
 	mSize( 0 ),
 	mColorKey( NULL ),
+	mReloadTexture( NULL ),
 	mLoaded( false ),
 	mTexLoaded( false ),
 	mDirectUpload( false ),
@@ -154,6 +158,7 @@ TextureLoader::TextureLoader( const unsigned char* Pixels, const unsigned int& W
 	mImagePtr( NULL ),
 	mSize( 0 ),
 	mColorKey( NULL ),
+	mReloadTexture( NULL ),
 	mLoaded( false ),
 	mTexLoaded( false ),
 	mDirectUpload( false ),
@@ -168,6 +173,12 @@ TextureLoader::~TextureLoader() {
 }
 
 void TextureLoader::load() {
+	decode();
+
+	loadFromPixels();
+}
+
+void TextureLoader::decode() {
 	mTE.restart();
 
 	if ( TEX_LT_PATH == mLoadType )
@@ -180,8 +191,6 @@ void TextureLoader::load() {
 		loadFromStream();
 
 	mTexLoaded = true;
-
-	loadFromPixels();
 }
 
 void TextureLoader::loadFile() {
@@ -365,7 +374,7 @@ void TextureLoader::loadFromPixels() {
 			{
 				ScopedTexture scopedTexture;
 
-				if ( mDirectUpload ) {
+				if ( mDirectUpload && !GLi->isNullRenderer() ) {
 					if ( STBI_dds == mImgType ) {
 						tTexId = SOIL_direct_load_DDS_from_memory( mPixels, mSize,
 																   SOIL_CREATE_NEW_ID, flags, 0 );
@@ -390,8 +399,8 @@ void TextureLoader::loadFromPixels() {
 						eeSAFE_DELETE( tImg );
 					}
 
-					tTexId = SOIL_create_OGL_texture( mPixels, &width, &height, mChannels,
-													  SOIL_CREATE_NEW_ID, flags );
+					tTexId = GLi->createTexture( mPixels, &width, &height, mChannels,
+												 SOIL_CREATE_NEW_ID, flags );
 				}
 			}
 
@@ -425,9 +434,18 @@ void TextureLoader::loadFromPixels() {
 					}
 				}
 
-				mTexId = TextureFactory::instance()->pushTexture(
-					mFilepath, tTexId, width, height, mImgWidth, mImgHeight, mMipmap, mChannels,
-					mClampMode, mCompressTexture || mIsCompressed, mLocalCopy, mSize );
+				if ( NULL != mReloadTexture ) {
+					TextureFactory::instance()->onTextureReloaded( mReloadTexture, tTexId, width,
+																   height, mSize );
+					mTexId = mReloadTexture->getTextureId();
+				} else {
+					mTexId = TextureFactory::instance()->pushTexture(
+						mFilepath, tTexId, width, height, mImgWidth, mImgHeight, mMipmap,
+						mChannels, mClampMode, mCompressTexture || mIsCompressed, mLocalCopy,
+						mSize );
+
+					setReloadSource();
+				}
 
 				if ( mFilepath.empty() ) {
 					Log::info( "Texture ID %d loaded in %4.3f ms.", mTexId,
@@ -467,6 +485,26 @@ void TextureLoader::loadFromPixels() {
 	}
 }
 
+void TextureLoader::setReloadSource() {
+	Texture* texture = getTexture();
+
+	// Only the textures that can be decoded again exactly as they were can be evicted and
+	// reloaded from its source.
+	if ( NULL == texture || NULL != mColorKey || mFilepath.empty() ||
+		 ( TEX_LT_PATH != mLoadType && TEX_LT_PACK != mLoadType ) ||
+		 ( TEX_LT_PACK == mLoadType && NULL == mPack ) )
+		return;
+
+	Texture::ReloadSource* source = eeNew( Texture::ReloadSource, () );
+	source->path = mFilepath;
+	source->packPath = TEX_LT_PACK == mLoadType ? mPack->getPackPath() : "";
+	source->compress = mCompressTexture;
+	source->formatConfiguration = mFormatConfiguration;
+
+	eeSAFE_DELETE( texture->mReloadSource );
+	texture->mReloadSource = source;
+}
+
 const Uint32& TextureLoader::getId() const {
 	return mTexId;
 }
@@ -1,15 +1,108 @@
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
 #include <eepp/graphics/texturepacker.hpp>
+#include <eepp/graphics/texturepackermaxrects.hpp>
 #include <eepp/graphics/texturepackernode.hpp>
+#include <eepp/graphics/texturepackerskyline.hpp>
 #include <eepp/graphics/texturepackertex.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/system/log.hpp>
 #include <eepp/system/md5.hpp>
 #include <eepp/system/sys.hpp>
+#include <eepp/system/thread.hpp>
+#include <eepp/system/threadpool.hpp>
+#include <mutex>
 
 namespace EE { namespace Graphics {
 
+static Uint32 getEffectiveThreadCount( const Uint32& threadCount ) {
+	return 0 == threadCount ? (Uint32)eemax( 1, Sys::getCPUCount() ) : threadCount;
+}
+
+static TexturePackerMaxRects::Heuristic
+toMaxRectsHeuristic( const TexturePacker::PackingHeuristic& heuristic ) {
+	switch ( heuristic ) {
+		case TexturePacker::PackingHeuristic::MaxRectsBestLongSideFit:
+			return TexturePackerMaxRects::Heuristic::BestLongSideFit;
+		case TexturePacker::PackingHeuristic::MaxRectsBestAreaFit:
+			return TexturePackerMaxRects::Heuristic::BestAreaFit;
+		case TexturePacker::PackingHeuristic::MaxRectsBottomLeft:
+			return TexturePackerMaxRects::Heuristic::BottomLeft;
+		case TexturePacker::PackingHeuristic::MaxRectsBestShortSideFit:
+		default:
+			return TexturePackerMaxRects::Heuristic::BestShortSideFit;
+	}
+}
+
+static void trimTransparentBorders( TexturePackerTex* t, Image* img ) {
+	const Uint8* pixels = img->getPixelsPtr();
+	Int32 channels = (Int32)img->getChannels();
+	Int32 width = (Int32)img->getWidth();
+	Int32 height = (Int32)img->getHeight();
+
+	if ( NULL == pixels || ( 2 != channels && 4 != channels ) || width != t->width() ||
+		 height != t->height() )
+		return;
+
+	Int32 minX = width;
+	Int32 minY = height;
+	Int32 maxX = -1;
+	Int32 maxY = -1;
+
+	for ( Int32 y = 0; y < height; y++ ) {
+		const Uint8* row = pixels + (size_t)y * width * channels + channels - 1;
+
+		for ( Int32 x = 0; x < width; x++ ) {
+			if ( 0 != row[x * channels] ) {
+				minX = eemin( minX, x );
+				maxX = eemax( maxX, x );
+				minY = eemin( minY, y );
+				maxY = y;
+			}
+		}
+	}
+
+	// A fully transparent image keeps a single pixel.
+	if ( -1 == maxX )
+		t->trim( 0, 0, 1, 1 );
+	else
+		t->trim( minX, minY, maxX - minX + 1, maxY - minY + 1 );
+}
+
+static bool copyToAtlas( Image& atlas, TexturePackerTex* t, Image* source ) {
+	if ( NULL == source->getPixelsPtr() )
+		return false;
+
+	Image* region = NULL;
+
+	if ( t->trimmed() && ( 0 != t->offsetX() || 0 != t->offsetY() ||
+						   t->width() != (int)source->getWidth() ||
+						   t->height() != (int)source->getHeight() ) ) {
+		region = source->crop( Rect( t->offsetX(), t->offsetY(), t->offsetX() + t->width(),
+									 t->offsetY() + t->height() ) );
+
+		if ( NULL == region )
+			return false;
+
+		source = region;
+	} else if ( t->width() != (int)source->getWidth() ||
+				t->height() != (int)source->getHeight() ) {
+		return false;
+	}
+
+	if ( t->flipped() )
+		source->flip();
+
+	atlas.copyImage( source, t->x(), t->y() );
+
+	eeSAFE_DELETE( region );
+
+	return true;
+}
+
 TexturePacker* TexturePacker::New() {
 	return eeNew( TexturePacker, () );
 }
@@ -46,7 +139,10 @@ TexturePacker::TexturePacker( const Uint32& maxWidth, const Uint32& maxHeight,
 	mTextureFilter( textureFilter ),
 	mKeepExtensions( false ),
 	mScalableSVG( scalableSVG ),
-	mFormat( Image::SaveType::SAVE_TYPE_PNG ) {
+	mFormat( Image::SaveType::SAVE_TYPE_PNG ),
+	mHeuristic( PackingHeuristic::Guillotine ),
+	mThreadCount( 0 ),
+	mTrim( false ) {
 	setOptions( maxWidth, maxHeight, pixelDensity, forcePowOfTwo, scalableSVG, pixelBorder,
 				textureFilter, allowChilds, allowFlipping );
 }
@@ -70,7 +166,10 @@ TexturePacker::TexturePacker() :
 	mTextureFilter( Texture::Filter::Linear ),
 	mKeepExtensions( false ),
 	mScalableSVG( false ),
-	mFormat( Image::SaveType::SAVE_TYPE_PNG ) {}
+	mFormat( Image::SaveType::SAVE_TYPE_PNG ),
+	mHeuristic( PackingHeuristic::Guillotine ),
+	mThreadCount( 0 ),
+	mTrim( false ) {}
 
 TexturePacker::~TexturePacker() {
 	close();
@@ -86,6 +185,7 @@ void TexturePacker::close() {
 	}
 
 	mTextures.clear();
+	mReused.clear();
 }
 
 void TexturePacker::reset() {
@@ -404,6 +504,8 @@ void TexturePacker::createChild() {
 	mChild = TexturePacker::New( mWidth, mHeight, mPixelDensity / 100.f, mForcePowOfTwo,
 								 mScalableSVG, mPixelBorder, mTextureFilter, mAllowFlipping );
 
+	copySettings( mChild );
+
 	std::list<TexturePackerTex*>::iterator it;
 	std::list<std::list<TexturePackerTex*>::iterator> remove;
 
@@ -439,14 +541,25 @@ bool TexturePacker::addTexturesPath( std::string TexturesPath ) {
 		FileSystem::dirAddSlashAtEnd( TexturesPath );
 
 		std::vector<std::string> files = FileSystem::filesGetInPath( TexturesPath );
+		std::vector<std::string> paths;
 		std::sort( files.begin(), files.end() );
 
 		for ( Uint32 i = 0; i < files.size(); i++ ) {
 			std::string path( TexturesPath + files[i] );
 			if ( !FileSystem::isDirectory( path ) && Image::isImageExtension( path ) )
-				addTexture( path );
+				paths.push_back( path );
 		}
 
+		// Reading the image headers ( and rasterizing the SVG sizes ) is done concurrently.
+		Image::FormatConfiguration imageFormatConfiguration( getImageFormatConfiguration() );
+		std::vector<TexturePackerTex*> texs( paths.size(), NULL );
+
+		parallelFor( paths.size(), [&]( size_t i ) {
+			texs[i] = eeNew( TexturePackerTex, ( paths[i], imageFormatConfiguration ) );
+		} );
+
+		addPackerTexs( texs );
+
 		return true;
 	}
 
@@ -494,12 +607,8 @@ bool TexturePacker::addImage( Image* Img, const std::string& Name ) {
 
 bool TexturePacker::addTexture( const std::string& TexturePath ) {
 	if ( FileSystem::fileExists( TexturePath ) ) {
-		Image::FormatConfiguration imageFormatConfiguration;
-
-		imageFormatConfiguration.svgScale( mScalableSVG ? mPixelDensity / 100.f : 1.f );
-
 		TexturePackerTex* TPack =
-			eeNew( TexturePackerTex, ( TexturePath, imageFormatConfiguration ) );
+			eeNew( TexturePackerTex, ( TexturePath, getImageFormatConfiguration() ) );
 
 		return addPackerTex( TPack );
 	}
@@ -507,7 +616,376 @@ bool TexturePacker::addTexture( const std::string& TexturePath ) {
 	return false;
 }
 
+void TexturePacker::addPackerTexs( std::vector<TexturePackerTex*>& texs ) {
+	std::stable_sort( texs.begin(), texs.end(),
+					  []( const TexturePackerTex* a, const TexturePackerTex* b ) {
+						  return a->area() > b->area();
+					  } );
+
+	std::list<TexturePackerTex*>::iterator it = mTextures.begin();
+
+	for ( TexturePackerTex* tex : texs ) {
+		// Only add the texture if can fit inside the atlas, otherwise it will ignore it
+		if ( !tex->loadedInfo() ||
+			 !( ( tex->width() + mPixelBorder <= mMaxSize.getWidth() &&
+				  tex->height() + mPixelBorder <= mMaxSize.getHeight() ) ||
+				( mAllowFlipping && ( tex->width() + mPixelBorder <= mMaxSize.getHeight() &&
+									  tex->height() + mPixelBorder <= mMaxSize.getWidth() ) ) ) ) {
+			eeSAFE_DELETE( tex );
+			continue;
+		}
+
+		mTotalArea += tex->area();
+
+		// Insert ordered, the textures are sorted so the insertion point only moves forward.
+		while ( it != mTextures.end() && ( *it )->area() >= tex->area() )
+			++it;
+
+		mTextures.insert( it, tex );
+	}
+
+	texs.clear();
+}
+
+Image::FormatConfiguration TexturePacker::getImageFormatConfiguration() const {
+	Image::FormatConfiguration imageFormatConfiguration;
+
+	imageFormatConfiguration.svgScale( mScalableSVG ? mPixelDensity / 100.f : 1.f );
+
+	return imageFormatConfiguration;
+}
+
+System::ThreadPool* TexturePacker::getThreadPool() {
+	Uint32 threadCount = getEffectiveThreadCount( mThreadCount );
+
+	if ( threadCount <= 1 )
+		return NULL;
+
+	if ( !mThreadPool )
+		mThreadPool = ThreadPool::createUnique( threadCount );
+
+	return mThreadPool.get();
+}
+
+void TexturePacker::parallelFor( const size_t& count, const std::function<void( size_t )>& func ) {
+	ThreadPool* pool = count > 1 ? getThreadPool() : NULL;
+
+	if ( NULL == pool ) {
+		for ( size_t i = 0; i < count; i++ )
+			func( i );
+
+		return;
+	}
+
+	size_t tasks = eemin<size_t>( count, getEffectiveThreadCount( mThreadCount ) );
+	std::atomic<size_t> next( 0 );
+	std::mutex mutex;
+	std::condition_variable finished;
+	size_t running = tasks;
+
+	for ( size_t t = 0; t < tasks; t++ ) {
+		pool->run(
+			[&] {
+				for ( size_t i = next++; i < count; i = next++ )
+					func( i );
+
+				std::lock_guard<std::mutex> lock( mutex );
+
+				if ( 0 == --running )
+					finished.notify_all();
+			},
+			nullptr );
+	}
+
+	std::unique_lock<std::mutex> lock( mutex );
+	finished.wait( lock, [&] { return 0 == running; } );
+}
+
+void TexturePacker::prepareTextures() {
+	bool hash = !mPreviousRegions.empty();
+
+	if ( !mTrim && !hash )
+		return;
+
+	std::vector<TexturePackerTex*> texs( mTextures.begin(), mTextures.end() );
+
+	parallelFor( texs.size(), [&]( size_t i ) {
+		TexturePackerTex* t = texs[i];
+
+		if ( hash && NULL == t->getImage() && t->hash().empty() )
+			t->hash( MD5::fromFile( t->name() ).digest );
+
+		if ( mTrim && !t->trimmed() && ( 2 == t->channels() || 4 == t->channels() ) ) {
+			if ( NULL != t->getImage() ) {
+				trimTransparentBorders( t, t->getImage() );
+			} else {
+				Image image( t->name(), 0, t->formatConfiguration() );
+				trimTransparentBorders( t, &image );
+			}
+		}
+	} );
+
+	if ( mTrim ) {
+		mTextures.sort( []( const TexturePackerTex* a, const TexturePackerTex* b ) {
+			return a->area() > b->area();
+		} );
+
+		mTotalArea = 0;
+
+		for ( const auto& t : mTextures )
+			mTotalArea += t->area();
+	}
+}
+
 Int32 TexturePacker::packTextures() {
+	prepareTextures();
+
+	if ( PackingHeuristic::Guillotine == mHeuristic && mPreviousRegions.empty() )
+		return packGuillotine();
+
+	return packBins();
+}
+
+Int32 TexturePacker::packBins() {
+	std::vector<TexturePackerTex*> texs( mTextures.begin(), mTextures.end() );
+	std::vector<sTextureRegionHdr> placements;
+	bool packed = false;
+
+	reset();
+
+	if ( !mPreviousRegions.empty() ) {
+		matchPreviousRegions( texs );
+
+		if ( !mReused.empty() ) {
+			packed = packBin( mPreviousSize, texs, placements, true ) == texs.size();
+
+			if ( packed ) {
+				mWidth = mPreviousSize.getWidth();
+				mHeight = mPreviousSize.getHeight();
+			} else {
+				Log::info( "TexturePacker: The modified images don't fit in the previous texture "
+						   "atlas, packing it from scratch." );
+				mReused.clear();
+			}
+		}
+
+		// Only the incremental update needs to track the free space around the kept images, a
+		// repack from scratch keeps the configured packer.
+		if ( !packed && PackingHeuristic::Guillotine == mHeuristic )
+			return packGuillotine();
+	}
+
+	if ( !packed ) {
+		std::vector<Sizei> sizes;
+		Int64 minArea = 0;
+		Sizei size( eemin( 128, mMaxSize.getWidth() ), eemin( 128, mMaxSize.getHeight() ) );
+
+		for ( const auto& t : texs )
+			minArea += (Int64)( t->width() + mPixelBorder ) * ( t->height() + mPixelBorder );
+
+		while ( true ) {
+			bool isMaxSize = size.getWidth() >= mMaxSize.getWidth() &&
+							 size.getHeight() >= mMaxSize.getHeight();
+
+			if ( isMaxSize || (Int64)size.getWidth() * size.getHeight() >= minArea )
+				sizes.push_back( size );
+
+			if ( isMaxSize )
+				break;
+
+			if ( ( size.getWidth() <= size.getHeight() && size.getWidth() < mMaxSize.getWidth() ) ||
+				 size.getHeight() >= mMaxSize.getHeight() ) {
+				size.x = eemin( size.getWidth() * 2, mMaxSize.getWidth() );
+			} else {
+				size.y = eemin( size.getHeight() * 2, mMaxSize.getHeight() );
+			}
+		}
+
+		// Every candidate atlas size is packed concurrently, the smallest one that fits all the
+		// images wins. The candidates that can't win stop at the first image that doesn't fit.
+		std::vector<std::vector<sTextureRegionHdr>> trials( sizes.size() );
+		std::vector<Uint32> trialsPlaced( sizes.size(), 0 );
+
+		parallelFor( sizes.size(), [&]( size_t i ) {
+			trialsPlaced[i] = packBin( sizes[i], texs, trials[i], i + 1 < sizes.size() );
+		} );
+
+		size_t best = sizes.size() - 1;
+
+		for ( size_t i = 0; i < sizes.size(); i++ ) {
+			if ( trialsPlaced[i] == texs.size() ) {
+				best = i;
+				break;
+			}
+		}
+
+		placements.swap( trials[best] );
+		mWidth = sizes[best].getWidth();
+		mHeight = sizes[best].getHeight();
+	}
+
+	mCount = (Int32)texs.size();
+	mTotalArea = 0;
+
+	for ( size_t i = 0; i < texs.size(); i++ ) {
+		if ( placements[i].Width > 0 ) {
+			texs[i]->place( placements[i].X, placements[i].Y,
+							0 != ( placements[i].Flags & HDR_TEXTUREREGION_FLAG_FLIPED ) );
+			mTotalArea += texs[i]->area();
+			mCount--;
+		}
+	}
+
+	if ( mCount > 0 ) {
+		if ( mAllowChilds ) {
+			Log::debug( "Creating a new image as a child. Some textures couldn't get it: %d",
+						mCount );
+			createBinChild();
+		} else {
+			return 0;
+		}
+	}
+
+	mPacked = true;
+
+	Log::debug( "Total Area Used: %d. This represents the %4.3f percent", mTotalArea,
+				( (double)mTotalArea / (double)( mWidth * mHeight ) ) * 100.0 );
+
+	return mTotalArea;
+}
+
+Uint32 TexturePacker::packBin( const Sizei& size, const std::vector<TexturePackerTex*>& texs,
+							   std::vector<sTextureRegionHdr>& placements,
+							   const bool& stopOnFailure ) const {
+	Uint32 placed = 0;
+	Int32 x = 0;
+	Int32 y = 0;
+	bool flipped = false;
+
+	// Only the position, size and flipping of the placements are used.
+	placements.assign( texs.size(), sTextureRegionHdr() );
+
+	auto setPlacement = [&]( const size_t& i ) {
+		placements[i].X = x;
+		placements[i].Y = y;
+		placements[i].Width = texs[i]->width();
+		placements[i].Height = texs[i]->height();
+		placements[i].Flags = flipped ? HDR_TEXTUREREGION_FLAG_FLIPED : 0;
+		placed++;
+	};
+
+	if ( PackingHeuristic::SkylineBottomLeft == mHeuristic && mReused.empty() ) {
+		TexturePackerSkyline bin( size.getWidth(), size.getHeight(), mAllowFlipping );
+
+		for ( size_t i = 0; i < texs.size(); i++ ) {
+			if ( bin.insert( texs[i]->width() + mPixelBorder, texs[i]->height() + mPixelBorder, x,
+							 y, flipped ) ) {
+				setPlacement( i );
+			} else if ( stopOnFailure ) {
+				break;
+			}
+		}
+
+		return placed;
+	}
+
+	TexturePackerMaxRects bin( size.getWidth(), size.getHeight(), mAllowFlipping );
+	TexturePackerMaxRects::Heuristic heuristic = toMaxRectsHeuristic( mHeuristic );
+
+	// The images kept from the previous atlas are placed first, in the same position.
+	for ( size_t i = 0; i < texs.size() && !mReused.empty(); i++ ) {
+		auto reused = mReused.find( texs[i] );
+
+		if ( reused == mReused.end() )
+			continue;
+
+		const sTextureRegionHdr& region = reused->second;
+		flipped = 0 != ( region.Flags & HDR_TEXTUREREGION_FLAG_FLIPED );
+		x = region.X;
+		y = region.Y;
+
+		if ( !bin.occupy( x, y, ( flipped ? region.Height : region.Width ) + mPixelBorder,
+						  ( flipped ? region.Width : region.Height ) + mPixelBorder ) )
+			return placed;
+
+		setPlacement( i );
+	}
+
+	for ( size_t i = 0; i < texs.size(); i++ ) {
+		if ( placements[i].Width > 0 )
+			continue;
+
+		if ( bin.insert( texs[i]->width() + mPixelBorder, texs[i]->height() + mPixelBorder,
+						 heuristic, x, y, flipped ) ) {
+			setPlacement( i );
+		} else if ( stopOnFailure ) {
+			break;
+		}
+	}
+
+	return placed;
+}
+
+void TexturePacker::matchPreviousRegions( const std::vector<TexturePackerTex*>& texs ) {
+	mReused.clear();
+
+	for ( TexturePackerTex* t : texs ) {
+		// Only the images read from files have a content hash to compare.
+		if ( NULL != t->getImage() || t->hash().size() != HDR_HASH_SIZE )
+			continue;
+
+		std::string name( FileSystem::fileNameFromPath( t->name() ) );
+
+		if ( name.size() > HDR_NAME_SIZE )
+			name.resize( HDR_NAME_SIZE );
+
+		auto it = mPreviousRegions.find( name );
+
+		if ( it == mPreviousRegions.end() )
+			continue;
+
+		const sTextureRegionHdr& region = it->second;
+
+		if ( region.Width == t->width() && region.Height == t->height() &&
+			 region.OffsetX == t->offsetX() && region.OffsetY == t->offsetY() &&
+			 region.Channels == t->channels() &&
+			 ( mAllowFlipping || 0 == ( region.Flags & HDR_TEXTUREREGION_FLAG_FLIPED ) ) &&
+			 0 == memcmp( region.Hash, t->hash().data(), HDR_HASH_SIZE ) )
+			mReused[t] = region;
+	}
+}
+
+void TexturePacker::createBinChild() {
+	mChild = TexturePacker::New( mMaxSize.getWidth(), mMaxSize.getHeight(), mPixelDensity / 100.f,
+								 mForcePowOfTwo, mScalableSVG, mPixelBorder, mTextureFilter,
+								 mAllowChilds, mAllowFlipping );
+	mChild->mParent = this;
+
+	copySettings( mChild );
+
+	// The images that didn't fit are moved to the child as they are ( already trimmed and hashed ).
+	for ( auto it = mTextures.begin(); it != mTextures.end(); ) {
+		if ( !( *it )->placed() ) {
+			mChild->mTotalArea += ( *it )->area();
+			mChild->mTextures.push_back( *it );
+			it = mTextures.erase( it );
+		} else {
+			++it;
+		}
+	}
+
+	mCount = 0;
+
+	mChild->packTextures();
+}
+
+void TexturePacker::copySettings( TexturePacker* packer ) const {
+	packer->mHeuristic = mHeuristic;
+	packer->mThreadCount = mThreadCount;
+	packer->mTrim = mTrim;
+}
+
+Int32 TexturePacker::packGuillotine() {
 	TexturePackerTex* t = NULL;
 
 	addBorderToTextures( (Int32)mPixelBorder );
@@ -542,7 +1020,7 @@ Int32 TexturePacker::packTextures() {
 				reset();
 				addBorderToTextures( -( (Int32)mPixelBorder ) );
 				mStrategy = PackTiny;
-				return packTextures();
+				return packGuillotine();
 			} else if ( PackTiny == mStrategy ) {
 				mStrategy = PackFail;
 				Log::warning( "TexturePacker: Strategy fail, must expand image or create a new "
@@ -571,7 +1049,7 @@ Int32 TexturePacker::packTextures() {
 						mHeight = mMaxSize.getHeight();
 				}
 
-				return packTextures();
+				return packGuillotine();
 			} else {
 				if ( !mAllowChilds ) {
 					return 0;
@@ -622,49 +1100,67 @@ void TexturePacker::save( const std::string& Filepath, const Image::SaveType& Fo
 
 	Img.fillWithColor( Color( 0, 0, 0, 0 ) );
 
-	TexturePackerTex* t = NULL;
-	std::list<TexturePackerTex*>::iterator it;
-
-	for ( it = mTextures.begin(); it != mTextures.end(); ++it ) {
-		t = ( *it );
+	std::vector<TexturePackerTex*> placed;
 
-		if ( t->placed() ) {
-			Uint8* data;
+	for ( const auto& t : mTextures ) {
+		if ( t->placed() )
+			placed.push_back( t );
+	}
 
-			if ( NULL == t->getImage() ) {
-				Image imageLoaded( t->name() );
+	// The images that kept its placement are copied from the previous atlas image.
+	Image* previousAtlas = NULL;
 
-				if ( NULL != imageLoaded.getPixelsPtr() &&
-					 t->width() == (int)imageLoaded.getWidth() &&
-					 t->height() == (int)imageLoaded.getHeight() ) {
-					if ( t->flipped() )
-						imageLoaded.flip();
+	if ( !mReused.empty() )
+		previousAtlas = Image::New( mPreviousImagePath, getAtlasNumChannels() );
 
-					Img.copyImage( &imageLoaded, t->x(), t->y() );
+	std::atomic<Int32> placedCount( 0 );
 
-					mPlacedCount++;
-				}
-			} else {
-				data = t->getImage()->getPixels();
+	// Every image is decoded and copied concurrently, each one writes to its own atlas area.
+	parallelFor( placed.size(), [&]( size_t i ) {
+		TexturePackerTex* t = placed[i];
+		auto reused = mReused.find( t );
 
-				if ( NULL != data ) {
-					if ( t->flipped() )
-						t->getImage()->flip();
+		if ( NULL == t->getImage() && t->hash().empty() )
+			t->hash( MD5::fromFile( t->name() ).digest );
 
-					Img.copyImage( t->getImage(), t->x(), t->y() );
+		if ( reused != mReused.end() && NULL != previousAtlas ) {
+			Int32 width = t->flipped() ? t->height() : t->width();
+			Int32 height = t->flipped() ? t->width() : t->height();
+			Image* region = previousAtlas->crop(
+				Rect( reused->second.X, reused->second.Y, reused->second.X + width,
+					  reused->second.Y + height ) );
 
-					mPlacedCount++;
-				}
+			if ( NULL != region ) {
+				Img.copyImage( region, t->x(), t->y() );
+				eeSAFE_DELETE( region );
+				placedCount++;
+				return;
 			}
 		}
-	}
 
+		if ( NULL == t->getImage() ) {
+			Image imageLoaded( t->name(), 0, t->formatConfiguration() );
+
+			if ( copyToAtlas( Img, t, &imageLoaded ) )
+				placedCount++;
+		} else if ( copyToAtlas( Img, t, t->getImage() ) ) {
+			placedCount++;
+		}
+	} );
+
+	eeSAFE_DELETE( previousAtlas );
+
+	mPlacedCount += placedCount;
 	mFormat = Format;
 
-	Img.saveToFile( Filepath, Format );
+	// The atlas image is encoded while the child atlases are composed.
+	Thread encoder( [&] { Img.saveToFile( Filepath, Format ); } );
+	encoder.launch();
 
 	childSave( Format );
 
+	encoder.wait();
+
 	saveTextureRegions();
 }
 
@@ -764,17 +1260,22 @@ void TexturePacker::createTextureRegionsHdr( TexturePacker* Packer,
 			tTextureRegionHdr.Width = tTex->width();
 			tTextureRegionHdr.Height = tTex->height();
 			tTextureRegionHdr.Channels = tTex->channels();
-			tTextureRegionHdr.DestWidth = tTex->width();
-			tTextureRegionHdr.DestHeight = tTex->height();
-			tTextureRegionHdr.OffsetX = 0;
-			tTextureRegionHdr.OffsetY = 0;
+			tTextureRegionHdr.DestWidth = tTex->destWidth();
+			tTextureRegionHdr.DestHeight = tTex->destHeight();
+			tTextureRegionHdr.OffsetX = tTex->offsetX();
+			tTextureRegionHdr.OffsetY = tTex->offsetY();
 			tTextureRegionHdr.X = tTex->x();
 			tTextureRegionHdr.Y = tTex->y();
 			tTextureRegionHdr.Date = FileSystem::fileGetModificationDate( tTex->name() );
 			tTextureRegionHdr.Flags = 0;
 			tTextureRegionHdr.PixelDensity = mPixelDensity;
-			MD5::Result md5Result = MD5::fromFile( tTex->name() );
-			memcpy( tTextureRegionHdr.Hash, &md5Result.digest[0], HDR_HASH_SIZE );
+
+			if ( tTex->hash().empty() )
+				tTex->hash( MD5::fromFile( tTex->name() ).digest );
+
+			memset( tTextureRegionHdr.Hash, 0, HDR_HASH_SIZE );
+			memcpy( tTextureRegionHdr.Hash, tTex->hash().data(),
+					eemin<size_t>( HDR_HASH_SIZE, tTex->hash().size() ) );
 
 			if ( tTex->flipped() )
 				tTextureRegionHdr.Flags |= HDR_TEXTUREREGION_FLAG_FLIPED;
@@ -853,4 +1354,78 @@ const Int32& TexturePacker::getPlacedCount() const {
 	return mPlacedCount;
 }
 
+void TexturePacker::setPackingHeuristic( const PackingHeuristic& heuristic ) {
+	mHeuristic = heuristic;
+}
+
+const TexturePacker::PackingHeuristic& TexturePacker::getPackingHeuristic() const {
+	return mHeuristic;
+}
+
+void TexturePacker::setThreadCount( const Uint32& threadCount ) {
+	if ( threadCount != mThreadCount ) {
+		mThreadCount = threadCount;
+		mThreadPool.reset();
+	}
+}
+
+const Uint32& TexturePacker::getThreadCount() const {
+	return mThreadCount;
+}
+
+void TexturePacker::setTrimTransparentBorders( const bool& trim ) {
+	mTrim = trim;
+}
+
+const bool& TexturePacker::getTrimTransparentBorders() const {
+	return mTrim;
+}
+
+bool TexturePacker::setPreviousTextureAtlas( const std::string& textureAtlasPath ) {
+	IOStreamFile fs( textureAtlasPath );
+	sTextureAtlasHdr atlasHdr;
+	sTextureHdr textureHdr;
+
+	mPreviousRegions.clear();
+
+	if ( !fs.isOpen() ||
+		 fs.read( reinterpret_cast<char*>( &atlasHdr ), sizeof( sTextureAtlasHdr ) ) !=
+			 sizeof( sTextureAtlasHdr ) ||
+		 atlasHdr.Magic != EE_TEXTURE_ATLAS_MAGIC || atlasHdr.TextureCount < 1 ||
+		 atlasHdr.PixelBorder != (Uint32)mPixelBorder ||
+		 fs.read( reinterpret_cast<char*>( &textureHdr ), sizeof( sTextureHdr ) ) !=
+			 sizeof( sTextureHdr ) )
+		return false;
+
+	std::string imagePath( FileSystem::fileRemoveExtension( textureAtlasPath ) + "." +
+						   Image::saveTypeToExtension( atlasHdr.Format ) );
+
+	if ( !FileSystem::fileExists( imagePath ) )
+		return false;
+
+	std::vector<sTextureRegionHdr> regions( eemax( 0, textureHdr.TextureRegionCount ) );
+	ios_size size = sizeof( sTextureRegionHdr ) * (ios_size)regions.size();
+
+	if ( !regions.empty() && fs.read( reinterpret_cast<char*>( &regions[0] ), size ) != size )
+		return false;
+
+	for ( const auto& region : regions ) {
+		std::string name( region.Name, strnlen( region.Name, HDR_NAME_SIZE ) );
+		mPreviousRegions[name] = region;
+	}
+
+	mPreviousImagePath = imagePath;
+	mPreviousSize = Sizei( atlasHdr.Width, atlasHdr.Height );
+
+	return !mPreviousRegions.empty();
+}
+
+Uint32 TexturePacker::getReusedCount() const {
+	return (Uint32)mReused.size();
+}
+
+Float TexturePacker::getOccupancy() const {
+	return mWidth > 0 && mHeight > 0 ? (Float)mTotalArea / ( (Float)mWidth * mHeight ) : 0.f;
+}
+
 }} // namespace EE::Graphics
@@ -0,0 +1,175 @@
+#include <eepp/graphics/texturepackermaxrects.hpp>
+
+namespace EE { namespace Graphics { namespace Private {
+
+static inline bool areaContains( const Int32& x, const Int32& y, const Int32& width,
+								 const Int32& height, const Int32& ox, const Int32& oy,
+								 const Int32& owidth, const Int32& oheight ) {
+	return ox >= x && oy >= y && ox + owidth <= x + width && oy + oheight <= y + height;
+}
+
+TexturePackerMaxRects::TexturePackerMaxRects( const Int32& width, const Int32& height,
+											  const bool& allowFlipping ) :
+	mWidth( width ), mHeight( height ), mAllowFlipping( allowFlipping ) {
+	mFree.push_back( {0, 0, width, height} );
+}
+
+void TexturePackerMaxRects::score( const Area& free, const Int32& width, const Int32& height,
+								   const Heuristic& heuristic, Int32& score1,
+								   Int32& score2 ) const {
+	Int32 leftoverH = free.width - width;
+	Int32 leftoverV = free.height - height;
+	Int32 shortSide = eemin( leftoverH, leftoverV );
+	Int32 longSide = eemax( leftoverH, leftoverV );
+
+	switch ( heuristic ) {
+		case Heuristic::BestLongSideFit:
+			score1 = longSide;
+			score2 = shortSide;
+			break;
+		case Heuristic::BestAreaFit:
+			score1 = free.width * free.height - width * height;
+			score2 = shortSide;
+			break;
+		case Heuristic::BottomLeft:
+			score1 = free.y + height;
+			score2 = free.x;
+			break;
+		case Heuristic::BestShortSideFit:
+		default:
+			score1 = shortSide;
+			score2 = longSide;
+			break;
+	}
+}
+
+bool TexturePackerMaxRects::insert( const Int32& width, const Int32& height,
+									const Heuristic& heuristic, Int32& x, Int32& y,
+									bool& flipped ) {
+	Int32 bestScore1 = 0x7FFFFFFF;
+	Int32 bestScore2 = 0x7FFFFFFF;
+	Area best = {0, 0, 0, 0};
+	bool found = false;
+
+	for ( const auto& free : mFree ) {
+		Int32 score1, score2;
+
+		if ( free.width >= width && free.height >= height ) {
+			score( free, width, height, heuristic, score1, score2 );
+
+			if ( score1 < bestScore1 || ( score1 == bestScore1 && score2 < bestScore2 ) ) {
+				bestScore1 = score1;
+				bestScore2 = score2;
+				best = {free.x, free.y, width, height};
+				flipped = false;
+				found = true;
+			}
+		}
+
+		if ( mAllowFlipping && width != height && free.width >= height && free.height >= width ) {
+			score( free, height, width, heuristic, score1, score2 );
+
+			if ( score1 < bestScore1 || ( score1 == bestScore1 && score2 < bestScore2 ) ) {
+				bestScore1 = score1;
+				bestScore2 = score2;
+				best = {free.x, free.y, height, width};
+				flipped = true;
+				found = true;
+			}
+		}
+	}
+
+	if ( !found )
+		return false;
+
+	x = best.x;
+	y = best.y;
+
+	place( best );
+
+	return true;
+}
+
+bool TexturePackerMaxRects::occupy( const Int32& x, const Int32& y, const Int32& width,
+									const Int32& height ) {
+	if ( x < 0 || y < 0 || x + width > mWidth || y + height > mHeight )
+		return false;
+
+	place( {x, y, width, height} );
+
+	return true;
+}
+
+void TexturePackerMaxRects::place( const Area& used ) {
+	mNewFree.clear();
+
+	for ( size_t i = 0; i < mFree.size(); ) {
+		if ( split( mFree[i], used ) ) {
+			mFree[i] = mFree.back();
+			mFree.pop_back();
+		} else {
+			i++;
+		}
+	}
+
+	// The new free areas are parts of the areas that were split, so they can only be contained in
+	// the remaining areas, never the opposite.
+	for ( const auto& area : mNewFree ) {
+		bool contained = false;
+
+		for ( const auto& free : mFree ) {
+			if ( areaContains( free.x, free.y, free.width, free.height, area.x, area.y,
+							   area.width, area.height ) ) {
+				contained = true;
+				break;
+			}
+		}
+
+		if ( !contained )
+			mFree.push_back( area );
+	}
+}
+
+bool TexturePackerMaxRects::split( const Area& free, const Area& used ) {
+	if ( used.x >= free.x + free.width || used.x + used.width <= free.x ||
+		 used.y >= free.y + free.height || used.y + used.height <= free.y )
+		return false;
+
+	if ( used.y > free.y )
+		insertNewFree( {free.x, free.y, free.width, used.y - free.y} );
+
+	if ( used.y + used.height < free.y + free.height )
+		insertNewFree( {free.x, used.y + used.height, free.width,
+						free.y + free.height - ( used.y + used.height )} );
+
+	if ( used.x > free.x )
+		insertNewFree( {free.x, free.y, used.x - free.x, free.height} );
+
+	if ( used.x + used.width < free.x + free.width )
+		insertNewFree( {used.x + used.width, free.y, free.x + free.width - ( used.x + used.width ),
+						free.height} );
+
+	return true;
+}
+
+void TexturePackerMaxRects::insertNewFree( const Area& area ) {
+	for ( size_t i = 0; i < mNewFree.size(); ) {
+		const Area& other = mNewFree[i];
+
+		if ( areaContains( other.x, other.y, other.width, other.height, area.x, area.y,
+						   area.width, area.height ) )
+			return;
+
+		if ( areaContains( area.x, area.y, area.width, area.height, other.x, other.y,
+						   other.width, other.height ) ) {
+			mNewFree[i] = mNewFree.back();
+			mNewFree.pop_back();
+		} else {
+			i++;
+		}
+	}
+
+	mNewFree.push_back( area );
+}
+
+}}} // namespace EE::Graphics::Private
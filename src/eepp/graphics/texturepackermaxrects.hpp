@@ -0,0 +1,53 @@
+#ifndef EE_GRAPHICSPRIVATECTEXTUREPACKERMAXRECTS
+#define EE_GRAPHICSPRIVATECTEXTUREPACKERMAXRECTS
+
+#include <eepp/graphics/base.hpp>
+#include <vector>
+
+namespace EE { namespace Graphics { namespace Private {
+
+/** @brief MaxRects bin packer. Keeps the list of maximal free rectangles of the bin, every
+**	placement splits the free rectangles that it intersects and removes the ones contained in
+**	others.
+*/
+class TexturePackerMaxRects {
+  public:
+	enum class Heuristic : Uint32 { BestShortSideFit, BestLongSideFit, BestAreaFit, BottomLeft };
+
+	TexturePackerMaxRects( const Int32& width, const Int32& height, const bool& allowFlipping );
+
+	/** Finds a place for a rectangle and occupies it.
+	 * @return False if the rectangle doesn't fit in the bin. */
+	bool insert( const Int32& width, const Int32& height, const Heuristic& heuristic, Int32& x,
+				 Int32& y, bool& flipped );
+
+	/** Occupies a fixed rectangle of the bin. */
+	bool occupy( const Int32& x, const Int32& y, const Int32& width, const Int32& height );
+
+  protected:
+	struct Area {
+		Int32 x;
+		Int32 y;
+		Int32 width;
+		Int32 height;
+	};
+
+	Int32 mWidth;
+	Int32 mHeight;
+	bool mAllowFlipping;
+	std::vector<Area> mFree;
+	std::vector<Area> mNewFree;
+
+	void score( const Area& free, const Int32& width, const Int32& height,
+				const Heuristic& heuristic, Int32& score1, Int32& score2 ) const;
+
+	void place( const Area& used );
+
+	bool split( const Area& free, const Area& used );
+
+	void insertNewFree( const Area& area );
+};
+
+}}} // namespace EE::Graphics::Private
+
+#endif
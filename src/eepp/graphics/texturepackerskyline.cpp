@@ -0,0 +1,120 @@
+#include <eepp/graphics/texturepackerskyline.hpp>
+
+namespace EE { namespace Graphics { namespace Private {
+
+TexturePackerSkyline::TexturePackerSkyline( const Int32& width, const Int32& height,
+											const bool& allowFlipping ) :
+	mWidth( width ), mHeight( height ), mAllowFlipping( allowFlipping ) {
+	mSkyline.push_back( {0, 0, width} );
+}
+
+bool TexturePackerSkyline::fits( const size_t& index, const Int32& width, const Int32& height,
+								 Int32& y ) const {
+	Int32 x = mSkyline[index].x;
+
+	if ( x + width > mWidth )
+		return false;
+
+	Int32 widthLeft = width;
+	size_t i = index;
+	y = mSkyline[index].y;
+
+	while ( widthLeft > 0 && i < mSkyline.size() ) {
+		y = eemax( y, mSkyline[i].y );
+
+		if ( y + height > mHeight )
+			return false;
+
+		widthLeft -= mSkyline[i].width;
+		i++;
+	}
+
+	return widthLeft <= 0;
+}
+
+bool TexturePackerSkyline::insert( const Int32& width, const Int32& height, Int32& x, Int32& y,
+								   bool& flipped ) {
+	Int32 bestBottom = 0x7FFFFFFF;
+	Int32 bestWidth = 0x7FFFFFFF;
+	size_t bestIndex = 0;
+	Int32 bestY = 0;
+	Int32 bestW = 0;
+	Int32 bestH = 0;
+	bool found = false;
+
+	for ( size_t i = 0; i < mSkyline.size(); i++ ) {
+		Int32 segmentY;
+
+		if ( fits( i, width, height, segmentY ) &&
+			 ( segmentY + height < bestBottom ||
+			   ( segmentY + height == bestBottom && mSkyline[i].width < bestWidth ) ) ) {
+			bestBottom = segmentY + height;
+			bestWidth = mSkyline[i].width;
+			bestIndex = i;
+			bestY = segmentY;
+			bestW = width;
+			bestH = height;
+			flipped = false;
+			found = true;
+		}
+
+		if ( mAllowFlipping && width != height && fits( i, height, width, segmentY ) &&
+			 ( segmentY + width < bestBottom ||
+			   ( segmentY + width == bestBottom && mSkyline[i].width < bestWidth ) ) ) {
+			bestBottom = segmentY + width;
+			bestWidth = mSkyline[i].width;
+			bestIndex = i;
+			bestY = segmentY;
+			bestW = height;
+			bestH = width;
+			flipped = true;
+			found = true;
+		}
+	}
+
+	if ( !found )
+		return false;
+
+	x = mSkyline[bestIndex].x;
+	y = bestY;
+
+	add( bestIndex, x, y, bestW, bestH );
+
+	return true;
+}
+
+void TexturePackerSkyline::add( const size_t& index, const Int32& x, const Int32& y,
+								const Int32& width, const Int32& height ) {
+	mSkyline.insert( mSkyline.begin() + index, {x, y + height, width} );
+
+	// Shrink or remove the segments now covered by the new one.
+	for ( size_t i = index + 1; i < mSkyline.size(); ) {
+		const Segment& prev = mSkyline[i - 1];
+		Segment& cur = mSkyline[i];
+
+		if ( cur.x >= prev.x + prev.width )
+			break;
+
+		Int32 shrink = prev.x + prev.width - cur.x;
+
+		cur.x += shrink;
+		cur.width -= shrink;
+
+		if ( cur.width > 0 )
+			break;
+
+		mSkyline.erase( mSkyline.begin() + i );
+	}
+
+	// Merge the neighbour segments at the same height.
+	for ( size_t i = 0; i + 1 < mSkyline.size(); ) {
+		if ( mSkyline[i].y == mSkyline[i + 1].y ) {
+			mSkyline[i].width += mSkyline[i + 1].width;
+			mSkyline.erase( mSkyline.begin() + i + 1 );
+		} else {
+			i++;
+		}
+	}
+}
+
+}}} // namespace EE::Graphics::Private
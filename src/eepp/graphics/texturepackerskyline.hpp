@@ -0,0 +1,40 @@
+#ifndef EE_GRAPHICSPRIVATECTEXTUREPACKERSKYLINE
+#define EE_GRAPHICSPRIVATECTEXTUREPACKERSKYLINE
+
+#include <eepp/graphics/base.hpp>
+#include <vector>
+
+namespace EE { namespace Graphics { namespace Private {
+
+/** @brief Skyline bin packer. Keeps the top edge of the placed rectangles as a list of horizontal
+**	segments and places every rectangle at the bottom-left most position of the skyline.
+*/
+class TexturePackerSkyline {
+  public:
+	TexturePackerSkyline( const Int32& width, const Int32& height, const bool& allowFlipping );
+
+	/** Finds a place for a rectangle and occupies it.
+	 * @return False if the rectangle doesn't fit in the bin. */
+	bool insert( const Int32& width, const Int32& height, Int32& x, Int32& y, bool& flipped );
+
+  protected:
+	struct Segment {
+		Int32 x;
+		Int32 y;
+		Int32 width;
+	};
+
+	Int32 mWidth;
+	Int32 mHeight;
+	bool mAllowFlipping;
+	std::vector<Segment> mSkyline;
+
+	bool fits( const size_t& index, const Int32& width, const Int32& height, Int32& y ) const;
+
+	void add( const size_t& index, const Int32& x, const Int32& y, const Int32& width,
+			  const Int32& height );
+};
+
+}}} // namespace EE::Graphics::Private
+
+#endif
@@ -13,12 +13,20 @@ TexturePackerTex::TexturePackerTex( const std::string& Name,
 	mY( 0 ),
 	mLongestEdge( 0 ),
 	mArea( 0 ),
+	mDestWidth( 0 ),
+	mDestHeight( 0 ),
+	mOffsetX( 0 ),
+	mOffsetY( 0 ),
 	mFlipped( false ),
 	mPlaced( false ),
 	mLoadedInfo( false ),
 	mDisabled( false ),
-	mImg( NULL ) {
+	mTrimmed( false ),
+	mImg( NULL ),
+	mFormatConfiguration( imageFormatConfiguration ) {
 	if ( Image::getInfo( Name.c_str(), &mWidth, &mHeight, &mChannels, imageFormatConfiguration ) ) {
+		mDestWidth = mWidth;
+		mDestHeight = mHeight;
 		mArea = mWidth * mHeight;
 		mLongestEdge = ( mWidth >= mHeight ) ? mWidth : mHeight;
 		mLoadedInfo = true;
@@ -34,10 +42,15 @@ TexturePackerTex::TexturePackerTex( EE::Graphics::Image* Img, const std::string&
 	mY( 0 ),
 	mLongestEdge( 0 ),
 	mArea( 0 ),
+	mDestWidth( mWidth ),
+	mDestHeight( mHeight ),
+	mOffsetX( 0 ),
+	mOffsetY( 0 ),
 	mFlipped( false ),
 	mPlaced( false ),
 	mLoadedInfo( false ),
 	mDisabled( false ),
+	mTrimmed( false ),
 	mImg( Img ) {
 	mArea = mWidth * mHeight;
 	mLongestEdge = ( mWidth >= mHeight ) ? mWidth : mHeight;
@@ -53,6 +66,17 @@ void TexturePackerTex::place( Int32 x, Int32 y, bool flipped ) {
 	}
 }
 
+void TexturePackerTex::trim( const Int32& x, const Int32& y, const Int32& width,
+							 const Int32& height ) {
+	mOffsetX = x;
+	mOffsetY = y;
+	mWidth = mDestWidth = width;
+	mHeight = mDestHeight = height;
+	mArea = mWidth * mHeight;
+	mLongestEdge = ( mWidth >= mHeight ) ? mWidth : mHeight;
+	mTrimmed = true;
+}
+
 EE::Graphics::Image* TexturePackerTex::getImage() const {
 	return mImg;
 }
@@ -3,6 +3,7 @@
 
 #include <eepp/graphics/base.hpp>
 #include <eepp/graphics/image.hpp>
+#include <vector>
 
 namespace EE { namespace Graphics {
 
@@ -69,7 +70,22 @@ class TexturePackerTex {
 
 	inline void offsetX( const Int32& offx ) { mOffsetX = offx; }
 
-	inline void offsetY( const Int32& offy ) { mDestHeight = offy; }
+	inline void offsetY( const Int32& offy ) { mOffsetY = offy; }
+
+	/** Trims the image to a sub-rectangle of the source image, the offset and destination size of
+	 * the texture region are the trimmed ones. */
+	void trim( const Int32& x, const Int32& y, const Int32& width, const Int32& height );
+
+	inline const bool& trimmed() const { return mTrimmed; }
+
+	/** @return The MD5 of the image file ( empty if it was not calculated ). */
+	inline const std::vector<Uint8>& hash() const { return mHash; }
+
+	inline void hash( const std::vector<Uint8>& hash ) { mHash = hash; }
+
+	inline const Image::FormatConfiguration& formatConfiguration() const {
+		return mFormatConfiguration;
+	}
 
 	EE::Graphics::Image* getImage() const;
 
@@ -90,7 +106,10 @@ class TexturePackerTex {
 	bool mPlaced;
 	bool mLoadedInfo;
 	bool mDisabled;
+	bool mTrimmed;
 	EE::Graphics::Image* mImg;
+	Image::FormatConfiguration mFormatConfiguration;
+	std::vector<Uint8> mHash;
 };
 
 } // namespace Private
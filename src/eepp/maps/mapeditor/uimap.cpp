@@ -114,6 +114,8 @@ void UIMap::scheduledUpdate( const Time& time ) {
 
 		mMap->update();
 
+		mSceneNode->setUpdateDeadline( Time::Zero );
+
 		if ( mEnabled && mVisible && isMouseOver() ) {
 			Uint32 Flags = getEventDispatcher()->getClickTrigger();
 
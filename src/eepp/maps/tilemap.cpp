@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <tuple>
 #include <eepp/maps/gameobjectobject.hpp>
 #include <eepp/maps/gameobjectpolygon.hpp>
 #include <eepp/maps/gameobjectpolyline.hpp>
@@ -7,6 +11,7 @@
 #include <eepp/maps/gameobjectvirtual.hpp>
 #include <eepp/maps/mapobjectlayer.hpp>
 #include <eepp/maps/tilemap.hpp>
+#include <eepp/maps/tilemapchunkstreamer.hpp>
 #include <eepp/maps/tilemaplayer.hpp>
 
 #include <eepp/graphics/globalbatchrenderer.hpp>
@@ -15,6 +20,7 @@
 #include <eepp/graphics/renderer/renderer.hpp>
 #include <eepp/graphics/textureatlasloader.hpp>
 #include <eepp/graphics/textureatlasmanager.hpp>
+#include <eepp/system/iostreamstring.hpp>
 #include <eepp/system/packmanager.hpp>
 #include <eepp/system/virtualfilesystem.hpp>
 using namespace EE::Graphics;
@@ -44,7 +50,13 @@ TileMap::TileMap() :
 	mScale( 1 ),
 	mOffscale( 1, 1 ),
 	mLastObjId( 0 ),
-	mForcedHeaders( NULL ) {
+	mForcedHeaders( NULL ),
+	mChunkSize( MAP_DEFAULT_CHUNK_SIZE ),
+	mChunked( false ),
+	mChunkCompression( true ),
+	mStreamingDistance( 1 ),
+	mStreamer( NULL ),
+	mPendingChunks( 0 ) {
 	setViewSize( mViewSize );
 }
 
@@ -76,6 +88,13 @@ void TileMap::disableForcedHeaders() {
 }
 
 void TileMap::deleteLayers() {
+	eeSAFE_DELETE( mStreamer );
+	mChunkStates.clear();
+	mActiveChunks.clear();
+	mPendingChunks = 0;
+	mStreamingRect = Rect();
+	mStreamPath.clear();
+
 	eeSAFE_DELETE( mLightManager );
 
 	for ( Uint32 i = 0; i < mLayerCount; i++ )
@@ -100,6 +119,8 @@ void TileMap::create( Sizei Size, Uint32 MaxLayers, Sizei TileSize, Uint32 Flags
 	mSize = Size;
 	mTileSize = TileSize;
 	mPixelSize = Size * TileSize;
+	mChunkCount = Sizei( ( Size.x + mChunkSize - 1 ) / mChunkSize,
+						 ( Size.y + mChunkSize - 1 ) / mChunkSize );
 	mLayers = eeNewArray( MapLayer*, mMaxLayers );
 
 	if ( getLightsEnabled() )
@@ -452,6 +473,8 @@ void TileMap::update() {
 
 	updateScreenAABB();
 
+	updateStreaming();
+
 	if ( NULL != mLightManager )
 		mLightManager->update();
 
@@ -715,6 +738,10 @@ bool TileMap::moveLayerUp( MapLayer* Layer ) {
 
 	if ( Lindex != EE_MAP_LAYER_UNKNOWN && mLayerCount > 1 && ( Lindex < mLayerCount - 1 ) &&
 		 ( Lindex + 1 < mLayerCount ) ) {
+		// The streamed chunks store the tiles in the order of the tiled layers.
+		if ( Layer->getType() == MAP_LAYER_TILED )
+			stopStreaming();
+
 		MapLayer* tLayer = mLayers[Lindex + 1];
 
 		mLayers[Lindex] = tLayer;
@@ -730,6 +757,9 @@ bool TileMap::moveLayerDown( MapLayer* Layer ) {
 	Uint32 Lindex = getLayerIndex( Layer );
 
 	if ( Lindex != EE_MAP_LAYER_UNKNOWN && mLayerCount > 1 && Lindex >= 1 ) {
+		if ( Layer->getType() == MAP_LAYER_TILED )
+			stopStreaming();
+
 		MapLayer* tLayer = mLayers[Lindex - 1];
 
 		mLayers[Lindex] = tLayer;
@@ -745,6 +775,9 @@ bool TileMap::removeLayer( MapLayer* Layer ) {
 	Uint32 Lindex = getLayerIndex( Layer );
 
 	if ( Lindex != EE_MAP_LAYER_UNKNOWN ) {
+		if ( Layer->getType() == MAP_LAYER_TILED )
+			stopStreaming();
+
 		eeSAFE_DELETE( mLayers[Lindex] );
 
 		MapLayer* LastLayer = NULL;
@@ -810,12 +843,28 @@ void TileMap::setCreateGameObjectCallback( const CreateGOCb& Cb ) {
 
 bool TileMap::loadFromStream( IOStream& IOS ) {
 	sMapHdr MapHdr;
+	sMapChunkedHdr ChunkedHdr;
 	Uint32 i, z;
 
+	//! The chunks are streamed from the map file only when it's loaded from loadFromFile.
+	std::string streamPath( std::move( mStreamPath ) );
+	mStreamPath.clear();
+
 	if ( IOS.isOpen() ) {
+		ios_size start = IOS.tell();
+
 		IOS.read( (char*)&MapHdr, sizeof( sMapHdr ) );
 
-		if ( MapHdr.Magic == EE_MAP_MAGIC ) {
+		bool chunked = MapHdr.Magic == EE_MAP_CHUNKED_MAGIC;
+
+		if ( chunked ) {
+			IOS.read( (char*)&ChunkedHdr, sizeof( sMapChunkedHdr ) );
+
+			if ( ChunkedHdr.Version != MAP_CHUNKED_VERSION )
+				return false;
+		}
+
+		if ( MapHdr.Magic == EE_MAP_MAGIC || chunked ) {
 			if ( NULL == mForcedHeaders ) {
 				create( Sizei( MapHdr.SizeX, MapHdr.SizeY ), MapHdr.MaxLayers,
 						Sizei( MapHdr.TileSizeX, MapHdr.TileSizeY ), MapHdr.Flags );
@@ -824,6 +873,15 @@ bool TileMap::loadFromStream( IOStream& IOS ) {
 						mForcedHeaders->TileSize, mForcedHeaders->Flags );
 			}
 
+			mChunked = chunked;
+
+			if ( chunked ) {
+				setChunkSize( ChunkedHdr.ChunkSize );
+
+				if ( mChunkSize != ChunkedHdr.ChunkSize )
+					return false;
+			}
+
 			setBaseColor( Color( MapHdr.BaseColor ) );
 
 			//! Load Properties
@@ -941,7 +999,7 @@ bool TileMap::loadFromStream( IOStream& IOS ) {
 					mSize = Sizei( MapHdr.SizeX, MapHdr.SizeY );
 				}
 
-				if ( ThereIsTiled ) {
+				if ( ThereIsTiled && !chunked ) {
 					//! First we read the tiled layers.
 					for ( y = 0; y < mSize.y; y++ ) {
 						for ( x = 0; x < mSize.x; x++ ) {
@@ -1063,6 +1121,16 @@ bool TileMap::loadFromStream( IOStream& IOS ) {
 				eeSAFE_DELETE_ARRAY( tLayersHdr );
 			}
 
+			//! The tiles of the chunked maps are loaded on demand
+			if ( chunked ) {
+				if ( !createStreamer( IOS, start, ChunkedHdr, streamPath ) )
+					return false;
+
+				//! A resized map can't be streamed, the chunks don't match the map chunks.
+				if ( NULL != mForcedHeaders )
+					stopStreaming();
+			}
+
 			onMapLoaded();
 
 			mPolyObjs.clear();
@@ -1081,6 +1149,7 @@ const std::string& TileMap::getPath() const {
 bool TileMap::loadFromFile( const std::string& path ) {
 	if ( FileSystem::fileExists( path ) ) {
 		mPath = path;
+		mStreamPath = path;
 
 		IOStreamFile IOS( mPath );
 
@@ -1117,12 +1186,25 @@ bool TileMap::loadFromMemory( const char* Data, const Uint32& DataSize ) {
 	return loadFromStream( IOS );
 }
 
-void TileMap::saveToStream( IOStream& IOS ) {
-	Uint32 i;
-	sMapHdr MapHdr;
-	MapLayer* tLayer;
+static void fillTileHeader( GameObject* tObj, sMapTileGOHdr& tTGOHdr ) {
+	//! The DataId should be the TextureRegion hash name ( at least in the cases of type
+	//! TextureRegion, TextureRegionEx and Sprite.
+	tTGOHdr.Id = tObj->getDataId();
 
-	std::vector<std::string> TextureAtlases = getTextureAtlases();
+	//! If the object type is virtual, means that the real type is stored elsewhere.
+	if ( tObj->getType() != GAMEOBJECT_TYPE_VIRTUAL ) {
+		tTGOHdr.Type = tObj->getType();
+	} else {
+		GameObjectVirtual* tObjV = reinterpret_cast<GameObjectVirtual*>( tObj );
+
+		tTGOHdr.Type = tObjV->getRealType();
+	}
+
+	tTGOHdr.Flags = tObj->getFlags();
+}
+
+sMapHdr TileMap::createMapHeader( const std::vector<std::string>& TextureAtlases ) {
+	sMapHdr MapHdr;
 
 	MapHdr.Magic = EE_MAP_MAGIC;
 	MapHdr.Flags = mFlags;
@@ -1144,92 +1226,229 @@ void TileMap::saveToStream( IOStream& IOS ) {
 	else
 		MapHdr.LightsCount = 0;
 
-	if ( IOS.isOpen() ) {
-		//! Writes the map header
-		IOS.write( (const char*)&MapHdr, sizeof( sMapHdr ) );
+	return MapHdr;
+}
+
+void TileMap::writeHeaders( IOStream& IOS, std::vector<std::string>& TextureAtlases ) {
+	Uint32 i;
+	MapLayer* tLayer;
+
+	//! Writes the properties of the map
+	for ( TileMap::PropertiesMap::iterator it = mProperties.begin(); it != mProperties.end();
+		  ++it ) {
+		sPropertyHdr tProp;
 
-		//! Writes the properties of the map
-		for ( TileMap::PropertiesMap::iterator it = mProperties.begin(); it != mProperties.end();
-			  ++it ) {
+		memset( tProp.Name, 0, MAP_PROPERTY_SIZE );
+		memset( tProp.Value, 0, MAP_PROPERTY_SIZE );
+
+		String::strCopy( tProp.Name, it->first.c_str(), MAP_PROPERTY_SIZE );
+		String::strCopy( tProp.Value, it->second.c_str(), MAP_PROPERTY_SIZE );
+
+		IOS.write( (const char*)&tProp, sizeof( sPropertyHdr ) );
+	}
+
+	//! Writes the texture atlases that the map will need and load
+	for ( i = 0; i < TextureAtlases.size(); i++ ) {
+		sMapTextureAtlas tSG;
+
+		memset( tSG.Path, 0, MAP_TEXTUREATLAS_PATH_SIZE );
+
+		if ( !mPath.empty() &&
+			 String::startsWith( TextureAtlases[i], FileSystem::fileRemoveFileName( mPath ) ) ) {
+			TextureAtlases[i] =
+				TextureAtlases[i].substr( FileSystem::fileRemoveFileName( mPath ).size() );
+		}
+
+		String::strCopy( tSG.Path, TextureAtlases[i].c_str(), MAP_TEXTUREATLAS_PATH_SIZE );
+
+		IOS.write( (const char*)&tSG, sizeof( sMapTextureAtlas ) );
+	}
+
+	//! Writes the names of the virtual object types created in the map editor
+	for ( GOTypesList::iterator votit = mObjTypes.begin(); votit != mObjTypes.end(); ++votit ) {
+		sVirtualObj tVObjH;
+
+		memset( tVObjH.Name, 0, MAP_PROPERTY_SIZE );
+
+		String::strCopy( tVObjH.Name, ( *votit ).c_str(), MAP_PROPERTY_SIZE );
+
+		IOS.write( (const char*)&tVObjH, sizeof( sVirtualObj ) );
+	}
+
+	//! Writes every layer header
+	for ( i = 0; i < mLayerCount; i++ ) {
+		tLayer = mLayers[i];
+		sLayerHdr tLayerH;
+
+		memset( tLayerH.Name, 0, LAYER_NAME_SIZE );
+
+		String::strCopy( tLayerH.Name, tLayer->getName().c_str(), LAYER_NAME_SIZE );
+
+		tLayerH.Type = tLayer->getType();
+		tLayerH.Flags = tLayer->getFlags();
+		tLayerH.OffsetX = tLayer->getOffset().x;
+		tLayerH.OffsetY = tLayer->getOffset().y;
+
+		if ( MAP_LAYER_OBJECT == tLayerH.Type )
+			tLayerH.ObjectCount = reinterpret_cast<MapObjectLayer*>( tLayer )->getObjectCount();
+		else
+			tLayerH.ObjectCount = 0;
+
+		MapLayer::PropertiesMap& tLayerProp = tLayer->getProperties();
+
+		tLayerH.PropertyCount = tLayerProp.size();
+
+		//! Writes the layer header
+		IOS.write( (const char*)&tLayerH, sizeof( sLayerHdr ) );
+
+		//! Writes the properties of the current layer
+		for ( MapLayer::PropertiesMap::iterator lit = tLayerProp.begin(); lit != tLayerProp.end();
+			  ++lit ) {
 			sPropertyHdr tProp;
 
 			memset( tProp.Name, 0, MAP_PROPERTY_SIZE );
 			memset( tProp.Value, 0, MAP_PROPERTY_SIZE );
 
-			String::strCopy( tProp.Name, it->first.c_str(), MAP_PROPERTY_SIZE );
-			String::strCopy( tProp.Value, it->second.c_str(), MAP_PROPERTY_SIZE );
+			String::strCopy( tProp.Name, ( *lit ).first.c_str(), MAP_PROPERTY_SIZE );
+			String::strCopy( tProp.Value, ( *lit ).second.c_str(), MAP_PROPERTY_SIZE );
 
 			IOS.write( (const char*)&tProp, sizeof( sPropertyHdr ) );
 		}
+	}
+}
+
+void TileMap::writeObjectLayers( IOStream& IOS ) {
+	MapLayer* tLayer;
+	MapObjectLayer* tOLayer;
+	GameObject* tObj;
 
-		//! Writes the texture atlases that the map will need and load
-		for ( i = 0; i < TextureAtlases.size(); i++ ) {
-			sMapTextureAtlas tSG;
+	for ( Uint32 i = 0; i < mLayerCount; i++ ) {
+		tLayer = mLayers[i];
 
-			memset( tSG.Path, 0, MAP_TEXTUREATLAS_PATH_SIZE );
+		if ( NULL != tLayer && tLayer->getType() == MAP_LAYER_OBJECT ) {
+			tOLayer = reinterpret_cast<MapObjectLayer*>( tLayer );
 
-			if ( !mPath.empty() && String::startsWith( TextureAtlases[i],
-													   FileSystem::fileRemoveFileName( mPath ) ) ) {
-				TextureAtlases[i] =
-					TextureAtlases[i].substr( FileSystem::fileRemoveFileName( mPath ).size() );
-			}
+			MapObjectLayer::ObjList ObjList = tOLayer->getObjectList();
 
-			String::strCopy( tSG.Path, TextureAtlases[i].c_str(), MAP_TEXTUREATLAS_PATH_SIZE );
+			for ( MapObjectLayer::ObjList::iterator MapObjIt = ObjList.begin();
+				  MapObjIt != ObjList.end(); ++MapObjIt ) {
+				tObj = ( *MapObjIt );
 
-			IOS.write( (const char*)&tSG, sizeof( sMapTextureAtlas ) );
-		}
+				sMapObjGOHdr tOGOHdr;
 
-		//! Writes the names of the virtual object types created in the map editor
-		for ( GOTypesList::iterator votit = mObjTypes.begin(); votit != mObjTypes.end(); ++votit ) {
-			sVirtualObj tVObjH;
+				//! The DataId should be the TextureRegion hash name ( at least in the cases of
+				//! type TextureRegion, TextureRegionEx and Sprite. And for the Poly Obj should
+				//! be an arbitrary value assigned by the map on the moment of creation
+				tOGOHdr.Id = tObj->getDataId();
 
-			memset( tVObjH.Name, 0, MAP_PROPERTY_SIZE );
+				//! If the object type is virtual, means that the real type is stored elsewhere.
+				if ( tObj->getType() != GAMEOBJECT_TYPE_VIRTUAL ) {
+					tOGOHdr.Type = tObj->getType();
+				} else {
+					GameObjectVirtual* tObjV = reinterpret_cast<GameObjectVirtual*>( tObj );
 
-			String::strCopy( tVObjH.Name, ( *votit ).c_str(), MAP_PROPERTY_SIZE );
+					tOGOHdr.Type = tObjV->getRealType();
+				}
 
-			IOS.write( (const char*)&tVObjH, sizeof( sVirtualObj ) );
-		}
+				tOGOHdr.Flags = tObj->getFlags();
 
-		//! Writes every layer header
-		for ( i = 0; i < mLayerCount; i++ ) {
-			tLayer = mLayers[i];
-			sLayerHdr tLayerH;
+				tOGOHdr.PosX = (Int32)tObj->getPosition().x;
+
+				tOGOHdr.PosY = (Int32)tObj->getPosition().y;
+
+				IOS.write( (const char*)&tOGOHdr, sizeof( sMapObjGOHdr ) );
 
-			memset( tLayerH.Name, 0, LAYER_NAME_SIZE );
+				//! For the polygon objects wee need to write the polygon points, the Name, the
+				//! TypeName and the Properties.
+				if ( tObj->getType() == GAMEOBJECT_TYPE_OBJECT ||
+					 tObj->getType() == GAMEOBJECT_TYPE_POLYGON ||
+					 tObj->getType() == GAMEOBJECT_TYPE_POLYLINE ) {
+					GameObjectObject* tObjObj = reinterpret_cast<GameObjectObject*>( tObj );
+					Polygon2f tPoly = tObjObj->getPolygon();
+					GameObjectObject::PropertiesMap tObjObjProp = tObjObj->getProperties();
+					sMapObjObjHdr tObjObjHdr;
 
-			String::strCopy( tLayerH.Name, tLayer->getName().c_str(), LAYER_NAME_SIZE );
+					memset( tObjObjHdr.Name, 0, MAP_PROPERTY_SIZE );
+					memset( tObjObjHdr.Type, 0, MAP_PROPERTY_SIZE );
 
-			tLayerH.Type = tLayer->getType();
-			tLayerH.Flags = tLayer->getFlags();
-			tLayerH.OffsetX = tLayer->getOffset().x;
-			tLayerH.OffsetY = tLayer->getOffset().y;
+					String::strCopy( tObjObjHdr.Name, tObjObj->getName().c_str(),
+									 MAP_PROPERTY_SIZE );
+					String::strCopy( tObjObjHdr.Type, tObjObj->getTypeName().c_str(),
+									 MAP_PROPERTY_SIZE );
 
-			if ( MAP_LAYER_OBJECT == tLayerH.Type )
-				tLayerH.ObjectCount = reinterpret_cast<MapObjectLayer*>( tLayer )->getObjectCount();
-			else
-				tLayerH.ObjectCount = 0;
+					tObjObjHdr.PointCount = tPoly.getSize();
+					tObjObjHdr.PropertyCount = tObjObjProp.size();
 
-			MapLayer::PropertiesMap& tLayerProp = tLayer->getProperties();
+					//! Writes the ObjObj header
+					IOS.write( (const char*)&tObjObjHdr, sizeof( sMapObjObjHdr ) );
 
-			tLayerH.PropertyCount = tLayerProp.size();
+					//! Writes the properties of the current polygon object
+					for ( GameObjectObject::PropertiesMap::iterator ooit = tObjObjProp.begin();
+						  ooit != tObjObjProp.end(); ++ooit ) {
+						sPropertyHdr tProp;
 
-			//! Writes the layer header
-			IOS.write( (const char*)&tLayerH, sizeof( sLayerHdr ) );
+						memset( tProp.Name, 0, MAP_PROPERTY_SIZE );
+						memset( tProp.Value, 0, MAP_PROPERTY_SIZE );
 
-			//! Writes the properties of the current layer
-			for ( MapLayer::PropertiesMap::iterator lit = tLayerProp.begin();
-				  lit != tLayerProp.end(); ++lit ) {
-				sPropertyHdr tProp;
+						String::strCopy( tProp.Name, ooit->first.c_str(), MAP_PROPERTY_SIZE );
+						String::strCopy( tProp.Value, ooit->second.c_str(), MAP_PROPERTY_SIZE );
 
-				memset( tProp.Name, 0, MAP_PROPERTY_SIZE );
-				memset( tProp.Value, 0, MAP_PROPERTY_SIZE );
+						IOS.write( (const char*)&tProp, sizeof( sPropertyHdr ) );
+					}
 
-				String::strCopy( tProp.Name, ( *lit ).first.c_str(), MAP_PROPERTY_SIZE );
-				String::strCopy( tProp.Value, ( *lit ).second.c_str(), MAP_PROPERTY_SIZE );
+					//! Writes the polygon points
+					for ( Uint32 tPoint = 0; tPoint < tPoly.getSize(); tPoint++ ) {
+						Vector2f pf( tPoly.getAt( tPoint ) );
+						Vector2if p( pf.x, pf.y ); //! Convert it to Int32
 
-				IOS.write( (const char*)&tProp, sizeof( sPropertyHdr ) );
+						IOS.write( (const char*)&p, sizeof( Vector2if ) );
+					}
+				}
 			}
 		}
+	}
+}
+
+void TileMap::writeLights( IOStream& IOS ) {
+	if ( getLightsEnabled() && NULL != mLightManager ) {
+		MapLightManager::LightsList& Lights = mLightManager->getLights();
+
+		for ( MapLightManager::LightsList::iterator LightsIt = Lights.begin();
+			  LightsIt != Lights.end(); ++LightsIt ) {
+			MapLight* Light = ( *LightsIt );
+
+			sMapLightHdr tLightHdr;
+
+			tLightHdr.Radius = Light->getRadius();
+			tLightHdr.PosX = (Int32)Light->getPosition().x;
+			tLightHdr.PosY = (Int32)Light->getPosition().y;
+			tLightHdr.Color = Color( Light->getColor() ).getValue();
+			tLightHdr.Type = Light->getType();
+
+			IOS.write( (const char*)&tLightHdr, sizeof( sMapLightHdr ) );
+		}
+	}
+}
+
+void TileMap::saveToStream( IOStream& IOS ) {
+	if ( mChunked ) {
+		saveToStreamChunked( IOS, mChunkCompression );
+		return;
+	}
+
+	Uint32 i;
+	MapLayer* tLayer;
+
+	std::vector<std::string> TextureAtlases = getTextureAtlases();
+
+	sMapHdr MapHdr = createMapHeader( TextureAtlases );
+
+	if ( IOS.isOpen() ) {
+		//! Writes the map header
+		IOS.write( (const char*)&MapHdr, sizeof( sMapHdr ) );
+
+		//! Writes the properties, texture atlases, virtual object types and layers headers
+		writeHeaders( IOS, TextureAtlases );
 
 		bool ThereIsTiled = false;
 
@@ -1239,8 +1458,8 @@ void TileMap::saveToStream( IOStream& IOS ) {
 			}
 		}
 
-		//! This method is slow, but allows to save big maps with little space needed, i'll add an
-		//! alternative save method ( just plain layer -> tile object saving )
+		//! This method is slow, but allows to save big maps with little space needed, the chunked
+		//! format is the alternative for big maps ( see saveToStreamChunked ).
 		Int32 x, y;
 		Uint32 tReadFlag = 0, z;
 		TileMapLayer* tTLayer;
@@ -1284,26 +1503,9 @@ void TileMap::saveToStream( IOStream& IOS ) {
 					//! Writes every game object header corresponding to this tile
 					for ( i = 0; i < mLayerCount; i++ ) {
 						if ( tReadFlag & ( 1 << i ) ) {
-							tObj = tObjects[i];
-
 							sMapTileGOHdr tTGOHdr;
 
-							//! The DataId should be the TextureRegion hash name ( at least in the
-							//! cases of type TextureRegion, TextureRegionEx and Sprite.
-							tTGOHdr.Id = tObj->getDataId();
-
-							//! If the object type is virtual, means that the real type is stored
-							//! elsewhere.
-							if ( tObj->getType() != GAMEOBJECT_TYPE_VIRTUAL ) {
-								tTGOHdr.Type = tObj->getType();
-							} else {
-								GameObjectVirtual* tObjV =
-									reinterpret_cast<GameObjectVirtual*>( tObj );
-
-								tTGOHdr.Type = tObjV->getRealType();
-							}
-
-							tTGOHdr.Flags = tObj->getFlags();
+							fillTileHeader( tObjects[i], tTGOHdr );
 
 							IOS.write( (const char*)&tTGOHdr, sizeof( sMapTileGOHdr ) );
 						}
@@ -1313,118 +1515,181 @@ void TileMap::saveToStream( IOStream& IOS ) {
 		}
 
 		//! Then we save the Object layers.
-		MapObjectLayer* tOLayer;
+		writeObjectLayers( IOS );
 
-		for ( i = 0; i < mLayerCount; i++ ) {
-			tLayer = mLayers[i];
+		//! Saves the lights
+		writeLights( IOS );
+	}
+}
 
-			if ( NULL != tLayer && tLayer->getType() == MAP_LAYER_OBJECT ) {
-				tOLayer = reinterpret_cast<MapObjectLayer*>( tLayer );
+bool TileMap::saveToStreamChunked( IOStream& IOS, const bool& compress ) {
+	if ( !IOS.isOpen() )
+		return false;
 
-				MapObjectLayer::ObjList ObjList = tOLayer->getObjectList();
+	std::vector<std::string> TextureAtlases = getTextureAtlases();
 
-				for ( MapObjectLayer::ObjList::iterator MapObjIt = ObjList.begin();
-					  MapObjIt != ObjList.end(); ++MapObjIt ) {
-					tObj = ( *MapObjIt );
+	sMapHdr MapHdr = createMapHeader( TextureAtlases );
 
-					sMapObjGOHdr tOGOHdr;
+	MapHdr.Magic = EE_MAP_CHUNKED_MAGIC;
 
-					//! The DataId should be the TextureRegion hash name ( at least in the cases of
-					//! type TextureRegion, TextureRegionEx and Sprite. And for the Poly Obj should
-					//! be an arbitrary value assigned by the map on the moment of creation
-					tOGOHdr.Id = tObj->getDataId();
+	//! Everything but the tiles is written as in the plain format.
+	IOStreamString body;
 
-					//! If the object type is virtual, means that the real type is stored elsewhere.
-					if ( tObj->getType() != GAMEOBJECT_TYPE_VIRTUAL ) {
-						tOGOHdr.Type = tObj->getType();
-					} else {
-						GameObjectVirtual* tObjV = reinterpret_cast<GameObjectVirtual*>( tObj );
+	writeHeaders( body, TextureAtlases );
+	writeObjectLayers( body );
+	writeLights( body );
 
-						tOGOHdr.Type = tObjV->getRealType();
-					}
+	std::vector<TileMapLayer*> tiledLayers;
 
-					tOGOHdr.Flags = tObj->getFlags();
+	for ( Uint32 i = 0; i < mLayerCount; i++ ) {
+		if ( NULL != mLayers[i] && mLayers[i]->getType() == MAP_LAYER_TILED )
+			tiledLayers.push_back( reinterpret_cast<TileMapLayer*>( mLayers[i] ) );
+	}
 
-					tOGOHdr.PosX = (Int32)tObj->getPosition().x;
+	Int32 cs = mChunkSize;
+	size_t chunkTiles = cs * cs;
+	Uint32 chunkCount = mChunkCount.x * mChunkCount.y;
 
-					tOGOHdr.PosY = (Int32)tObj->getPosition().y;
+	//! The chunks that are not loaded are copied from the streamed file, so the tile types of the
+	//! file keep their indexes and the types of the loaded tiles are added after them.
+	std::vector<sMapTileGOHdr> tileTypes;
+	std::map<std::tuple<Uint32, Uint32, Uint32>, Uint32> typeIndex;
 
-					IOS.write( (const char*)&tOGOHdr, sizeof( sMapObjGOHdr ) );
+	if ( NULL != mStreamer )
+		tileTypes = mStreamer->getTileTypes();
 
-					//! For the polygon objects wee need to write the polygon points, the Name, the
-					//! TypeName and the Properties.
-					if ( tObj->getType() == GAMEOBJECT_TYPE_OBJECT ||
-						 tObj->getType() == GAMEOBJECT_TYPE_POLYGON ||
-						 tObj->getType() == GAMEOBJECT_TYPE_POLYLINE ) {
-						GameObjectObject* tObjObj = reinterpret_cast<GameObjectObject*>( tObj );
-						Polygon2f tPoly = tObjObj->getPolygon();
-						GameObjectObject::PropertiesMap tObjObjProp = tObjObj->getProperties();
-						sMapObjObjHdr tObjObjHdr;
+	for ( size_t i = 0; i < tileTypes.size(); i++ )
+		typeIndex[std::make_tuple( tileTypes[i].Type, tileTypes[i].Id, tileTypes[i].Flags )] =
+			i + 1;
 
-						memset( tObjObjHdr.Name, 0, MAP_PROPERTY_SIZE );
-						memset( tObjObjHdr.Type, 0, MAP_PROPERTY_SIZE );
+	auto isChunkLoaded = [&]( const Uint32& index ) {
+		return NULL == mStreamer || mChunkStates[index] >= CHUNK_LOADED;
+	};
 
-						String::strCopy( tObjObjHdr.Name, tObjObj->getName().c_str(),
-										 MAP_PROPERTY_SIZE );
-						String::strCopy( tObjObjHdr.Type, tObjObj->getTypeName().c_str(),
-										 MAP_PROPERTY_SIZE );
+	auto forEachTile = [&]( const Uint32& index,
+							const std::function<void( size_t, GameObject* )>& cb ) {
+		Vector2i start( ( index % mChunkCount.x ) * cs, ( index / mChunkCount.x ) * cs );
 
-						tObjObjHdr.PointCount = tPoly.getSize();
-						tObjObjHdr.PropertyCount = tObjObjProp.size();
+		for ( size_t k = 0; k < tiledLayers.size(); k++ ) {
+			if ( !tiledLayers[k]->isChunkAllocated( index ) )
+				continue;
 
-						//! Writes the ObjObj header
-						IOS.write( (const char*)&tObjObjHdr, sizeof( sMapObjObjHdr ) );
+			for ( Int32 y = 0; y < cs && start.y + y < mSize.y; y++ ) {
+				for ( Int32 x = 0; x < cs && start.x + x < mSize.x; x++ ) {
+					GameObject* tObj = tiledLayers[k]->getTile( start.x + x, start.y + y );
 
-						//! Writes the properties of the current polygon object
-						for ( GameObjectObject::PropertiesMap::iterator ooit = tObjObjProp.begin();
-							  ooit != tObjObjProp.end(); ++ooit ) {
-							sPropertyHdr tProp;
+					if ( NULL != tObj )
+						cb( k * chunkTiles + y * cs + x, tObj );
+				}
+			}
+		}
+	};
 
-							memset( tProp.Name, 0, MAP_PROPERTY_SIZE );
-							memset( tProp.Value, 0, MAP_PROPERTY_SIZE );
+	//! First pass, collects the tile types of the loaded chunks.
+	for ( Uint32 index = 0; index < chunkCount; index++ ) {
+		if ( !isChunkLoaded( index ) )
+			continue;
 
-							String::strCopy( tProp.Name, ooit->first.c_str(), MAP_PROPERTY_SIZE );
-							String::strCopy( tProp.Value, ooit->second.c_str(), MAP_PROPERTY_SIZE );
+		forEachTile( index, [&]( size_t, GameObject* tObj ) {
+			sMapTileGOHdr tTGOHdr;
 
-							IOS.write( (const char*)&tProp, sizeof( sPropertyHdr ) );
-						}
+			fillTileHeader( tObj, tTGOHdr );
 
-						//! Writes the polygon points
-						for ( Uint32 tPoint = 0; tPoint < tPoly.getSize(); tPoint++ ) {
-							Vector2f pf( tPoly.getAt( tPoint ) );
-							Vector2if p( pf.x, pf.y ); //! Convert it to Int32
+			auto key = std::make_tuple( tTGOHdr.Type, tTGOHdr.Id, tTGOHdr.Flags );
 
-							IOS.write( (const char*)&p, sizeof( Vector2if ) );
-						}
-					}
-				}
+			if ( typeIndex.find( key ) == typeIndex.end() ) {
+				tileTypes.push_back( tTGOHdr );
+				typeIndex[key] = tileTypes.size();
 			}
+		} );
+	}
+
+	Uint32 indexSize = tileTypes.size() < 0xFFFF ? sizeof( Uint16 ) : sizeof( Uint32 );
+
+	//! Second pass, encodes every chunk.
+	std::vector<sMapChunkHdr> chunks( chunkCount );
+	std::vector<std::string> chunksData( chunkCount );
+	std::vector<Uint32> tiles;
+
+	for ( Uint32 index = 0; index < chunkCount; index++ ) {
+		sMapChunkHdr& chunk = chunks[index];
+		bool empty = true;
+
+		chunk.Offset = 0;
+		chunk.Size = 0;
+		chunk.Flags = 0;
+
+		if ( isChunkLoaded( index ) ) {
+			tiles.assign( chunkTiles * tiledLayers.size(), 0 );
+
+			forEachTile( index, [&]( size_t pos, GameObject* tObj ) {
+				sMapTileGOHdr tTGOHdr;
+
+				fillTileHeader( tObj, tTGOHdr );
+
+				tiles[pos] = typeIndex[std::make_tuple( tTGOHdr.Type, tTGOHdr.Id, tTGOHdr.Flags )];
+				empty = false;
+			} );
+		} else if ( !mStreamer->isChunkEmpty( index ) ) {
+			mStreamer->readChunk( index, tiles );
+
+			//! The tiled layers added after loading the map are empty in the unloaded chunks.
+			tiles.resize( chunkTiles * tiledLayers.size(), 0 );
+			empty = false;
 		}
 
-		//! Saves the lights
-		if ( MapHdr.LightsCount && NULL != mLightManager ) {
-			MapLightManager::LightsList& Lights = mLightManager->getLights();
+		if ( !empty ) {
+			Private::TileMapChunkStreamer::encode( tiles, indexSize, compress, chunksData[index],
+												  chunk.Flags );
+			chunk.Size = chunksData[index].size();
+		}
+	}
 
-			for ( MapLightManager::LightsList::iterator LightsIt = Lights.begin();
-				  LightsIt != Lights.end(); ++LightsIt ) {
-				MapLight* Light = ( *LightsIt );
+	sMapChunkedHdr ChunkedHdr;
 
-				sMapLightHdr tLightHdr;
+	ChunkedHdr.Version = MAP_CHUNKED_VERSION;
+	ChunkedHdr.ChunkSize = mChunkSize;
+	ChunkedHdr.ChunkCountX = mChunkCount.x;
+	ChunkedHdr.ChunkCountY = mChunkCount.y;
+	ChunkedHdr.TileTypeCount = tileTypes.size();
+	ChunkedHdr.IndexSize = indexSize;
+	ChunkedHdr.TileTypesOffset = sizeof( sMapHdr ) + sizeof( sMapChunkedHdr ) + body.getSize();
+	ChunkedHdr.ChunkIndexOffset =
+		ChunkedHdr.TileTypesOffset + sizeof( sMapTileGOHdr ) * tileTypes.size();
 
-				tLightHdr.Radius = Light->getRadius();
-				tLightHdr.PosX = (Int32)Light->getPosition().x;
-				tLightHdr.PosY = (Int32)Light->getPosition().y;
-				tLightHdr.Color = Color( Light->getColor() ).getValue();
-				tLightHdr.Type = Light->getType();
+	Uint64 offset = ChunkedHdr.ChunkIndexOffset + sizeof( sMapChunkHdr ) * chunkCount;
 
-				IOS.write( (const char*)&tLightHdr, sizeof( sMapLightHdr ) );
-			}
+	for ( auto& chunk : chunks ) {
+		if ( chunk.Size > 0 ) {
+			chunk.Offset = offset;
+			offset += chunk.Size;
 		}
 	}
+
+	IOS.write( (const char*)&MapHdr, sizeof( sMapHdr ) );
+	IOS.write( (const char*)&ChunkedHdr, sizeof( sMapChunkedHdr ) );
+	IOS.write( body.getStreamPointer(), body.getSize() );
+
+	if ( !tileTypes.empty() )
+		IOS.write( (const char*)tileTypes.data(), sizeof( sMapTileGOHdr ) * tileTypes.size() );
+
+	IOS.write( (const char*)chunks.data(), sizeof( sMapChunkHdr ) * chunkCount );
+
+	for ( const auto& data : chunksData ) {
+		if ( !data.empty() )
+			IOS.write( data.data(), data.size() );
+	}
+
+	return true;
 }
 
 void TileMap::saveToFile( const std::string& path ) {
 	if ( !FileSystem::isDirectory( path ) ) {
+		if ( mChunked ) {
+			saveToFileChunked( path, mChunkCompression );
+			return;
+		}
+
 		mPath = path;
 
 		IOStreamFile IOS( path, "wb" );
@@ -1433,6 +1698,62 @@ void TileMap::saveToFile( const std::string& path ) {
 	}
 }
 
+bool TileMap::saveToFileChunked( const std::string& path, const bool& compress ) {
+	if ( FileSystem::isDirectory( path ) )
+		return false;
+
+	mPath = path;
+
+	if ( NULL == mStreamer || path != mStreamPath ) {
+		IOStreamFile IOS( path, "wb" );
+
+		return saveToStreamChunked( IOS, compress );
+	}
+
+	//! The unloaded chunks are read from the file that is being replaced, so the map is saved in
+	//! memory first and streamed from the new file after.
+	IOStreamString data;
+
+	if ( !saveToStreamChunked( data, compress ) )
+		return false;
+
+	eeSAFE_DELETE( mStreamer );
+
+	{
+		IOStreamFile IOS( path, "wb" );
+
+		IOS.write( data.getStreamPointer(), data.getSize() );
+	}
+
+	IOStreamFile IOS( path );
+	sMapHdr MapHdr;
+	sMapChunkedHdr ChunkedHdr;
+
+	IOS.read( (char*)&MapHdr, sizeof( sMapHdr ) );
+	IOS.read( (char*)&ChunkedHdr, sizeof( sMapChunkedHdr ) );
+
+	if ( !createStreamer( IOS, 0, ChunkedHdr, path ) )
+		return false;
+
+	//! The modified chunks are stored in the file now, so they can be unloaded.
+	mActiveChunks.clear();
+	mPendingChunks = 0;
+	mStreamingRect = Rect();
+
+	for ( Uint32 index = 0; index < mChunkStates.size(); index++ ) {
+		Uint8& state = mChunkStates[index];
+
+		if ( CHUNK_LOADING == state ) {
+			state = CHUNK_UNLOADED;
+		} else if ( CHUNK_MODIFIED == state || CHUNK_LOADED == state ) {
+			state = CHUNK_LOADED;
+			mActiveChunks.push_back( index );
+		}
+	}
+
+	return true;
+}
+
 std::vector<std::string> TileMap::getTextureAtlases() {
 	TextureAtlasManager* SGM = TextureAtlasManager::instance();
 	auto& res = SGM->getResources();
@@ -1441,12 +1762,14 @@ std::vector<std::string> TileMap::getTextureAtlases() {
 
 	//! Ugly ugly ugly, but i don't see another way
 	Uint32 Restricted1 = String::hash( std::string( "global" ) );
-	Uint32 Restricted2 = String::hash( SceneManager::instance()
-										   ->getUISceneNode()
-										   ->getUIThemeManager()
-										   ->getDefaultTheme()
-										   ->getTextureAtlas()
-										   ->getName() );
+	Uint32 Restricted2 = 0;
+	UISceneNode* uiSceneNode = SceneManager::instance()->getUISceneNode();
+
+	// Maps can be saved without an UI, e.g. when they are converted or generated.
+	if ( NULL != uiSceneNode && NULL != uiSceneNode->getUIThemeManager()->getDefaultTheme() &&
+		 NULL != uiSceneNode->getUIThemeManager()->getDefaultTheme()->getTextureAtlas() )
+		Restricted2 = String::hash(
+			uiSceneNode->getUIThemeManager()->getDefaultTheme()->getTextureAtlas()->getName() );
 
 	for ( auto& it : res ) {
 		if ( it.second->getId() != Restricted1 && it.second->getId() != Restricted2 )
@@ -1541,4 +1864,338 @@ const Color& TileMap::setGridLinesColor() const {
 	return mGridLinesColor;
 }
 
+void TileMap::setChunkSize( const Uint32& chunkSize ) {
+	if ( mLayerCount > 0 )
+		return;
+
+	Uint32 size = 4;
+
+	while ( size < chunkSize && size < 256 )
+		size <<= 1;
+
+	mChunkSize = size;
+	mChunkCount = Sizei( ( mSize.x + mChunkSize - 1 ) / mChunkSize,
+						 ( mSize.y + mChunkSize - 1 ) / mChunkSize );
+}
+
+const Uint32& TileMap::getChunkSize() const {
+	return mChunkSize;
+}
+
+void TileMap::setChunked( const bool& chunked, const bool& compress ) {
+	mChunked = chunked;
+	mChunkCompression = compress;
+
+	if ( !mChunked )
+		stopStreaming();
+}
+
+const bool& TileMap::isChunked() const {
+	return mChunked;
+}
+
+void TileMap::setStreamingDistance( const Uint32& distance ) {
+	mStreamingDistance = distance;
+	mStreamingRect = Rect();
+}
+
+const Uint32& TileMap::getStreamingDistance() const {
+	return mStreamingDistance;
+}
+
+bool TileMap::isStreaming() const {
+	return NULL != mStreamer;
+}
+
+Uint32 TileMap::getLoadedChunkCount() const {
+	Uint32 count = 0;
+
+	for ( const auto& state : mChunkStates ) {
+		if ( state >= CHUNK_LOADED )
+			count++;
+	}
+
+	return count;
+}
+
+const Uint32& TileMap::getPendingChunkCount() const {
+	return mPendingChunks;
+}
+
+void TileMap::waitForChunks() {
+	if ( NULL == mStreamer )
+		return;
+
+	updateScreenAABB();
+
+	updateStreaming();
+
+	while ( mPendingChunks > 0 ) {
+		mStreamer->waitForChunks();
+
+		if ( !collectChunks() )
+			break;
+	}
+}
+
+bool TileMap::createStreamer( IOStream& IOS, const ios_size& start, const sMapChunkedHdr& header,
+							  const std::string& path ) {
+	Uint32 tiledLayerCount = 0;
+
+	for ( Uint32 i = 0; i < mLayerCount; i++ ) {
+		if ( NULL != mLayers[i] && mLayers[i]->getType() == MAP_LAYER_TILED )
+			tiledLayerCount++;
+	}
+
+	if ( 0 == tiledLayerCount )
+		return true;
+
+	if ( ( header.IndexSize != sizeof( Uint16 ) && header.IndexSize != sizeof( Uint32 ) ) ||
+		 ( NULL == mForcedHeaders && ( header.ChunkCountX != (Uint32)mChunkCount.x ||
+									   header.ChunkCountY != (Uint32)mChunkCount.y ) ) )
+		return false;
+
+	// The counts come from the file, check that the tables fit in it before allocating them.
+	Uint64 available = IOS.getSize() > start ? (Uint64)( IOS.getSize() - start ) : 0;
+	Uint64 chunkCount64 = (Uint64)header.ChunkCountX * header.ChunkCountY;
+	Uint64 indexSize64 = sizeof( sMapChunkHdr ) * chunkCount64;
+	Uint64 typesSize64 = sizeof( sMapTileGOHdr ) * (Uint64)header.TileTypeCount;
+
+	if ( header.ChunkIndexOffset > available || indexSize64 > available - header.ChunkIndexOffset ||
+		 header.TileTypesOffset > available || typesSize64 > available - header.TileTypesOffset )
+		return false;
+
+	Uint32 chunkCount = (Uint32)chunkCount64;
+	std::vector<sMapChunkHdr> index( chunkCount );
+	std::vector<sMapTileGOHdr> tileTypes( header.TileTypeCount );
+	ios_size indexSize = (ios_size)indexSize64;
+	ios_size typesSize = (ios_size)typesSize64;
+
+	IOS.seek( start + header.ChunkIndexOffset );
+
+	if ( indexSize > 0 && IOS.read( (char*)index.data(), indexSize ) != indexSize )
+		return false;
+
+	IOS.seek( start + header.TileTypesOffset );
+
+	if ( typesSize > 0 && IOS.read( (char*)tileTypes.data(), typesSize ) != typesSize )
+		return false;
+
+	IOStream* source = NULL;
+	ios_size base = start;
+	std::string data;
+
+	if ( !path.empty() ) {
+		source = IOStreamFile::New( path, "rb" );
+
+		if ( !source->isOpen() )
+			eeSAFE_DELETE( source );
+	}
+
+	//! The maps loaded from memory keep a copy of the map data to read the chunks from it.
+	if ( NULL == source ) {
+		data.resize( IOS.getSize() - start );
+
+		IOS.seek( start );
+		IOS.read( &data[0], data.size() );
+
+		base = 0;
+	}
+
+	mStreamer = eeNew( Private::TileMapChunkStreamer,
+					   ( source, std::move( data ), base, header, std::move( index ),
+						 std::move( tileTypes ), tiledLayerCount ) );
+	mStreamPath = path;
+	mChunkStates.assign( chunkCount, CHUNK_UNLOADED );
+	mActiveChunks.clear();
+	mPendingChunks = 0;
+	mStreamingRect = Rect();
+
+	return true;
+}
+
+void TileMap::stopStreaming() {
+	if ( NULL == mStreamer )
+		return;
+
+	for ( Uint32 index = 0; index < mChunkStates.size(); index++ ) {
+		if ( mChunkStates[index] < CHUNK_LOADED )
+			loadChunk( index );
+	}
+
+	eeSAFE_DELETE( mStreamer );
+	mChunkStates.clear();
+	mActiveChunks.clear();
+	mPendingChunks = 0;
+	mStreamingRect = Rect();
+}
+
+void TileMap::updateStreaming() {
+	if ( NULL == mStreamer || mChunkCount.x <= 0 || mChunkCount.y <= 0 )
+		return;
+
+	collectChunks();
+
+	Int32 cs = mChunkSize;
+	Int32 distance = mStreamingDistance;
+	Rect view( eemax( 0, mStartTile.x / cs - distance ), eemax( 0, mStartTile.y / cs - distance ),
+			   eemin( mChunkCount.x - 1, eemax( 0, mEndTile.x - 1 ) / cs + distance ),
+			   eemin( mChunkCount.y - 1, eemax( 0, mEndTile.y - 1 ) / cs + distance ) );
+
+	if ( view == mStreamingRect )
+		return;
+
+	mStreamingRect = view;
+
+	//! Releases the chunks that are out of range, with one chunk of margin so moving back and
+	//! forth over a chunk border doesn't reload them. The modified chunks are only stored in the
+	//! layers, so they are never released.
+	for ( size_t i = 0; i < mActiveChunks.size(); ) {
+		Uint32 index = mActiveChunks[i];
+		Int32 x = index % mChunkCount.x;
+		Int32 y = index / mChunkCount.x;
+		Uint8& state = mChunkStates[index];
+
+		if ( CHUNK_MODIFIED != state && x >= view.Left - 1 && x <= view.Right + 1 &&
+			 y >= view.Top - 1 && y <= view.Bottom + 1 ) {
+			i++;
+			continue;
+		}
+
+		if ( CHUNK_LOADING == state ) {
+			mStreamer->cancel( index );
+			mPendingChunks--;
+			state = CHUNK_UNLOADED;
+		} else if ( CHUNK_LOADED == state ) {
+			for ( Uint32 l = 0; l < mLayerCount; l++ ) {
+				if ( mLayers[l]->getType() == MAP_LAYER_TILED )
+					reinterpret_cast<TileMapLayer*>( mLayers[l] )->releaseChunk( index );
+			}
+
+			state = CHUNK_UNLOADED;
+		}
+
+		mActiveChunks[i] = mActiveChunks.back();
+		mActiveChunks.pop_back();
+	}
+
+	//! Requests the chunks in range, the closest to the center of the view first.
+	Vector2i center( ( view.Left + view.Right ) / 2, ( view.Top + view.Bottom ) / 2 );
+	std::vector<std::pair<Int32, Uint32>> requests;
+
+	for ( Int32 y = view.Top; y <= view.Bottom; y++ ) {
+		for ( Int32 x = view.Left; x <= view.Right; x++ ) {
+			Uint32 index = y * mChunkCount.x + x;
+
+			if ( CHUNK_UNLOADED != mChunkStates[index] )
+				continue;
+
+			if ( mStreamer->isChunkEmpty( index ) ) {
+				mChunkStates[index] = CHUNK_LOADED;
+				mActiveChunks.push_back( index );
+			} else {
+				Int32 dx = x - center.x;
+				Int32 dy = y - center.y;
+
+				requests.push_back( std::make_pair( dx * dx + dy * dy, index ) );
+			}
+		}
+	}
+
+	std::sort( requests.begin(), requests.end() );
+
+	for ( const auto& request : requests ) {
+		mStreamer->request( request.second );
+		mChunkStates[request.second] = CHUNK_LOADING;
+		mActiveChunks.push_back( request.second );
+		mPendingChunks++;
+	}
+}
+
+bool TileMap::collectChunks() {
+	bool collected = false;
+
+	for ( const auto& chunk : mStreamer->collect() ) {
+		collected = true;
+
+		//! The chunks that were cancelled or loaded synchronously in the meantime are discarded.
+		if ( CHUNK_LOADING == mChunkStates[chunk.index] ) {
+			installChunk( chunk.index, chunk.tiles );
+			mChunkStates[chunk.index] = CHUNK_LOADED;
+			mPendingChunks--;
+		}
+	}
+
+	return collected;
+}
+
+void TileMap::loadChunk( const Uint32& chunkIndex ) {
+	if ( CHUNK_LOADING == mChunkStates[chunkIndex] ) {
+		mStreamer->cancel( chunkIndex );
+		mPendingChunks--;
+	}
+
+	if ( !mStreamer->isChunkEmpty( chunkIndex ) ) {
+		std::vector<Uint32> tiles;
+
+		mStreamer->readChunk( chunkIndex, tiles );
+
+		installChunk( chunkIndex, tiles );
+	}
+
+	mChunkStates[chunkIndex] = CHUNK_LOADED;
+}
+
+void TileMap::installChunk( const Uint32& chunkIndex, const std::vector<Uint32>& tiles ) {
+	const std::vector<sMapTileGOHdr>& tileTypes = mStreamer->getTileTypes();
+	const sMapChunkedHdr& header = mStreamer->getHeader();
+	Int32 cs = header.ChunkSize;
+	size_t chunkTiles = cs * cs;
+	Vector2i start( ( chunkIndex % header.ChunkCountX ) * cs,
+					( chunkIndex / header.ChunkCountX ) * cs );
+	size_t k = 0;
+
+	for ( Uint32 i = 0; i < mLayerCount && ( k + 1 ) * chunkTiles <= tiles.size(); i++ ) {
+		if ( mLayers[i]->getType() != MAP_LAYER_TILED )
+			continue;
+
+		TileMapLayer* tTLayer = reinterpret_cast<TileMapLayer*>( mLayers[i] );
+		const Uint32* ids = &tiles[k++ * chunkTiles];
+
+		for ( Int32 y = 0; y < cs && start.y + y < mSize.y; y++ ) {
+			for ( Int32 x = 0; x < cs && start.x + x < mSize.x; x++ ) {
+				Uint32 id = ids[y * cs + x];
+
+				if ( 0 == id || id > tileTypes.size() )
+					continue;
+
+				const sMapTileGOHdr& type = tileTypes[id - 1];
+
+				tTLayer->placeGameObject(
+					createGameObject( type.Type, type.Flags, mLayers[i], type.Id ),
+					Vector2i( start.x + x, start.y + y ) );
+			}
+		}
+	}
+}
+
+Uint32 TileMap::getChunkIndex( const Vector2i& TilePos ) const {
+	return ( TilePos.y / mChunkSize ) * mChunkCount.x + TilePos.x / mChunkSize;
+}
+
+void TileMap::onTileModified( const Vector2i& TilePos ) {
+	if ( NULL == mStreamer )
+		return;
+
+	Uint32 index = getChunkIndex( TilePos );
+
+	if ( index >= mChunkStates.size() )
+		return;
+
+	if ( mChunkStates[index] < CHUNK_LOADED )
+		loadChunk( index );
+
+	mChunkStates[index] = CHUNK_MODIFIED;
+}
+
 }} // namespace EE::Maps
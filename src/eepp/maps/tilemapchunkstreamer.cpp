@@ -0,0 +1,184 @@
+#include <cstring>
+#include <eepp/core/memorymanager.hpp>
+#include <eepp/maps/tilemapchunkstreamer.hpp>
+#include <eepp/system/compression.hpp>
+#include <eepp/system/iostreammemory.hpp>
+#include <eepp/system/iostreamstring.hpp>
+#include <eepp/system/threadpool.hpp>
+
+namespace EE { namespace Maps { namespace Private {
+
+TileMapChunkStreamer::TileMapChunkStreamer( IOStream* source, std::string&& data,
+											const ios_size& base, const sMapChunkedHdr& header,
+											std::vector<sMapChunkHdr>&& index,
+											std::vector<sMapTileGOHdr>&& tileTypes,
+											const Uint32& tiledLayerCount ) :
+	mSource( source ),
+	mData( std::move( data ) ),
+	mBase( base ),
+	mHeader( header ),
+	mIndex( std::move( index ) ),
+	mTileTypes( std::move( tileTypes ) ),
+	mTiledLayerCount( tiledLayerCount ),
+	mInFlight( 0 ),
+	mStopping( false ),
+	mPool( ThreadPool::createUnique( 1 ) ) {
+	if ( NULL == mSource )
+		mSource = eeNew( IOStreamMemory, ( mData.data(), (ios_size)mData.size() ) );
+}
+
+TileMapChunkStreamer::~TileMapChunkStreamer() {
+	// The queued requests return immediately, the pool waits for the one being read.
+	mStopping = true;
+	mPool.reset();
+	eeSAFE_DELETE( mSource );
+}
+
+bool TileMapChunkStreamer::readChunk( const Uint32& index, std::vector<Uint32>& tiles ) {
+	size_t count = (size_t)mHeader.ChunkSize * mHeader.ChunkSize * mTiledLayerCount;
+
+	tiles.assign( count, 0 );
+
+	if ( index >= mIndex.size() )
+		return false;
+
+	const sMapChunkHdr& chunk = mIndex[index];
+
+	if ( 0 == chunk.Offset )
+		return true;
+
+	size_t rawSize = count * mHeader.IndexSize;
+
+	// Chunks are only stored compressed when that makes them smaller, so no valid chunk is larger
+	// than its raw tile indexes. Anything else comes from a corrupted or hostile index.
+	if ( 0 == chunk.Size || chunk.Size > rawSize ||
+		 ( !( chunk.Flags & MAP_CHUNK_FLAG_COMPRESSED ) && chunk.Size != rawSize ) )
+		return false;
+
+	std::vector<Uint8> data( chunk.Size );
+
+	{
+		std::lock_guard<std::mutex> lock( mSourceMutex );
+
+		Uint64 available =
+			mSource->getSize() > mBase ? (Uint64)( mSource->getSize() - mBase ) : 0;
+
+		if ( chunk.Offset > available || chunk.Size > available - chunk.Offset )
+			return false;
+
+		mSource->seek( mBase + (ios_size)chunk.Offset );
+
+		if ( mSource->read( (char*)data.data(), chunk.Size ) != (ios_size)chunk.Size )
+			return false;
+	}
+
+	std::vector<Uint8> raw;
+	const Uint8* src = data.data();
+
+	if ( chunk.Flags & MAP_CHUNK_FLAG_COMPRESSED ) {
+		raw.resize( rawSize );
+
+		if ( Compression::decompress( raw.data(), rawSize, data.data(), data.size() ) !=
+			 Compression::OK )
+			return false;
+
+		src = raw.data();
+	}
+
+	if ( 2 == mHeader.IndexSize ) {
+		for ( size_t i = 0; i < count; i++ ) {
+			Uint16 id;
+			memcpy( &id, src + i * sizeof( Uint16 ), sizeof( Uint16 ) );
+			tiles[i] = id;
+		}
+	} else {
+		memcpy( tiles.data(), src, count * sizeof( Uint32 ) );
+	}
+
+	return true;
+}
+
+void TileMapChunkStreamer::request( const Uint32& index ) {
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mCancelled.erase( index );
+		mInFlight++;
+	}
+
+	mPool->run(
+		[this, index] {
+			Chunk chunk;
+			bool cancelled;
+
+			{
+				std::lock_guard<std::mutex> lock( mMutex );
+				cancelled = mStopping || mCancelled.erase( index ) > 0;
+			}
+
+			if ( !cancelled ) {
+				chunk.index = index;
+				readChunk( index, chunk.tiles );
+			}
+
+			{
+				std::lock_guard<std::mutex> lock( mMutex );
+
+				if ( !cancelled )
+					mReady.emplace_back( std::move( chunk ) );
+
+				mInFlight--;
+			}
+
+			mCondition.notify_all();
+		},
+		nullptr );
+}
+
+void TileMapChunkStreamer::cancel( const Uint32& index ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+	mCancelled.insert( index );
+}
+
+std::vector<TileMapChunkStreamer::Chunk> TileMapChunkStreamer::collect() {
+	std::vector<Chunk> ready;
+	std::lock_guard<std::mutex> lock( mMutex );
+	ready.swap( mReady );
+	return ready;
+}
+
+void TileMapChunkStreamer::waitForChunks() {
+	std::unique_lock<std::mutex> lock( mMutex );
+	mCondition.wait( lock, [&] { return !mReady.empty() || 0 == mInFlight; } );
+}
+
+void TileMapChunkStreamer::encode( const std::vector<Uint32>& tiles, const Uint32& indexSize,
+								   const bool& compress, std::string& data, Uint32& flags ) {
+	std::string raw( tiles.size() * indexSize, '\0' );
+
+	if ( 2 == indexSize ) {
+		for ( size_t i = 0; i < tiles.size(); i++ ) {
+			Uint16 id = (Uint16)tiles[i];
+			memcpy( &raw[i * sizeof( Uint16 )], &id, sizeof( Uint16 ) );
+		}
+	} else {
+		memcpy( &raw[0], tiles.data(), raw.size() );
+	}
+
+	flags = 0;
+
+	if ( compress ) {
+		IOStreamMemory src( raw.data(), (ios_size)raw.size() );
+		IOStreamString dst;
+
+		if ( Compression::compress( dst, src ) == Compression::OK &&
+			 dst.getStream().size() < raw.size() ) {
+			data = dst.getStream();
+			flags |= MAP_CHUNK_FLAG_COMPRESSED;
+			return;
+		}
+	}
+
+	data.swap( raw );
+}
+
+}}} // namespace EE::Maps::Private
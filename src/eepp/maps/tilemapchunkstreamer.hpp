@@ -0,0 +1,88 @@
+#ifndef EE_MAPS_PRIVATE_TILEMAPCHUNKSTREAMER_HPP
+#define EE_MAPS_PRIVATE_TILEMAPCHUNKSTREAMER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <eepp/maps/base.hpp>
+#include <eepp/maps/maphelper.hpp>
+#include <eepp/system/iostream.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace EE { namespace System {
+class ThreadPool;
+}} // namespace EE::System
+
+namespace EE { namespace Maps { namespace Private {
+
+/** @brief Reads the chunks of a chunked map file on a worker thread.
+**	The chunks are read and decompressed into tile type index arrays in the background, the map
+**	collects them from the main thread and creates the tile game objects.
+*/
+class TileMapChunkStreamer {
+  public:
+	struct Chunk {
+		Uint32 index;
+		std::vector<Uint32> tiles;
+	};
+
+	/** @param source The stream of the map file, owned by the streamer. If it's NULL the map is
+	 *	read from data.
+	 *	@param base The position of the map start in the source stream. */
+	TileMapChunkStreamer( IOStream* source, std::string&& data, const ios_size& base,
+						  const sMapChunkedHdr& header, std::vector<sMapChunkHdr>&& index,
+						  std::vector<sMapTileGOHdr>&& tileTypes, const Uint32& tiledLayerCount );
+
+	~TileMapChunkStreamer();
+
+	/** Reads and decodes a chunk synchronously. Can be called from any thread. */
+	bool readChunk( const Uint32& index, std::vector<Uint32>& tiles );
+
+	/** Queues a chunk to be read on the worker thread. */
+	void request( const Uint32& index );
+
+	/** Discards a queued request if it wasn't read yet. */
+	void cancel( const Uint32& index );
+
+	/** @return The chunks read since the last call. The chunks that failed to be read are
+	 *	returned empty. */
+	std::vector<Chunk> collect();
+
+	/** Blocks until there are chunks ready to be collected or no requests in flight. */
+	void waitForChunks();
+
+	inline bool isChunkEmpty( const Uint32& index ) const { return 0 == mIndex[index].Offset; }
+
+	inline const std::vector<sMapTileGOHdr>& getTileTypes() const { return mTileTypes; }
+
+	inline const sMapChunkedHdr& getHeader() const { return mHeader; }
+
+	/** Encodes the tile type indexes of a chunk, compressing them if requested and if they are
+	 * smaller compressed. */
+	static void encode( const std::vector<Uint32>& tiles, const Uint32& indexSize,
+						const bool& compress, std::string& data, Uint32& flags );
+
+  protected:
+	IOStream* mSource;
+	std::string mData;
+	ios_size mBase;
+	sMapChunkedHdr mHeader;
+	std::vector<sMapChunkHdr> mIndex;
+	std::vector<sMapTileGOHdr> mTileTypes;
+	Uint32 mTiledLayerCount;
+	std::mutex mSourceMutex;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::vector<Chunk> mReady;
+	std::unordered_set<Uint32> mCancelled;
+	Uint32 mInFlight;
+	std::atomic<bool> mStopping;
+	std::unique_ptr<System::ThreadPool> mPool;
+};
+
+}}} // namespace EE::Maps::Private
+
+#endif
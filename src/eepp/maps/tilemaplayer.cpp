@@ -1,3 +1,4 @@
+#include <cstring>
 #include <eepp/maps/tilemap.hpp>
 #include <eepp/maps/tilemaplayer.hpp>
 
@@ -10,7 +11,10 @@ namespace EE { namespace Maps {
 
 TileMapLayer::TileMapLayer( TileMap* map, Sizei size, Uint32 flags, std::string name,
 							Vector2f offset ) :
-	MapLayer( map, MAP_LAYER_TILED, flags, name, offset ), mSize( size ) {
+	MapLayer( map, MAP_LAYER_TILED, flags, name, offset ),
+	mSize( size ),
+	mChunkShift( 0 ),
+	mChunkMask( 0 ) {
 	allocateLayer();
 }
 
@@ -32,8 +36,10 @@ void TileMapLayer::draw( const Vector2f& Offset ) {
 			mCurTile.x = x;
 			mCurTile.y = y;
 
-			if ( NULL != mTiles[x][y] ) {
-				mTiles[x][y]->draw();
+			GameObject* tile = getTile( x, y );
+
+			if ( NULL != tile ) {
+				tile->draw();
 			}
 		}
 	}
@@ -43,8 +49,10 @@ void TileMapLayer::draw( const Vector2f& Offset ) {
 	if ( mMap->getShowBlocked() && NULL != Tex ) {
 		for ( Int32 x = start.x; x < end.x; x++ ) {
 			for ( Int32 y = start.y; y < end.y; y++ ) {
-				if ( NULL != mTiles[x][y] ) {
-					if ( mTiles[x][y]->isBlocked() ) {
+				GameObject* tile = getTile( x, y );
+
+				if ( NULL != tile ) {
+					if ( tile->isBlocked() ) {
 						Tex->draw( x * mMap->getTileSize().x, y * mMap->getTileSize().y, 0,
 								   Vector2f::One, Color( 255, 0, 0, 200 ) );
 					}
@@ -67,47 +75,90 @@ void TileMapLayer::update( const Time& dt ) {
 			mCurTile.x = x;
 			mCurTile.y = y;
 
-			if ( NULL != mTiles[x][y] ) {
-				mTiles[x][y]->update( dt );
+			GameObject* tile = getTile( x, y );
+
+			if ( NULL != tile ) {
+				tile->update( dt );
 			}
 		}
 	}
 }
 
 void TileMapLayer::allocateLayer() {
-	mTiles = eeNewArray( GameObject**, mSize.getWidth() );
+	Uint32 chunkSize = mMap->getChunkSize();
 
-	for ( Int32 x = 0; x < mSize.x; x++ ) {
-		mTiles[x] = eeNewArray( GameObject*, mSize.getHeight() );
+	mChunkShift = 0;
 
-		for ( Int32 y = 0; y < mSize.y; y++ ) {
-			mTiles[x][y] = NULL;
-		}
-	}
+	while ( ( 1u << mChunkShift ) < chunkSize )
+		mChunkShift++;
+
+	mChunkMask = ( 1 << mChunkShift ) - 1;
+	mChunkCount = Sizei( ( mSize.x + mChunkMask ) >> mChunkShift,
+						 ( mSize.y + mChunkMask ) >> mChunkShift );
+
+	mChunks.assign( mChunkCount.x * mChunkCount.y, NULL );
 }
 
 void TileMapLayer::deallocateLayer() {
-	for ( Int32 x = 0; x < mSize.x; x++ ) {
-		for ( Int32 y = 0; y < mSize.y; y++ ) {
-			eeSAFE_DELETE( mTiles[x][y] );
-		}
+	for ( Uint32 i = 0; i < mChunks.size(); i++ )
+		releaseChunk( i );
 
-		eeSAFE_DELETE_ARRAY( mTiles[x] );
+	mChunks.clear();
+}
+
+bool TileMapLayer::isChunkAllocated( const Uint32& chunkIndex ) const {
+	return chunkIndex < mChunks.size() && NULL != mChunks[chunkIndex];
+}
+
+GameObject*& TileMapLayer::getTileRef( const Int32& x, const Int32& y ) {
+	GameObject**& chunk =
+		mChunks[( y >> mChunkShift ) * mChunkCount.x + ( x >> mChunkShift )];
+
+	if ( NULL == chunk ) {
+		Uint32 count = 1u << ( mChunkShift * 2 );
+
+		chunk = eeNewArray( GameObject*, count );
+
+		memset( chunk, 0, sizeof( GameObject* ) * count );
 	}
 
-	eeSAFE_DELETE_ARRAY( mTiles );
+	return chunk[( ( y & mChunkMask ) << mChunkShift ) + ( x & mChunkMask )];
+}
+
+void TileMapLayer::releaseChunk( const Uint32& chunkIndex ) {
+	GameObject** chunk = mChunks[chunkIndex];
+
+	if ( NULL == chunk )
+		return;
+
+	Uint32 count = 1u << ( mChunkShift * 2 );
+
+	for ( Uint32 i = 0; i < count; i++ )
+		eeSAFE_DELETE( chunk[i] );
+
+	eeSAFE_DELETE_ARRAY( chunk );
+
+	mChunks[chunkIndex] = NULL;
+}
+
+void TileMapLayer::placeGameObject( GameObject* obj, const Vector2i& TilePos ) {
+	GameObject*& tile = getTileRef( TilePos.x, TilePos.y );
+
+	eeSAFE_DELETE( tile );
+
+	tile = obj;
+
+	obj->setPosition(
+		Vector2f( TilePos.x * mMap->getTileSize().x, TilePos.y * mMap->getTileSize().y ) );
 }
 
 void TileMapLayer::addGameObject( GameObject* obj, const Vector2i& TilePos ) {
 	eeASSERT( TilePos.x >= 0 && TilePos.y >= 0 );
 
 	if ( TilePos.x < mSize.x && TilePos.y < mSize.y ) {
-		removeGameObject( TilePos );
-
-		mTiles[TilePos.x][TilePos.y] = obj;
+		mMap->onTileModified( TilePos );
 
-		obj->setPosition(
-			Vector2f( TilePos.x * mMap->getTileSize().x, TilePos.y * mMap->getTileSize().y ) );
+		placeGameObject( obj, TilePos );
 	}
 }
 
@@ -115,24 +166,30 @@ void TileMapLayer::removeGameObject( const Vector2i& TilePos ) {
 	eeASSERT( TilePos.x >= 0 && TilePos.y >= 0 );
 
 	if ( TilePos.x < mSize.x && TilePos.y < mSize.y ) {
-		if ( NULL != mTiles[TilePos.x][TilePos.y] ) {
-			eeSAFE_DELETE( mTiles[TilePos.x][TilePos.y] );
-		}
+		// Loads the tile chunk if it's streamed and not resident yet.
+		mMap->onTileModified( TilePos );
+
+		if ( NULL != getTile( TilePos.x, TilePos.y ) )
+			eeSAFE_DELETE( getTileRef( TilePos.x, TilePos.y ) );
 	}
 }
 
 void TileMapLayer::moveTileObject( const Vector2i& FromPos, const Vector2i& ToPos ) {
 	removeGameObject( ToPos );
 
-	GameObject* tObj = mTiles[FromPos.x][FromPos.y];
+	mMap->onTileModified( FromPos );
+	mMap->onTileModified( ToPos );
+
+	GameObject*& from = getTileRef( FromPos.x, FromPos.y );
+	GameObject* tObj = from;
 
-	mTiles[FromPos.x][FromPos.y] = NULL;
+	from = NULL;
 
-	mTiles[ToPos.x][ToPos.y] = tObj;
+	getTileRef( ToPos.x, ToPos.y ) = tObj;
 }
 
 GameObject* TileMapLayer::getGameObject( const Vector2i& TilePos ) {
-	return mTiles[TilePos.x][TilePos.y];
+	return getTile( TilePos.x, TilePos.y );
 }
 
 const Vector2i& TileMapLayer::getCurrentTile() const {
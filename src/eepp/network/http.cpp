@@ -2,15 +2,19 @@
 #include <cctype>
 #include <eepp/network/http.hpp>
 #include <eepp/network/http/httpstreamchunked.hpp>
+#include <eepp/network/httpcache.hpp>
 #include <eepp/network/ssl/sslsocket.hpp>
 #include <eepp/network/uri.hpp>
+#include <eepp/system/clock.hpp>
 #include <eepp/system/compression.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/iostream.hpp>
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/system/iostreaminflate.hpp>
 #include <eepp/system/iostreamstring.hpp>
+#include <eepp/system/md5.hpp>
 #include <eepp/system/sys.hpp>
+#include <atomic>
 #include <iterator>
 #include <limits>
 #include <sstream>
@@ -526,6 +530,16 @@ void Http::Response::parseFields( std::istream& in ) {
 
 static Http::Pool sGlobalHttpPool = Http::Pool();
 
+static HttpCache* sHttpCache = NULL;
+
+void Http::setCache( HttpCache* cache ) {
+	sHttpCache = cache;
+}
+
+HttpCache* Http::getCache() {
+	return sHttpCache;
+}
+
 Http::Response Http::request( const URI& uri, Request::Method method, const Time& timeout,
 							  const Http::Request::ProgressCallback& progressCallback,
 							  const Http::Request::FieldTable& headers, const std::string& body,
@@ -686,6 +700,16 @@ static bool sendProgress( const Http& http, const Http::Request& request,
 
 Http::Response Http::downloadRequest( const Http::Request& request, IOStream& writeTo,
 									  Time timeout ) {
+	HttpCache* cache = sHttpCache;
+
+	if ( NULL != cache && HttpCache::isCacheable( request ) )
+		return cache->fetch( *this, request, writeTo, timeout );
+
+	return download( request, writeTo, timeout, Request::FieldTable() );
+}
+
+Http::Response Http::download( const Http::Request& request, IOStream& writeTo, Time timeout,
+							   const Http::Request::FieldTable& validators ) {
 	// Solve the host IP only when the request starts.
 	if ( !mHostSolved ) {
 		if ( !mProxy.empty() ) {
@@ -731,6 +755,9 @@ Http::Response Http::downloadRequest( const Http::Request& request, IOStream& wr
 	// First make sure that the request is valid -- add missing mandatory fields
 	Request toSend( prepareFields( request ) );
 
+	for ( const auto& validator : validators )
+		toSend.setField( validator.first, validator.second );
+
 	// Prepare the response
 	Response received;
 
@@ -854,6 +881,7 @@ Http::Response Http::downloadRequest( const Http::Request& request, IOStream& wr
 				bool isnheader = false;
 				bool chunked = false;
 				bool compressed = false;
+				bool hasBody = true;
 				std::size_t contentLength = 0;
 				std::string headerBuffer;
 				HttpStreamChunked* chunkedStream = NULL;
@@ -937,6 +965,13 @@ Http::Response Http::downloadRequest( const Http::Request& request, IOStream& wr
 											contentLength = 0;
 									}
 
+									// These responses never have a body, don't wait for one.
+									hasBody = received.getStatus() != Response::NotModified &&
+											  received.getStatus() != Response::NoContent &&
+											  request.getMethod() != Request::Head &&
+											  ( chunked || compressed || contentLength > 0 ||
+												received.getField( "content-length" ).empty() );
+
 									if ( received.getField( "connection" ) == "closed" ) {
 										mConnection->setConnected( false );
 										mConnection->setTunneled( false );
@@ -967,8 +1002,10 @@ Http::Response Http::downloadRequest( const Http::Request& request, IOStream& wr
 
 											eeSAFE_DELETE( chunkedStream );
 											eeSAFE_DELETE( inflateStream );
-											return http.downloadRequest( request, writeTo,
-																		 timeout );
+											// A cached request stores the final response under
+											// its own url.
+											return http.download( request, writeTo, timeout,
+																  Request::FieldTable() );
 										}
 									}
 
@@ -998,6 +1035,9 @@ Http::Response Http::downloadRequest( const Http::Request& request, IOStream& wr
 					}
 
 					if ( isnheader ) {
+						if ( !hasBody )
+							break;
+
 						currentTotalBytes += readed;
 
 						if ( readed > 0 )
@@ -1055,6 +1095,335 @@ Http::Response Http::downloadRequest( const Http::Request& request, std::string
 	return downloadRequest( request, file, timeout );
 }
 
+// Writes the body of a range response at its offset in the destination file.
+class HttpRangeStream : public IOStream {
+  public:
+	HttpRangeStream( const std::string& path, Uint64 offset, Uint64 length,
+					 std::atomic<Uint64>& received ) :
+		mFile( path, "rb+" ), mLength( length ), mWritten( 0 ), mUnflushed( 0 ),
+		mReceived( received ) {
+		if ( mFile.isOpen() )
+			mFile.seek( offset );
+	}
+
+	~HttpRangeStream() { close(); }
+
+	ios_size read( char*, ios_size ) { return 0; }
+
+	ios_size write( const char* data, ios_size size ) {
+		// Anything past the end of the part is ignored.
+		ios_size length = static_cast<ios_size>( eemin<Uint64>( size, mLength - mWritten ) );
+
+		if ( length > 0 && mFile.write( data, length ) == length ) {
+			mWritten += length;
+			mUnflushed += length;
+
+			// The progress saved in the state file must already be in the file.
+			if ( mUnflushed >= 256 * 1024 )
+				flush();
+		}
+
+		return size;
+	}
+
+	ios_size seek( ios_size ) { return mWritten; }
+
+	ios_size tell() { return mWritten; }
+
+	ios_size getSize() { return mWritten; }
+
+	bool isOpen() { return mFile.isOpen(); }
+
+	void close() {
+		if ( mFile.isOpen() ) {
+			flush();
+			mFile.close();
+		}
+	}
+
+  protected:
+	IOStreamFile mFile;
+	Uint64 mLength;
+	Uint64 mWritten;
+	Uint64 mUnflushed;
+	std::atomic<Uint64>& mReceived;
+
+	void flush() {
+		mFile.flush();
+		mReceived += mUnflushed;
+		mUnflushed = 0;
+	}
+};
+
+struct HttpRangedPart {
+	Uint64 start;
+	Uint64 end; ///< Last byte of the part
+	std::atomic<Uint64> received;
+	Http::Response::Status status;
+};
+
+static const char* RANGED_STATE_HEADER = "eepp-ranged-download 1";
+
+static void saveRangedState( const std::string& path, const std::string& url, Uint64 size,
+							 const std::string& validator,
+							 const std::vector<HttpRangedPart>& parts ) {
+	std::ostringstream out;
+	out << RANGED_STATE_HEADER << "\n" << url << "\n" << size << "\n" << validator << "\n";
+
+	for ( const auto& part : parts )
+		out << part.start << " " << part.end << " " << part.received << "\n";
+
+	// The state is written aside first, a failed write must not lose the previous one. The rename
+	// doesn't replace an existing file on every platform, so the previous state is removed first.
+	std::string data( out.str() );
+	std::string tempPath( path + ".tmp" );
+
+	if ( FileSystem::fileWrite( tempPath, (const Uint8*)data.c_str(), data.size() ) ) {
+		FileSystem::fileRemove( path );
+		std::rename( tempPath.c_str(), path.c_str() );
+	}
+}
+
+static bool loadRangedState( const std::string& path, const std::string& url, Uint64 size,
+							 const std::string& validator,
+							 std::vector<std::pair<Uint64, Uint64>>& ranges,
+							 std::vector<Uint64>& received ) {
+	std::string data;
+
+	if ( !FileSystem::fileGet( path, data ) )
+		return false;
+
+	std::istringstream in( data );
+	std::string header, stateUrl, stateSize, stateValidator;
+
+	if ( !std::getline( in, header ) || header != RANGED_STATE_HEADER ||
+		 !std::getline( in, stateUrl ) || stateUrl != url || !std::getline( in, stateSize ) ||
+		 stateSize != String::toString( size ) || !std::getline( in, stateValidator ) ||
+		 stateValidator != validator )
+		return false;
+
+	Uint64 start, end, bytes, next = 0;
+
+	while ( in >> start >> end >> bytes ) {
+		// The parts must cover the whole file, in order.
+		if ( start != next || end < start || end >= size || bytes > end - start + 1 )
+			return false;
+
+		ranges.push_back( std::make_pair( start, end ) );
+		received.push_back( bytes );
+		next = end + 1;
+	}
+
+	return next == size;
+}
+
+Http::Response Http::downloadRangedRequest( const Http::Request& request,
+											const std::string& writePath,
+											const RangedDownloadOptions& options, Time timeout ) {
+	std::string statePath( writePath + ".download" );
+	std::string url( String::format( "%s://%s:%d%s", mIsSSL ? "https" : "http", mHostName.c_str(),
+									 mPort, request.getUri().c_str() ) );
+
+	auto verify = [&options, &writePath]( Response& response ) {
+		if ( response.getStatus() == Response::Ok && !options.md5.empty() &&
+			 String::toLower( MD5::fromFile( writePath ).toHexString() ) !=
+				 String::toLower( options.md5 ) ) {
+			FileSystem::fileRemove( writePath );
+			response.mStatus = Response::InvalidResponse;
+		}
+
+		return response;
+	};
+
+	auto downloadSingle = [&]() {
+		FileSystem::fileRemove( statePath );
+		Response response( downloadRequest( request, writePath, timeout ) );
+		return verify( response );
+	};
+
+	// Probe the server support for ranges and the size of the file.
+	Request probe( request );
+	probe.setMethod( Request::Head );
+	probe.setContinue( false );
+	probe.setCompressedResponse( false );
+	probe.setProgressCallback( Request::ProgressCallback() );
+	IOStreamString probeBody;
+	Response head( download( probe, probeBody, timeout, Request::FieldTable() ) );
+	Uint64 size = 0;
+
+	if ( head.getStatus() != Response::Ok || head.getField( "accept-ranges" ) != "bytes" ||
+		 !String::fromString( size, head.getField( "content-length" ) ) || size == 0 )
+		return downloadSingle();
+
+	// Parts are only resumed if the remote file is the same. Without an ETag or Last-Modified
+	// there's no way to know it, so the download starts over.
+	std::string validator( head.hasField( "etag" ) ? head.getField( "etag" )
+												   : head.getField( "last-modified" ) );
+	std::vector<std::pair<Uint64, Uint64>> ranges;
+	std::vector<Uint64> resumed;
+
+	if ( validator.empty() || FileSystem::fileSize( writePath ) != size ||
+		 !loadRangedState( statePath, url, size, validator, ranges, resumed ) ) {
+		ranges.clear();
+		resumed.clear();
+
+		IOStreamFile file( writePath, "wb" );
+
+		if ( !file.isOpen() )
+			return Response();
+
+		// Allocate the whole file so every part can be written at its offset.
+		file.seek( size - 1 );
+		file.write( "", 1 );
+
+		Uint64 count = eemax<Uint64>(
+			1, eemin<Uint64>( options.connections,
+							  size / eemax<Uint64>( 1, options.minPartSize ) ) );
+		Uint64 partSize = size / count;
+
+		for ( Uint64 i = 0; i < count; i++ ) {
+			ranges.push_back( std::make_pair(
+				i * partSize, i == count - 1 ? size - 1 : ( i + 1 ) * partSize - 1 ) );
+			resumed.push_back( 0 );
+		}
+	}
+
+	std::vector<HttpRangedPart> parts( ranges.size() );
+
+	for ( size_t i = 0; i < parts.size(); i++ ) {
+		parts[i].start = ranges[i].first;
+		parts[i].end = ranges[i].second;
+		parts[i].received = resumed[i];
+		parts[i].status = Response::PartialContent;
+	}
+
+	saveRangedState( statePath, url, size, validator, parts );
+
+	std::atomic<bool> cancelled( false );
+	std::atomic<bool> changed( false );
+	std::atomic<size_t> running( parts.size() );
+	std::vector<Thread*> threads;
+
+	for ( size_t i = 0; i < parts.size(); i++ ) {
+		Thread* thread = eeNew( Thread, ( [&, i] {
+			HttpRangedPart& part = parts[i];
+			unsigned int failures = 0;
+
+			while ( !cancelled && part.start + part.received <= part.end ) {
+				Uint64 from = part.start + part.received;
+				Http http( mHostName, mPort, mIsSSL, mProxy );
+				http.mHost = mHost;
+				http.mHostSolved = true;
+
+				Request partRequest( request );
+				partRequest.setMethod( Request::Get );
+				partRequest.setContinue( false );
+				partRequest.setCompressedResponse( false );
+				partRequest.setField( "Range",
+									  String::format( "bytes=%llu-%llu", (unsigned long long)from,
+													  (unsigned long long)part.end ) );
+
+				if ( !validator.empty() )
+					partRequest.setField( "If-Range", validator );
+
+				// Only the expected range can be written, a full response means that the remote
+				// file changed.
+				std::string contentRange(
+					String::format( "bytes %llu-", (unsigned long long)from ) );
+				partRequest.setProgressCallback(
+					[&cancelled, &changed, contentRange](
+						const Http&, const Http::Request&, const Http::Response& response,
+						const Http::Request::Status& status, std::size_t, std::size_t ) {
+						if ( status == Request::HeaderReceived &&
+							 ( response.getStatus() != Response::PartialContent ||
+							   !String::startsWith( response.getField( "content-range" ),
+													contentRange ) ) ) {
+							if ( response.getStatus() == Response::Ok )
+								changed = true;
+
+							return false;
+						}
+
+						return !cancelled;
+					} );
+
+				HttpRangeStream stream( writePath, from, part.end + 1 - from, part.received );
+				Response response(
+					http.download( partRequest, stream, timeout, Request::FieldTable() ) );
+				stream.close();
+				part.status = response.getStatus();
+
+				if ( changed || part.start + part.received > part.end ||
+					 ++failures > options.retries )
+					break;
+
+				Sys::sleep( Milliseconds( 100 * failures ) );
+			}
+
+			if ( changed )
+				cancelled = true;
+
+			running--;
+		} ) );
+
+		thread->launch();
+		threads.push_back( thread );
+	}
+
+	Clock saveClock;
+	Uint64 lastReceived = 0;
+
+	while ( running > 0 ) {
+		Sys::sleep( Milliseconds( 10 ) );
+
+		Uint64 received = 0;
+
+		for ( const auto& part : parts )
+			received += part.received;
+
+		if ( received != lastReceived ) {
+			lastReceived = received;
+
+			if ( !sendProgress( *this, request, head, Request::ContentReceived, size, received ) )
+				cancelled = true;
+		}
+
+		if ( request.isCancelled() )
+			cancelled = true;
+
+		if ( saveClock.getElapsedTime() >= Milliseconds( 250 ) ) {
+			saveRangedState( statePath, url, size, validator, parts );
+			saveClock.restart();
+		}
+	}
+
+	for ( auto thread : threads ) {
+		thread->wait();
+		eeDelete( thread );
+	}
+
+	if ( changed )
+		return downloadSingle();
+
+	for ( const auto& part : parts ) {
+		if ( part.start + part.received <= part.end ) {
+			// Keep the progress for the next call.
+			saveRangedState( statePath, url, size, validator, parts );
+			head.mStatus = part.status != Response::Ok ? part.status : Response::PartialContent;
+			return head;
+		}
+	}
+
+	FileSystem::fileRemove( statePath );
+
+	if ( FileSystem::fileSize( writePath ) != size ) {
+		head.mStatus = Response::InvalidResponse;
+		return head;
+	}
+
+	return verify( head );
+}
+
 Http::AsyncRequest::AsyncRequest( Http* http, const Http::AsyncResponseCallback& cb,
 								  Http::Request request, Time timeout ) :
 	mHttp( http ),
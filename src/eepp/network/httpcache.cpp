@@ -0,0 +1,542 @@
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <eepp/core/string.hpp>
+#include <eepp/network/httpcache.hpp>
+#include <eepp/system/filesystem.hpp>
+#include <eepp/system/iostreamfile.hpp>
+#include <sstream>
+
+namespace EE { namespace Network {
+
+// Writes the response body to the request stream and to the file that will be stored in the cache.
+class HttpCacheStream : public IOStream {
+  public:
+	HttpCacheStream( IOStream& writeTo, const std::string& path ) :
+		mWriteTo( writeTo ), mFile( path, "wb" ), mSize( 0 ), mFailed( !mFile.isOpen() ) {}
+
+	ios_size read( char* data, ios_size size ) { return mWriteTo.read( data, size ); }
+
+	ios_size write( const char* data, ios_size size ) {
+		if ( !mFailed && mFile.write( data, size ) != size )
+			mFailed = true;
+
+		mSize += size;
+
+		return mWriteTo.write( data, size );
+	}
+
+	ios_size seek( ios_size position ) {
+		// The stored copy is only valid if it's written sequentially.
+		if ( static_cast<Uint64>( position ) != mSize )
+			mFailed = true;
+
+		return mWriteTo.seek( position );
+	}
+
+	ios_size tell() { return mWriteTo.tell(); }
+
+	ios_size getSize() { return mWriteTo.getSize(); }
+
+	bool isOpen() { return mWriteTo.isOpen(); }
+
+	void close() { mFile.close(); }
+
+	Uint64 getStoredSize() const { return mSize; }
+
+	bool hasFailed() const { return mFailed; }
+
+  protected:
+	IOStream& mWriteTo;
+	IOStreamFile mFile;
+	Uint64 mSize;
+	bool mFailed;
+};
+
+static const char* CACHE_INDEX_NAME = "index";
+static const char* CACHE_INDEX_HEADER = "eepp-http-cache 1";
+
+static bool isStoredField( const std::string& field ) {
+	// The body is stored decoded, and the connection fields only apply to the original response.
+	return field != "connection" && field != "keep-alive" && field != "transfer-encoding" &&
+		   field != "content-encoding" && field != "content-length" && field != "date" &&
+		   field != "age";
+}
+
+static bool hasDirective( const std::string& cacheControl, const std::string& directive ) {
+	for ( auto& part : String::split( cacheControl, ',' ) ) {
+		std::string name( String::trim( part ) );
+		size_t pos = name.find( '=' );
+
+		if ( pos != std::string::npos )
+			name = name.substr( 0, pos );
+
+		if ( String::toLower( String::trim( name ) ) == directive )
+			return true;
+	}
+
+	return false;
+}
+
+static bool getDirectiveValue( const std::string& cacheControl, const std::string& directive,
+							   Int64& value ) {
+	for ( auto& part : String::split( cacheControl, ',' ) ) {
+		std::string item( String::trim( part ) );
+		size_t pos = item.find( '=' );
+
+		if ( pos != std::string::npos &&
+			 String::toLower( String::trim( item.substr( 0, pos ) ) ) == directive )
+			return String::fromString( value, String::trim( item.substr( pos + 1 ), '"' ) );
+	}
+
+	return false;
+}
+
+static Int64 daysFromCivil( Int64 year, unsigned month, unsigned day ) {
+	year -= month <= 2;
+	const Int64 era = ( year >= 0 ? year : year - 399 ) / 400;
+	const unsigned yoe = static_cast<unsigned>( year - era * 400 );
+	const unsigned doy = ( 153 * ( month + ( month > 2 ? -3 : 9 ) ) + 2 ) / 5 + day - 1;
+	const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + static_cast<Int64>( doe ) - 719468;
+}
+
+/** @return The Unix time of an HTTP date ( RFC 1123 format ), 0 if it's not valid */
+static Int64 parseHttpDate( const std::string& date ) {
+	static const char* months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+									"Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+	int day, year, hour, minute, second;
+	char month[4] = { 0 };
+
+	if ( sscanf( date.c_str(), "%*[^,], %d %3s %d %d:%d:%d", &day, month, &year, &hour, &minute,
+				 &second ) != 6 )
+		return 0;
+
+	for ( unsigned i = 0; i < 12; i++ ) {
+		if ( strcmp( months[i], month ) == 0 )
+			return daysFromCivil( year, i + 1, day ) * 86400 + hour * 3600 + minute * 60 +
+				   second;
+	}
+
+	return 0;
+}
+
+HttpCache::HttpCache( const std::string& directory, Uint64 maxSize ) :
+	mDirectory( directory ),
+	mMaxSize( maxSize ),
+	mSize( 0 ),
+	mNextId( 1 ),
+	mDirty( false ),
+	mStats() {
+	FileSystem::dirAddSlashAtEnd( mDirectory );
+
+	if ( !FileSystem::isDirectory( mDirectory ) )
+		FileSystem::makeDir( mDirectory );
+
+	load();
+}
+
+HttpCache::~HttpCache() {
+	flush();
+}
+
+const std::string& HttpCache::getDirectory() const {
+	return mDirectory;
+}
+
+void HttpCache::setMaxSize( Uint64 maxSize ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	mMaxSize = maxSize;
+
+	if ( mSize > mMaxSize ) {
+		while ( mSize > mMaxSize && !mEntries.empty() ) {
+			removeEntry( std::prev( mEntries.end() ) );
+			mStats.evictions++;
+		}
+
+		save();
+	}
+}
+
+Uint64 HttpCache::getMaxSize() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mMaxSize;
+}
+
+Uint64 HttpCache::getSize() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mSize;
+}
+
+size_t HttpCache::getCount() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mEntries.size();
+}
+
+bool HttpCache::contains( const std::string& url ) const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mIndex.find( url ) != mIndex.end();
+}
+
+void HttpCache::remove( const std::string& url ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	auto it = mIndex.find( url );
+
+	if ( it != mIndex.end() ) {
+		removeEntry( it->second );
+		save();
+	}
+}
+
+void HttpCache::clear() {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	while ( !mEntries.empty() )
+		removeEntry( mEntries.begin() );
+
+	save();
+}
+
+void HttpCache::flush() {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	if ( mDirty )
+		save();
+}
+
+HttpCache::Stats HttpCache::getStats() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mStats;
+}
+
+void HttpCache::resetStats() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	mStats = Stats();
+}
+
+bool HttpCache::isCacheable( const Http::Request& request ) {
+	return request.getMethod() == Http::Request::Get && !request.isContinue() &&
+		   !request.hasField( "range" ) &&
+		   !hasDirective( request.getField( "cache-control" ), "no-store" );
+}
+
+Http::Response HttpCache::fetch( Http& http, const Http::Request& request, IOStream& writeTo,
+								 Time timeout ) {
+	std::string url( String::format( "%s://%s:%d%s", http.isSSL() ? "https" : "http",
+									 http.getHostName().c_str(), http.getPort(),
+									 request.getUri().c_str() ) );
+	Int64 now = static_cast<Int64>( std::time( NULL ) );
+	Http::Response::Status status = Http::Response::Ok;
+	Http::Request::FieldTable validators;
+	Entry entry;
+	bool found = find( url, entry );
+
+	if ( found && now < entry.expires &&
+		 !hasDirective( request.getField( "cache-control" ), "no-cache" ) &&
+		 request.getField( "pragma" ) != "no-cache" ) {
+		if ( readBody( entry, writeTo ) ) {
+			std::lock_guard<std::mutex> lock( mMutex );
+			mStats.hits++;
+			mStats.bytesSaved += entry.size;
+			return Http::Response::createFakeResponse( entry.fields, status, "" );
+		}
+
+		remove( url );
+		found = false;
+	}
+
+	if ( found ) {
+		auto etag = entry.fields.find( "etag" );
+		auto lastModified = entry.fields.find( "last-modified" );
+
+		if ( etag != entry.fields.end() )
+			validators["if-none-match"] = etag->second;
+
+		if ( lastModified != entry.fields.end() )
+			validators["if-modified-since"] = lastModified->second;
+	}
+
+	Uint64 id = allocateId();
+	std::string tempPath( getTempPath( id ) );
+	HttpCacheStream stream( writeTo, tempPath );
+	Http::Response response( http.download( request, stream, timeout, validators ) );
+	stream.close();
+
+	if ( found && !validators.empty() && response.getStatus() == Http::Response::NotModified ) {
+		FileSystem::fileRemove( tempPath );
+
+		// The 304 response can carry new freshness information and validators.
+		Http::Response::FieldTable fields( entry.fields );
+		Http::Response::FieldTable current( entry.fields );
+
+		for ( const auto& field : response.getHeaders() ) {
+			current[field.first] = field.second;
+
+			if ( isStoredField( field.first ) )
+				fields[field.first] = field.second;
+		}
+
+		if ( readBody( entry, writeTo ) ) {
+			update( url, getExpiration( current, now ), fields );
+
+			std::lock_guard<std::mutex> lock( mMutex );
+			mStats.revalidations++;
+			mStats.bytesSaved += entry.size;
+			return Http::Response::createFakeResponse( fields, status, "" );
+		}
+
+		remove( url );
+		return response;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mStats.misses++;
+	}
+
+	Http::Response::FieldTable headers( response.getHeaders() );
+	auto cacheControl = headers.find( "cache-control" );
+	auto vary = headers.find( "vary" );
+	Int64 expires = getExpiration( headers, now );
+
+	bool storable =
+		response.getStatus() == Http::Response::Ok && !stream.hasFailed() &&
+		!request.isCancelled() &&
+		( cacheControl == headers.end() || !hasDirective( cacheControl->second, "no-store" ) ) &&
+		( vary == headers.end() || vary->second != "*" ) &&
+		( expires > now || headers.find( "etag" ) != headers.end() ||
+		  headers.find( "last-modified" ) != headers.end() );
+
+	if ( !storable || std::rename( tempPath.c_str(), getEntryPath( id ).c_str() ) != 0 ) {
+		FileSystem::fileRemove( tempPath );
+		return response;
+	}
+
+	Http::Response::FieldTable fields;
+
+	for ( const auto& field : headers )
+		if ( isStoredField( field.first ) )
+			fields[field.first] = field.second;
+
+	fields["content-length"] = String::toString( stream.getStoredSize() );
+
+	store( url, id, stream.getStoredSize(), expires, fields );
+
+	return response;
+}
+
+bool HttpCache::find( const std::string& url, Entry& entry ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	auto it = mIndex.find( url );
+
+	if ( it == mIndex.end() )
+		return false;
+
+	mEntries.splice( mEntries.begin(), mEntries, it->second );
+	mDirty = true;
+	entry = *it->second;
+
+	return true;
+}
+
+Uint64 HttpCache::allocateId() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mNextId++;
+}
+
+void HttpCache::store( const std::string& url, Uint64 id, Uint64 size, Int64 expires,
+					   const Http::Response::FieldTable& fields ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	auto it = mIndex.find( url );
+
+	if ( it != mIndex.end() )
+		removeEntry( it->second );
+
+	if ( size > mMaxSize ) {
+		FileSystem::fileRemove( getEntryPath( id ) );
+		save();
+		return;
+	}
+
+	while ( mSize + size > mMaxSize && !mEntries.empty() ) {
+		removeEntry( std::prev( mEntries.end() ) );
+		mStats.evictions++;
+	}
+
+	mEntries.push_front( { url, id, size, expires, fields } );
+	mIndex[url] = mEntries.begin();
+	mSize += size;
+	mStats.stores++;
+
+	save();
+}
+
+void HttpCache::update( const std::string& url, Int64 expires,
+						const Http::Response::FieldTable& fields ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	auto it = mIndex.find( url );
+
+	if ( it != mIndex.end() ) {
+		it->second->expires = expires;
+		it->second->fields = fields;
+		save();
+	}
+}
+
+bool HttpCache::readBody( const Entry& entry, IOStream& writeTo ) {
+	// Bodies are never modified once stored, a new version is stored with a new id.
+	IOStreamFile file( getEntryPath( entry.id ) );
+
+	if ( !file.isOpen() || static_cast<Uint64>( file.getSize() ) != entry.size )
+		return false;
+
+	char buffer[16384];
+	ios_size read;
+
+	while ( ( read = file.read( buffer, sizeof( buffer ) ) ) > 0 )
+		writeTo.write( buffer, read );
+
+	return true;
+}
+
+void HttpCache::removeEntry( EntryList::iterator it ) {
+	FileSystem::fileRemove( getEntryPath( it->id ) );
+	mSize -= it->size;
+	mIndex.erase( it->url );
+	mEntries.erase( it );
+}
+
+std::string HttpCache::getEntryPath( Uint64 id ) const {
+	return mDirectory + "entry-" + String::toString( id );
+}
+
+std::string HttpCache::getTempPath( Uint64 id ) const {
+	return mDirectory + "tmp-" + String::toString( id );
+}
+
+void HttpCache::load() {
+	std::string data;
+
+	if ( FileSystem::fileGet( mDirectory + CACHE_INDEX_NAME, data ) ) {
+		std::istringstream in( data );
+		std::string line;
+		Entry* entry = NULL;
+
+		if ( std::getline( in, line ) && line == CACHE_INDEX_HEADER ) {
+			// Index lines: "E\tid\tsize\texpires\turl", followed by its fields "F\tname\tvalue".
+			while ( std::getline( in, line ) ) {
+				if ( String::startsWith( line, "F\t" ) ) {
+					size_t pos = line.find( '\t', 2 );
+
+					if ( NULL != entry && pos != std::string::npos )
+						entry->fields[line.substr( 2, pos - 2 )] = line.substr( pos + 1 );
+
+					continue;
+				}
+
+				std::vector<std::string> parts( String::split( line, '\t', true ) );
+
+				if ( parts.size() == 5 && parts[0] == "E" ) {
+					Entry newEntry;
+					newEntry.url = parts[4];
+
+					if ( !String::fromString( newEntry.id, parts[1] ) ||
+						 !String::fromString( newEntry.size, parts[2] ) ||
+						 !String::fromString( newEntry.expires, parts[3] ) ||
+						 mIndex.find( newEntry.url ) != mIndex.end() ||
+						 FileSystem::fileSize( getEntryPath( newEntry.id ) ) != newEntry.size ) {
+						entry = NULL;
+						continue;
+					}
+
+					mEntries.push_back( newEntry );
+					mIndex[newEntry.url] = std::prev( mEntries.end() );
+					mSize += newEntry.size;
+					mNextId = eemax( mNextId, newEntry.id + 1 );
+					entry = &mEntries.back();
+				}
+			}
+		}
+	}
+
+	// Remove the bodies that are not in the index, like the ones of interrupted downloads.
+	for ( const auto& file : FileSystem::filesGetInPath( mDirectory ) ) {
+		Uint64 id = 0;
+		bool isEntry = String::startsWith( file, "entry-" );
+
+		if ( ( isEntry || String::startsWith( file, "tmp-" ) ) &&
+			 ( !isEntry || !String::fromString( id, file.substr( 6 ) ) ||
+			   std::none_of( mEntries.begin(), mEntries.end(),
+							 [id]( const Entry& entry ) { return entry.id == id; } ) ) )
+			FileSystem::fileRemove( mDirectory + file );
+	}
+
+	while ( mSize > mMaxSize && !mEntries.empty() )
+		removeEntry( std::prev( mEntries.end() ) );
+}
+
+void HttpCache::save() {
+	std::ostringstream out;
+
+	out << CACHE_INDEX_HEADER << "\n";
+
+	for ( const auto& entry : mEntries ) {
+		out << "E\t" << entry.id << "\t" << entry.size << "\t" << entry.expires << "\t"
+			<< entry.url << "\n";
+
+		for ( const auto& field : entry.fields )
+			out << "F\t" << field.first << "\t" << field.second << "\n";
+	}
+
+	std::string data( out.str() );
+	FileSystem::fileWrite( mDirectory + CACHE_INDEX_NAME, (const Uint8*)data.c_str(),
+						   data.size() );
+	mDirty = false;
+}
+
+Int64 HttpCache::getExpiration( const Http::Response::FieldTable& fields, Int64 now ) {
+	auto get = [&fields]( const std::string& name ) -> std::string {
+		auto it = fields.find( name );
+		return it != fields.end() ? it->second : "";
+	};
+
+	std::string cacheControl( get( "cache-control" ) );
+	Int64 maxAge;
+
+	if ( hasDirective( cacheControl, "no-cache" ) || hasDirective( cacheControl, "no-store" ) )
+		return now;
+
+	Int64 age = 0;
+	String::fromString( age, get( "age" ) );
+
+	if ( getDirectiveValue( cacheControl, "max-age", maxAge ) )
+		return now + maxAge - age;
+
+	// Expires is relative to the server clock, so it's applied as a lifetime from its Date.
+	Int64 date = parseHttpDate( get( "date" ) );
+	std::string expiresField( get( "expires" ) );
+
+	if ( !expiresField.empty() ) {
+		Int64 expires = parseHttpDate( expiresField );
+
+		if ( expires == 0 )
+			return now;
+
+		return date > 0 ? now + expires - date - age : expires;
+	}
+
+	// Without explicit freshness, use a tenth of the time since the last modification.
+	Int64 lastModified = parseHttpDate( get( "last-modified" ) );
+
+	if ( lastModified > 0 && date > lastModified )
+		return now + eemin<Int64>( ( date - lastModified ) / 10, 86400 );
+
+	return now;
+}
+
+}} // namespace EE::Network
@@ -0,0 +1,51 @@
+#include <eepp/network/packet.hpp>
+#include <eepp/network/packetpool.hpp>
+
+namespace EE { namespace Network {
+
+PacketPool::PacketPool( std::size_t maxFreePackets ) : mMaxFreePackets( maxFreePackets ) {}
+
+PacketPool::~PacketPool() {
+	for ( auto& packet : mFree )
+		eeSAFE_DELETE( packet );
+}
+
+Packet* PacketPool::acquire() {
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+
+		if ( !mFree.empty() ) {
+			Packet* packet = mFree.back();
+			mFree.pop_back();
+			return packet;
+		}
+	}
+
+	return eeNew( Packet, () );
+}
+
+void PacketPool::release( Packet* packet ) {
+	if ( NULL == packet )
+		return;
+
+	// Clearing the packet keeps the capacity of its data
+	packet->clear();
+
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+
+		if ( mFree.size() < mMaxFreePackets ) {
+			mFree.push_back( packet );
+			return;
+		}
+	}
+
+	eeSAFE_DELETE( packet );
+}
+
+std::size_t PacketPool::getFreeCount() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mFree.size();
+}
+
+}} // namespace EE::Network
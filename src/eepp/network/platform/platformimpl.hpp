@@ -4,8 +4,10 @@
 #include <eepp/config.hpp>
 
 #if defined( EE_PLATFORM_POSIX )
+#include <eepp/network/platform/unix/pollerimpl.hpp>
 #include <eepp/network/platform/unix/socketimpl.hpp>
 #elif EE_PLATFORM == EE_PLATFORM_WIN
+#include <eepp/network/platform/win/pollerimpl.hpp>
 #include <eepp/network/platform/win/socketimpl.hpp>
 #else
 #error Sockets not implemented for this platform
@@ -0,0 +1,223 @@
+#include <eepp/network/platform/unix/pollerimpl.hpp>
+
+#if defined( EE_PLATFORM_POSIX )
+
+#include <errno.h>
+#include <unistd.h>
+
+namespace EE { namespace Network { namespace Private {
+
+#ifdef EE_NETWORK_EPOLL
+
+static Uint32 toEpollEvents( Uint32 events, bool edgeTriggered ) {
+	Uint32 flags = EPOLLRDHUP;
+
+	if ( events & SocketPoller::Read )
+		flags |= EPOLLIN;
+
+	if ( events & SocketPoller::Write )
+		flags |= EPOLLOUT;
+
+	if ( edgeTriggered )
+		flags |= EPOLLET;
+
+	return flags;
+}
+
+PollerImpl::PollerImpl( bool edgeTriggered ) :
+	mEdgeTriggered( edgeTriggered ), mEpoll( epoll_create1( EPOLL_CLOEXEC ) ) {}
+
+PollerImpl::~PollerImpl() {
+	if ( -1 != mEpoll )
+		::close( mEpoll );
+}
+
+bool PollerImpl::isValid() const {
+	return -1 != mEpoll;
+}
+
+bool PollerImpl::isEdgeTriggered() const {
+	return mEdgeTriggered;
+}
+
+bool PollerImpl::add( SocketHandle handle, Uint32 events ) {
+	epoll_event event;
+	event.events = toEpollEvents( events, mEdgeTriggered );
+	event.data.u64 = 0;
+	event.data.fd = handle;
+	return 0 == epoll_ctl( mEpoll, EPOLL_CTL_ADD, handle, &event );
+}
+
+bool PollerImpl::modify( SocketHandle handle, Uint32 events ) {
+	epoll_event event;
+	event.events = toEpollEvents( events, mEdgeTriggered );
+	event.data.u64 = 0;
+	event.data.fd = handle;
+	return 0 == epoll_ctl( mEpoll, EPOLL_CTL_MOD, handle, &event );
+}
+
+void PollerImpl::remove( SocketHandle handle ) {
+	// Kernels before 2.6.9 require a non-null event even if it's ignored.
+	epoll_event event;
+	epoll_ctl( mEpoll, EPOLL_CTL_DEL, handle, &event );
+}
+
+int PollerImpl::wait( size_t maxEvents, int timeout ) {
+	mReady.clear();
+
+	mEvents.resize( maxEvents );
+
+	int count;
+
+	do {
+		count = epoll_wait( mEpoll, mEvents.data(), (int)maxEvents, timeout );
+	} while ( -1 == count && EINTR == errno && -1 == timeout );
+
+	for ( int i = 0; i < count; i++ ) {
+		Uint32 flags = mEvents[i].events;
+		Uint32 events = 0;
+
+		if ( flags & EPOLLIN )
+			events |= SocketPoller::Read;
+
+		if ( flags & EPOLLOUT )
+			events |= SocketPoller::Write;
+
+		if ( flags & ( EPOLLHUP | EPOLLRDHUP ) )
+			events |= SocketPoller::Hangup;
+
+		if ( flags & EPOLLERR )
+			events |= SocketPoller::Error;
+
+		mReady.push_back( {mEvents[i].data.fd, events} );
+	}
+
+	return count;
+}
+
+#else
+
+static short toPollEvents( Uint32 events ) {
+	short flags = 0;
+
+	if ( events & SocketPoller::Read )
+		flags |= POLLIN;
+
+	if ( events & SocketPoller::Write )
+		flags |= POLLOUT;
+
+	return flags;
+}
+
+PollerImpl::PollerImpl( bool ) : mEdgeTriggered( false ), mStart( 0 ) {}
+
+PollerImpl::~PollerImpl() {}
+
+bool PollerImpl::isValid() const {
+	return true;
+}
+
+bool PollerImpl::isEdgeTriggered() const {
+	return mEdgeTriggered;
+}
+
+bool PollerImpl::add( SocketHandle handle, Uint32 events ) {
+	if ( mIndex.find( handle ) != mIndex.end() )
+		return false;
+
+	pollfd fd;
+	fd.fd = handle;
+	fd.events = toPollEvents( events );
+	fd.revents = 0;
+
+	mIndex[handle] = mPollFds.size();
+	mPollFds.push_back( fd );
+
+	return true;
+}
+
+bool PollerImpl::modify( SocketHandle handle, Uint32 events ) {
+	auto it = mIndex.find( handle );
+
+	if ( it == mIndex.end() )
+		return false;
+
+	mPollFds[it->second].events = toPollEvents( events );
+
+	return true;
+}
+
+void PollerImpl::remove( SocketHandle handle ) {
+	auto it = mIndex.find( handle );
+
+	if ( it == mIndex.end() )
+		return;
+
+	size_t index = it->second;
+
+	mIndex.erase( it );
+
+	if ( index != mPollFds.size() - 1 ) {
+		mPollFds[index] = mPollFds.back();
+		mIndex[mPollFds[index].fd] = index;
+	}
+
+	mPollFds.pop_back();
+}
+
+int PollerImpl::wait( size_t maxEvents, int timeout ) {
+	mReady.clear();
+
+	int count;
+
+	do {
+		count = poll( mPollFds.data(), mPollFds.size(), timeout );
+	} while ( -1 == count && EINTR == errno && -1 == timeout );
+
+	if ( count <= 0 )
+		return count;
+
+	// Start where the previous batch stopped, so the first sockets can't starve the rest.
+	size_t size = mPollFds.size();
+	size_t n = 0;
+	int found = 0;
+
+	for ( ; n < size && found < count && (size_t)found < maxEvents; n++ ) {
+		size_t i = ( mStart + n ) % size;
+		short flags = mPollFds[i].revents;
+
+		if ( 0 == flags )
+			continue;
+
+		Uint32 events = 0;
+
+		if ( flags & POLLIN )
+			events |= SocketPoller::Read;
+
+		if ( flags & POLLOUT )
+			events |= SocketPoller::Write;
+
+		if ( flags & POLLHUP )
+			events |= SocketPoller::Hangup;
+
+		if ( flags & ( POLLERR | POLLNVAL ) )
+			events |= SocketPoller::Error;
+
+		mReady.push_back( {mPollFds[i].fd, events} );
+		found++;
+	}
+
+	mStart = ( mStart + n ) % size;
+
+	return found;
+}
+
+#endif
+
+const std::vector<PollerImpl::Ready>& PollerImpl::getReady() const {
+	return mReady;
+}
+
+}}} // namespace EE::Network::Private
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef EE_NETWORKCPOLLERIMPL_UNIX_HPP
+#define EE_NETWORKCPOLLERIMPL_UNIX_HPP
+
+#include <eepp/config.hpp>
+
+#if defined( EE_PLATFORM_POSIX )
+
+#include <eepp/network/socketpoller.hpp>
+#include <unordered_map>
+#include <vector>
+
+#if EE_PLATFORM == EE_PLATFORM_LINUX || EE_PLATFORM == EE_PLATFORM_ANDROID
+#define EE_NETWORK_EPOLL
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+namespace EE { namespace Network { namespace Private {
+
+/** @brief Helper class implementing the non-portable socket polling; this is the Unix version.
+**  Uses epoll on Linux and Android, and poll() on the other Unix platforms. */
+class PollerImpl {
+  public:
+	struct Ready {
+		SocketHandle handle;
+		Uint32 events;
+	};
+
+	/** @param edgeTriggered Report only the readiness changes. Only supported by epoll, the
+	**  poll() fallback is always level-triggered. */
+	PollerImpl( bool edgeTriggered );
+
+	~PollerImpl();
+
+	/** @return True if the poller is ready to be used */
+	bool isValid() const;
+
+	/** @return True if the edge-triggered mode is honored */
+	bool isEdgeTriggered() const;
+
+	/** Start watching the socket for the SocketPoller::EventFlags events */
+	bool add( SocketHandle handle, Uint32 events );
+
+	/** Change the events watched for an already added socket */
+	bool modify( SocketHandle handle, Uint32 events );
+
+	void remove( SocketHandle handle );
+
+	/** Wait up to timeout milliseconds ( -1 for infinity ) for up to maxEvents ready sockets.
+	**  @return The number of ready sockets, or -1 on error */
+	int wait( size_t maxEvents, int timeout );
+
+	/** @return The sockets found ready by the last wait */
+	const std::vector<Ready>& getReady() const;
+
+  private:
+	std::vector<Ready> mReady;
+	bool mEdgeTriggered;
+#ifdef EE_NETWORK_EPOLL
+	int mEpoll;
+	std::vector<epoll_event> mEvents;
+#else
+	std::vector<pollfd> mPollFds;
+	std::unordered_map<SocketHandle, size_t> mIndex;
+	size_t mStart;
+#endif
+};
+
+}}} // namespace EE::Network::Private
+
+#endif
+
+#endif // EE_NETWORKCPOLLERIMPL_UNIX_HPP
@@ -5,6 +5,7 @@
 #include <cstring>
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/uio.h>
 #if EE_PLATFORM == EE_PLATFORM_HAIKU
 #include <posix/sys/time.h>
 #endif
@@ -82,6 +83,29 @@ void SocketImpl::setReceiveTimeout( SocketHandle sock, const Time& timeout ) {
 	setsockopt( sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&time, sizeof time );
 }
 
+int SocketImpl::send( SocketHandle sock, const Buffer* buffers, std::size_t count ) {
+	iovec iov[MaxBuffers];
+	msghdr message;
+	std::memset( &message, 0, sizeof( message ) );
+
+	count = eemin<std::size_t>( count, MaxBuffers );
+
+	for ( std::size_t i = 0; i < count; i++ ) {
+		iov[i].iov_base = const_cast<void*>( buffers[i].data );
+		iov[i].iov_len = buffers[i].size;
+	}
+
+	message.msg_iov = iov;
+	message.msg_iovlen = count;
+
+	// sendmsg instead of writev, so the flags avoid the SIGPIPE on disconnection.
+#if EE_PLATFORM == EE_PLATFORM_LINUX
+	return static_cast<int>( sendmsg( sock, &message, MSG_NOSIGNAL ) );
+#else
+	return static_cast<int>( sendmsg( sock, &message, 0 ) );
+#endif
+}
+
 }}} // namespace EE::Network::Private
 
 #endif
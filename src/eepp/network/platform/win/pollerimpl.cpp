@@ -0,0 +1,144 @@
+#include <eepp/config.hpp>
+
+#if EE_PLATFORM == EE_PLATFORM_WIN
+
+// WSAPoll is only declared for Windows Vista and newer.
+#ifdef _WIN32_WINNT
+#undef _WIN32_WINNT
+#endif
+#define _WIN32_WINNT 0x0600
+#include <winsock2.h>
+
+#include <eepp/network/platform/win/pollerimpl.hpp>
+
+namespace EE { namespace Network { namespace Private {
+
+static short toPollEvents( Uint32 events ) {
+	short flags = 0;
+
+	if ( events & SocketPoller::Read )
+		flags |= POLLRDNORM;
+
+	if ( events & SocketPoller::Write )
+		flags |= POLLWRNORM;
+
+	return flags;
+}
+
+PollerImpl::PollerImpl( bool ) : mStart( 0 ) {
+	static_assert( sizeof( PollFd ) == sizeof( WSAPOLLFD ), "PollFd must match WSAPOLLFD" );
+}
+
+PollerImpl::~PollerImpl() {}
+
+bool PollerImpl::isValid() const {
+	return true;
+}
+
+bool PollerImpl::isEdgeTriggered() const {
+	return false;
+}
+
+bool PollerImpl::add( SocketHandle handle, Uint32 events ) {
+	if ( mIndex.find( handle ) != mIndex.end() )
+		return false;
+
+	PollFd fd;
+	fd.fd = handle;
+	fd.events = toPollEvents( events );
+	fd.revents = 0;
+
+	mIndex[handle] = mPollFds.size();
+	mPollFds.push_back( fd );
+
+	return true;
+}
+
+bool PollerImpl::modify( SocketHandle handle, Uint32 events ) {
+	auto it = mIndex.find( handle );
+
+	if ( it == mIndex.end() )
+		return false;
+
+	mPollFds[it->second].events = toPollEvents( events );
+
+	return true;
+}
+
+void PollerImpl::remove( SocketHandle handle ) {
+	auto it = mIndex.find( handle );
+
+	if ( it == mIndex.end() )
+		return;
+
+	size_t index = it->second;
+
+	mIndex.erase( it );
+
+	if ( index != mPollFds.size() - 1 ) {
+		mPollFds[index] = mPollFds.back();
+		mIndex[mPollFds[index].fd] = index;
+	}
+
+	mPollFds.pop_back();
+}
+
+int PollerImpl::wait( size_t maxEvents, int timeout ) {
+	mReady.clear();
+
+	// WSAPoll fails with an empty set instead of waiting.
+	if ( mPollFds.empty() ) {
+		if ( timeout != 0 )
+			Sleep( timeout < 0 ? INFINITE : (DWORD)timeout );
+
+		return 0;
+	}
+
+	int count = WSAPoll( reinterpret_cast<WSAPOLLFD*>( mPollFds.data() ),
+						 (ULONG)mPollFds.size(), timeout );
+
+	if ( count <= 0 )
+		return count == SOCKET_ERROR ? -1 : 0;
+
+	// Start where the previous batch stopped, so the first sockets can't starve the rest.
+	size_t size = mPollFds.size();
+	size_t n = 0;
+	int found = 0;
+
+	for ( ; n < size && found < count && (size_t)found < maxEvents; n++ ) {
+		size_t i = ( mStart + n ) % size;
+		short flags = mPollFds[i].revents;
+
+		if ( 0 == flags )
+			continue;
+
+		Uint32 events = 0;
+
+		if ( flags & POLLRDNORM )
+			events |= SocketPoller::Read;
+
+		if ( flags & POLLWRNORM )
+			events |= SocketPoller::Write;
+
+		if ( flags & POLLHUP )
+			events |= SocketPoller::Hangup;
+
+		if ( flags & ( POLLERR | POLLNVAL ) )
+			events |= SocketPoller::Error;
+
+		mReady.push_back( {mPollFds[i].fd, events} );
+		found++;
+	}
+
+	mStart = ( mStart + n ) % size;
+
+	return found;
+}
+
+const std::vector<PollerImpl::Ready>& PollerImpl::getReady() const {
+	return mReady;
+}
+
+}}} // namespace EE::Network::Private
+
+#endif
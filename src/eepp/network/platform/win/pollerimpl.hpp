@@ -0,0 +1,67 @@
+#ifndef EE_NETWORKCPOLLERIMPL_WIN_HPP
+#define EE_NETWORKCPOLLERIMPL_WIN_HPP
+
+#include <eepp/config.hpp>
+
+#if EE_PLATFORM == EE_PLATFORM_WIN
+
+#include <eepp/network/socketpoller.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace EE { namespace Network { namespace Private {
+
+/** @brief Helper class implementing the non-portable socket polling; this is the Windows version.
+**  Uses WSAPoll, which is always level-triggered. */
+class PollerImpl {
+  public:
+	struct Ready {
+		SocketHandle handle;
+		Uint32 events;
+	};
+
+	/** @param edgeTriggered Ignored, WSAPoll is always level-triggered. */
+	PollerImpl( bool edgeTriggered );
+
+	~PollerImpl();
+
+	/** @return True if the poller is ready to be used */
+	bool isValid() const;
+
+	/** @return True if the edge-triggered mode is honored */
+	bool isEdgeTriggered() const;
+
+	/** Start watching the socket for the SocketPoller::EventFlags events */
+	bool add( SocketHandle handle, Uint32 events );
+
+	/** Change the events watched for an already added socket */
+	bool modify( SocketHandle handle, Uint32 events );
+
+	void remove( SocketHandle handle );
+
+	/** Wait up to timeout milliseconds ( -1 for infinity ) for up to maxEvents ready sockets.
+	**  @return The number of ready sockets, or -1 on error */
+	int wait( size_t maxEvents, int timeout );
+
+	/** @return The sockets found ready by the last wait */
+	const std::vector<Ready>& getReady() const;
+
+  private:
+	std::vector<Ready> mReady;
+	/** Same layout as WSAPOLLFD, which can't be declared here without winsock2.h */
+	struct PollFd {
+		SocketHandle fd;
+		short events;
+		short revents;
+	};
+
+	std::vector<PollFd> mPollFds;
+	std::unordered_map<SocketHandle, size_t> mIndex;
+	size_t mStart;
+};
+
+}}} // namespace EE::Network::Private
+
+#endif
+
+#endif // EE_NETWORKCPOLLERIMPL_WIN_HPP
@@ -61,6 +61,24 @@ void SocketImpl::setReceiveTimeout( SocketHandle sock, const Time& timeout ) {
 	setsockopt( sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&time, sizeof time );
 }
 
+int SocketImpl::send( SocketHandle sock, const Buffer* buffers, std::size_t count ) {
+	WSABUF wsaBuffers[MaxBuffers];
+	DWORD sent = 0;
+
+	count = eemin<std::size_t>( count, MaxBuffers );
+
+	for ( std::size_t i = 0; i < count; i++ ) {
+		wsaBuffers[i].buf = const_cast<char*>( static_cast<const char*>( buffers[i].data ) );
+		wsaBuffers[i].len = static_cast<ULONG>( buffers[i].size );
+	}
+
+	if ( WSASend( sock, wsaBuffers, static_cast<DWORD>( count ), &sent, 0, NULL, NULL ) ==
+		 SOCKET_ERROR )
+		return -1;
+
+	return static_cast<int>( sent );
+}
+
 /** Windows needs some initialization and cleanup to get
 **  sockets working properly... so let's create a class that will do it automatically */
 struct SocketInitializer {
@@ -58,6 +58,22 @@ class SocketImpl {
 
 	/** Set the receive timeout */
 	static void setReceiveTimeout( SocketHandle sock, const Time& timeout );
+
+	/** @brief Memory block of a gathered send */
+	struct Buffer {
+		const void* data;
+		std::size_t size;
+	};
+
+	/** @brief Maximum number of buffers sent by a single call to send */
+	enum { MaxBuffers = 16 };
+
+	/** @brief  Send several memory blocks with a single system call, without copying them
+	**  @param sock Handle of the socket
+	**  @param buffers Blocks to send, in order
+	**  @param count Number of blocks, at most MaxBuffers
+	**  @return Number of bytes sent, or -1 on error */
+	static int send( SocketHandle sock, const Buffer* buffers, std::size_t count );
 };
 
 }}} // namespace EE::Network::Private
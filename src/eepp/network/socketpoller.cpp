@@ -0,0 +1,261 @@
+#include <eepp/network/platform/platformimpl.hpp>
+#include <eepp/network/socket.hpp>
+#include <eepp/network/socketpoller.hpp>
+
+namespace EE { namespace Network {
+
+SocketPoller::SocketPoller( Mode mode, size_t maxEvents, Time timerResolution,
+							Uint32 timerSlots ) :
+	mImpl( eeNew( Private::PollerImpl, ( mode == EdgeTriggered ) ) ),
+	mMode( mImpl->isEdgeTriggered() ? EdgeTriggered : LevelTriggered ),
+	mMaxEvents( eemax<size_t>( 1, maxEvents ) ),
+	mResolution( eemax<Int64>( 1, timerResolution.asMicroseconds() ) ),
+	mWheel( eemax<Uint32>( 1, timerSlots ) ),
+	mTick( 0 ),
+	mArmedTimers( 0 ),
+	mTimerId( 0 ) {}
+
+SocketPoller::~SocketPoller() {
+	eeSAFE_DELETE( mImpl );
+}
+
+SocketPoller::Mode SocketPoller::getMode() const {
+	return mMode;
+}
+
+bool SocketPoller::add( Socket& socket, Uint32 events, void* userData ) {
+	SocketHandle handle = socket.getHandle();
+
+	if ( handle == Private::SocketImpl::invalidSocket() || !mImpl->isValid() ||
+		 mEntries.find( handle ) != mEntries.end() || !mImpl->add( handle, events ) )
+		return false;
+
+	Entry& entry = mEntries[handle];
+	entry.socket = &socket;
+	entry.userData = userData;
+	entry.events = events;
+	entry.timeout = 0;
+	entry.lastActivity = getCurrentTick();
+	entry.timerId = 0;
+	entry.timerArmed = false;
+
+	return true;
+}
+
+bool SocketPoller::modify( Socket& socket, Uint32 events ) {
+	Entry* entry = getEntry( socket );
+
+	if ( NULL == entry || !mImpl->modify( socket.getHandle(), events ) )
+		return false;
+
+	entry->events = events;
+
+	return true;
+}
+
+void SocketPoller::remove( Socket& socket ) {
+	SocketHandle handle = socket.getHandle();
+	auto it = mEntries.find( handle );
+
+	if ( it == mEntries.end() )
+		return;
+
+	// The timers of the socket are dropped lazily, when its wheel slot is reached.
+	if ( it->second.timerArmed )
+		mArmedTimers--;
+
+	mEntries.erase( it );
+	mImpl->remove( handle );
+}
+
+void SocketPoller::clear() {
+	for ( auto& entry : mEntries )
+		mImpl->remove( entry.first );
+
+	mEntries.clear();
+	mEvents.clear();
+
+	for ( auto& slot : mWheel )
+		slot.clear();
+
+	mArmedTimers = 0;
+}
+
+bool SocketPoller::contains( Socket& socket ) const {
+	return NULL != getEntry( socket );
+}
+
+size_t SocketPoller::getSocketCount() const {
+	return mEntries.size();
+}
+
+void SocketPoller::setUserData( Socket& socket, void* userData ) {
+	Entry* entry = getEntry( socket );
+
+	if ( NULL != entry )
+		entry->userData = userData;
+}
+
+void* SocketPoller::getUserData( Socket& socket ) const {
+	const Entry* entry = getEntry( socket );
+	return NULL != entry ? entry->userData : NULL;
+}
+
+void SocketPoller::setTimeout( Socket& socket, const Time& timeout ) {
+	Entry* entry = getEntry( socket );
+
+	if ( NULL == entry )
+		return;
+
+	// Invalidate the timers already scheduled for the socket. Ids are never reused, so the timers
+	// left by a removed socket can't match a new socket with the same handle.
+	entry->timerId = ++mTimerId;
+
+	if ( entry->timerArmed ) {
+		entry->timerArmed = false;
+		mArmedTimers--;
+	}
+
+	entry->timeout = timeout > Time::Zero
+						 ? ( timeout.asMicroseconds() + mResolution - 1 ) / mResolution
+						 : 0;
+
+	if ( entry->timeout > 0 ) {
+		Uint64 now = getCurrentTick();
+		entry->lastActivity = now;
+		schedule( socket.getHandle(), *entry, now + entry->timeout );
+	}
+}
+
+size_t SocketPoller::wait( Time timeout ) {
+	mEvents.clear();
+
+	Time start( mClock.getElapsedTime() );
+	Int64 tickMs = eemax<Int64>( 1, ( mResolution + 999 ) / 1000 );
+
+	do {
+		int waitMs = -1;
+
+		if ( timeout != Time::Zero ) {
+			Int64 remaining =
+				( timeout - ( mClock.getElapsedTime() - start ) ).asMicroseconds();
+			waitMs = (int)eemax<Int64>( 0, ( remaining + 999 ) / 1000 );
+		}
+
+		// Wake up every tick while there are timeouts pending.
+		if ( mArmedTimers > 0 )
+			waitMs = waitMs < 0 ? (int)tickMs : (int)eemin<Int64>( waitMs, tickMs );
+
+		int count = mImpl->wait( mMaxEvents, waitMs );
+
+		if ( count < 0 )
+			break;
+
+		Uint64 now = getCurrentTick();
+
+		for ( const auto& ready : mImpl->getReady() ) {
+			auto it = mEntries.find( ready.handle );
+
+			if ( it == mEntries.end() )
+				continue;
+
+			Entry& entry = it->second;
+			entry.lastActivity = now;
+
+			// A socket that already timed out is watched again after its next event.
+			if ( entry.timeout > 0 && !entry.timerArmed )
+				schedule( ready.handle, entry, now + entry.timeout );
+
+			mEvents.push_back( {entry.socket, entry.userData, ready.events} );
+		}
+
+		expireTimers( now );
+	} while ( mEvents.empty() &&
+			  ( timeout == Time::Zero || mClock.getElapsedTime() - start < timeout ) );
+
+	return mEvents.size();
+}
+
+const std::vector<SocketPoller::Event>& SocketPoller::getEvents() const {
+	return mEvents;
+}
+
+SocketPoller::Entry* SocketPoller::getEntry( Socket& socket ) {
+	auto it = mEntries.find( socket.getHandle() );
+	return it != mEntries.end() ? &it->second : NULL;
+}
+
+const SocketPoller::Entry* SocketPoller::getEntry( Socket& socket ) const {
+	auto it = mEntries.find( socket.getHandle() );
+	return it != mEntries.end() ? &it->second : NULL;
+}
+
+Uint64 SocketPoller::getCurrentTick() const {
+	return (Uint64)( mClock.getElapsedTime().asMicroseconds() / mResolution );
+}
+
+void SocketPoller::schedule( SocketHandle handle, Entry& entry, Uint64 deadline ) {
+	// The current tick was already processed, the earliest slot is the next one.
+	deadline = eemax( deadline, mTick + 1 );
+
+	mWheel[deadline % mWheel.size()].push_back( {handle, entry.timerId, deadline} );
+
+	if ( !entry.timerArmed ) {
+		entry.timerArmed = true;
+		mArmedTimers++;
+	}
+}
+
+void SocketPoller::expireTimers( Uint64 now ) {
+	if ( now <= mTick )
+		return;
+
+	// After a full turn every slot has been visited, older ticks don't need to be replayed.
+	Uint64 ticks = eemin<Uint64>( now - mTick, mWheel.size() );
+
+	for ( Uint64 i = 1; i <= ticks; i++ ) {
+		std::vector<Timer>& slot = mWheel[( mTick + i ) % mWheel.size()];
+		size_t kept = 0;
+
+		for ( size_t t = 0; t < slot.size(); t++ ) {
+			const Timer& timer = slot[t];
+
+			// Scheduled for a later turn of the wheel.
+			if ( timer.deadline > now ) {
+				slot[kept++] = timer;
+				continue;
+			}
+
+			auto it = mEntries.find( timer.handle );
+
+			if ( it == mEntries.end() || it->second.timerId != timer.timerId ||
+				 !it->second.timerArmed )
+				continue;
+
+			Entry& entry = it->second;
+			Uint64 deadline = entry.lastActivity + entry.timeout;
+
+			// The socket had activity since the timer was scheduled, move it to the new deadline
+			// instead of touching the wheel on every event.
+			if ( deadline > now ) {
+				mReschedule.push_back( {timer.handle, timer.timerId, deadline} );
+				continue;
+			}
+
+			entry.timerArmed = false;
+			mArmedTimers--;
+			mEvents.push_back( {entry.socket, entry.userData, Timeout} );
+		}
+
+		slot.resize( kept );
+	}
+
+	mTick = now;
+
+	for ( const auto& timer : mReschedule )
+		mWheel[timer.deadline % mWheel.size()].push_back( timer );
+
+	mReschedule.clear();
+}
+
+}} // namespace EE::Network
@@ -2,9 +2,12 @@
 
 #ifdef EE_MBEDTLS
 
+#include <eepp/network/ssl/sslsessioncache.hpp>
+#include <eepp/system/clock.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/log.hpp>
 #include <eepp/system/packmanager.hpp>
+#include <cstring>
 #include <mbedtls/error.h>
 
 namespace EE { namespace Network { namespace SSL {
@@ -58,10 +61,7 @@ bool MbedTLSSocket::end() {
 
 MbedTLSSocket::MbedTLSSocket( SSLSocket* socket ) :
 	SSLSocketImpl( socket ),
-	mConnected( false ),
-	mSessionOwner( false ),
-	mStatus( Socket::Disconnected ),
-	mSSLSession( NULL ) {
+	mConnected( false ), mStatus( Socket::Disconnected ) {
 	mSSLSocket = socket;
 }
 
@@ -107,8 +107,22 @@ int MbedTLSSocket::bio_recv( void* ctx, unsigned char* buf, size_t len ) {
 	return got;
 }
 
+void MbedTLSSocket::sessionFree( mbedtls_ssl_session* session ) {
+	mbedtls_ssl_session_free( session );
+	eeFree( session );
+}
+
+bool MbedTLSSocket::isSameSession( const mbedtls_ssl_session* offered,
+									const mbedtls_ssl_session* negotiated ) {
+	// A session ticket is offered with a new random session id, so a session resumed from a
+	// ticket is found by its master secret, that a full handshake always derives again.
+	return ( offered->id_len != 0 && offered->id_len == negotiated->id_len &&
+			 0 == memcmp( offered->id, negotiated->id, offered->id_len ) ) ||
+		   0 == memcmp( offered->master, negotiated->master, sizeof( offered->master ) );
+}
+
 Socket::Status MbedTLSSocket::connect( const IpAddress& /*remoteAddress*/,
-									   unsigned short /*remotePort*/, Time /*timeout*/ ) {
+									   unsigned short remotePort, Time /*timeout*/ ) {
 	if ( mConnected ) {
 		disconnect();
 	}
@@ -122,11 +136,16 @@ Socket::Status MbedTLSSocket::connect( const IpAddress& /*remoteAddress*/,
 	mbedtls_ctr_drbg_init( &mCtrDrbg );
 	mbedtls_entropy_init( &mEntropy );
 
+	// From now on the contexts are released by disconnect.
+	mConnected = true;
+
 	ret = mbedtls_ctr_drbg_seed( &mCtrDrbg, mbedtls_entropy_func, &mEntropy, NULL, 0 );
 
 	if ( ret != 0 ) {
 		Log::error( " failed\n  ! mbedtls_ctr_drbg_seed returned an error: %d", ret );
-		return Socket::Error;
+		disconnect();
+		mStatus = Socket::Error;
+		return mStatus;
 	}
 
 	mbedtls_ssl_config_defaults( &mSSLConfig, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
@@ -135,36 +154,75 @@ Socket::Status MbedTLSSocket::connect( const IpAddress& /*remoteAddress*/,
 	mbedtls_ssl_conf_authmode( &mSSLConfig, authmode );
 	mbedtls_ssl_conf_ca_chain( &mSSLConfig, &sCACert, NULL );
 	mbedtls_ssl_conf_rng( &mSSLConfig, mbedtls_ctr_drbg_random, &mCtrDrbg );
+	mbedtls_ssl_conf_session_tickets( &mSSLConfig, MBEDTLS_SSL_SESSION_TICKETS_ENABLED );
 	mbedtls_ssl_setup( &mSSLContext, &mSSLConfig );
 	mbedtls_ssl_set_hostname( &mSSLContext, mSSLSocket->mHostName.c_str() );
 	mbedtls_ssl_set_bio( &mSSLContext, this, bio_send, bio_recv, NULL );
-	mbedtls_ssl_conf_session_tickets( &mSSLConfig, MBEDTLS_SSL_SESSION_TICKETS_DISABLED );
-
-	if ( mSSLSocket->mRestoreSession == NULL ) {
-		while ( ( ret = mbedtls_ssl_handshake( &mSSLContext ) ) != 0 ) {
-			if ( ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE ) {
-				mStatus = Socket::Error;
-				return mStatus;
-			}
-		}
 
-		mSSLSession = (mbedtls_ssl_session*)eeMalloc( sizeof( mbedtls_ssl_session ) );
-		mbedtls_ssl_session_init( mSSLSession );
-		ret = mbedtls_ssl_get_session( &mSSLContext, mSSLSession );
-		if ( ret ) {
-			if ( ret != MBEDTLS_ERR_SSL_ALLOC_FAILED )
-				mbedtls_ssl_session_free( mSSLSession );
-			eeSAFE_FREE( mSSLSession );
-		} else {
-			mSessionOwner = true;
-		}
-	} else {
+	SSLSessionCache* cache = SSLSessionCache::instance();
+	const std::string& hostname = mSSLSocket->mHostName;
+	bool validateCertificate = mSSLSocket->mValidateCertificate;
+	bool validateHostname = mSSLSocket->mValidateHostname;
+	std::shared_ptr<mbedtls_ssl_session> session;
+
+	// An explicitly restored session ( FTP data connections ) takes precedence over the cache.
+	if ( mSSLSocket->mRestoreSession != NULL ) {
 		MbedTLSSocket* oldSocket =
 			reinterpret_cast<MbedTLSSocket*>( mSSLSocket->mRestoreSession->mImpl );
-		mbedtls_ssl_set_session( &mSSLContext, oldSocket->mSSLSession );
+		session = oldSocket->mSSLSession;
+	} else {
+		session = std::static_pointer_cast<mbedtls_ssl_session>(
+			cache->find( hostname, remotePort, validateCertificate, validateHostname ) );
 	}
 
-	mConnected = true;
+	if ( session )
+		mbedtls_ssl_set_session( &mSSLContext, session.get() );
+
+	Clock clock;
+
+	while ( ( ret = mbedtls_ssl_handshake( &mSSLContext ) ) == MBEDTLS_ERR_SSL_WANT_READ ||
+			ret == MBEDTLS_ERR_SSL_WANT_WRITE )
+		;
+
+	mHandshakeTime = clock.getElapsedTime();
+	mSessionResumed = false;
+
+	if ( ret != 0 ) {
+		cache->addHandshake( false, false, mHandshakeTime );
+
+		// Don't try to resume a session that fails.
+		if ( session && mSSLSocket->mRestoreSession == NULL )
+			cache->remove( hostname, remotePort );
+
+		disconnect();
+		mStatus = Socket::Error;
+		return mStatus;
+	}
+
+	mSSLSession.reset();
+
+	mbedtls_ssl_session* newSession =
+		(mbedtls_ssl_session*)eeMalloc( sizeof( mbedtls_ssl_session ) );
+	mbedtls_ssl_session_init( newSession );
+
+	ret = mbedtls_ssl_get_session( &mSSLContext, newSession );
+
+	if ( 0 == ret ) {
+		mSessionResumed = session && isSameSession( session.get(), newSession );
+		mSSLSession.reset( newSession, sessionFree );
+
+		if ( mSSLSocket->mRestoreSession == NULL )
+			cache->store( hostname, remotePort, mSSLSession, validateCertificate,
+						  validateHostname );
+	} else {
+		// A failed allocation leaves pointers shared with the context session.
+		if ( ret != MBEDTLS_ERR_SSL_ALLOC_FAILED )
+			mbedtls_ssl_session_free( newSession );
+		eeFree( newSession );
+	}
+
+	cache->addHandshake( true, mSessionResumed, mHandshakeTime );
+
 	mStatus = Socket::Done;
 
 	return mStatus;
@@ -179,11 +237,7 @@ void MbedTLSSocket::disconnect() {
 	mbedtls_ctr_drbg_free( &mCtrDrbg );
 	mbedtls_entropy_free( &mEntropy );
 
-	if ( mSessionOwner && NULL != mSSLSession ) {
-		mbedtls_ssl_session_free( mSSLSession );
-		eeSAFE_FREE( mSSLSession );
-	}
-
+	mConnected = false;
 	mStatus = Socket::Disconnected;
 }
 
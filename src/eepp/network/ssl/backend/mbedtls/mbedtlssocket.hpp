@@ -11,6 +11,7 @@
 #include <mbedtls/entropy.h>
 #include <mbedtls/net.h>
 #include <mbedtls/ssl.h>
+#include <memory>
 
 namespace EE { namespace Network { namespace SSL {
 
@@ -42,11 +43,13 @@ class EE_API MbedTLSSocket : public SSLSocketImpl {
 	mbedtls_ssl_context mSSLContext;
 	mbedtls_ssl_config mSSLConfig;
 	bool mConnected;
-	bool mSessionOwner;
 	Socket::Status mStatus;
-	mbedtls_ssl_session* mSSLSession;
+	std::shared_ptr<mbedtls_ssl_session> mSSLSession;
 	static int bio_send( void* ctx, const unsigned char* buf, size_t len );
 	static int bio_recv( void* ctx, unsigned char* buf, size_t len );
+	static void sessionFree( mbedtls_ssl_session* session );
+	static bool isSameSession( const mbedtls_ssl_session* offered,
+							   const mbedtls_ssl_session* negotiated );
 };
 
 }}} // namespace EE::Network::SSL
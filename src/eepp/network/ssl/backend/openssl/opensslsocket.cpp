@@ -7,6 +7,8 @@
 
 #include <eepp/network/packet.hpp>
 #include <eepp/network/ssl/backend/openssl/curl_hostcheck.h>
+#include <eepp/network/ssl/sslsessioncache.hpp>
+#include <eepp/system/clock.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/log.hpp>
 #include <eepp/system/packmanager.hpp>
@@ -15,6 +17,8 @@ namespace EE { namespace Network { namespace SSL {
 
 static std::vector<X509*> sCerts;
 
+SSL_CTX* OpenSSLSocket::sCTX = NULL;
+
 bool OpenSSLSocket::matchHostname( const char* name, const char* hostname ) {
 	return Tool_Curl_cert_hostcheck( name, hostname ) == CURL_HOST_MATCH;
 }
@@ -100,7 +104,15 @@ bool OpenSSLSocket::matchSubjectAlternativeName( const char* hostname, const X50
 	return result;
 }
 
-int OpenSSLSocket::certVerifyCb( X509_STORE_CTX* x509_ctx, void* arg ) {
+int OpenSSLSocket::certVerifyCb( X509_STORE_CTX* x509_ctx, void* /*arg*/ ) {
+	// The context is shared by every connection, the socket is found through the SSL object.
+	::SSL* sslObj = (::SSL*)X509_STORE_CTX_get_ex_data( x509_ctx,
+													   SSL_get_ex_data_X509_STORE_CTX_idx() );
+	OpenSSLSocket* ssl = (OpenSSLSocket*)SSL_get_app_data( sslObj );
+
+	if ( NULL == ssl || !ssl->mSSLSocket->mValidateCertificate )
+		return 1;
+
 	/* This is the function that OpenSSL would call if we hadn't called
 	 * SSL_CTX_set_cert_verify_callback().  Therefore, we are "wrapping"
 	 * the default functionality, rather than replacing it. */
@@ -124,8 +136,6 @@ int OpenSSLSocket::certVerifyCb( X509_STORE_CTX* x509_ctx, void* arg ) {
 		return 0;
 	}
 
-	OpenSSLSocket* ssl = (OpenSSLSocket*)arg;
-
 	if ( ssl->mSSLSocket->mValidateHostname ) {
 		bool err = !matchSubjectAlternativeName( ssl->mSSLSocket->mHostName.c_str(), server_cert );
 
@@ -142,6 +152,22 @@ int OpenSSLSocket::certVerifyCb( X509_STORE_CTX* x509_ctx, void* arg ) {
 	return 1;
 }
 
+int OpenSSLSocket::newSessionCb( ::SSL* ssl, SSL_SESSION* session ) {
+	OpenSSLSocket* socket = (OpenSSLSocket*)SSL_get_app_data( ssl );
+
+	if ( NULL == socket || NULL != socket->mSSLSocket->mRestoreSession )
+		return 0;
+
+	// TLS 1.3 sessions arrive after the handshake, so they are stored as soon as they come.
+	// Returning 1 keeps the reference to the session, released by the cache.
+	SSLSessionCache::instance()->store(
+		socket->mSSLSocket->mHostName, socket->mRemotePort,
+		SSLSessionCache::Session( session, SSL_SESSION_free ),
+		socket->mSSLSocket->mValidateCertificate, socket->mSSLSocket->mValidateHostname );
+
+	return 1;
+}
+
 bool OpenSSLSocket::init() {
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
 	CRYPTO_malloc_init(); // Initialize malloc, free, etc for OpenSSL's use
@@ -188,10 +214,43 @@ bool OpenSSLSocket::init() {
 		BIO_free( mem );
 	}
 
+	// A single context is shared by every connection, so the certificate store is built once.
+	sCTX = SSL_CTX_new( SSLv23_client_method() );
+
+	if ( !sCerts.empty() ) {
+		// yay for undocumented OpenSSL functions
+		X509_STORE* store = SSL_CTX_get_cert_store( sCTX );
+
+		for ( size_t i = 0; i < sCerts.size(); i++ ) {
+			X509_STORE_add_cert( store, sCerts[i] );
+		}
+	}
+
+	/* This is how we solve the problem of OpenSSL not verifying the hostname of the server
+	 * certificate. We "wrap" OpenSSL's validation routine in our own routine, which also
+	 * validates the hostname by calling the code provided by iSECPartners.  Note that even
+	 * though the "Everything You've Always Wanted to Know About Certificate Validation With
+	 * OpenSSL (But Were Afraid to Ask)" paper from iSECPartners says very explicitly not to
+	 * call SSL_CTX_set_cert_verify_callback (at the bottom of page 2), what we're doing here is
+	 * safe because our cert_verify_callback() calls X509_verify_cert(), which is OpenSSL's
+	 * built-in routine which would have been called if we hadn't set the callback.  Therefore,
+	 * we're just "wrapping" OpenSSL's routine, not replacing it. */
+	SSL_CTX_set_cert_verify_callback( sCTX, certVerifyCb, NULL );
+
+	// The sessions are kept by SSLSessionCache, keyed by host and port.
+	SSL_CTX_set_session_cache_mode( sCTX, SSL_SESS_CACHE_CLIENT |
+											  SSL_SESS_CACHE_NO_INTERNAL_STORE );
+	SSL_CTX_sess_set_new_cb( sCTX, newSessionCb );
+
 	return true;
 }
 
 bool OpenSSLSocket::end() {
+	if ( NULL != sCTX ) {
+		SSL_CTX_free( sCTX );
+		sCTX = NULL;
+	}
+
 	if ( !sCerts.empty() ) {
 		for ( size_t i = 0; i < sCerts.size(); i++ ) {
 			X509_free( sCerts[i] );
@@ -205,12 +264,12 @@ bool OpenSSLSocket::end() {
 
 OpenSSLSocket::OpenSSLSocket( SSLSocket* socket ) :
 	SSLSocketImpl( socket ),
-	mCTX( NULL ),
 	mSSL( NULL ),
 	mBIO( NULL ),
 	mConnected( false ),
 	mStatus( Socket::Disconnected ),
-	mMaxCertChainDepth( 9 ) {
+	mMaxCertChainDepth( 9 ),
+	mRemotePort( 0 ) {
 	mSSLSocket = socket;
 }
 
@@ -219,26 +278,21 @@ OpenSSLSocket::~OpenSSLSocket() {
 }
 
 Socket::Status OpenSSLSocket::connect( const IpAddress& /*remoteAddress*/,
-									   unsigned short /*remotePort*/, Time /*timeout*/ ) {
+									   unsigned short remotePort, Time /*timeout*/ ) {
 	if ( mConnected ) {
 		disconnect();
 	}
 
-	// Set up a SSL_CTX object, which will tell our BIO object how to do its work
-	mCTX = SSL_CTX_new( SSLv23_client_method() );
+	if ( NULL == sCTX ) {
+		return Socket::Error;
+	}
 
-	SSL_CTX_set_options( mCTX, SSL_OP_NO_TICKET );
+	mRemotePort = remotePort;
+	mSSL = SSL_new( sCTX );
 
-	if ( mSSLSocket->mValidateCertificate ) {
-		if ( !sCerts.empty() ) {
-			// yay for undocumented OpenSSL functions
-			X509_STORE* store = SSL_CTX_get_cert_store( mCTX );
-
-			for ( size_t i = 0; i < sCerts.size(); i++ ) {
-				X509_STORE_add_cert( store, sCerts[i] );
-			}
-		}
+	SSL_set_app_data( mSSL, this );
 
+	if ( mSSLSocket->mValidateCertificate ) {
 		/* Ask OpenSSL to verify the server certificate.  Note that this
 		 * does NOT include verifying that the hostname is correct.
 		 * So, by itself, this means anyone with any legitimate
@@ -247,30 +301,13 @@ Socket::Status OpenSSLSocket::connect( const IpAddress& /*remoteAddress*/,
 		 * Most Dangerous Code in the World" article at
 		 * https://crypto.stanford.edu/~dabo/pubs/abstracts/ssl-client-bugs.html
 		 */
-		SSL_CTX_set_verify( mCTX, SSL_VERIFY_PEER, NULL );
-
-		/* This is how we solve the problem mentioned in the previous
-		 * comment.  We "wrap" OpenSSL's validation routine in our
-		 * own routine, which also validates the hostname by calling
-		 * the code provided by iSECPartners.  Note that even though
-		 * the "Everything You've Always Wanted to Know About
-		 * Certificate Validation With OpenSSL (But Were Afraid to
-		 * Ask)" paper from iSECPartners says very explicitly not to
-		 * call SSL_CTX_set_cert_verify_callback (at the bottom of
-		 * page 2), what we're doing here is safe because our
-		 * cert_verify_callback() calls X509_verify_cert(), which is
-		 * OpenSSL's built-in routine which would have been called if
-		 * we hadn't set the callback.  Therefore, we're just
-		 * "wrapping" OpenSSL's routine, not replacing it. */
-		SSL_CTX_set_cert_verify_callback( mCTX, certVerifyCb, this );
+		SSL_set_verify( mSSL, SSL_VERIFY_PEER, NULL );
 
 		// Let the verify_callback catch the verify_depth error so that we get an appropriate error
 		// in the logfile. (??)
-		SSL_CTX_set_verify_depth( mCTX, mMaxCertChainDepth + 1 );
+		SSL_set_verify_depth( mSSL, mMaxCertChainDepth + 1 );
 	}
 
-	mSSL = SSL_new( mCTX );
-
 	SSL_set_fd( mSSL, (int)mSSLSocket->mSocket );
 
 	// Set the SSL to automatically retry on failure.
@@ -285,19 +322,52 @@ Socket::Status OpenSSLSocket::connect( const IpAddress& /*remoteAddress*/,
 
 		printError( result );
 
+		SSL_free( mSSL );
+		mSSL = NULL;
 		mStatus = Socket::Error;
 
 		return mStatus;
 	}
 
+	SSLSessionCache* cache = SSLSessionCache::instance();
+	bool hasSession = false;
+
+	// An explicitly restored session ( FTP data connections ) takes precedence over the cache.
+	if ( NULL != mSSLSocket->mRestoreSession ) {
+		OpenSSLSocket* oldSocket =
+			reinterpret_cast<OpenSSLSocket*>( mSSLSocket->mRestoreSession->mImpl );
+
+		if ( NULL != oldSocket->mSSL && NULL != SSL_get_session( oldSocket->mSSL ) )
+			hasSession = 1 == SSL_set_session( mSSL, SSL_get_session( oldSocket->mSSL ) );
+	} else {
+		SSLSessionCache::Session session =
+			cache->find( mSSLSocket->mHostName, mRemotePort, mSSLSocket->mValidateCertificate,
+						 mSSLSocket->mValidateHostname );
+
+		// SSL_set_session takes its own reference to the session.
+		if ( session )
+			hasSession = 1 == SSL_set_session( mSSL, (SSL_SESSION*)session.get() );
+	}
+
 	// Same as before, try to connect.
+	Clock clock;
 	result = SSL_connect( mSSL );
+	mHandshakeTime = clock.getElapsedTime();
+	mSessionResumed = result == 1 && 0 != SSL_session_reused( mSSL );
+
+	cache->addHandshake( result == 1, mSessionResumed, mHandshakeTime );
 
 	if ( result < 1 ) {
 		ERR_print_errors_fp( stdout );
 
 		printError( result );
 
+		// Don't try to resume a session that fails.
+		if ( hasSession && NULL == mSSLSocket->mRestoreSession )
+			cache->remove( mSSLSocket->mHostName, mRemotePort );
+
+		SSL_free( mSSL );
+		mSSL = NULL;
 		mStatus = Socket::Error;
 
 		return mStatus;
@@ -308,12 +378,16 @@ Socket::Status OpenSSLSocket::connect( const IpAddress& /*remoteAddress*/,
 	if ( peer ) {
 		// Log::debug( "cert_ok: %d", (int)( SSL_get_verify_result(mSSL) == X509_V_OK ) );
 		mStatus = Socket::Done;
+		X509_free( peer );
 	} else if ( mSSLSocket->mValidateCertificate ) {
 		mStatus = Socket::Error;
 	}
 
 	if ( mStatus == Socket::Done ) {
 		mConnected = true;
+	} else {
+		SSL_free( mSSL );
+		mSSL = NULL;
 	}
 
 	return mStatus;
@@ -325,10 +399,8 @@ void OpenSSLSocket::disconnect() {
 
 	SSL_shutdown( mSSL );
 	SSL_free( mSSL );
-	SSL_CTX_free( mCTX );
 
 	mSSL = NULL;
-	mCTX = NULL;
 	mConnected = false;
 	mStatus = Socket::Disconnected;
 }
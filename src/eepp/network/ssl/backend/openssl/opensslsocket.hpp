@@ -43,17 +43,20 @@ class OpenSSLSocket : public SSLSocketImpl {
 	Socket::Status receive( void* data, std::size_t size, std::size_t& received );
 
   protected:
-	SSL_CTX* mCTX;
+	static SSL_CTX* sCTX;
 	::SSL* mSSL;
 	BIO* mBIO;
 	SSLSocket* mSSLSocket;
 	bool mConnected;
 	Socket::Status mStatus;
 	int mMaxCertChainDepth;
+	unsigned short mRemotePort;
 
   private:
 	static int certVerifyCb( X509_STORE_CTX* x509_ctx, void* arg );
 
+	static int newSessionCb( ::SSL* ssl, SSL_SESSION* session );
+
 	static bool matchHostname( const char* name, const char* hostname );
 
 	static bool matchCommonName( const char* hostname, const X509* server_cert );
@@ -0,0 +1,164 @@
+#include <eepp/core/string.hpp>
+#include <eepp/network/ssl/sslsessioncache.hpp>
+
+namespace EE { namespace Network { namespace SSL {
+
+SINGLETON_DECLARE_IMPLEMENTATION( SSLSessionCache )
+
+SSLSessionCache::SSLSessionCache() :
+	mEnabled( true ), mCapacity( 64 ), mLifetime( Seconds( 300 ) ), mStats() {}
+
+SSLSessionCache::~SSLSessionCache() {
+	clear();
+}
+
+void SSLSessionCache::setEnabled( bool enabled ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	mEnabled = enabled;
+
+	if ( !mEnabled ) {
+		mEntries.clear();
+		mIndex.clear();
+	}
+}
+
+bool SSLSessionCache::isEnabled() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mEnabled;
+}
+
+void SSLSessionCache::setCapacity( size_t capacity ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	mCapacity = capacity;
+
+	while ( mEntries.size() > mCapacity )
+		removeEntry( std::prev( mEntries.end() ) );
+}
+
+size_t SSLSessionCache::getCapacity() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mCapacity;
+}
+
+void SSLSessionCache::setLifetime( const Time& lifetime ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+	mLifetime = lifetime;
+}
+
+const Time& SSLSessionCache::getLifetime() const {
+	return mLifetime;
+}
+
+size_t SSLSessionCache::getSize() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mEntries.size();
+}
+
+void SSLSessionCache::remove( const std::string& hostname, unsigned short port ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	auto it = mIndex.find( getKey( hostname, port ) );
+
+	if ( it != mIndex.end() )
+		removeEntry( it->second );
+}
+
+void SSLSessionCache::clear() {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	mEntries.clear();
+	mIndex.clear();
+}
+
+SSLHandshakeStats SSLSessionCache::getStats() const {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mStats;
+}
+
+void SSLSessionCache::resetStats() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	mStats = SSLHandshakeStats();
+}
+
+SSLSessionCache::Session SSLSessionCache::find( const std::string& hostname, unsigned short port,
+												bool validateCertificate,
+												bool validateHostname ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	if ( !mEnabled )
+		return Session();
+
+	auto it = mIndex.find( getKey( hostname, port ) );
+
+	if ( it == mIndex.end() ) {
+		mStats.cacheMisses++;
+		return Session();
+	}
+
+	EntryList::iterator entry = it->second;
+
+	if ( mClock.getElapsedTime() - entry->created > mLifetime ) {
+		removeEntry( entry );
+		mStats.cacheMisses++;
+		return Session();
+	}
+
+	if ( ( validateCertificate && !entry->validateCertificate ) ||
+		 ( validateHostname && !entry->validateHostname ) ) {
+		mStats.cacheMisses++;
+		return Session();
+	}
+
+	mEntries.splice( mEntries.begin(), mEntries, entry );
+	mStats.cacheHits++;
+
+	return entry->session;
+}
+
+void SSLSessionCache::store( const std::string& hostname, unsigned short port, Session session,
+							 bool validateCertificate, bool validateHostname ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	if ( !mEnabled || mCapacity == 0 || !session )
+		return;
+
+	std::string key( getKey( hostname, port ) );
+	auto it = mIndex.find( key );
+
+	if ( it != mIndex.end() )
+		removeEntry( it->second );
+
+	mEntries.push_front(
+		{key, session, mClock.getElapsedTime(), validateCertificate, validateHostname} );
+	mIndex[key] = mEntries.begin();
+
+	while ( mEntries.size() > mCapacity )
+		removeEntry( std::prev( mEntries.end() ) );
+}
+
+void SSLSessionCache::addHandshake( bool succeeded, bool resumed, const Time& time ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	if ( !succeeded ) {
+		mStats.failedHandshakes++;
+	} else if ( resumed ) {
+		mStats.resumedHandshakes++;
+		mStats.resumedHandshakeTime += time;
+	} else {
+		mStats.fullHandshakes++;
+		mStats.fullHandshakeTime += time;
+	}
+}
+
+std::string SSLSessionCache::getKey( const std::string& hostname, unsigned short port ) {
+	return String::toLower( hostname ) + ":" + String::toString( port );
+}
+
+void SSLSessionCache::removeEntry( EntryList::iterator it ) {
+	mIndex.erase( it->key );
+	mEntries.erase( it );
+}
+
+}}} // namespace EE::Network::SSL
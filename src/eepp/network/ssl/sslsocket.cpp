@@ -1,3 +1,4 @@
+#include <eepp/network/ssl/sslsessioncache.hpp>
 #include <eepp/network/ssl/sslsocket.hpp>
 #include <eepp/network/ssl/sslsocketimpl.hpp>
 #include <eepp/system/filesystem.hpp>
@@ -94,6 +95,8 @@ bool SSLSocket::end() {
 		ret = MbedTLSSocket::end();
 #endif
 
+		SSLSessionCache::destroySingleton();
+
 		ssl_initialized = false;
 	}
 
@@ -184,6 +187,14 @@ void SSLSocket::tcpDisconnect() {
 	TcpSocket::disconnect();
 }
 
+bool SSLSocket::isSessionResumed() const {
+	return NULL != mImpl && mImpl->isSessionResumed();
+}
+
+Time SSLSocket::getHandshakeTime() const {
+	return NULL != mImpl ? mImpl->getHandshakeTime() : Time::Zero;
+}
+
 Socket::Status SSLSocket::tcpReceive( void* data, std::size_t size, std::size_t& received ) {
 	return TcpSocket::receive( data, size, received );
 }
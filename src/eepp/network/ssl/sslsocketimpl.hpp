@@ -7,7 +7,8 @@ namespace EE { namespace Network { namespace SSL {
 
 class EE_API SSLSocketImpl {
   public:
-	SSLSocketImpl( SSLSocket* socket ) : mSSLSocket( socket ) {}
+	SSLSocketImpl( SSLSocket* socket ) :
+		mSSLSocket( socket ), mSessionResumed( false ), mHandshakeTime( Time::Zero ) {}
 
 	virtual ~SSLSocketImpl() {}
 
@@ -20,8 +21,14 @@ class EE_API SSLSocketImpl {
 
 	virtual Socket::Status receive( void* data, std::size_t size, std::size_t& received ) = 0;
 
+	bool isSessionResumed() const { return mSessionResumed; }
+
+	const Time& getHandshakeTime() const { return mHandshakeTime; }
+
   protected:
 	SSLSocket* mSSLSocket;
+	bool mSessionResumed;
+	Time mHandshakeTime;
 };
 
 }}} // namespace EE::Network::SSL
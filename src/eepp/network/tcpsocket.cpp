@@ -30,7 +30,7 @@ TcpSocket* TcpSocket::New() {
 	return eeNew( TcpSocket, () );
 }
 
-TcpSocket::TcpSocket() : Socket( Tcp ) {}
+TcpSocket::TcpSocket() : Socket( Tcp ), mSendQueuePos( 0 ), mMaxPacketSize( 0 ) {}
 
 unsigned short TcpSocket::getLocalPort() const {
 	if ( getHandle() != Private::SocketImpl::invalidSocket() ) {
@@ -165,6 +165,10 @@ void TcpSocket::disconnect() {
 
 	// Reset the pending packet data
 	mPendingPacket = PendingPacket();
+
+	// Drop the packets not flushed
+	mSendQueue.clear();
+	mSendQueuePos = 0;
 }
 
 Socket::Status TcpSocket::send( const void* data, std::size_t size ) {
@@ -234,10 +238,9 @@ Socket::Status TcpSocket::send( Packet& packet ) {
 	// This means that we have to send the packet size first, so that the
 	// receiver knows the actual end of the packet in the data stream.
 
-	// We allocate an extra memory block so that the size can be sent
-	// together with the data in a single call. This may seem inefficient,
-	// but it is actually required to avoid partial send, which could cause
-	// data corruption on the receiving end.
+	// The size and the data are gathered in a single call, so they don't need to be copied
+	// into a single block. Sending them in separate calls could end in a partial send between
+	// them, which could cause data corruption on the receiving end.
 
 	// Get the data to send from the packet
 	std::size_t size = 0;
@@ -245,30 +248,82 @@ Socket::Status TcpSocket::send( Packet& packet ) {
 
 	// First convert the packet size to network byte order
 	Uint32 packetSize = htonl( static_cast<Uint32>( size ) );
+	std::size_t total = sizeof( packetSize ) + size;
+	std::size_t sent = 0;
+
+	// Loop until every byte has been sent, resuming from the location of a previous partial send
+	while ( packet.mSendPos < total ) {
+		Private::SocketImpl::Buffer buffers[2];
+		std::size_t count = 0;
+
+		if ( packet.mSendPos < sizeof( packetSize ) ) {
+			buffers[count++] = {reinterpret_cast<const char*>( &packetSize ) + packet.mSendPos,
+								sizeof( packetSize ) - packet.mSendPos};
+
+			if ( size > 0 )
+				buffers[count++] = {data, size};
+		} else {
+			buffers[count++] = {static_cast<const char*>( data ) + packet.mSendPos -
+									sizeof( packetSize ),
+								total - packet.mSendPos};
+		}
+
+		int result = Private::SocketImpl::send( getHandle(), buffers, count );
+
+		if ( result < 0 ) {
+			Status status = Private::SocketImpl::getErrorStatus();
+
+			if ( ( status == NotReady ) && sent )
+				return Partial;
+
+			return status;
+		}
+
+		sent += result;
+		packet.mSendPos += result;
+	}
+
+	packet.mSendPos = 0;
+
+	return Done;
+}
+
+void TcpSocket::queue( Packet& packet ) {
+	std::size_t size = 0;
+	const void* data = packet.onSend( size );
+	Uint32 packetSize = htonl( static_cast<Uint32>( size ) );
+	std::size_t start = mSendQueue.size();
 
-	// Allocate memory for the data block to send
-	std::vector<char> blockToSend( sizeof( packetSize ) + size );
+	mSendQueue.resize( start + sizeof( packetSize ) + size );
+	std::memcpy( &mSendQueue[start], &packetSize, sizeof( packetSize ) );
 
-	// Copy the packet size and data into the block to send
-	std::memcpy( &blockToSend[0], &packetSize, sizeof( packetSize ) );
 	if ( size > 0 )
-		std::memcpy( &blockToSend[0] + sizeof( packetSize ), data, size );
+		std::memcpy( &mSendQueue[start] + sizeof( packetSize ), data, size );
+}
+
+Socket::Status TcpSocket::flush() {
+	if ( mSendQueuePos >= mSendQueue.size() )
+		return Done;
 
-	// Send the data block
 	std::size_t sent;
 	Status status =
-		send( &blockToSend[0] + packet.mSendPos, blockToSend.size() - packet.mSendPos, sent );
+		send( &mSendQueue[0] + mSendQueuePos, mSendQueue.size() - mSendQueuePos, sent );
 
-	// In the case of a partial send, record the location to resume from
 	if ( status == Partial ) {
-		packet.mSendPos += sent;
+		mSendQueuePos += sent;
 	} else if ( status == Done ) {
-		packet.mSendPos = 0;
+		// Keep the queue memory for the next packets
+		mSendQueue.clear();
+		mSendQueuePos = 0;
 	}
 
 	return status;
 }
 
+std::size_t TcpSocket::getQueuedSize() const {
+	return mSendQueue.size() - mSendQueuePos;
+}
+
 Socket::Status TcpSocket::receive( Packet& packet ) {
 	// First clear the variables to fill
 	packet.clear();
@@ -297,34 +352,48 @@ Socket::Status TcpSocket::receive( Packet& packet ) {
 		packetSize = ntohl( mPendingPacket.Size );
 	}
 
-	// Loop until we receive all the packet data
-	char buffer[1024];
+	// Reject the frames over the limit, the rest of the stream can't be trusted after them
+	if ( 0 != mMaxPacketSize && packetSize > mMaxPacketSize ) {
+		mPendingPacket = PendingPacket();
+		disconnect();
+		return Error;
+	}
+
+	// Loop until we receive all the packet data, directly in the pending packet buffer. The
+	// buffer grows with the data actually received, not with the size announced by the peer.
 	while ( mPendingPacket.Data.size() < packetSize ) {
-		// Receive a chunk of data
-		std::size_t sizeToGet = eemin(
-			static_cast<std::size_t>( packetSize - mPendingPacket.Data.size() ), sizeof( buffer ) );
-		Status status = receive( buffer, sizeToGet, received );
+		std::size_t start = mPendingPacket.Data.size();
+		mPendingPacket.Data.resize( start +
+									std::min<std::size_t>( packetSize - start, 64 * 1024 ) );
+
+		Status status =
+			receive( &mPendingPacket.Data[start], mPendingPacket.Data.size() - start, received );
+		mPendingPacket.Data.resize( start + received );
+
 		if ( status != Done )
 			return status;
-
-		// Append it into the packet
-		if ( received > 0 ) {
-			mPendingPacket.Data.resize( mPendingPacket.Data.size() + received );
-			char* begin = &mPendingPacket.Data[0] + mPendingPacket.Data.size() - received;
-			std::memcpy( begin, buffer, received );
-		}
 	}
 
 	// We have received all the packet data: we can copy it to the user packet
 	if ( !mPendingPacket.Data.empty() )
 		packet.onReceive( &mPendingPacket.Data[0], mPendingPacket.Data.size() );
 
-	// Clear the pending packet data
-	mPendingPacket = PendingPacket();
+	// Clear the pending packet data, keeping the buffer memory for the next packet
+	mPendingPacket.Size = 0;
+	mPendingPacket.SizeReceived = 0;
+	mPendingPacket.Data.clear();
 
 	return Done;
 }
 
+void TcpSocket::setMaxPacketSize( const std::size_t& maxPacketSize ) {
+	mMaxPacketSize = maxPacketSize;
+}
+
+const std::size_t& TcpSocket::getMaxPacketSize() const {
+	return mMaxPacketSize;
+}
+
 void TcpSocket::setSendTimeout( SocketHandle /*sock*/, const Time& timeout ) {
 	if ( getHandle() != Private::SocketImpl::invalidSocket() ) {
 		Private::SocketImpl::setSendTimeout( getHandle(), timeout );
@@ -1,10 +1,15 @@
 #include <algorithm>
+#include <cstring>
 #include <eepp/network/ipaddress.hpp>
 #include <eepp/network/packet.hpp>
 #include <eepp/network/platform/platformimpl.hpp>
 #include <eepp/network/udpsocket.hpp>
 #include <eepp/system/log.hpp>
 
+#if EE_PLATFORM == EE_PLATFORM_LINUX
+#define EE_NETWORK_MMSG
+#endif
+
 namespace EE { namespace Network {
 
 UdpSocket* UdpSocket::New() {
@@ -148,6 +153,128 @@ Socket::Status UdpSocket::receive( Packet& packet, IpAddress& remoteAddress,
 	return status;
 }
 
+Socket::Status UdpSocket::send( const Datagram* datagrams, std::size_t count,
+								std::size_t& sent ) {
+	sent = 0;
+
+	// Create the internal socket if it doesn't exist
+	create();
+
+#ifdef EE_NETWORK_MMSG
+	mmsghdr messages[MaxBatchSize];
+	iovec buffers[MaxBatchSize];
+	sockaddr_in addresses[MaxBatchSize];
+
+	while ( sent < count ) {
+		std::size_t batch = eemin<std::size_t>( count - sent, MaxBatchSize );
+
+		for ( std::size_t i = 0; i < batch; i++ ) {
+			const Datagram& datagram = datagrams[sent + i];
+			std::size_t size = 0;
+			const void* data = datagram.packet->onSend( size );
+
+			if ( size > MaxDatagramSize ) {
+				Log::error(
+					"Cannot send data over the network (the number of bytes to send is greater "
+					"than UdpSocket::MaxDatagramSize)" );
+				return Error;
+			}
+
+			addresses[i] = Private::SocketImpl::createAddress(
+				datagram.remoteAddress.toInteger(), datagram.remotePort );
+			buffers[i].iov_base = const_cast<void*>( data );
+			buffers[i].iov_len = size;
+			std::memset( &messages[i], 0, sizeof( mmsghdr ) );
+			messages[i].msg_hdr.msg_name = &addresses[i];
+			messages[i].msg_hdr.msg_namelen = sizeof( sockaddr_in );
+			messages[i].msg_hdr.msg_iov = &buffers[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int result = sendmmsg( getHandle(), messages, batch, 0 );
+
+		if ( result < 0 ) {
+			Status status = Private::SocketImpl::getErrorStatus();
+			return ( status == NotReady && sent ) ? Partial : status;
+		}
+
+		sent += result;
+
+		// The socket send buffer is full
+		if ( (std::size_t)result < batch )
+			return Partial;
+	}
+#else
+	for ( ; sent < count; sent++ ) {
+		const Datagram& datagram = datagrams[sent];
+		Status status = send( *datagram.packet, datagram.remoteAddress, datagram.remotePort );
+
+		if ( status != Done )
+			return ( status == NotReady && sent ) ? Partial : status;
+	}
+#endif
+
+	return Done;
+}
+
+Socket::Status UdpSocket::receive( Datagram* datagrams, std::size_t count,
+								   std::size_t& received ) {
+	received = 0;
+
+	if ( 0 == count )
+		return Done;
+
+#ifdef EE_NETWORK_MMSG
+	mmsghdr messages[MaxBatchSize];
+	iovec buffers[MaxBatchSize];
+	sockaddr_in addresses[MaxBatchSize];
+	std::size_t batch = eemin<std::size_t>( count, MaxBatchSize );
+
+	// The buffers are allocated once, on the first batched receive
+	if ( mBatchBuffer.size() < batch * MaxDatagramSize )
+		mBatchBuffer.resize( batch * MaxDatagramSize );
+
+	for ( std::size_t i = 0; i < batch; i++ ) {
+		buffers[i].iov_base = &mBatchBuffer[i * MaxDatagramSize];
+		buffers[i].iov_len = MaxDatagramSize;
+		std::memset( &messages[i], 0, sizeof( mmsghdr ) );
+		messages[i].msg_hdr.msg_name = &addresses[i];
+		messages[i].msg_hdr.msg_namelen = sizeof( sockaddr_in );
+		messages[i].msg_hdr.msg_iov = &buffers[i];
+		messages[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	// Wait only for the first datagram, then take the ones already queued
+	int result = recvmmsg( getHandle(), messages, batch, MSG_WAITFORONE, NULL );
+
+	if ( result < 0 )
+		return Private::SocketImpl::getErrorStatus();
+
+	for ( int i = 0; i < result; i++ ) {
+		Datagram& datagram = datagrams[i];
+		datagram.packet->clear();
+
+		if ( messages[i].msg_len > 0 )
+			datagram.packet->onReceive( &mBatchBuffer[i * MaxDatagramSize], messages[i].msg_len );
+
+		datagram.remoteAddress = IpAddress( ntohl( addresses[i].sin_addr.s_addr ) );
+		datagram.remotePort = ntohs( addresses[i].sin_port );
+	}
+
+	received = result;
+
+	return Done;
+#else
+	Status status =
+		receive( *datagrams[0].packet, datagrams[0].remoteAddress, datagrams[0].remotePort );
+
+	if ( status == Done )
+		received = 1;
+
+	return status;
+#endif
+}
+
 void UdpSocket::setSendTimeout( SocketHandle sock, const Time& timeout ) {
 	if ( getHandle() != Private::SocketImpl::invalidSocket() ) {
 		Private::SocketImpl::setSendTimeout( getHandle(), timeout );
@@ -1,11 +1,102 @@
 #include <eepp/scene/action.hpp>
+#include <eepp/scene/actionmanager.hpp>
 #include <eepp/scene/node.hpp>
+#include <eepp/system/lock.hpp>
+#include <eepp/system/mutex.hpp>
 
 namespace EE { namespace Scene {
 
-Action::Action() : mNode( NULL ), mFlags( 0 ), mTag( 0 ), mNumCallBacks( 0 ), mId( 0 ) {}
+// Free lists of blocks grouped in 16 bytes size classes. Every action type ends up in the pool of
+// its own size. Blocks are allocated in chunks and reused, they are never returned to the system.
+class ActionAllocator {
+  public:
+	static constexpr std::size_t Granularity = 16;
+	static constexpr std::size_t MaxBlockSize = 512;
+	static constexpr std::size_t BlocksPerChunk = 64;
+
+	static ActionAllocator* instance() {
+		// Intentionally leaked: actions can be destroyed during the static destruction.
+		static ActionAllocator* allocator = new ActionAllocator();
+		return allocator;
+	}
+
+	void* allocate( std::size_t size ) {
+		if ( size > MaxBlockSize )
+			return ::operator new( size );
+
+		std::size_t sizeClass = ( size + Granularity - 1 ) / Granularity;
+		Lock l( mMutex );
+		FreeBlock*& freeList = mFreeLists[sizeClass];
+
+		if ( NULL == freeList ) {
+			std::size_t blockSize = sizeClass * Granularity;
+			char* chunk = static_cast<char*>( ::operator new( blockSize * BlocksPerChunk ) );
+
+			for ( std::size_t i = 0; i < BlocksPerChunk; i++ ) {
+				FreeBlock* block = reinterpret_cast<FreeBlock*>( chunk + i * blockSize );
+				block->next = freeList;
+				freeList = block;
+			}
+		}
+
+		FreeBlock* block = freeList;
+		freeList = block->next;
+		return block;
+	}
+
+	void deallocate( void* ptr, std::size_t size ) {
+		if ( size > MaxBlockSize ) {
+			::operator delete( ptr );
+			return;
+		}
+
+		std::size_t sizeClass = ( size + Granularity - 1 ) / Granularity;
+		Lock l( mMutex );
+		FreeBlock* block = static_cast<FreeBlock*>( ptr );
+		block->next = mFreeLists[sizeClass];
+		mFreeLists[sizeClass] = block;
+	}
+
+  protected:
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	Mutex mMutex;
+	FreeBlock* mFreeLists[MaxBlockSize / Granularity + 1] = {};
+};
+
+void* Action::operator new( std::size_t size ) {
+	return ActionAllocator::instance()->allocate( size );
+}
+
+void Action::operator delete( void* ptr, std::size_t size ) {
+	if ( NULL != ptr )
+		ActionAllocator::instance()->deallocate( ptr, size );
+}
+
+void* Action::operator new( std::size_t, void* ptr ) {
+	return ptr;
+}
+
+void Action::operator delete( void*, void* ) {}
+
+Action::Action() :
+	mNode( NULL ),
+	mFlags( 0 ),
+	mTag( 0 ),
+	mNumCallBacks( 0 ),
+	mId( 0 ),
+	mManager( NULL ),
+	mManagerIndex( 0 ),
+	mTargetIndexSlot( 0 ),
+	mTagIndexSlot( 0 ) {}
 
 Action::~Action() {
+	// Deleted without being removed from its manager.
+	if ( NULL != mManager )
+		mManager->unindexAction( this );
+
 	sendEvent( ActionType::OnDelete );
 }
 
@@ -22,12 +113,23 @@ Uint32 Action::getTag() const {
 }
 
 void Action::setTag( const Uint32& tag ) {
-	mTag = tag;
+	if ( mTag != tag ) {
+		Uint32 oldTag = mTag;
+		mTag = tag;
+
+		if ( NULL != mManager )
+			mManager->onActionTagChange( this, oldTag );
+	}
 }
 
 void Action::setTarget( Node* target ) {
 	if ( mNode != target ) {
+		Node* oldTarget = mNode;
 		mNode = target;
+
+		if ( NULL != mManager )
+			mManager->onActionTargetChange( this, oldTarget );
+
 		onTargetChange();
 	}
 }
@@ -44,6 +146,10 @@ Node* Action::getTarget() const {
 	return mNode;
 }
 
+Time Action::getNextDeadline() {
+	return Time::Zero;
+}
+
 Action* Action::clone() const {
 	return NULL;
 }
@@ -1,4 +1,3 @@
-#include <algorithm>
 #include <eepp/core.hpp>
 #include <eepp/scene/action.hpp>
 #include <eepp/scene/actionmanager.hpp>
@@ -6,29 +5,70 @@
 
 namespace EE { namespace Scene {
 
+// Every action keeps its position in the vectors of its target and its tag, so it is removed by
+// moving the last action of the vector into its place.
+template <typename Key>
+static void addToIndex( std::unordered_map<Key, std::vector<Action*>>& index, const Key& key,
+						Action* action, size_t Action::*slot ) {
+	std::vector<Action*>& actions = index[key];
+	action->*slot = actions.size();
+	actions.push_back( action );
+}
+
+template <typename Key>
+static void removeFromIndex( std::unordered_map<Key, std::vector<Action*>>& index,
+							 const Key& key, Action* action, size_t Action::*slot ) {
+	auto it = index.find( key );
+
+	if ( it == index.end() )
+		return;
+
+	std::vector<Action*>& actions = it->second;
+	size_t pos = action->*slot;
+
+	if ( pos >= actions.size() || actions[pos] != action )
+		return;
+
+	actions[pos] = actions.back();
+	actions[pos]->*slot = pos;
+	actions.pop_back();
+
+	if ( actions.empty() )
+		index.erase( it );
+}
+
 ActionManager* ActionManager::New() {
 	return eeNew( ActionManager, () );
 }
 
-ActionManager::ActionManager() : mUpdating( false ) {}
+ActionManager::ActionManager() : mRemovedCount( 0 ), mUpdating( false ) {}
 
 ActionManager::~ActionManager() {
 	clear();
 }
 
 void ActionManager::addAction( Action* action ) {
-	bool found = ( std::find( mActions.begin(), mActions.end(), action ) != mActions.end() );
+	if ( NULL == action || NULL != action->mManager )
+		return;
 
-	if ( !found ) {
-		mActions.push_back( action );
-	}
+	action->mManager = this;
+	action->mManagerIndex = mActions.size();
+	mActions.push_back( action );
+
+	addToIndex( mTargetIndex, action->getTarget(), action, &Action::mTargetIndexSlot );
+
+	if ( 0 != action->getTag() )
+		addToIndex( mTagIndex, action->getTag(), action, &Action::mTagIndexSlot );
 }
 
 Action* ActionManager::getActionByTag( const Uint32& tag ) {
-	for ( auto it = mActions.begin(); it != mActions.end(); ++it ) {
-		Action* action = ( *it );
+	if ( 0 != tag ) {
+		auto it = mTagIndex.find( tag );
+		return it != mTagIndex.end() ? it->second.front() : NULL;
+	}
 
-		if ( action->getTag() == tag )
+	for ( auto& action : mActions ) {
+		if ( NULL != action && action->getTag() == tag )
 			return action;
 	}
 
@@ -36,26 +76,19 @@ Action* ActionManager::getActionByTag( const Uint32& tag ) {
 }
 
 std::vector<Action*> ActionManager::getActionsFromTarget( Node* target ) {
-	std::vector<Action*> actions;
-
-	for ( auto it = mActions.begin(); it != mActions.end(); ++it ) {
-		Action* action = ( *it );
-
-		if ( action->getTarget() == target )
-			actions.push_back( action );
-	}
-
-	return actions;
+	auto it = mTargetIndex.find( target );
+	return it != mTargetIndex.end() ? it->second : std::vector<Action*>();
 }
 
 std::vector<Action*> ActionManager::getActionsByTagFromTarget( Node* target, const Uint32& tag ) {
 	std::vector<Action*> actions;
+	auto it = mTargetIndex.find( target );
 
-	for ( auto it = mActions.begin(); it != mActions.end(); ++it ) {
-		Action* action = ( *it );
-
-		if ( action->getTarget() == target && action->getTag() == tag )
-			actions.push_back( action );
+	if ( it != mTargetIndex.end() ) {
+		for ( auto& action : it->second ) {
+			if ( action->getTag() == tag )
+				actions.push_back( action );
+		}
 	}
 
 	return actions;
@@ -66,82 +99,108 @@ void ActionManager::removeActionByTag( const Uint32& tag ) {
 }
 
 void ActionManager::removeActionsByTagFromTarget( Node* target, const Uint32& tag ) {
-	std::vector<Action*> removeList;
-
-	for ( auto it = mActions.begin(); it != mActions.end(); ++it ) {
-		Action* action = ( *it );
-
-		if ( action->getTarget() == target && action->getTag() == tag ) {
-			removeList.push_back( *it );
-		}
-	}
-
-	for ( auto it = removeList.begin(); it != removeList.end(); ++it )
-		removeAction( ( *it ) );
+	removeActions( getActionsByTagFromTarget( target, tag ) );
 }
 
 void ActionManager::update( const Time& time ) {
 	if ( isEmpty() )
 		return;
 
-	std::vector<Action*> removeList;
-
 	mUpdating = true;
 
-	for ( auto it = mActions.begin(); it != mActions.end(); ++it ) {
-		Action* action = ( *it );
+	// Actions added during the update are appended and also updated in this pass.
+	for ( std::size_t i = 0; i < mActions.size(); i++ ) {
+		Action* action = mActions[i];
+
+		if ( NULL == action )
+			continue;
 
 		action->update( time );
 
 		if ( action->isDone() ) {
 			action->sendEvent( Action::ActionType::OnDone );
 
-			removeList.push_back( action );
+			removeAction( action );
 		}
 	}
 
 	mUpdating = false;
 
-	for ( auto it = mActionsRemoveList.begin(); it != mActionsRemoveList.end(); ++it )
-		removeAction( ( *it ) );
+	for ( auto& action : mActionsRemoveList )
+		eeSAFE_DELETE( action );
 
 	mActionsRemoveList.clear();
 
-	for ( auto it = removeList.begin(); it != removeList.end(); ++it )
-		removeAction( ( *it ) );
+	compact();
+}
+
+bool ActionManager::getNextDeadline( Time& deadline ) {
+	bool found = false;
+
+	for ( auto& action : mActions ) {
+		if ( NULL == action )
+			continue;
+
+		Time actionDeadline = action->getNextDeadline();
+
+		if ( !found || actionDeadline < deadline ) {
+			deadline = actionDeadline;
+			found = true;
+
+			if ( deadline <= Time::Zero )
+				break;
+		}
+	}
+
+	return found;
 }
 
 std::size_t ActionManager::count() const {
-	return mActions.size();
+	return mActions.size() - mRemovedCount;
 }
 
 bool ActionManager::isEmpty() const {
-	return mActions.empty();
+	return count() == 0;
 }
 
 void ActionManager::clear() {
-	for ( auto it = mActions.begin(); it != mActions.end(); ++it ) {
-		Action* action = ( *it );
+	std::vector<Action*> actions;
+	actions.swap( mActions );
 
-		eeSAFE_DELETE( action );
+	mTargetIndex.clear();
+	mTagIndex.clear();
+	mRemovedCount = 0;
+
+	for ( auto& action : actions ) {
+		if ( NULL != action ) {
+			action->mManager = NULL;
+			eeSAFE_DELETE( action );
+		}
 	}
 
-	mActions.clear();
+	if ( !mUpdating ) {
+		for ( auto& action : mActionsRemoveList )
+			eeSAFE_DELETE( action );
+
+		mActionsRemoveList.clear();
+	}
 }
 
 void ActionManager::removeAction( Action* action ) {
-	if ( NULL != action ) {
-		if ( !mUpdating ) {
-			bool found = std::find( mActions.begin(), mActions.end(), action ) != mActions.end();
+	if ( NULL == action || action->mManager != this )
+		return;
 
-			if ( found ) {
-				mActions.remove( action );
+	unindexAction( action );
 
-				eeSAFE_DELETE( action );
-			}
-		} else {
-			mActionsRemoveList.push_back( action );
-		}
+	if ( mUpdating ) {
+		// It could still be running its own update, it's deleted after the update.
+		mActionsRemoveList.push_back( action );
+	} else {
+		eeSAFE_DELETE( action );
+
+		// Do not let the removed slots outgrow the live actions between updates.
+		if ( mRemovedCount > mActions.size() / 2 )
+			compact();
 	}
 }
 
@@ -152,18 +211,54 @@ void ActionManager::removeActions( const std::vector<Action*>& actions ) {
 }
 
 void ActionManager::removeAllActionsFromTarget( Node* target ) {
-	std::vector<Action*> removeList;
+	removeActions( getActionsFromTarget( target ) );
+}
+
+void ActionManager::unindexAction( Action* action ) {
+	removeFromIndex( mTargetIndex, action->getTarget(), action, &Action::mTargetIndexSlot );
+
+	if ( 0 != action->getTag() )
+		removeFromIndex( mTagIndex, action->getTag(), action, &Action::mTagIndexSlot );
+
+	if ( action->mManagerIndex < mActions.size() &&
+		 mActions[action->mManagerIndex] == action ) {
+		mActions[action->mManagerIndex] = NULL;
+		mRemovedCount++;
+	}
+
+	action->mManager = NULL;
+}
+
+void ActionManager::onActionTagChange( Action* action, const Uint32& oldTag ) {
+	if ( 0 != oldTag )
+		removeFromIndex( mTagIndex, oldTag, action, &Action::mTagIndexSlot );
+
+	if ( 0 != action->getTag() )
+		addToIndex( mTagIndex, action->getTag(), action, &Action::mTagIndexSlot );
+}
+
+void ActionManager::onActionTargetChange( Action* action, Node* oldTarget ) {
+	removeFromIndex( mTargetIndex, oldTarget, action, &Action::mTargetIndexSlot );
+	addToIndex( mTargetIndex, action->getTarget(), action, &Action::mTargetIndexSlot );
+}
+
+void ActionManager::compact() {
+	if ( 0 == mRemovedCount )
+		return;
+
+	std::size_t count = 0;
 
-	for ( auto it = mActions.begin(); it != mActions.end(); ++it ) {
-		Action* action = ( *it );
+	for ( std::size_t i = 0; i < mActions.size(); i++ ) {
+		Action* action = mActions[i];
 
-		if ( action->getTarget() == target ) {
-			removeList.push_back( *it );
+		if ( NULL != action ) {
+			action->mManagerIndex = count;
+			mActions[count++] = action;
 		}
 	}
 
-	for ( auto it = removeList.begin(); it != removeList.end(); ++it )
-		removeAction( ( *it ) );
+	mActions.resize( count );
+	mRemovedCount = 0;
 }
 
 }} // namespace EE::Scene
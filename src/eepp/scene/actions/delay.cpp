@@ -35,6 +35,10 @@ Time Delay::getTotalTime() {
 	return mTime;
 }
 
+Time Delay::getNextDeadline() {
+	return !isDone() ? mTime - mClock.getElapsedTime() : Time::Zero;
+}
+
 Action* Delay::clone() const {
 	return New( mTime );
 }
@@ -101,6 +101,10 @@ Time Sequence::getTotalTime() {
 	return mDuration;
 }
 
+Time Sequence::getNextDeadline() {
+	return mSequence[mCurPos]->getNextDeadline();
+}
+
 Action* Sequence::clone() const {
 	return Sequence::New( mSequence );
 }
@@ -101,6 +101,25 @@ Time Spawn::getTotalTime() {
 	return Microseconds( max );
 }
 
+Time Spawn::getNextDeadline() {
+	Time deadline = Time::Zero;
+	bool found = false;
+
+	for ( auto& spawn : mSpawn ) {
+		if ( spawn->isDone() )
+			continue;
+
+		Time spawnDeadline = spawn->getNextDeadline();
+
+		if ( !found || spawnDeadline < deadline ) {
+			deadline = spawnDeadline;
+			found = true;
+		}
+	}
+
+	return deadline;
+}
+
 Action* Spawn::clone() const {
 	return Spawn::New( mSpawn );
 }
@@ -23,7 +23,9 @@ EventDispatcher::EventDispatcher( SceneNode* sceneNode ) :
 	mCbId( 0 ),
 	mFirstPress( false ),
 	mNodeWasDragging( NULL ),
-	mNodeDragging( NULL ) {
+	mNodeDragging( NULL ),
+	mOverFindGeneration( 0 ),
+	mOverFindValid( false ) {
 	mCbId = mInput->pushCallback( cb::Make1( this, &EventDispatcher::inputCallback ) );
 }
 
@@ -68,7 +70,20 @@ void EventDispatcher::update( const Time& time ) {
 	mMousePos = mInput->getMousePosFromView( mWindow->getDefaultView() );
 	mMousePosi = mMousePos.asInt();
 
-	Node* pOver = mSceneNode->overFind( mMousePos );
+	Node* pOver;
+
+	// The node under the cursor can only change if the cursor or the scene moved.
+	if ( !mOverFindValid || mOverFindPos != mMousePos ||
+		 mOverFindGeneration != mSceneNode->getHitTestGeneration() ) {
+		mOverFindPos = mMousePos;
+		mOverFindGeneration = mSceneNode->getHitTestGeneration();
+		mOverFindValid = true;
+		mSceneNode->resetMouseOverNodes();
+		pOver = mSceneNode->overFind( mMousePos );
+	} else {
+		mSceneNode->restoreMouseOverNodes();
+		pOver = mOverNode;
+	}
 
 	if ( pOver != mOverNode ) {
 		Node* oldOverNode = mOverNode;
@@ -240,6 +255,7 @@ Node* EventDispatcher::getMouseOverNode() const {
 
 void EventDispatcher::setMouseOverNode( Node* node ) {
 	mOverNode = node;
+	mOverFindValid = false;
 }
 
 Node* EventDispatcher::getFocusNode() const {
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <cmath>
+#include <eepp/scene/hittestindex.hpp>
+#include <eepp/scene/node.hpp>
+
+namespace EE { namespace Scene { namespace Private {
+
+// A child covering more cells than this is tested on every query instead.
+static const Int32 MaxCellsPerChild = 16;
+
+static const Int32 MaxGridSize = 256;
+
+HitTestIndex::HitTestIndex( Node* owner ) :
+	mOwner( owner ),
+	mColumns( 0 ),
+	mRows( 0 ),
+	mNextOrder( 0 ),
+	mOverflowLimit( 0 ),
+	mTransformed( false ),
+	mRebuild( true ) {}
+
+void HitTestIndex::invalidate() {
+	// The bounds are relative to the owner, so moving it doesn't change them. Once it's rotated
+	// or scaled they are not, and any change of the owner can change every child.
+	if ( mTransformed )
+		mRebuild = true;
+}
+
+void HitTestIndex::reset() {
+	mRebuild = true;
+}
+
+void HitTestIndex::invalidate( Node* child ) {
+	if ( mRebuild )
+		return;
+
+	auto it = mEntries.find( child );
+
+	if ( it != mEntries.end() && !it->second.pending ) {
+		it->second.pending = true;
+		mPending.push_back( child );
+	}
+}
+
+void HitTestIndex::add( Node* child ) {
+	if ( mRebuild )
+		return;
+
+	Entry& entry = mEntries[child];
+	entry.order = mNextOrder++;
+	entry.placed = false;
+	entry.pending = true;
+	mPending.push_back( child );
+}
+
+void HitTestIndex::remove( Node* child ) {
+	if ( mRebuild )
+		return;
+
+	auto it = mEntries.find( child );
+
+	if ( it != mEntries.end() ) {
+		erase( child, it->second );
+		mEntries.erase( it );
+	}
+}
+
+const std::vector<Node*>& HitTestIndex::query( const Vector2f& point ) {
+	mOwner->updateWorldPolygon();
+
+	if ( mOwner->mScreenTransformed != mTransformed )
+		mRebuild = true;
+
+	if ( mRebuild ) {
+		rebuild();
+	} else if ( !mPending.empty() ) {
+		for ( auto& child : mPending ) {
+			auto it = mEntries.find( child );
+
+			if ( it != mEntries.end() && it->second.pending )
+				update( child, it->second );
+		}
+
+		mPending.clear();
+
+		// Too many children moved out of the grid, it doesn't fit them anymore.
+		if ( mOverflow.size() > mOverflowLimit )
+			rebuild();
+	}
+
+	Vector2f local( point - mOwner->mScreenPos );
+
+	mResult.clear();
+
+	if ( mColumns > 0 && mArea.contains( local ) ) {
+		Int32 x = eemin( (Int32)( ( local.x - mArea.Left ) / mCellSize.x ), mColumns - 1 );
+		Int32 y = eemin( (Int32)( ( local.y - mArea.Top ) / mCellSize.y ), mRows - 1 );
+
+		for ( auto& child : mCells[y * mColumns + x] )
+			if ( mEntries[child].bounds.contains( local ) )
+				mResult.push_back( child );
+	}
+
+	for ( auto& child : mOverflow )
+		if ( mEntries[child].bounds.contains( local ) )
+			mResult.push_back( child );
+
+	if ( mResult.size() > 1 ) {
+		std::sort( mResult.begin(), mResult.end(), [this]( Node* a, Node* b ) {
+			return mEntries[a].order > mEntries[b].order;
+		} );
+	}
+
+	return mResult;
+}
+
+void HitTestIndex::rebuild() {
+	mEntries.clear();
+	mOverflow.clear();
+	mPending.clear();
+	mRebuild = false;
+	mTransformed = mOwner->mScreenTransformed;
+	mNextOrder = 0;
+
+	Vector2f origin( mOwner->mScreenPos );
+	bool first = true;
+
+	for ( Node* child = mOwner->getFirstChild(); NULL != child; child = child->getNextNode() ) {
+		Entry& entry = mEntries[child];
+		entry.bounds = child->getWorldBounds();
+		entry.bounds.Left -= origin.x;
+		entry.bounds.Right -= origin.x;
+		entry.bounds.Top -= origin.y;
+		entry.bounds.Bottom -= origin.y;
+		entry.order = mNextOrder++;
+		entry.placed = false;
+		entry.pending = false;
+
+		if ( first ) {
+			mArea = entry.bounds;
+			first = false;
+		} else {
+			mArea.expand( entry.bounds );
+		}
+	}
+
+	// Around one cell per child, following the aspect ratio of the area.
+	Float width = eemax( mArea.getWidth(), 1.f );
+	Float height = eemax( mArea.getHeight(), 1.f );
+	Float count = eemax( (Float)mEntries.size(), 1.f );
+
+	mColumns = eeclamp( (Int32)std::round( std::sqrt( count * width / height ) ), 1, MaxGridSize );
+	mRows = eeclamp( (Int32)std::ceil( count / mColumns ), 1, MaxGridSize );
+	mCellSize = Vector2f( width / mColumns, height / mRows );
+
+	mCells.resize( mColumns * mRows );
+
+	for ( auto& cell : mCells )
+		cell.clear();
+
+	for ( auto& entry : mEntries )
+		insert( entry.first, entry.second );
+
+	mOverflowLimit = mOverflow.size() * 2 + MinChildCount / 4;
+}
+
+void HitTestIndex::update( Node* child, Entry& entry ) {
+	erase( child, entry );
+
+	entry.bounds = child->getWorldBounds();
+	entry.bounds.Left -= mOwner->mScreenPos.x;
+	entry.bounds.Right -= mOwner->mScreenPos.x;
+	entry.bounds.Top -= mOwner->mScreenPos.y;
+	entry.bounds.Bottom -= mOwner->mScreenPos.y;
+	entry.pending = false;
+
+	insert( child, entry );
+}
+
+void HitTestIndex::insert( Node* child, Entry& entry ) {
+	entry.placed = true;
+
+	if ( mColumns > 0 && mArea.contains( entry.bounds ) ) {
+		entry.left = eeclamp( (Int32)( ( entry.bounds.Left - mArea.Left ) / mCellSize.x ), 0,
+							  mColumns - 1 );
+		entry.right = eeclamp( (Int32)( ( entry.bounds.Right - mArea.Left ) / mCellSize.x ), 0,
+							   mColumns - 1 );
+		entry.top =
+			eeclamp( (Int32)( ( entry.bounds.Top - mArea.Top ) / mCellSize.y ), 0, mRows - 1 );
+		entry.bottom =
+			eeclamp( (Int32)( ( entry.bounds.Bottom - mArea.Top ) / mCellSize.y ), 0, mRows - 1 );
+
+		if ( ( entry.right - entry.left + 1 ) * ( entry.bottom - entry.top + 1 ) <=
+			 MaxCellsPerChild ) {
+			for ( Int32 y = entry.top; y <= entry.bottom; y++ )
+				for ( Int32 x = entry.left; x <= entry.right; x++ )
+					mCells[y * mColumns + x].push_back( child );
+
+			return;
+		}
+	}
+
+	entry.left = -1;
+	mOverflow.push_back( child );
+}
+
+static void eraseFrom( std::vector<Node*>& list, Node* child ) {
+	auto it = std::find( list.begin(), list.end(), child );
+
+	if ( it != list.end() ) {
+		*it = list.back();
+		list.pop_back();
+	}
+}
+
+void HitTestIndex::erase( Node* child, Entry& entry ) {
+	if ( !entry.placed )
+		return;
+
+	entry.placed = false;
+
+	if ( entry.left == -1 ) {
+		eraseFrom( mOverflow, child );
+		return;
+	}
+
+	for ( Int32 y = entry.top; y <= entry.bottom; y++ )
+		for ( Int32 x = entry.left; x <= entry.right; x++ )
+			eraseFrom( mCells[y * mColumns + x], child );
+}
+
+}}} // namespace EE::Scene::Private
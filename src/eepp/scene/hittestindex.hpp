@@ -0,0 +1,85 @@
+#ifndef EE_SCENE_HITTESTINDEX_HPP
+#define EE_SCENE_HITTESTINDEX_HPP
+
+#include <eepp/math/rect.hpp>
+#include <eepp/math/vector2.hpp>
+#include <unordered_map>
+#include <vector>
+using namespace EE::Math;
+
+namespace EE { namespace Scene {
+class Node;
+}} // namespace EE::Scene
+
+namespace EE { namespace Scene { namespace Private {
+
+/** @brief Uniform grid over the world bounds of the children of a node.
+**	Used by Node::overFind to test only the children under the point instead of every child. The
+**	bounds of a child are read again only when the child is invalidated, so a still tree costs
+**	nothing to keep indexed. */
+class HitTestIndex {
+  public:
+	/** Nodes with less children than this are tested linearly */
+	static const Uint32 MinChildCount = 64;
+
+	HitTestIndex( Node* owner );
+
+	/** @brief The owner moved or was transformed.
+	**	The bounds are kept relative to the owner, so they are only read again if the owner is
+	**	rotated or scaled. */
+	void invalidate();
+
+	/** @brief Forgets the bounds of every child, the grid is rebuilt by the next query.
+	**	Used when the children are reordered. */
+	void reset();
+
+	/** @brief Marks the bounds of a child as outdated, when it moves by itself */
+	void invalidate( Node* child );
+
+	/** @brief Adds a child on top of the others */
+	void add( Node* child );
+
+	void remove( Node* child );
+
+	/** @return The children whose world bounds contain the point, the topmost first */
+	const std::vector<Node*>& query( const Vector2f& point );
+
+  protected:
+	struct Entry {
+		Rectf bounds;
+		Uint32 order; ///< Position of the child in its parent, higher is on top
+		Int32 left;	  ///< Cells covered by the child, left is -1 if it's in the overflow list
+		Int32 top;
+		Int32 right;
+		Int32 bottom;
+		bool placed; ///< The child is in the grid or in the overflow list
+		bool pending;
+	};
+
+	Node* mOwner;
+	std::unordered_map<Node*, Entry> mEntries;
+	std::vector<std::vector<Node*>> mCells;
+	std::vector<Node*> mOverflow; ///< Children outside the grid or covering too many cells
+	std::vector<Node*> mPending;
+	std::vector<Node*> mResult;
+	Rectf mArea;
+	Vector2f mCellSize;
+	Int32 mColumns;
+	Int32 mRows;
+	Uint32 mNextOrder;
+	size_t mOverflowLimit; ///< Overflow size that triggers a rebuild
+	bool mTransformed;	   ///< The owner was rotated or scaled when the grid was built
+	bool mRebuild;
+
+	void rebuild();
+
+	void update( Node* child, Entry& entry );
+
+	void insert( Node* child, Entry& entry );
+
+	void erase( Node* child, Entry& entry );
+};
+
+}}} // namespace EE::Scene::Private
+
+#endif
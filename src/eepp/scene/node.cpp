@@ -3,12 +3,23 @@
 #include <eepp/graphics/renderer/renderer.hpp>
 #include <eepp/scene/action.hpp>
 #include <eepp/scene/actionmanager.hpp>
+#include <eepp/scene/hittestindex.hpp>
 #include <eepp/scene/node.hpp>
 #include <eepp/scene/scenemanager.hpp>
 #include <eepp/scene/scenenode.hpp>
+#include <eepp/system/thread.hpp>
+#include <eepp/window/engine.hpp>
+#include <eepp/window/input.hpp>
+#include <eepp/window/window.hpp>
 
 namespace EE { namespace Scene {
 
+static Uint64 sTransformUpdates = 0;
+
+Uint64 Node::getTransformUpdateCount() {
+	return sTransformUpdates;
+}
+
 Node* Node::New() {
 	return eeNew( Node, () );
 }
@@ -24,9 +35,12 @@ Node::Node() :
 	mChildLast( NULL ),
 	mNext( NULL ),
 	mPrev( NULL ),
-	mNodeFlags( NODE_FLAG_POSITION_DIRTY | NODE_FLAG_POLYGON_DIRTY ),
+	mChildCount( 0 ),
+	mHitTestIndex( NULL ),
+	mNodeFlags( NODE_FLAG_POSITION_DIRTY | NODE_FLAG_POLYGON_DIRTY | NODE_FLAG_TRANSFORM_DIRTY ),
 	mBlend( BlendAlpha ),
 	mNumCallBacks( 0 ),
+	mScreenTransformed( false ),
 	mVisible( true ),
 	mEnabled( true ),
 	mAlpha( 255.f ) {}
@@ -41,10 +55,15 @@ Node::~Node() {
 
 		if ( isMouseOverMeOrChilds() )
 			mSceneNode->removeMouseOverNode( this );
+
+		if ( mSceneNode->usesDirtyRegions() )
+			mSceneNode->removeDirtyNode( this );
 	}
 
 	childDeleteAll();
 
+	eeSAFE_DELETE( mHitTestIndex );
+
 	if ( NULL != mParentNode )
 		mParentNode->childRemove( this );
 
@@ -132,6 +151,18 @@ Node* Node::setPosition( const Float& x, const Float& y ) {
 void Node::setInternalSize( const Sizef& size ) {
 	mSize = size;
 	mNodeFlags |= NODE_FLAG_POLYGON_DIRTY;
+
+	if ( NULL != mSceneNode )
+		mSceneNode->invalidateHitTest();
+
+	if ( NULL != mParentNode && NULL != mParentNode->mHitTestIndex )
+		mParentNode->mHitTestIndex->invalidate( this );
+
+	// The rotation and scale centers can depend on the size, and the children are transformed
+	// around them.
+	if ( mNodeFlags & ( NODE_FLAG_ROTATED | NODE_FLAG_SCALED ) )
+		setChildsDirty();
+
 	updateCenter();
 	sendCommonEvent( Event::OnSizeChange );
 	invalidateDraw();
@@ -172,6 +203,10 @@ const Sizef& Node::getPixelsSize() const {
 Node* Node::setVisible( const bool& visible ) {
 	if ( mVisible != visible ) {
 		mVisible = visible;
+
+		if ( NULL != mSceneNode )
+			mSceneNode->invalidateHitTest();
+
 		onVisibilityChange();
 	}
 	return this;
@@ -188,6 +223,10 @@ bool Node::isHided() const {
 Node* Node::setEnabled( const bool& enabled ) {
 	if ( mEnabled != enabled ) {
 		mEnabled = enabled;
+
+		if ( NULL != mSceneNode )
+			mSceneNode->invalidateHitTest();
+
 		onEnabledChange();
 	}
 	return this;
@@ -488,11 +527,14 @@ void Node::setNodeFlags( const Uint32& Flags ) {
 }
 
 void Node::drawChilds() {
+	const Rectf* cullRect = NULL != mSceneNode ? mSceneNode->getCullRect() : NULL;
+
 	if ( isReverseDraw() ) {
 		Node* child = mChildLast;
 
 		while ( NULL != child ) {
-			if ( child->mVisible ) {
+			if ( child->mVisible &&
+				 ( NULL == cullRect || !child->isOutsideCullRect( *cullRect ) ) ) {
 				child->nodeDraw();
 			}
 
@@ -502,7 +544,8 @@ void Node::drawChilds() {
 		Node* child = mChild;
 
 		while ( NULL != child ) {
-			if ( child->mVisible ) {
+			if ( child->mVisible &&
+				 ( NULL == cullRect || !child->isOutsideCullRect( *cullRect ) ) ) {
 				child->nodeDraw();
 			}
 
@@ -545,15 +588,34 @@ Uint32 Node::forceTextInput( const TextInputEvent& event ) {
 void Node::clipStart() {
 	if ( mVisible && isClipped() ) {
 		clipSmartEnable( mScreenPos.x, mScreenPos.y, mSize.getWidth(), mSize.getHeight() );
+
+		if ( NULL != mSceneNode )
+			mSceneNode->pushCullRect( Rectf( mScreenPos, mSize ) );
 	}
 }
 
 void Node::clipEnd() {
 	if ( mVisible && isClipped() ) {
+		if ( NULL != mSceneNode )
+			mSceneNode->popCullRect();
+
 		clipSmartDisable();
 	}
 }
 
+bool Node::isOutsideCullRect( const Rectf& cullRect ) {
+	// Only clipped nodes can be culled, since the childs of a non-clipped node can be drawn
+	// outside of its bounds. The cull rectangles are in untransformed screen coordinates, so a
+	// node with its own scale or rotation is never culled.
+	if ( !isClipped() || isRotated() || isScaled() )
+		return false;
+
+	if ( mNodeFlags & NODE_FLAG_POSITION_DIRTY )
+		updateScreenPos();
+
+	return !cullRect.overlap( Rectf( mScreenPos, mSize ) );
+}
+
 void Node::matrixSet() {
 	if ( getScale() != 1.f || getRotation() != 0.f ) {
 		GlobalBatchRenderer::instance()->draw();
@@ -599,6 +661,14 @@ void Node::childAdd( Node* node ) {
 		mChildLast = node;
 	}
 
+	mChildCount++;
+
+	if ( NULL != mHitTestIndex )
+		mHitTestIndex->add( node );
+
+	if ( NULL != mSceneNode )
+		mSceneNode->invalidateHitTest();
+
 	eeASSERT( !( NULL == mChildLast && NULL != mChild ) );
 
 	onChildCountChange( node, false );
@@ -654,6 +724,15 @@ void Node::childAddAt( Node* node, Uint32 index ) {
 		}
 	}
 
+	mChildCount++;
+
+	// The order of the children changed.
+	if ( NULL != mHitTestIndex )
+		mHitTestIndex->reset();
+
+	if ( NULL != mSceneNode )
+		mSceneNode->invalidateHitTest();
+
 	eeASSERT( !( NULL == mChildLast && NULL != mChild ) );
 
 	onChildCountChange( node, false );
@@ -686,6 +765,14 @@ void Node::childRemove( Node* node ) {
 		node->mPrev = NULL;
 	}
 
+	mChildCount--;
+
+	if ( NULL != mHitTestIndex )
+		mHitTestIndex->remove( node );
+
+	if ( NULL != mSceneNode )
+		mSceneNode->invalidateHitTest();
+
 	eeASSERT( !( NULL == mChildLast && NULL != mChild ) );
 
 	onChildCountChange( node, true );
@@ -809,13 +896,7 @@ bool Node::isLoadingState() const {
 }
 
 Uint32 Node::getChildCount() const {
-	Node* child = mChild;
-	Uint32 count = 0;
-	while ( NULL != child ) {
-		child = child->mNext;
-		count++;
-	}
-	return count;
+	return mChildCount;
 }
 
 Uint32 Node::getChildOfTypeCount( const Uint32& type ) const {
@@ -891,18 +972,32 @@ Node* Node::overFind( const Vector2f& point ) {
 			writeNodeFlag( NODE_FLAG_MOUSEOVER_ME_OR_CHILD, 1 );
 			mSceneNode->addMouseOverNode( this );
 
-			Node* child = mChildLast;
+			if ( NULL == mHitTestIndex && mChildCount >= Private::HitTestIndex::MinChildCount )
+				mHitTestIndex = eeNew( Private::HitTestIndex, ( this ) );
+			else if ( NULL != mHitTestIndex &&
+					  mChildCount < Private::HitTestIndex::MinChildCount / 2 )
+				eeSAFE_DELETE( mHitTestIndex );
+
+			if ( NULL != mHitTestIndex ) {
+				// Only the children under the point, already sorted from top to bottom.
+				for ( Node* child : mHitTestIndex->query( point ) ) {
+					if ( NULL != ( pOver = child->overFind( point ) ) )
+						break;
+				}
+			} else {
+				Node* child = mChildLast;
 
-			while ( NULL != child ) {
-				Node* childOver = child->overFind( point );
+				while ( NULL != child ) {
+					Node* childOver = child->overFind( point );
 
-				if ( NULL != childOver ) {
-					pOver = childOver;
+					if ( NULL != childOver ) {
+						pOver = childOver;
 
-					break; // Search from top to bottom, so the first over will be the topmost
-				}
+						break; // Search from top to bottom, so the first over will be the topmost
+					}
 
-				child = child->mPrev;
+					child = child->mPrev;
+				}
 			}
 
 			if ( NULL == pOver )
@@ -1031,7 +1126,8 @@ bool Node::isMeOrParentTreeScaledOrRotated() const {
 bool Node::isMeOrParentTreeScaledOrRotatedOrFrameBuffer() const {
 	const Node* node = this;
 	while ( NULL != node ) {
-		if ( node->isScaled() || node->isRotated() || node->isFrameBuffer() )
+		if ( node->isScaled() || node->isRotated() || node->isFrameBuffer() ||
+			 ( node->mNodeFlags & NODE_FLAG_RENDER_CACHE ) )
 			return true;
 		node = node->getParent();
 	}
@@ -1059,24 +1155,46 @@ void Node::updateWorldPolygon() {
 	if ( mNodeFlags & NODE_FLAG_POSITION_DIRTY )
 		updateScreenPos();
 
-	mPoly = Polygon2f( Rectf( mScreenPos.x, mScreenPos.y, mScreenPos.x + mSize.getWidth(),
-							  mScreenPos.y + mSize.getHeight() ) );
+	// The screen transform of the parent is up to date after this, so only the dirty part of the
+	// tree is recalculated, once per node, instead of walking every parent again.
+	if ( NULL != mParentNode )
+		mParentNode->updateWorldPolygon();
 
-	mPoly.rotate( getRotation(), getRotationCenter() );
-	mPoly.scale( getScale(), getScaleCenter() );
+	mScreenTransformed = ( NULL != mParentNode && mParentNode->mScreenTransformed ) ||
+						 ( mNodeFlags & ( NODE_FLAG_ROTATED | NODE_FLAG_SCALED ) );
 
-	Node* tParent = getParent();
+	if ( mScreenTransformed ) {
+		// The node is rotated and then scaled, and then the same is done by each parent.
+		mScreenTransform = NULL != mParentNode && mParentNode->mScreenTransformed
+							   ? mParentNode->mScreenTransform
+							   : Transform();
+		mScreenTransform.scale( getScale(), getScaleCenter() );
+		mScreenTransform.rotate( getRotation(), getRotationCenter() );
+	}
 
-	while ( tParent ) {
-		mPoly.rotate( tParent->getRotation(), tParent->getRotationCenter() );
-		mPoly.scale( tParent->getScale(), tParent->getScaleCenter() );
+	Rectf rect( mScreenPos.x, mScreenPos.y, mScreenPos.x + mSize.getWidth(),
+				mScreenPos.y + mSize.getHeight() );
 
-		tParent = tParent->getParent();
-	};
+	if ( mPoly.getSize() != 4 )
+		mPoly = Polygon2f( rect );
 
-	mWorldBounds = mPoly.getBounds();
+	if ( mScreenTransformed ) {
+		mPoly.setAt( 0, mScreenTransform.transformPoint( rect.Left, rect.Top ) );
+		mPoly.setAt( 1, mScreenTransform.transformPoint( rect.Left, rect.Bottom ) );
+		mPoly.setAt( 2, mScreenTransform.transformPoint( rect.Right, rect.Bottom ) );
+		mPoly.setAt( 3, mScreenTransform.transformPoint( rect.Right, rect.Top ) );
+		mWorldBounds = mPoly.getBounds();
+	} else {
+		mPoly.setAt( 0, Vector2f( rect.Left, rect.Top ) );
+		mPoly.setAt( 1, Vector2f( rect.Left, rect.Bottom ) );
+		mPoly.setAt( 2, Vector2f( rect.Right, rect.Bottom ) );
+		mPoly.setAt( 3, Vector2f( rect.Right, rect.Top ) );
+		mWorldBounds = rect;
+	}
 
 	mNodeFlags &= ~NODE_FLAG_POLYGON_DIRTY;
+
+	sTransformUpdates++;
 }
 
 void Node::updateCenter() {
@@ -1132,7 +1250,11 @@ void Node::updateScreenPos() {
 
 	Vector2f Pos( mPosition );
 
-	nodeToWorldTranslation( Pos );
+	// Same as nodeToWorldTranslation, but reusing the position of the parent.
+	if ( NULL != mParentNode ) {
+		mParentNode->updateScreenPos();
+		Pos += mParentNode->mScreenPos;
+	}
 
 	mScreenPos = Pos;
 	mScreenPosi = Vector2i( Pos.x, Pos.y );
@@ -1141,6 +1263,8 @@ void Node::updateScreenPos() {
 
 	mNodeFlags &= ~NODE_FLAG_POSITION_DIRTY;
 
+	sTransformUpdates++;
+
 	sendCommonEvent( Event::OnUpdateScreenPosition );
 }
 
@@ -1187,6 +1311,10 @@ void Node::setReverseDraw( bool reverseDraw ) {
 }
 
 void Node::invalidateDraw() {
+	// A render cached node must redraw its cache when the node itself changes.
+	if ( mNodeFlags & NODE_FLAG_RENDER_CACHE )
+		mNodeFlags |= NODE_FLAG_VIEW_DIRTY;
+
 	if ( NULL != mNodeDrawInvalidator ) {
 		mNodeDrawInvalidator->invalidate( this );
 	}
@@ -1239,19 +1367,37 @@ void Node::updateOriginPoint() {
 }
 
 void Node::setDirty() {
-	if ( ( mNodeFlags & NODE_FLAG_POSITION_DIRTY ) && ( mNodeFlags & NODE_FLAG_POLYGON_DIRTY ) )
+	// Any change of the bounds can change the node under the cursor. The parent is notified even
+	// if the node is already dirty, since its hit-test index only tracks the nodes that move by
+	// themselves.
+	if ( NULL != mSceneNode )
+		mSceneNode->invalidateHitTest();
+
+	if ( NULL != mParentNode && NULL != mParentNode->mHitTestIndex )
+		mParentNode->mHitTestIndex->invalidate( this );
+
+	invalidateTransform();
+}
+
+void Node::invalidateTransform() {
+	// If the node is already dirty its children are too.
+	if ( ( mNodeFlags & NODE_FLAG_POSITION_DIRTY ) && ( mNodeFlags & NODE_FLAG_POLYGON_DIRTY ) &&
+		 ( mNodeFlags & NODE_FLAG_TRANSFORM_DIRTY ) )
 		return;
 
-	mNodeFlags |= NODE_FLAG_POSITION_DIRTY | NODE_FLAG_POLYGON_DIRTY;
+	mNodeFlags |= NODE_FLAG_POSITION_DIRTY | NODE_FLAG_POLYGON_DIRTY | NODE_FLAG_TRANSFORM_DIRTY;
 
 	setChildsDirty();
 }
 
 void Node::setChildsDirty() {
+	if ( NULL != mHitTestIndex )
+		mHitTestIndex->invalidate();
+
 	Node* ChildLoop = mChild;
 
 	while ( NULL != ChildLoop ) {
-		ChildLoop->setDirty();
+		ChildLoop->invalidateTransform();
 
 		ChildLoop = ChildLoop->mNext;
 	}
@@ -1460,6 +1606,11 @@ void Node::clearActions() {
 
 void Node::runOnMainThread( Actions::Runnable::RunnableFunc runnable, const Time& delay ) {
 	runAction( Actions::Runnable::New( runnable, delay ) );
+
+	// Wake up the main loop in case it's sleeping until the next event.
+	if ( NULL != mSceneNode && NULL != mSceneNode->getWindow() &&
+		 Thread::getCurrentThreadId() != Engine::instance()->getMainThreadId() )
+		mSceneNode->getWindow()->getInput()->wakeUp();
 }
 
 Transform Node::getLocalTransform() const {
@@ -1467,8 +1618,16 @@ Transform Node::getLocalTransform() const {
 }
 
 Transform Node::getGlobalTransform() const {
-	return NULL != mParentNode ? mParentNode->getGlobalTransform() * getTransform()
-							   : getTransform();
+	if ( mNodeFlags & NODE_FLAG_TRANSFORM_DIRTY ) {
+		mWorldTransform = NULL != mParentNode ? mParentNode->getGlobalTransform() * getTransform()
+											  : getTransform();
+
+		// The flag only tracks the cache, it's not part of the node state.
+		const_cast<Node*>( this )->mNodeFlags &= ~NODE_FLAG_TRANSFORM_DIRTY;
+		sTransformUpdates++;
+	}
+
+	return mWorldTransform;
 }
 
 Transform Node::getNodeToWorldTransform() const {
@@ -2,12 +2,19 @@
 #include <eepp/scene/scenemanager.hpp>
 #include <eepp/scene/scenenode.hpp>
 #include <eepp/ui/uiscenenode.hpp>
+#include <eepp/window/input.hpp>
+#include <eepp/window/window.hpp>
 
 namespace EE { namespace Scene {
 
 SINGLETON_DECLARE_IMPLEMENTATION( SceneManager )
 
-SceneManager::SceneManager() : mUISceneNode( NULL ), mIsShootingDown( false ) {}
+SceneManager::SceneManager() :
+	mUISceneNode( NULL ),
+	mIsShootingDown( false ),
+	mFrameInterval( Microseconds( 1000000 / 60 ) ),
+	mWakeUps( 0 ),
+	mWakeUpsPerSecond( 0 ) {}
 
 SceneManager::~SceneManager() {
 	mIsShootingDown = true;
@@ -48,6 +55,14 @@ void SceneManager::update( const Time& elapsed ) {
 	for ( auto& sceneNode : mSceneNodes ) {
 		sceneNode->update( elapsed );
 	}
+
+	mWakeUps++;
+
+	if ( mWakeUpsClock.getElapsedTime() >= Seconds( 1 ) ) {
+		mWakeUpsPerSecond = mWakeUps / mWakeUpsClock.getElapsedTime().asSeconds();
+		mWakeUps = 0;
+		mWakeUpsClock.restart();
+	}
 }
 
 void SceneManager::update() {
@@ -79,4 +94,58 @@ Time SceneManager::getElapsed() const {
 	return mClock.getElapsedTime();
 }
 
+bool SceneManager::getNextDeadline( Time& timeLeft ) const {
+	bool found = false;
+
+	for ( auto& sceneNode : mSceneNodes ) {
+		if ( !sceneNode->hasUpdateDeadline() )
+			continue;
+
+		Time sceneDeadline( sceneNode->getTimeToUpdateDeadline() );
+
+		if ( !found || sceneDeadline < timeLeft ) {
+			timeLeft = sceneDeadline;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+void SceneManager::waitForNextDeadline( EE::Window::Window* window, const Time& maxWait ) {
+	Time wait( maxWait );
+	Time deadline;
+
+	if ( getNextDeadline( deadline ) ) {
+		wait = maxWait != Time::Zero ? eemin( deadline, maxWait ) : deadline;
+
+		// mClock is restarted by update(), so it holds the time since the last update.
+		wait = eemax( wait, mFrameInterval - mClock.getElapsedTime() );
+
+		// Less than a millisecond is not worth the wait.
+		if ( wait < Milliseconds( 1 ) )
+			return;
+	}
+
+	window->getInput()->waitEvent( wait );
+}
+
+const Time& SceneManager::getFrameInterval() const {
+	return mFrameInterval;
+}
+
+void SceneManager::setFrameInterval( const Time& frameInterval ) {
+	mFrameInterval = frameInterval;
+}
+
+Float SceneManager::getWakeUpsPerSecond() const {
+	Time elapsed( mWakeUpsClock.getElapsedTime() );
+
+	// When idle for longer than a second the current count is the most accurate measure.
+	if ( elapsed >= Seconds( 1 ) )
+		return mWakeUps / elapsed.asSeconds();
+
+	return mWakeUpsPerSecond;
+}
+
 }} // namespace EE::Scene
@@ -1,10 +1,12 @@
 #include <algorithm>
 #include <eepp/graphics/framebuffer.hpp>
 #include <eepp/graphics/globalbatchrenderer.hpp>
+#include <eepp/graphics/renderer/openglext.hpp>
 #include <eepp/graphics/renderer/renderer.hpp>
 #include <eepp/graphics/textureregion.hpp>
 #include <eepp/scene/actionmanager.hpp>
 #include <eepp/scene/scenenode.hpp>
+#include <eepp/system/profiler.hpp>
 #include <eepp/window/cursormanager.hpp>
 #include <eepp/window/engine.hpp>
 #include <eepp/window/window.hpp>
@@ -33,7 +35,13 @@ SceneNode::SceneNode( EE::Window::Window* window ) :
 	mHighlightInvalidation( false ),
 	mHighlightFocusColor( 234, 195, 123, 255 ),
 	mHighlightOverColor( 195, 123, 234, 255 ),
-	mHighlightInvalidationColor( 220, 0, 0, 255 ) {
+	mHighlightInvalidationColor( 220, 0, 0, 255 ),
+	mUseDirtyRegions( false ),
+	mDirtyRegionFull( true ),
+	mDirtyRegionEmpty( true ),
+	mDirtyRegionClipped( false ),
+	mHasUpdateDeadline( false ),
+	mHitTestGeneration( 0 ) {
 	mNodeFlags |= NODE_FLAG_SCENENODE;
 	mSceneNode = this;
 
@@ -120,6 +128,8 @@ void SceneNode::draw() {
 		postDraw();
 
 		writeNodeFlag( NODE_FLAG_VIEW_DIRTY, 0 );
+
+		resetDirtyRegion();
 	}
 
 	mWindow->setView( prevView );
@@ -128,8 +138,14 @@ void SceneNode::draw() {
 }
 
 void SceneNode::update( const Time& time ) {
+	EE_PROFILE_SCOPE( "SceneNode::update" );
+
 	mElapsed = time;
 
+	// The deadlines already reached are fulfilled by this update.
+	if ( mHasUpdateDeadline && mDeadlineClock.getElapsedTime() >= mUpdateDeadline )
+		mHasUpdateDeadline = false;
+
 	mActionManager->update( time );
 
 	if ( NULL != mEventDispatcher )
@@ -156,7 +172,8 @@ void SceneNode::update( const Time& time ) {
 			nodeOver->writeNodeFlag( NODE_FLAG_MOUSEOVER_ME_OR_CHILD, 0 );
 	}
 
-	mMouseOverNodes.clear();
+	// The mouse over nodes are kept, if nothing moves the event dispatcher restores their flags
+	// in the next frames instead of searching them again.
 }
 
 void SceneNode::onSizeChange() {
@@ -243,6 +260,7 @@ void SceneNode::createFrameBuffer() {
 		fboSize.setHeight( 1 );
 	mFrameBuffer =
 		FrameBuffer::New( fboSize.getWidth(), fboSize.getHeight(), true, false, false, 4, mWindow );
+	mDirtyRegionFull = true;
 
 	// Frame buffer failed to create?
 	if ( !mFrameBuffer->created() ) {
@@ -266,6 +284,92 @@ void SceneNode::drawFrameBuffer() {
 	}
 }
 
+void SceneNode::setUseDirtyRegions( bool use ) {
+	mUseDirtyRegions = use;
+	mDirtyRegionFull = true;
+	mDirtyNodes.clear();
+	invalidateDraw();
+}
+
+bool SceneNode::usesDirtyRegions() const {
+	return mUseDirtyRegions;
+}
+
+void SceneNode::invalidate( Node* invalidator ) {
+	Node::invalidate( invalidator );
+
+	if ( !mUseDirtyRegions || mDirtyRegionFull )
+		return;
+
+	if ( NULL == invalidator || invalidator == this ) {
+		mDirtyRegionFull = true;
+		mDirtyNodes.clear();
+		return;
+	}
+
+	// The cached bounds are the ones used the last time the node was drawn, the new bounds are
+	// added when the region is requested.
+	addDirtyRect( invalidator->mWorldBounds );
+	mDirtyNodes.insert( invalidator );
+}
+
+void SceneNode::addDirtyRect( const Rectf& rect ) {
+	if ( rect.getWidth() <= 0 || rect.getHeight() <= 0 )
+		return;
+
+	if ( mDirtyRegionEmpty ) {
+		mDirtyRegion = rect;
+		mDirtyRegionEmpty = false;
+	} else {
+		mDirtyRegion.expand( rect );
+	}
+}
+
+void SceneNode::removeDirtyNode( Node* node ) {
+	mDirtyNodes.erase( node );
+}
+
+void SceneNode::resetDirtyRegion() {
+	mDirtyNodes.clear();
+	mDirtyRegionEmpty = true;
+	mDirtyRegionFull = false;
+}
+
+Rectf SceneNode::getDirtyRegion() {
+	for ( Node* node : mDirtyNodes )
+		if ( node->getSceneNode() == this )
+			addDirtyRect( node->getWorldBounds() );
+
+	mDirtyNodes.clear();
+
+	if ( mDirtyRegionEmpty )
+		return Rectf();
+
+	Rectf region( mDirtyRegion.Left, mDirtyRegion.Top, mDirtyRegion.Right, mDirtyRegion.Bottom );
+	region.shrink( Rectf( mScreenPos, mSize ) );
+	return Rectf( eefloor( region.Left ), eefloor( region.Top ), eeceil( region.Right ),
+				  eeceil( region.Bottom ) );
+}
+
+void SceneNode::pushCullRect( const Rectf& rect, bool intersect ) {
+	if ( mCullRects.empty() || !intersect ) {
+		mCullRects.push_back( rect );
+	} else {
+		Rectf r( rect );
+		r.shrink( mCullRects.back() );
+		mCullRects.push_back( r );
+	}
+}
+
+void SceneNode::popCullRect() {
+	if ( !mCullRects.empty() )
+		mCullRects.pop_back();
+}
+
+const Rectf* SceneNode::getCullRect() const {
+	return mCullRects.empty() ? NULL : &mCullRects.back();
+}
+
 void SceneNode::enableDrawInvalidation() {
 	mUseInvalidation = true;
 }
@@ -285,13 +389,35 @@ void SceneNode::matrixSet() {
 
 			mFrameBuffer->bind();
 
-			mFrameBuffer->clear();
+			if ( mUseInvalidation && mUseDirtyRegions && !mDirtyRegionFull ) {
+				Rectf region( getDirtyRegion() );
+				Rectf local( region.Left - mScreenPos.x, region.Top - mScreenPos.y,
+							 region.Right - mScreenPos.x, region.Bottom - mScreenPos.y );
+
+				GLi->scissor( local.Left, mFrameBuffer->getHeight() - local.Bottom,
+							  local.getWidth(), local.getHeight() );
+				GLi->enable( GL_SCISSOR_TEST );
+				mFrameBuffer->clear();
+				GLi->disable( GL_SCISSOR_TEST );
+
+				mDirtyRegionClipped = true;
+				mDirtyRegion = region;
+			} else {
+				mFrameBuffer->clear();
+			}
 		}
 
 		if ( 0.f != mScreenPos ) {
 			GLi->pushMatrix();
 			GLi->translatef( -mScreenPos.x, -mScreenPos.y, 0.f );
 		}
+
+		if ( mDirtyRegionClipped ) {
+			GLi->getClippingMask()->clipPlaneEnable( mDirtyRegion.Left, mDirtyRegion.Top,
+													 mDirtyRegion.getWidth(),
+													 mDirtyRegion.getHeight() );
+			pushCullRect( mDirtyRegion );
+		}
 	} else {
 		Node::matrixSet();
 	}
@@ -301,6 +427,12 @@ void SceneNode::matrixUnset() {
 	if ( NULL != mFrameBuffer ) {
 		GlobalBatchRenderer::instance()->draw();
 
+		if ( mDirtyRegionClipped ) {
+			popCullRect();
+			GLi->getClippingMask()->clipPlaneDisable();
+			mDirtyRegionClipped = false;
+		}
+
 		if ( 0.f != mScreenPos )
 			GLi->popMatrix();
 
@@ -469,6 +601,24 @@ void SceneNode::removeMouseOverNode( Node* node ) {
 	mMouseOverNodes.erase( node );
 }
 
+void SceneNode::invalidateHitTest() {
+	mHitTestGeneration++;
+}
+
+const Uint64& SceneNode::getHitTestGeneration() const {
+	return mHitTestGeneration;
+}
+
+void SceneNode::resetMouseOverNodes() {
+	mMouseOverNodes.clear();
+}
+
+void SceneNode::restoreMouseOverNodes() {
+	// Every node removed from the scene invalidates the hit-test, so these are still alive.
+	for ( auto& nodeOver : mMouseOverNodes )
+		nodeOver->writeNodeFlag( NODE_FLAG_MOUSEOVER_ME_OR_CHILD, 1 );
+}
+
 const bool& SceneNode::getUpdateAllChilds() const {
 	return mUpdateAllChilds;
 }
@@ -481,4 +631,30 @@ const Float& SceneNode::getDPI() const {
 	return mDPI;
 }
 
+void SceneNode::setUpdateDeadline( const Time& timeFromNow ) {
+	Time deadline( mDeadlineClock.getElapsedTime() + eemax( Time::Zero, timeFromNow ) );
+
+	if ( !mHasUpdateDeadline || deadline < mUpdateDeadline ) {
+		mUpdateDeadline = deadline;
+		mHasUpdateDeadline = true;
+	}
+}
+
+bool SceneNode::hasUpdateDeadline() const {
+	return mHasUpdateDeadline || !mActionManager->isEmpty();
+}
+
+Time SceneNode::getTimeToUpdateDeadline() const {
+	Time deadline( mHasUpdateDeadline ? mUpdateDeadline - mDeadlineClock.getElapsedTime()
+									  : Time::Zero );
+	Time actionsDeadline;
+
+	// The actions deadlines are collected when requested since actions are started at any time.
+	if ( mActionManager->getNextDeadline( actionsDeadline ) &&
+		 ( !mHasUpdateDeadline || actionsDeadline < deadline ) )
+		deadline = actionsDeadline;
+
+	return eemax( Time::Zero, deadline );
+}
+
 }} // namespace EE::Scene
@@ -0,0 +1,212 @@
+#include <cstring>
+#include <eepp/core/memorymanager.hpp>
+#include <eepp/system/iostreamfile.hpp>
+#include <eepp/system/iostreammapped.hpp>
+
+#if EE_PLATFORM == EE_PLATFORM_WIN
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined( EE_PLATFORM_POSIX ) && EE_PLATFORM != EE_PLATFORM_EMSCRIPTEN
+#define EE_IOSTREAM_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace EE { namespace System {
+
+#ifdef EE_IOSTREAM_MMAP
+static int accessHintToAdvice( const IOStreamMapped::AccessHint& hint ) {
+	switch ( hint ) {
+		case IOStreamMapped::AccessHint::Sequential:
+			return MADV_SEQUENTIAL;
+		case IOStreamMapped::AccessHint::Random:
+			return MADV_RANDOM;
+		case IOStreamMapped::AccessHint::WillNeed:
+			return MADV_WILLNEED;
+		case IOStreamMapped::AccessHint::Normal:
+		default:
+			return MADV_NORMAL;
+	}
+}
+#endif
+
+IOStreamMapped* IOStreamMapped::New( const std::string& path, const AccessHint& hint ) {
+	return eeNew( IOStreamMapped, ( path, hint ) );
+}
+
+IOStreamMapped::IOStreamMapped( const std::string& path, const AccessHint& hint ) :
+	mData( NULL ),
+	mSize( 0 ),
+	mPos( 0 ),
+	mOpen( false ),
+	mMapped( false )
+#if EE_PLATFORM == EE_PLATFORM_WIN
+	,
+	mFile( INVALID_HANDLE_VALUE ),
+	mMapping( NULL )
+#endif
+{
+#if defined( EE_IOSTREAM_MMAP )
+	int fd = ::open( path.c_str(), O_RDONLY );
+
+	if ( -1 == fd )
+		return;
+
+	struct stat st;
+
+	if ( 0 == fstat( fd, &st ) && S_ISREG( st.st_mode ) ) {
+		mOpen = true;
+		mSize = static_cast<ios_size>( st.st_size );
+
+		if ( mSize > 0 ) {
+			void* data = mmap( NULL, static_cast<size_t>( mSize ), PROT_READ, MAP_PRIVATE, fd, 0 );
+
+			if ( MAP_FAILED != data ) {
+				mData = static_cast<const char*>( data );
+				mMapped = true;
+				setAccessHint( hint );
+			}
+		}
+	}
+
+	// The mapping keeps its own reference to the file.
+	::close( fd );
+#elif EE_PLATFORM == EE_PLATFORM_WIN
+	HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+							   OPEN_EXISTING,
+							   hint == AccessHint::Random ? FILE_FLAG_RANDOM_ACCESS
+														  : FILE_FLAG_SEQUENTIAL_SCAN,
+							   NULL );
+
+	if ( INVALID_HANDLE_VALUE == file )
+		return;
+
+	LARGE_INTEGER size;
+
+	if ( GetFileSizeEx( file, &size ) ) {
+		mOpen = true;
+		mSize = static_cast<ios_size>( size.QuadPart );
+
+		if ( mSize > 0 ) {
+			HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+
+			if ( NULL != mapping ) {
+				void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+				mData = static_cast<const char*>( data );
+
+				if ( NULL != mData ) {
+					mMapping = mapping;
+					mFile = file;
+					mMapped = true;
+					return;
+				}
+
+				CloseHandle( mapping );
+			}
+		}
+	}
+
+	CloseHandle( file );
+#endif
+
+	if ( !mMapped && ( !mOpen || mSize > 0 ) ) {
+		// No memory mapping available, read the whole file once.
+		IOStreamFile file( path );
+		ios_size size = file.getSize();
+
+		mOpen = file.isOpen();
+		mSize = 0;
+
+		if ( size > 0 ) {
+			char* data = eeNewArray( char, size );
+			mSize = file.read( data, size );
+			mData = data;
+		}
+	}
+}
+
+IOStreamMapped::~IOStreamMapped() {
+	close();
+}
+
+ios_size IOStreamMapped::read( char* data, ios_size size ) {
+	if ( NULL == mData || mPos >= mSize || size <= 0 )
+		return 0;
+
+	ios_size count = eemin( size, mSize - mPos );
+
+	memcpy( data, mData + mPos, static_cast<size_t>( count ) );
+
+	mPos += count;
+
+	return count;
+}
+
+ios_size IOStreamMapped::write( const char*, ios_size ) {
+	return 0;
+}
+
+ios_size IOStreamMapped::seek( ios_size position ) {
+	mPos = eemax<ios_size>( 0, eemin( position, mSize ) );
+	return mPos;
+}
+
+ios_size IOStreamMapped::tell() {
+	return mOpen ? mPos : -1;
+}
+
+ios_size IOStreamMapped::getSize() {
+	return mSize;
+}
+
+bool IOStreamMapped::isOpen() {
+	return mOpen;
+}
+
+const char* IOStreamMapped::getData() const {
+	return mData;
+}
+
+void IOStreamMapped::setAccessHint( const AccessHint& hint ) {
+#ifdef EE_IOSTREAM_MMAP
+	if ( mMapped )
+		madvise( const_cast<char*>( mData ), static_cast<size_t>( mSize ),
+				 accessHintToAdvice( hint ) );
+#endif
+}
+
+bool IOStreamMapped::isMapped() const {
+	return mMapped;
+}
+
+void IOStreamMapped::close() {
+	if ( mMapped ) {
+#if defined( EE_IOSTREAM_MMAP )
+		munmap( const_cast<char*>( mData ), static_cast<size_t>( mSize ) );
+#elif EE_PLATFORM == EE_PLATFORM_WIN
+		UnmapViewOfFile( mData );
+		CloseHandle( mMapping );
+		CloseHandle( mFile );
+		mMapping = NULL;
+		mFile = INVALID_HANDLE_VALUE;
+#endif
+	} else if ( NULL != mData ) {
+		char* data = const_cast<char*>( mData );
+		eeSAFE_DELETE_ARRAY( data );
+	}
+
+	mData = NULL;
+	mSize = 0;
+	mPos = 0;
+	mOpen = false;
+	mMapped = false;
+}
+
+}} // namespace EE::System
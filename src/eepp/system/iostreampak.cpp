@@ -1,3 +1,4 @@
+#include <cstring>
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/system/iostreampak.hpp>
 
@@ -8,12 +9,18 @@ IOStreamPak* IOStreamPak::New( Pak* pack, const std::string& path, bool writeMod
 }
 
 IOStreamPak::IOStreamPak( Pak* pack, const std::string& path, bool writeMode ) :
-	mFile( NULL ), mPos( 0 ), mOpen( false ) {
+	mFile( NULL ), mData( NULL ), mPos( 0 ), mOpen( false ) {
 	int index = -1;
 
 	if ( -1 != ( index = pack->exists( path ) ) ) {
 		mEntry = pack->getPackEntry( (Uint32)index );
 
+		if ( !writeMode &&
+			 NULL != ( mData = reinterpret_cast<const char*>( pack->getEntryData( mEntry ) ) ) ) {
+			mOpen = true;
+			return;
+		}
+
 		mFile = IOStreamFile::New( pack->getPackPath(), ( writeMode ? "wb" : "rb" ) );
 
 		if ( mFile->isOpen() ) {
@@ -29,7 +36,16 @@ IOStreamPak::~IOStreamPak() {
 
 ios_size IOStreamPak::read( char* data, ios_size size ) {
 	if ( isOpen() ) {
-		mFile->read( data, size );
+		size = eemin<ios_size>( size, (ios_size)mEntry.file_length - mPos );
+
+		if ( size <= 0 )
+			return 0;
+
+		if ( NULL != mData ) {
+			memcpy( data, mData + mPos, size );
+		} else {
+			size = mFile->read( data, size );
+		}
 
 		mPos += size;
 	}
@@ -38,7 +54,7 @@ ios_size IOStreamPak::read( char* data, ios_size size ) {
 }
 
 ios_size IOStreamPak::write( const char* data, ios_size size ) {
-	if ( isOpen() && static_cast<Uint32>( mPos ) + size < mEntry.file_length ) {
+	if ( isOpen() && NULL != mFile && static_cast<Uint32>( mPos ) + size < mEntry.file_length ) {
 		mFile->write( data, size );
 	}
 
@@ -47,7 +63,9 @@ ios_size IOStreamPak::write( const char* data, ios_size size ) {
 
 ios_size IOStreamPak::seek( ios_size position ) {
 	if ( isOpen() ) {
-		mFile->seek( mEntry.file_position + position );
+		if ( NULL == mData )
+			mFile->seek( mEntry.file_position + position );
+
 		mPos = position;
 	}
 
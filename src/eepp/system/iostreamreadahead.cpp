@@ -0,0 +1,199 @@
+#include <cstring>
+#include <eepp/core/memorymanager.hpp>
+#include <eepp/system/iostreamfile.hpp>
+#include <eepp/system/iostreamreadahead.hpp>
+#include <eepp/system/thread.hpp>
+
+namespace EE { namespace System {
+
+IOStreamReadAhead* IOStreamReadAhead::New( const std::string& path, const size_t& chunkSize,
+										   const size_t& chunksAhead ) {
+	return eeNew( IOStreamReadAhead,
+				  ( IOStreamFile::New( path, "rb" ), true, chunkSize, chunksAhead ) );
+}
+
+IOStreamReadAhead* IOStreamReadAhead::New( IOStream* stream, bool ownStream,
+										   const size_t& chunkSize, const size_t& chunksAhead ) {
+	return eeNew( IOStreamReadAhead, ( stream, ownStream, chunkSize, chunksAhead ) );
+}
+
+IOStreamReadAhead::IOStreamReadAhead( IOStream* stream, bool ownStream, const size_t& chunkSize,
+									  const size_t& chunksAhead ) :
+	mStream( stream ),
+	mOwnStream( ownStream ),
+	mChunkSize( eemax<size_t>( 1, chunkSize ) ),
+	mChunksAhead( eemax<size_t>( 1, chunksAhead ) ),
+	mSize( 0 ),
+	mPos( 0 ),
+	mCurrentPos( 0 ),
+	mEof( false ),
+	mStop( false ),
+	mThread( NULL ) {
+	if ( isOpen() ) {
+		mSize = mStream->getSize();
+		mPos = eemax<ios_size>( 0, mStream->tell() );
+		startReadAhead();
+	}
+}
+
+IOStreamReadAhead::~IOStreamReadAhead() {
+	stopReadAhead();
+
+	if ( mOwnStream )
+		eeSAFE_DELETE( mStream );
+}
+
+ios_size IOStreamReadAhead::read( char* data, ios_size size ) {
+	ios_size total = 0;
+
+	if ( NULL == mThread && mCurrentPos >= mCurrent.size() )
+		return total;
+
+	while ( total < size ) {
+		if ( mCurrentPos >= mCurrent.size() && !nextChunk() )
+			break;
+
+		size_t count = eemin<size_t>( size - total, mCurrent.size() - mCurrentPos );
+
+		memcpy( data + total, mCurrent.data() + mCurrentPos, count );
+
+		mCurrentPos += count;
+		total += count;
+	}
+
+	mPos += total;
+
+	return total;
+}
+
+ios_size IOStreamReadAhead::write( const char*, ios_size ) {
+	return 0;
+}
+
+ios_size IOStreamReadAhead::seek( ios_size position ) {
+	if ( !isOpen() )
+		return 0;
+
+	position = eemax<ios_size>( 0, eemin( position, mSize ) );
+
+	ios_size chunkStart = mPos - mCurrentPos;
+
+	if ( position >= chunkStart && position <= chunkStart + (ios_size)mCurrent.size() ) {
+		mCurrentPos = position - chunkStart;
+		mPos = position;
+		return mPos;
+	}
+
+	stopReadAhead();
+
+	mCurrent.clear();
+	mCurrentPos = 0;
+	mReady.clear();
+	mStream->seek( position );
+	mPos = position;
+
+	startReadAhead();
+
+	return mPos;
+}
+
+ios_size IOStreamReadAhead::tell() {
+	return isOpen() ? mPos : -1;
+}
+
+ios_size IOStreamReadAhead::getSize() {
+	return mSize;
+}
+
+bool IOStreamReadAhead::isOpen() {
+	return NULL != mStream && mStream->isOpen();
+}
+
+void IOStreamReadAhead::readAhead() {
+	while ( true ) {
+		Chunk chunk;
+
+		{
+			std::unique_lock<std::mutex> lock( mMutex );
+
+			mCondition.wait( lock, [&] { return mStop || mReady.size() < mChunksAhead; } );
+
+			if ( mStop )
+				return;
+
+			if ( !mFree.empty() ) {
+				chunk.swap( mFree.back() );
+				mFree.pop_back();
+			}
+		}
+
+		chunk.resize( mChunkSize );
+
+		ios_size count = mStream->read( chunk.data(), (ios_size)mChunkSize );
+		bool eof = count < (ios_size)mChunkSize;
+
+		{
+			std::lock_guard<std::mutex> lock( mMutex );
+
+			if ( count > 0 ) {
+				chunk.resize( count );
+				mReady.emplace_back( std::move( chunk ) );
+			}
+
+			mEof = eof;
+		}
+
+		mCondition.notify_all();
+
+		if ( eof )
+			return;
+	}
+}
+
+void IOStreamReadAhead::startReadAhead() {
+	mStop = false;
+	mEof = false;
+	mThread = eeNew( Thread, ( &IOStreamReadAhead::readAhead, this ) );
+	mThread->launch();
+}
+
+void IOStreamReadAhead::stopReadAhead() {
+	if ( NULL == mThread )
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mStop = true;
+	}
+
+	mCondition.notify_all();
+	mThread->wait();
+	eeSAFE_DELETE( mThread );
+}
+
+bool IOStreamReadAhead::nextChunk() {
+	std::unique_lock<std::mutex> lock( mMutex );
+
+	// Give the consumed chunk back to the worker so its memory is reused.
+	if ( mCurrent.capacity() > 0 ) {
+		mFree.emplace_back( std::move( mCurrent ) );
+		mCurrent = Chunk();
+	}
+
+	mCurrentPos = 0;
+
+	mCondition.wait( lock, [&] { return mStop || mEof || !mReady.empty(); } );
+
+	if ( mReady.empty() )
+		return false;
+
+	mCurrent = std::move( mReady.front() );
+	mReady.pop_front();
+
+	lock.unlock();
+	mCondition.notify_all();
+
+	return true;
+}
+
+}} // namespace EE::System
@@ -1,16 +1,66 @@
+#include <cstring>
 #include <eepp/system/iostreamzip.hpp>
 #include <eepp/system/zip.hpp>
 #include <libzip/zip.h>
 #include <libzip/zipint.h>
+#include <deque>
+#include <zlib.h>
 
 namespace EE { namespace System {
 
+static const ios_size ZIP_CHECKPOINT_INTERVAL = EE_1MB;
+
+struct ZipInflateData {
+	struct Checkpoint {
+		ios_size pos;
+		z_stream strm;
+	};
+
+	// zlib streams can't be moved once initialized, the deque keeps them in place.
+	z_stream strm;
+	std::deque<Checkpoint> checkpoints; // The checkpoint k is at ( k + 1 ) * interval.
+	bool ok;
+};
+
+static bool zipInflateInit( ZipInflateData& inflateData, const Uint8* data,
+							const Uint64& compressedSize ) {
+	inflateData.strm = z_stream{};
+	inflateData.ok = Z_OK == inflateInit2( &inflateData.strm, -MAX_WBITS );
+	inflateData.strm.next_in = const_cast<Bytef*>( data );
+	inflateData.strm.avail_in = (uInt)compressedSize;
+	return inflateData.ok;
+}
+
 IOStreamZip* IOStreamZip::New( Zip* pack, const std::string& path ) {
 	return eeNew( IOStreamZip, ( pack, path ) );
 }
 
 IOStreamZip::IOStreamZip( Zip* pack, const std::string& path ) :
-	mPath( path ), mZip( pack->getZip() ), mFile( NULL ), mPos( 0 ) {
+	mPath( path ),
+	mZip( pack->getZip() ),
+	mFile( NULL ),
+	mPos( 0 ),
+	mData( NULL ),
+	mInflate( NULL ) {
+	const Zip::Entry* entry = pack->getEntry( path );
+
+	if ( NULL != entry && 0 != entry->offset ) {
+		mEntry = *entry;
+		mData = pack->getEntryData( mEntry );
+
+		if ( ZIP_CM_DEFLATE == mEntry.method ) {
+			mInflate = eeNew( ZipInflateData, () );
+
+			if ( !zipInflateInit( *mInflate, mData, mEntry.compressedSize ) ) {
+				eeSAFE_DELETE( mInflate );
+				mData = NULL;
+			}
+		}
+
+		if ( NULL != mData )
+			return;
+	}
+
 	struct zip_stat zs;
 	int err = zip_stat( mZip, path.c_str(), 0, &zs );
 
@@ -20,12 +70,36 @@ IOStreamZip::IOStreamZip( Zip* pack, const std::string& path ) :
 }
 
 IOStreamZip::~IOStreamZip() {
-	if ( isOpen() ) {
+	if ( NULL != mInflate ) {
+		if ( mInflate->ok )
+			inflateEnd( &mInflate->strm );
+
+		for ( auto& checkpoint : mInflate->checkpoints )
+			inflateEnd( &checkpoint.strm );
+
+		eeSAFE_DELETE( mInflate );
+	}
+
+	if ( NULL != mFile ) {
 		zip_fclose( mFile );
 	}
 }
 
 ios_size IOStreamZip::read( char* data, ios_size size ) {
+	if ( NULL != mData ) {
+		size = eemin<ios_size>( size, (ios_size)mEntry.size - mPos );
+
+		if ( size <= 0 )
+			return 0;
+
+		if ( NULL != mInflate )
+			return inflateRead( data, size );
+
+		memcpy( data, mData + mPos, size );
+		mPos += size;
+		return size;
+	}
+
 	int res = -1;
 
 	if ( isOpen() ) {
@@ -44,6 +118,17 @@ ios_size IOStreamZip::write( const char* data, ios_size size ) {
 }
 
 ios_size IOStreamZip::seek( ios_size position ) {
+	if ( NULL != mData ) {
+		position = eemax<ios_size>( 0, eemin<ios_size>( position, mEntry.size ) );
+
+		if ( NULL != mInflate )
+			inflateSeek( position );
+		else
+			mPos = position;
+
+		return mPos;
+	}
+
 	if ( isOpen() && mPos != position ) {
 		zip_fclose( mFile );
 
@@ -72,13 +157,89 @@ ios_size IOStreamZip::tell() {
 }
 
 ios_size IOStreamZip::getSize() {
+	if ( NULL != mData )
+		return mEntry.size;
+
 	struct zip_stat zs;
 	int err = zip_stat( mZip, mPath.c_str(), 0, &zs );
 	return !err ? zs.size : 0;
 }
 
 bool IOStreamZip::isOpen() {
-	return NULL != mFile;
+	return NULL != mFile || NULL != mData;
+}
+
+ios_size IOStreamZip::inflateRead( char* data, ios_size size ) {
+	ZipInflateData& inflateData = *mInflate;
+	ios_size total = 0;
+
+	while ( inflateData.ok && total < size ) {
+		ios_size next = ( inflateData.checkpoints.size() + 1 ) * ZIP_CHECKPOINT_INTERVAL;
+
+		// Save the decompression state the first time a checkpoint position is reached.
+		if ( mPos == next ) {
+			inflateData.checkpoints.emplace_back();
+
+			ZipInflateData::Checkpoint& checkpoint = inflateData.checkpoints.back();
+			checkpoint.pos = mPos;
+
+			if ( Z_OK == inflateCopy( &checkpoint.strm, &inflateData.strm ) )
+				next += ZIP_CHECKPOINT_INTERVAL;
+			else
+				inflateData.checkpoints.pop_back();
+		}
+
+		ios_size chunk = size - total;
+
+		// Stop at the next checkpoint position.
+		if ( mPos < next )
+			chunk = eemin( chunk, next - mPos );
+
+		inflateData.strm.next_out = reinterpret_cast<Bytef*>( data + total );
+		inflateData.strm.avail_out = (uInt)chunk;
+
+		int rc = inflate( &inflateData.strm, Z_NO_FLUSH );
+		ios_size count = chunk - inflateData.strm.avail_out;
+
+		total += count;
+		mPos += count;
+
+		if ( Z_OK != rc || 0 == count )
+			break;
+	}
+
+	return total;
+}
+
+void IOStreamZip::inflateSeek( ios_size position ) {
+	ZipInflateData& inflateData = *mInflate;
+	size_t index = eemin<size_t>( position / ZIP_CHECKPOINT_INTERVAL,
+								  inflateData.checkpoints.size() );
+	ios_size checkpointPos = index > 0 ? inflateData.checkpoints[index - 1].pos : 0;
+
+	// Restart from the nearest checkpoint when going back or when it skips decompressing data.
+	if ( position < mPos || checkpointPos > mPos ) {
+		if ( inflateData.ok )
+			inflateEnd( &inflateData.strm );
+
+		if ( index > 0 &&
+			 Z_OK == inflateCopy( &inflateData.strm, &inflateData.checkpoints[index - 1].strm ) ) {
+			inflateData.ok = true;
+			mPos = checkpointPos;
+		} else {
+			zipInflateInit( inflateData, mData, mEntry.compressedSize );
+			mPos = 0;
+		}
+	}
+
+	char buffer[16384];
+
+	while ( mPos < position ) {
+		ios_size count = eemin<ios_size>( sizeof( buffer ), position - mPos );
+
+		if ( inflateRead( buffer, count ) <= 0 )
+			break;
+	}
 }
 
 }} // namespace EE::System
@@ -43,6 +43,8 @@ Log::Log( const LogLevel& level, bool consoleOutput, bool liveWrite ) :
 Log::~Log() {
 	writel( LogLevel::Info, "eepp stoped\n" );
 
+	setAsync( false );
+
 	if ( mSave && !mLiveWrite ) {
 		openFS();
 
@@ -71,12 +73,56 @@ void Log::save( const std::string& filepath ) {
 }
 
 void Log::write( const std::string& text ) {
+	appendToBuffer( text );
+
+	writeToReaders( text );
+
+	output( std::string( text ) );
+}
+
+void Log::appendToBuffer( const std::string& text ) {
 	lock();
+
 	mData += text;
+
+	// Trim with some slack so the front erase is amortized over many writes.
+	if ( mMaxBufferSize > 0 && mData.size() > mMaxBufferSize + mMaxBufferSize / 4 ) {
+		size_t pos = mData.find( '\n', mData.size() - mMaxBufferSize );
+		mData.erase( 0, pos != std::string::npos ? pos + 1 : mData.size() - mMaxBufferSize );
+	}
+
 	unlock();
+}
 
-	writeToReaders( text );
+void Log::output( std::string&& text ) {
+	if ( !mConsoleOutput && !mLiveWrite )
+		return;
+
+	if ( mAsync && Thread::getCurrentThreadId() != mWriterThreadId ) {
+		std::unique_lock<std::mutex> lock( mQueueMutex );
+
+		if ( mQueue.size() >= mQueueCapacity ) {
+			if ( mQueuePolicy == LogQueuePolicy::Drop ) {
+				mDroppedCount++;
+				return;
+			}
+
+			mQueueCond.wait( lock,
+							 [this]() { return mQueue.size() < mQueueCapacity || mWriterStop; } );
+		}
+
+		if ( !mWriterStop ) {
+			mQueue.emplace_back( std::move( text ) );
+			lock.unlock();
+			mQueueCond.notify_all();
+			return;
+		}
+	}
 
+	writeOutput( text, true );
+}
+
+void Log::writeOutput( const std::string& text, bool flush ) {
 	if ( mConsoleOutput ) {
 #if EE_PLATFORM == EE_PLATFORM_ANDROID
 		__android_log_print( ANDROID_LOG_INFO, "eepp", "%s", text.c_str() );
@@ -88,16 +134,145 @@ void Log::write( const std::string& text ) {
 #endif
 #else
 		std::cout << text;
+
+		if ( flush )
+			std::cout.flush();
 #endif
 	}
 
 	if ( mLiveWrite ) {
+		lock();
+
 		openFS();
 
 		mFS->write( text.c_str(), text.size() );
 
-		mFS->flush();
+		if ( flush )
+			mFS->flush();
+
+		unlock();
+	}
+}
+
+void Log::writerThreadFunc() {
+	std::vector<std::string> batch;
+
+	while ( true ) {
+		{
+			std::unique_lock<std::mutex> lock( mQueueMutex );
+			mWriterBusy = false;
+			mQueueCond.notify_all();
+			mQueueCond.wait( lock, [this]() { return !mQueue.empty() || mWriterStop; } );
+
+			if ( mQueue.empty() )
+				return;
+
+			batch.swap( mQueue );
+			mWriterBusy = true;
+		}
+
+		mQueueCond.notify_all();
+
+		for ( const auto& text : batch )
+			writeOutput( text, false );
+
+		batch.clear();
+
+#if EE_PLATFORM != EE_PLATFORM_ANDROID && !defined( EE_COMPILER_MSVC )
+		if ( mConsoleOutput )
+			std::cout.flush();
+#endif
+
+		if ( mLiveWrite ) {
+			lock();
+			if ( NULL != mFS )
+				mFS->flush();
+			unlock();
+		}
+	}
+}
+
+bool Log::isAsync() const {
+	return mAsync;
+}
+
+void Log::setAsync( bool async ) {
+	if ( async == mAsync )
+		return;
+
+	if ( async ) {
+		{
+			std::unique_lock<std::mutex> lock( mQueueMutex );
+			mWriterStop = false;
+		}
+
+		mWriterThread = eeNew( Thread, ( &Log::writerThreadFunc, this ) );
+		mWriterThread->launch();
+		mWriterThreadId = mWriterThread->getId();
+		mAsync = true;
+	} else {
+		mAsync = false;
+
+		{
+			std::unique_lock<std::mutex> lock( mQueueMutex );
+			mWriterStop = true;
+		}
+
+		mQueueCond.notify_all();
+
+		// The writer drains the queue before exiting.
+		eeSAFE_DELETE( mWriterThread );
+		mWriterThreadId = 0;
+	}
+}
+
+const size_t& Log::getAsyncQueueCapacity() const {
+	return mQueueCapacity;
+}
+
+void Log::setAsyncQueueCapacity( const size_t& capacity ) {
+	{
+		std::unique_lock<std::mutex> lock( mQueueMutex );
+		mQueueCapacity = eemax<size_t>( 1, capacity );
 	}
+
+	mQueueCond.notify_all();
+}
+
+const LogQueuePolicy& Log::getAsyncQueuePolicy() const {
+	return mQueuePolicy;
+}
+
+void Log::setAsyncQueuePolicy( const LogQueuePolicy& policy ) {
+	std::unique_lock<std::mutex> lock( mQueueMutex );
+	mQueuePolicy = policy;
+}
+
+Uint64 Log::getDroppedCount() const {
+	std::unique_lock<std::mutex> lock( mQueueMutex );
+	return mDroppedCount;
+}
+
+void Log::flush() {
+	if ( mAsync && Thread::getCurrentThreadId() != mWriterThreadId ) {
+		std::unique_lock<std::mutex> lock( mQueueMutex );
+		mQueueCond.wait( lock,
+						 [this]() { return ( mQueue.empty() && !mWriterBusy ) || mWriterStop; } );
+	}
+
+	lock();
+	if ( NULL != mFS )
+		mFS->flush();
+	unlock();
+}
+
+const size_t& Log::getMaxBufferSize() const {
+	return mMaxBufferSize;
+}
+
+void Log::setMaxBufferSize( const size_t& maxBufferSize ) {
+	mMaxBufferSize = maxBufferSize;
+	appendToBuffer( "" );
 }
 
 static std::string logLevelToString( const LogLevel& level ) {
@@ -133,36 +308,14 @@ void Log::write( const LogLevel& level, const std::string& text ) {
 }
 
 void Log::writel( const std::string& text ) {
-	lock();
-	mData += text;
-	mData += "\n";
-	unlock();
+	std::string line( text + "\n" );
+
+	appendToBuffer( line );
 
 	writeToReaders( text );
 	writeToReaders( "\n" );
 
-	if ( mConsoleOutput ) {
-#if EE_PLATFORM == EE_PLATFORM_ANDROID
-		__android_log_print( ANDROID_LOG_INFO, "eepp", "%s\n", text.c_str() );
-#elif defined( EE_COMPILER_MSVC )
-#ifdef UNICODE
-		OutputDebugString( String::fromUtf8( text + "\n" ).toWideString().c_str() );
-#else
-		OutputDebugString( ( text + "\n" ).c_str() );
-#endif
-#else
-		std::cout << text << std::endl;
-#endif
-	}
-
-	if ( mLiveWrite ) {
-		openFS();
-
-		mFS->write( text.c_str(), text.size() );
-		mFS->write( "\n", 1 );
-
-		mFS->flush();
-	}
+	output( std::move( line ) );
 }
 
 void Log::writel( const LogLevel& level, const std::string& text ) {
@@ -190,52 +343,22 @@ void Log::closeFS() {
 	unlock();
 }
 
-void Log::writef( const char* format, ... ) {
+static std::string formatString( const char* format, va_list args ) {
 	int n, size = 256;
 	std::string tstr( size, '\0' );
 
-	va_list args;
-
 	while ( 1 ) {
-		va_start( args, format );
+		va_list argsCopy;
+		va_copy( argsCopy, args );
 
-		n = vsnprintf( &tstr[0], size, format, args );
+		n = vsnprintf( &tstr[0], size, format, argsCopy );
+
+		va_end( argsCopy );
 
 		if ( n > -1 && n < size ) {
 			tstr.resize( n );
 			tstr += '\n';
-
-			lock();
-			mData += tstr;
-			unlock();
-
-			writeToReaders( tstr );
-
-			if ( mConsoleOutput ) {
-#if EE_PLATFORM == EE_PLATFORM_ANDROID
-				__android_log_print( ANDROID_LOG_INFO, "eepp", "%s", tstr.c_str() );
-#elif defined( EE_COMPILER_MSVC )
-#ifdef UNICODE
-				OutputDebugString( String::fromUtf8( tstr ).toWideString().c_str() );
-#else
-				OutputDebugString( tstr.c_str() );
-#endif
-#else
-				std::cout << tstr;
-#endif
-			}
-
-			if ( mLiveWrite ) {
-				openFS();
-
-				mFS->write( tstr.c_str(), tstr.size() );
-
-				mFS->flush();
-			}
-
-			va_end( args );
-
-			return;
+			return tstr;
 		}
 
 		if ( n > -1 )	  // glibc 2.1
@@ -247,69 +370,25 @@ void Log::writef( const char* format, ... ) {
 	}
 }
 
+void Log::writef( const char* format, ... ) {
+	va_list args;
+	va_start( args, format );
+	std::string tstr( formatString( format, args ) );
+	va_end( args );
+
+	write( tstr );
+}
+
 void Log::writef( const LogLevel& level, const char* format, ... ) {
 	if ( mLogLevelThreshold > level )
 		return;
 
-	int n, size = 256;
-	std::string tstr( size, '\0' );
-	bool first = true;
 	va_list args;
+	va_start( args, format );
+	std::string tstr( formatString( format, args ) );
+	va_end( args );
 
-	while ( 1 ) {
-		va_start( args, format );
-
-		n = vsnprintf( &tstr[0], size, format, args );
-
-		if ( n > -1 && n < size ) {
-			tstr.resize( n );
-			tstr += '\n';
-
-			if ( first ) {
-				tstr = logLevelWithTimestamp( level, tstr, false );
-				first = false;
-			}
-
-			lock();
-			mData += tstr;
-			unlock();
-
-			writeToReaders( tstr );
-
-			if ( mConsoleOutput ) {
-#if EE_PLATFORM == EE_PLATFORM_ANDROID
-				__android_log_print( ANDROID_LOG_INFO, "eepp", "%s", tstr.c_str() );
-#elif defined( EE_COMPILER_MSVC )
-#ifdef UNICODE
-				OutputDebugString( String::fromUtf8( tstr ).toWideString().c_str() );
-#else
-				OutputDebugString( tstr.c_str() );
-#endif
-#else
-				std::cout << tstr;
-#endif
-			}
-
-			if ( mLiveWrite ) {
-				openFS();
-
-				mFS->write( tstr.c_str(), tstr.size() );
-
-				mFS->flush();
-			}
-
-			va_end( args );
-
-			return;
-		}
-
-		if ( n > -1 )	  // glibc 2.1
-			size = n + 1; // precisely what is needed
-		else			  // glibc 2.0
-			size *= 2;	  // twice the old size
-
-		tstr.resize( size, '\0' );
-	}
+	write( logLevelWithTimestamp( level, tstr, false ) );
 }
 
 std::string Log::getBuffer() const {
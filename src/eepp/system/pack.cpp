@@ -16,6 +16,10 @@ bool Pack::isOpen() const {
 	return mIsOpen;
 }
 
+bool Pack::getFileView( const std::string&, const Uint8*&, size_t& ) {
+	return false;
+}
+
 void Pack::onPackOpened() {
 	VirtualFileSystem::instance()->onResourceAdd( this );
 }
@@ -1,3 +1,4 @@
+#include <cstring>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/iostreampak.hpp>
 #include <eepp/system/log.hpp>
@@ -9,7 +10,7 @@ Pak* Pak::New() {
 	return eeNew( Pak, () );
 }
 
-Pak::Pak() : Pack() {
+Pak::Pak() : Pack(), mMapped( NULL ) {
 	mPak.fs = NULL;
 }
 
@@ -53,24 +54,34 @@ bool Pak::open( const std::string& path ) {
 
 		eeSAFE_DELETE( mPak.fs );
 
-		mPak.fs = IOStreamFile::New( path, "rwb" ); // Open the PAK file
+		mPak.fs = IOStreamFile::New( path, "r+b" ); // Open the PAK file
 
 		mPak.fs->read( reinterpret_cast<char*>( &mPak.header ),
 					   sizeof( pakHeader ) ); // Read the PAK header
 
 		if ( checkPack() == 0 ) {
-			mPak.pakFilesNum = mPak.header.dir_length / 64; // Number of files in the PAK
+			// Number of files in the PAK
+			mPak.pakFilesNum = mPak.header.dir_length / sizeof( pakEntry );
 
-			mPak.fs->seek( mPak.header.dir_offset ); // Seek to read the pakEntrys
+			mPakFiles.clear();
+			mPakFiles.resize( mPak.pakFilesNum );
+			mPakIndex.clear();
 
-			for ( Uint32 i = 0; i < mPak.pakFilesNum; i++ ) { // Read all the pakEntrys
-				pakEntry Entry;
+			if ( mPak.pakFilesNum > 0 ) {
+				// Read all the pakEntrys at once
+				mPak.fs->seek( mPak.header.dir_offset );
+				ios_size size = (ios_size)( sizeof( pakEntry ) * mPak.pakFilesNum );
+				ios_size read = mPak.fs->read( reinterpret_cast<char*>( &mPakFiles[0] ), size );
 
-				mPak.fs->read( reinterpret_cast<char*>( &Entry ), sizeof( pakEntry ) );
-
-				mPakFiles.push_back( Entry );
+				mPak.pakFilesNum = (Uint32)( eemax<ios_size>( 0, read ) / sizeof( pakEntry ) );
+				mPakFiles.resize( mPak.pakFilesNum );
 			}
 
+			for ( Uint32 i = 0; i < mPak.pakFilesNum; i++ )
+				indexEntry( i );
+
+			mapPack();
+
 			mIsOpen = true;
 
 			onPackOpened();
@@ -84,9 +95,11 @@ bool Pak::open( const std::string& path ) {
 
 bool Pak::close() {
 	if ( mIsOpen ) {
+		eeSAFE_DELETE( mMapped );
 		eeSAFE_DELETE( mPak.fs );
 
 		mPakFiles.clear();
+		mPakIndex.clear();
 
 		mIsOpen = false;
 
@@ -114,9 +127,10 @@ Int8 Pak::checkPack() {
 
 Int32 Pak::exists( const std::string& path ) {
 	if ( isOpen() ) {
-		for ( Uint32 i = 0; i < mPakFiles.size(); i++ )
-			if ( strcmp( path.c_str(), mPakFiles[i].filename ) == 0 )
-				return i;
+		auto it = mPakIndex.find( path );
+
+		if ( it != mPakIndex.end() )
+			return (Int32)it->second;
 	}
 
 	return -1;
@@ -127,25 +141,15 @@ bool Pak::extractFile( const std::string& path, const std::string& dest ) {
 		return false;
 	}
 
-	lock();
-
-	bool Ret = false;
-
-	Int32 Pos = exists( path );
-
-	if ( Pos != -1 ) {
-		ScopedBuffer data;
+	ScopedBuffer data;
 
-		if ( extractFileToMemory( path, data ) ) {
-			FileSystem::fileWrite( path, data.get(), data.length() );
-		}
+	if ( extractFileToMemory( path, data ) ) {
+		FileSystem::fileWrite( dest, data.get(), data.length() );
 
-		Ret = true;
+		return true;
 	}
 
-	unlock();
-
-	return Ret;
+	return false;
 }
 
 bool Pak::extractFileToMemory( const std::string& path, std::vector<Uint8>& data ) {
@@ -153,25 +157,32 @@ bool Pak::extractFileToMemory( const std::string& path, std::vector<Uint8>& data
 		return false;
 	}
 
-	lock();
+	Int32 Pos = exists( path );
 
-	bool Ret = false;
+	if ( Pos == -1 )
+		return false;
 
-	Int32 Pos = exists( path );
+	pakEntry entry( mPakFiles[Pos] );
+	const Uint8* view = getEntryData( entry );
 
-	if ( Pos != -1 ) {
-		data.clear();
-		data.resize( mPakFiles[Pos].file_length );
+	if ( NULL != view ) {
+		data.assign( view, view + entry.file_length );
+		return true;
+	}
 
-		mPak.fs->seek( mPakFiles[Pos].file_position );
-		mPak.fs->read( reinterpret_cast<char*>( &data[0] ), mPakFiles[Pos].file_length );
+	lock();
 
-		Ret = true;
+	data.clear();
+	data.resize( entry.file_length );
+
+	if ( entry.file_length > 0 ) {
+		mPak.fs->seek( entry.file_position );
+		mPak.fs->read( reinterpret_cast<char*>( &data[0] ), entry.file_length );
 	}
 
 	unlock();
 
-	return Ret;
+	return true;
 }
 
 bool Pak::extractFileToMemory( const std::string& path, ScopedBuffer& data ) {
@@ -179,24 +190,46 @@ bool Pak::extractFileToMemory( const std::string& path, ScopedBuffer& data ) {
 		return false;
 	}
 
+	Int32 Pos = exists( path );
+
+	if ( Pos == -1 )
+		return false;
+
+	pakEntry entry( mPakFiles[Pos] );
+	const Uint8* view = getEntryData( entry );
+
+	data.reset( entry.file_length );
+
+	if ( NULL != view ) {
+		memcpy( data.get(), view, entry.file_length );
+		return true;
+	}
+
 	lock();
 
-	bool Ret = false;
+	mPak.fs->seek( entry.file_position );
+	mPak.fs->read( reinterpret_cast<char*>( data.get() ), data.length() );
+
+	unlock();
+
+	return true;
+}
 
+bool Pak::getFileView( const std::string& path, const Uint8*& data, size_t& size ) {
 	Int32 Pos = exists( path );
 
-	if ( Pos != -1 ) {
-		data.reset( mPakFiles[Pos].file_length );
+	if ( Pos == -1 )
+		return false;
 
-		mPak.fs->seek( mPakFiles[Pos].file_position );
-		mPak.fs->read( reinterpret_cast<char*>( data.get() ), data.length() );
+	const Uint8* view = getEntryData( mPakFiles[Pos] );
 
-		Ret = true;
-	}
+	if ( NULL == view )
+		return false;
 
-	unlock();
+	data = view;
+	size = mPakFiles[Pos].file_length;
 
-	return Ret;
+	return true;
 }
 
 bool Pak::addFile( const Uint8* data, const Uint32& dataSize, const std::string& inpack ) {
@@ -227,6 +260,10 @@ bool Pak::addFile( const Uint8* data, const Uint32& dataSize, const std::string&
 			mPak.fs->write( reinterpret_cast<const char*>( &newFile ), sizeof( pakEntry ) );
 
 			mPakFiles.push_back( newFile );
+			indexEntry( mPakFiles.size() - 1 );
+
+			mPak.fs->flush();
+			mapPack();
 
 			return true;
 		} else {
@@ -268,10 +305,14 @@ bool Pak::addFile( const Uint8* data, const Uint32& dataSize, const std::string&
 							( std::streamsize )( sizeof( pakEntry ) * pakE.size() ) );
 
 			mPakFiles.push_back( pakE[mPak.pakFilesNum] );
+			indexEntry( mPakFiles.size() - 1 );
 			mPak.pakFilesNum += 1;
 
 			pakE.clear();
 
+			mPak.fs->flush();
+			mapPack();
+
 			return true;
 		}
 	}
@@ -407,4 +448,29 @@ Pak::pakEntry Pak::getPackEntry( Uint32 index ) {
 	return pakEntry();
 }
 
+void Pak::indexEntry( const Uint32& index ) {
+	const pakEntry& entry = mPakFiles[index];
+	std::string name( entry.filename, strnlen( entry.filename, sizeof( entry.filename ) ) );
+
+	// The first entry with a name wins, as it did with the linear search.
+	mPakIndex.emplace( name, index );
+}
+
+void Pak::mapPack() {
+	eeSAFE_DELETE( mMapped );
+
+	mMapped = IOStreamMapped::New( mPak.pakPath, IOStreamMapped::AccessHint::Random );
+
+	if ( NULL == mMapped->getData() )
+		eeSAFE_DELETE( mMapped );
+}
+
+const Uint8* Pak::getEntryData( const pakEntry& entry ) const {
+	if ( NULL == mMapped ||
+		 (Uint64)entry.file_position + entry.file_length > (Uint64)mMapped->getSize() )
+		return NULL;
+
+	return reinterpret_cast<const Uint8*>( mMapped->getData() ) + entry.file_position;
+}
+
 }} // namespace EE::System
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <chrono>
+#include <eepp/core/string.hpp>
+#include <eepp/system/filesystem.hpp>
+#include <eepp/system/profiler.hpp>
+#include <eepp/system/thread.hpp>
+#include <unordered_map>
+
+namespace EE { namespace System {
+
+SINGLETON_DECLARE_IMPLEMENTATION( Profiler )
+
+std::atomic<bool> Profiler::sActive{false};
+
+static std::atomic<Uint32> sProfilerGeneration{0};
+
+struct Profiler::ThreadBuffer {
+	Uint32 threadId{0};
+	std::vector<Event> events;
+	size_t capacity{0};
+	size_t next{0};
+	std::atomic_flag busy = ATOMIC_FLAG_INIT;
+
+	void acquire() {
+		while ( busy.test_and_set( std::memory_order_acquire ) )
+			;
+	}
+
+	void release() { busy.clear( std::memory_order_release ); }
+
+	void reset( const size_t& maxEvents ) {
+		capacity = maxEvents;
+		events.clear();
+		events.reserve( capacity );
+		next = 0;
+	}
+};
+
+struct ThreadBufferRef {
+	void* buffer{NULL};
+	Uint32 generation{0};
+};
+
+static thread_local ThreadBufferRef sThreadBuffer;
+
+Uint64 Profiler::now() {
+	return static_cast<Uint64>( std::chrono::duration_cast<std::chrono::microseconds>(
+									std::chrono::steady_clock::now().time_since_epoch() )
+									.count() );
+}
+
+Profiler::Profiler() : mGeneration( ++sProfilerGeneration ) {}
+
+Profiler::~Profiler() {
+	sActive = false;
+}
+
+bool Profiler::isEnabled() const {
+	return sActive;
+}
+
+void Profiler::setEnabled( bool enabled ) {
+	sActive = enabled;
+}
+
+const size_t& Profiler::getMaxEventsPerThread() const {
+	return mMaxEventsPerThread;
+}
+
+void Profiler::setMaxEventsPerThread( const size_t& maxEvents ) {
+	std::lock_guard<std::mutex> lock( mBuffersMutex );
+	mMaxEventsPerThread = eemax<size_t>( 1, maxEvents );
+}
+
+Profiler::ThreadBuffer* Profiler::getThreadBuffer() {
+	if ( sThreadBuffer.generation == mGeneration && NULL != sThreadBuffer.buffer )
+		return static_cast<ThreadBuffer*>( sThreadBuffer.buffer );
+
+	std::lock_guard<std::mutex> lock( mBuffersMutex );
+	mBuffers.emplace_back( std::make_unique<ThreadBuffer>() );
+	ThreadBuffer* buffer = mBuffers.back().get();
+	buffer->threadId = Thread::getCurrentThreadId();
+	buffer->reset( mMaxEventsPerThread );
+	sThreadBuffer.buffer = buffer;
+	sThreadBuffer.generation = mGeneration;
+	return buffer;
+}
+
+void Profiler::addEvent( const char* name, const Uint64& start, const Uint64& end ) {
+	ThreadBuffer* buffer = getThreadBuffer();
+
+	buffer->acquire();
+
+	Event event{name, start, end - start, buffer->threadId};
+
+	if ( buffer->events.size() < buffer->capacity ) {
+		buffer->events.emplace_back( event );
+	} else {
+		buffer->events[buffer->next] = event;
+		buffer->next = ( buffer->next + 1 ) % buffer->events.size();
+	}
+
+	buffer->release();
+}
+
+void Profiler::clear() {
+	std::lock_guard<std::mutex> lock( mBuffersMutex );
+
+	for ( auto& buffer : mBuffers ) {
+		buffer->acquire();
+		buffer->reset( mMaxEventsPerThread );
+		buffer->release();
+	}
+}
+
+std::vector<Profiler::Event> Profiler::getEvents() const {
+	std::vector<Event> events;
+	std::lock_guard<std::mutex> lock( mBuffersMutex );
+
+	for ( auto& buffer : mBuffers ) {
+		buffer->acquire();
+		events.insert( events.end(), buffer->events.begin(), buffer->events.end() );
+		buffer->release();
+	}
+
+	std::sort( events.begin(), events.end(),
+			   []( const Event& a, const Event& b ) { return a.start < b.start; } );
+
+	return events;
+}
+
+std::vector<Profiler::ZoneStats> Profiler::getZoneStats() const {
+	std::unordered_map<std::string, ZoneStats> zones;
+	std::vector<Event> events( getEvents() );
+
+	for ( const auto& event : events ) {
+		auto it = zones.find( event.name );
+
+		if ( it == zones.end() ) {
+			zones[event.name] = {event.name, 1, event.duration, event.duration};
+		} else {
+			it->second.calls++;
+			it->second.totalTime += event.duration;
+			it->second.maxTime = eemax( it->second.maxTime, event.duration );
+		}
+	}
+
+	std::vector<ZoneStats> stats;
+	stats.reserve( zones.size() );
+
+	for ( const auto& zone : zones )
+		stats.emplace_back( zone.second );
+
+	std::sort( stats.begin(), stats.end(), []( const ZoneStats& a, const ZoneStats& b ) {
+		return a.totalTime > b.totalTime;
+	} );
+
+	return stats;
+}
+
+static std::string escapeJsonString( const char* str ) {
+	std::string escaped;
+
+	for ( const char* c = str; *c; ++c ) {
+		switch ( *c ) {
+			case '"':
+				escaped += "\\\"";
+				break;
+			case '\\':
+				escaped += "\\\\";
+				break;
+			case '\n':
+				escaped += "\\n";
+				break;
+			default:
+				escaped += *c;
+		}
+	}
+
+	return escaped;
+}
+
+std::string Profiler::toChromeTrace() const {
+	std::vector<Event> events( getEvents() );
+	Uint64 origin = events.empty() ? 0 : events.front().start;
+	std::string json( "{\"traceEvents\":[" );
+
+	for ( size_t i = 0; i < events.size(); i++ ) {
+		const Event& event = events[i];
+
+		if ( i > 0 )
+			json += ",\n";
+
+		json += String::format( "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,"
+								"\"dur\":%llu}",
+								escapeJsonString( event.name ).c_str(), event.threadId,
+								(unsigned long long)( event.start - origin ),
+								(unsigned long long)event.duration );
+	}
+
+	json += "],\"displayTimeUnit\":\"ms\"}\n";
+
+	return json;
+}
+
+bool Profiler::saveChromeTrace( const std::string& path ) const {
+	std::string json( toChromeTrace() );
+	return FileSystem::fileWrite( path, reinterpret_cast<const Uint8*>( json.c_str() ),
+								  json.size() );
+}
+
+}} // namespace EE::System
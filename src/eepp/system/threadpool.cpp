@@ -1,3 +1,4 @@
+#include <eepp/system/profiler.hpp>
 #include <eepp/system/threadpool.hpp>
 
 namespace EE { namespace System {
@@ -52,7 +53,10 @@ void ThreadPool::threadFunc() {
 			mWork.pop_front();
 		}
 
-		work->func();
+		{
+			EE_PROFILE_SCOPE( "ThreadPool::task" );
+			work->func();
+		}
 
 		if ( work->callback != nullptr ) {
 			work->callback();
@@ -4,12 +4,18 @@ namespace EE { namespace System {
 
 SINGLETON_DECLARE_IMPLEMENTATION( VirtualFileSystem )
 
-static std::vector<std::string> vfsSplitPath( std::string& path ) {
+static void vfsNormalizePath( std::string& path ) {
 #if EE_PLATFORM == EE_PLATFORM_WIN
 	if ( path.find_first_of( '\\' ) != std::string::npos ) {
 		String::replaceAll( path, "\\", "/" );
 	}
+#else
+	(void)path;
 #endif
+}
+
+static std::vector<std::string> vfsSplitPath( std::string& path ) {
+	vfsNormalizePath( path );
 	return String::split( path, '/' );
 }
 
@@ -45,30 +51,11 @@ std::vector<std::string> VirtualFileSystem::filesGetInPath( std::string path ) {
 }
 
 Pack* VirtualFileSystem::getPackFromFile( std::string path ) {
-	std::vector<std::string> paths = vfsSplitPath( path );
-	vfsDirectory* curDir = &mRoot;
-
-	if ( paths.size() >= 1 ) {
-		size_t pos = 0;
-
-		do {
-			if ( pos == paths.size() - 1 ) {
-				if ( curDir->files.find( paths[pos] ) != curDir->files.end() ) {
-					return curDir->files[paths[pos]].pack;
-				}
-			} else {
-				if ( curDir->directories.find( paths[pos] ) == curDir->directories.end() ) {
-					return NULL;
-				}
+	vfsNormalizePath( path );
 
-				curDir = &curDir->directories[paths[pos]];
-			}
+	auto it = mFileIndex.find( path );
 
-			pos++;
-		} while ( pos < paths.size() );
-	}
-
-	return NULL;
+	return it != mFileIndex.end() ? it->second : NULL;
 }
 
 IOStream* VirtualFileSystem::getFileFromPath( const std::string& path ) {
@@ -93,10 +80,20 @@ void VirtualFileSystem::onResourceAdd( Pack* resource ) {
 void VirtualFileSystem::onResourceRemove( Pack* resource ) {
 	remove( resource );
 	removePackFromDirectory( resource, mRoot );
+
+	for ( auto it = mFileIndex.begin(); it != mFileIndex.end(); ) {
+		if ( it->second == resource )
+			it = mFileIndex.erase( it );
+		else
+			++it;
+	}
 }
 
 void VirtualFileSystem::addFile( std::string path, Pack* pack ) {
 	std::vector<std::string> paths = vfsSplitPath( path );
+
+	mFileIndex[path] = pack;
+
 	vfsDirectory* curDir = &mRoot;
 
 	if ( paths.size() >= 1 ) {
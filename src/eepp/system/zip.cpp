@@ -1,8 +1,12 @@
+#include <algorithm>
+#include <cstring>
 #include <eepp/system/filesystem.hpp>
+#include <eepp/system/iostreammapped.hpp>
 #include <eepp/system/iostreamzip.hpp>
 #include <eepp/system/zip.hpp>
 #include <libzip/zip.h>
 #include <libzip/zipint.h>
+#include <zlib.h>
 
 namespace EE { namespace System {
 
@@ -10,7 +14,7 @@ Zip* Zip::New() {
 	return eeNew( Zip, () );
 }
 
-Zip::Zip() : mZip( NULL ) {}
+Zip::Zip() : mZip( NULL ), mMapped( NULL ) {}
 
 Zip::~Zip() {
 	close();
@@ -24,6 +28,8 @@ bool Zip::create( const std::string& path ) {
 		if ( 0 == checkPack() ) {
 			mZipPath = path;
 
+			indexEntries();
+
 			mIsOpen = true;
 
 			onPackOpened();
@@ -45,6 +51,8 @@ bool Zip::open( const std::string& path ) {
 		if ( 0 == checkPack() ) {
 			mZipPath = path;
 
+			indexEntries();
+
 			mIsOpen = true;
 
 			onPackOpened();
@@ -60,6 +68,10 @@ bool Zip::open( const std::string& path ) {
 
 bool Zip::close() {
 	if ( 0 == checkPack() ) {
+		// The mapping must be released before libzip rewrites the file.
+		eeSAFE_DELETE( mMapped );
+		mEntries.clear();
+
 		zip_close( mZip );
 
 		mIsOpen = false;
@@ -135,6 +147,8 @@ bool Zip::eraseFiles( const std::vector<std::string>& paths ) {
 		else {
 			if ( zip_delete( mZip, Ex ) == -1 )
 				return false;
+
+			mEntries.erase( paths[i] );
 		}
 	}
 
@@ -142,8 +156,6 @@ bool Zip::eraseFiles( const std::vector<std::string>& paths ) {
 }
 
 bool Zip::extractFile( const std::string& path, const std::string& dest ) {
-	lock();
-
 	bool Ret;
 
 	ScopedBuffer data;
@@ -153,12 +165,19 @@ bool Zip::extractFile( const std::string& path, const std::string& dest ) {
 	if ( Ret )
 		FileSystem::fileWrite( dest, data.get(), data.length() );
 
-	unlock();
-
 	return Ret;
 }
 
 bool Zip::extractFileToMemory( const std::string& path, std::vector<Uint8>& data ) {
+	const Entry* entry = getEntry( path );
+
+	if ( NULL != entry && 0 != entry->offset ) {
+		data.resize( (size_t)entry->size );
+
+		// A failed read means corrupted data, libzip would not detect it on an exact size read.
+		return 0 == entry->size || readEntry( *entry, &data[0] );
+	}
+
 	lock();
 
 	bool Ret = false;
@@ -194,6 +213,14 @@ bool Zip::extractFileToMemory( const std::string& path, std::vector<Uint8>& data
 }
 
 bool Zip::extractFileToMemory( const std::string& path, ScopedBuffer& data ) {
+	const Entry* entry = getEntry( path );
+
+	if ( NULL != entry && 0 != entry->offset ) {
+		data.reset( (size_t)entry->size );
+
+		return 0 == entry->size || readEntry( *entry, data.get() );
+	}
+
 	lock();
 
 	bool Ret = false;
@@ -226,10 +253,8 @@ bool Zip::extractFileToMemory( const std::string& path, ScopedBuffer& data ) {
 }
 
 Int32 Zip::exists( const std::string& path ) {
-	if ( isOpen() )
-		return zip_name_locate( mZip, path.c_str(), 0 );
-
-	return -1;
+	const Entry* entry = getEntry( path );
+	return NULL != entry ? entry->index : -1;
 }
 
 Int8 Zip::checkPack() {
@@ -267,4 +292,108 @@ zip* Zip::getZip() {
 	return mZip;
 }
 
+bool Zip::getFileView( const std::string& path, const Uint8*& data, size_t& size ) {
+	const Entry* entry = getEntry( path );
+
+	if ( NULL == entry || 0 == entry->offset || ZIP_CM_STORE != entry->method )
+		return false;
+
+	data = getEntryData( *entry );
+	size = (size_t)entry->size;
+
+	return true;
+}
+
+static Uint16 readLE16( const Uint8* data ) {
+	return (Uint16)( data[0] | ( data[1] << 8 ) );
+}
+
+void Zip::indexEntries() {
+	mEntries.clear();
+	eeSAFE_DELETE( mMapped );
+
+	mMapped = IOStreamMapped::New( mZipPath, IOStreamMapped::AccessHint::Random );
+
+	if ( NULL == mMapped->getData() )
+		eeSAFE_DELETE( mMapped );
+
+	const Uint8* mapped = NULL != mMapped ? (const Uint8*)mMapped->getData() : NULL;
+	Uint64 mappedSize = NULL != mMapped ? (Uint64)mMapped->getSize() : 0;
+	Int32 numfiles = zip_get_num_files( mZip );
+
+	for ( Int32 i = 0; i < numfiles; i++ ) {
+		struct zip_stat zs;
+
+		if ( -1 == zip_stat_index( mZip, i, 0, &zs ) || NULL == zs.name )
+			continue;
+
+		Entry entry = { i, 0, zs.comp_size, zs.size, zs.comp_method, zs.crc };
+
+		// Locate the entry data after its local header, so it can be read from the mapped file.
+		// zlib reads and checksums 32 bit lengths, bigger entries are left to libzip.
+		if ( NULL != mapped && NULL != mZip->cdir && i < mZip->cdir->nentry &&
+			 !( mZip->cdir->entry[i].bitflags & 1 ) &&
+			 ( ZIP_CM_STORE == zs.comp_method || ZIP_CM_DEFLATE == zs.comp_method ) &&
+			 zs.comp_size <= UINT32_MAX && zs.size <= UINT32_MAX ) {
+			Uint64 header = mZip->cdir->entry[i].offset;
+
+			if ( header + LENTRYSIZE <= mappedSize &&
+				 0 == memcmp( mapped + header, LOCAL_MAGIC, 4 ) ) {
+				Uint64 offset = header + LENTRYSIZE + readLE16( mapped + header + 26 ) +
+								readLE16( mapped + header + 28 );
+
+				if ( offset + entry.compressedSize <= mappedSize )
+					entry.offset = offset;
+			}
+		}
+
+		mEntries.emplace( zs.name, entry );
+	}
+}
+
+const Zip::Entry* Zip::getEntry( const std::string& path ) const {
+	if ( !isOpen() )
+		return NULL;
+
+	auto it = mEntries.find( path );
+	return it != mEntries.end() ? &it->second : NULL;
+}
+
+const Uint8* Zip::getEntryData( const Entry& entry ) const {
+	return reinterpret_cast<const Uint8*>( mMapped->getData() ) + entry.offset;
+}
+
+bool Zip::readEntry( const Entry& entry, Uint8* data ) const {
+	const Uint8* src = getEntryData( entry );
+
+	if ( ZIP_CM_STORE == entry.method ) {
+		memcpy( data, src, (size_t)entry.size );
+		return crc32( crc32( 0L, Z_NULL, 0 ), data, (uInt)entry.size ) == entry.crc;
+	}
+
+	z_stream strm = z_stream{};
+
+	if ( Z_OK != inflateInit2( &strm, -MAX_WBITS ) )
+		return false;
+
+	strm.next_in = const_cast<Bytef*>( src );
+	strm.avail_in = (uInt)entry.compressedSize;
+
+	uLong crc = crc32( 0L, Z_NULL, 0 );
+	int rc = Z_OK;
+
+	// Inflate in slices and checksum every slice while it is still in cache.
+	while ( Z_OK == rc ) {
+		Uint8* out = data + strm.total_out;
+		strm.next_out = out;
+		strm.avail_out = (uInt)std::min<uLong>( entry.size - strm.total_out, 64 * 1024 );
+		rc = inflate( &strm, Z_NO_FLUSH );
+		crc = crc32( crc, out, (uInt)( strm.next_out - out ) );
+	}
+
+	inflateEnd( &strm );
+
+	return Z_STREAM_END == rc && strm.total_out == entry.size && crc == entry.crc;
+}
+
 }} // namespace EE::System
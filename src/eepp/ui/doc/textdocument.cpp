@@ -7,6 +7,7 @@
 #include <eepp/system/log.hpp>
 #include <eepp/system/luapattern.hpp>
 #include <eepp/system/packmanager.hpp>
+#include <eepp/system/profiler.hpp>
 #include <eepp/ui/doc/syntaxdefinitionmanager.hpp>
 #include <eepp/ui/doc/textdocument.hpp>
 #include <sstream>
@@ -23,6 +24,150 @@ bool TextDocument::isNonWord( String::StringBaseType ch ) const {
 	return mNonWordChars.find_first_of( ch ) != String::InvalidPos;
 }
 
+static inline String::StringBaseType foldCase( const String::StringBaseType& ch ) {
+	return static_cast<String::StringBaseType>( std::tolower( ch ) );
+}
+
+// Compares text against the line at position pos without copying the line. When the comparison is
+// case insensitive text must be already lowercase.
+static inline bool matchesAt( const String& line, const String& text, const size_t& pos,
+							  const bool& caseSensitive ) {
+	if ( caseSensitive ) {
+		for ( size_t i = 0; i < text.size(); i++ )
+			if ( line[pos + i] != text[i] )
+				return false;
+	} else {
+		for ( size_t i = 0; i < text.size(); i++ )
+			if ( foldCase( line[pos + i] ) != text[i] )
+				return false;
+	}
+	return true;
+}
+
+// Returns the first position of text in the line contained in [start, end).
+static size_t findInLine( const String& line, const String& text, size_t start, size_t end,
+						  const bool& caseSensitive ) {
+	end = eemin( end, line.size() );
+	if ( text.empty() || start > end || end - start < text.size() )
+		return String::InvalidPos;
+	for ( size_t i = start; i <= end - text.size(); i++ )
+		if ( matchesAt( line, text, i, caseSensitive ) )
+			return i;
+	return String::InvalidPos;
+}
+
+// Returns the last position of text in the line contained in [start, end).
+static size_t rfindInLine( const String& line, const String& text, size_t start, size_t end,
+						   const bool& caseSensitive ) {
+	end = eemin( end, line.size() );
+	if ( text.empty() || start > end || end - start < text.size() )
+		return String::InvalidPos;
+	for ( size_t i = end - text.size() + 1; i-- > start; )
+		if ( matchesAt( line, text, i, caseSensitive ) )
+			return i;
+	return String::InvalidPos;
+}
+
+static inline bool isWholeWord( const String& line, const String& nonWordChars, const size_t& start,
+								const size_t& end ) {
+	return ( start == 0 || nonWordChars.find_first_of( line[start - 1] ) != String::InvalidPos ) &&
+		   ( end >= line.size() || nonWordChars.find_first_of( line[end] ) != String::InvalidPos );
+}
+
+// Lowercases a Lua pattern keeping the character classes ("%A", "%S", etc) untouched.
+static std::string toLowerLuaPattern( std::string pattern ) {
+	for ( size_t i = 0; i < pattern.size(); i++ ) {
+		if ( pattern[i] == '%' )
+			i++;
+		else
+			pattern[i] =
+				static_cast<char>( std::tolower( static_cast<unsigned char>( pattern[i] ) ) );
+	}
+	return pattern;
+}
+
+static inline bool isUtf8Continuation( const char& ch ) {
+	return ( static_cast<unsigned char>( ch ) & 0xC0 ) == 0x80;
+}
+
+static void findAllInLines( const std::vector<TextDocumentLine>& lines, const String& nonWordChars,
+							const String& text, const bool& caseSensitive, const bool& wholeWord,
+							const TextDocument::FindReplaceType& type, const TextRange& range,
+							std::vector<TextRange>& matches ) {
+	if ( TextDocument::FindReplaceType::LuaPattern == type ) {
+		LuaPattern pattern( caseSensitive ? text.toUtf8() : toLowerLuaPattern( text.toUtf8() ) );
+		// The matcher anchors "^" to the search offset, so anchored patterns only match once per
+		// line and only from the line start.
+		bool anchored = !text.empty() && '^' == text[0];
+		std::string utf8;
+
+		for ( Int64 i = range.start().line(); i <= range.end().line(); i++ ) {
+			const String& line = lines[i].getText();
+			// The line break is not part of the searched text so "$" anchors to the line end.
+			utf8 = line.substr( 0, line.size() - 1 ).toUtf8();
+			if ( !caseSensitive )
+				String::toLowerInPlace( utf8 );
+
+			Int64 startColumn = i == range.start().line() ? range.start().column() : 0;
+			Int64 endColumn = i == range.end().line() ? range.end().column() : (Int64)line.size();
+			// Matches are found in order, so byte offsets are converted into columns advancing a
+			// single cursor through the line.
+			size_t byte = 0;
+			Int64 column = 0;
+			auto advance = [&]( const size_t& to ) {
+				for ( ; byte < to && byte < utf8.size(); byte++ )
+					if ( !isUtf8Continuation( utf8[byte] ) )
+						column++;
+			};
+
+			while ( byte < utf8.size() && column < startColumn ) {
+				byte++;
+				while ( byte < utf8.size() && isUtf8Continuation( utf8[byte] ) )
+					byte++;
+				column++;
+			}
+
+			int offset = (int)byte;
+			int start, end;
+			while ( offset <= (int)utf8.size() && ( !anchored || 0 == offset ) &&
+					pattern.find( utf8.c_str(), start, end, offset, (int)utf8.size(), 0 ) ) {
+				if ( start == end ) {
+					offset = end + 1;
+					continue;
+				}
+				advance( start );
+				Int64 startCol = column;
+				advance( end );
+				if ( column > endColumn )
+					break;
+				if ( !wholeWord || isWholeWord( line, nonWordChars, startCol, column ) )
+					matches.push_back( {{i, startCol}, {i, column}} );
+				offset = end;
+			}
+		}
+		return;
+	}
+
+	String search( caseSensitive ? text : String::toLower( text ) );
+
+	for ( Int64 i = range.start().line(); i <= range.end().line(); i++ ) {
+		const String& line = lines[i].getText();
+		size_t col = i == range.start().line() ? range.start().column() : 0;
+		size_t end = i == range.end().line() ? range.end().column() : line.size() - 1;
+		end = eemin( end, line.size() - 1 );
+
+		while ( ( col = findInLine( line, search, col, end, caseSensitive ) ) !=
+				String::InvalidPos ) {
+			if ( !wholeWord || isWholeWord( line, nonWordChars, col, col + search.size() ) ) {
+				matches.push_back( {{i, (Int64)col}, {i, (Int64)( col + search.size() )}} );
+				col += search.size();
+			} else {
+				col++;
+			}
+		}
+	}
+}
+
 TextDocument::TextDocument( bool verbose ) :
 	mUndoStack( this ),
 	mVerbose( verbose ),
@@ -36,6 +181,8 @@ TextDocument::TextDocument( bool verbose ) :
 }
 
 TextDocument::~TextDocument() {
+	// Waits for the pending searches, they work on their own copy of the document.
+	mSearchPool.reset();
 	notifyDocumentClosed();
 }
 
@@ -74,6 +221,7 @@ bool TextDocument::loadFromStream( IOStream& file ) {
 }
 
 bool TextDocument::loadFromStream( IOStream& file, std::string path ) {
+	EE_PROFILE_SCOPE( "TextDocument::loadFromStream" );
 	Clock clock;
 	reset();
 	mLines.clear();
@@ -470,9 +618,14 @@ TextPosition TextDocument::insert( TextPosition position, const String& text,
 	mLines[position.line()] = TextDocumentLine( lines[0] );
 	notifyLineChanged( position.line() );
 
-	for ( Int64 i = 1; i < (Int64)lines.size(); i++ ) {
-		mLines.insert( mLines.begin() + position.line() + i, TextDocumentLine( lines[i] ) );
-		notifyLineChanged( position.line() + i );
+	if ( lines.size() > 1 ) {
+		// Insert all the new lines at once, inserting them one by one is quadratic.
+		std::vector<TextDocumentLine> newLines( lines.begin() + 1, lines.end() );
+		mLines.insert( mLines.begin() + position.line() + 1,
+					   std::make_move_iterator( newLines.begin() ),
+					   std::make_move_iterator( newLines.end() ) );
+		for ( Int64 i = 1; i < (Int64)lines.size(); i++ )
+			notifyLineChanged( position.line() + i );
 	}
 
 	TextPosition cursor = positionOffset( position, text.size() );
@@ -1204,23 +1357,11 @@ TextPosition TextDocument::find( String text, TextPosition from, const bool& cas
 		text.toLower();
 
 	for ( Int64 i = from.line(); i <= to.line(); i++ ) {
-		size_t col;
-		if ( i == from.line() ) {
-			col = caseSensitive
-					  ? line( i ).getText().substr( from.column() ).find( text )
-					  : String::toLower( line( i ).getText() ).substr( from.column() ).find( text );
-			if ( String::StringType::npos != col )
-				col += from.column();
-		} else if ( i == to.line() && to != endOfDoc() ) {
-			col =
-				caseSensitive
-					? line( i ).getText().substr( 0, to.column() ).find( text )
-					: String::toLower( line( i ).getText() ).substr( 0, to.column() ).find( text );
-		} else {
-			col = caseSensitive ? line( i ).getText().find( text )
-								: String::toLower( line( i ).getText() ).find( text );
-		}
-		if ( String::StringType::npos != col ) {
+		const String& lineText = line( i ).getText();
+		size_t start = i == from.line() ? from.column() : 0;
+		size_t end = i == to.line() && to != endOfDoc() ? to.column() : lineText.size();
+		size_t col = findInLine( lineText, text, start, end, caseSensitive );
+		if ( String::InvalidPos != col ) {
 			return {(Int64)i, (Int64)col};
 		}
 	}
@@ -1244,23 +1385,11 @@ TextPosition TextDocument::findLast( String text, TextPosition from, const bool&
 	if ( !caseSensitive )
 		text.toLower();
 	for ( Int64 i = from.line(); i >= to.line(); i-- ) {
-		size_t col;
-		if ( i == from.line() ) {
-			col = caseSensitive ? line( i ).getText().substr( 0, from.column() ).rfind( text )
-								: String::toLower( line( i ).getText() )
-									  .substr( 0, from.column() )
-									  .rfind( text );
-		} else if ( i == to.line() ) {
-			col = caseSensitive
-					  ? line( i ).getText().substr( to.column() ).rfind( text )
-					  : String::toLower( line( i ).getText() ).substr( to.column() ).rfind( text );
-			if ( String::StringType::npos != col )
-				col += to.column();
-		} else {
-			col = caseSensitive ? line( i ).getText().rfind( text )
-								: String::toLower( line( i ).getText() ).rfind( text );
-		}
-		if ( String::StringType::npos != col ) {
+		const String& lineText = line( i ).getText();
+		size_t start = i == to.line() ? to.column() : 0;
+		size_t end = i == from.line() ? from.column() : lineText.size();
+		size_t col = rfindInLine( lineText, text, start, end, caseSensitive );
+		if ( String::InvalidPos != col ) {
 			return {(Int64)i, (Int64)col};
 		}
 	}
@@ -1290,6 +1419,111 @@ TextPosition TextDocument::replace( String search, const String& replace, TextPo
 	return TextPosition();
 }
 
+std::vector<TextRange> TextDocument::findAll( const String& text, const bool& caseSensitive,
+											  const bool& wholeWord, const FindReplaceType& type,
+											  TextRange restrictRange ) const {
+	std::vector<TextRange> matches;
+	if ( text.empty() )
+		return matches;
+	restrictRange = restrictRange.isValid() ? sanitizeRange( restrictRange.normalized() )
+											: getDocRange();
+	findAllInLines( mLines, mNonWordChars, text, caseSensitive, wholeWord, type, restrictRange,
+					matches );
+	return matches;
+}
+
+void TextDocument::findAllAsync( const String& text, const FindAllCallback& onFinish,
+								 const bool& caseSensitive, const bool& wholeWord,
+								 const FindReplaceType& type, TextRange restrictRange ) {
+	if ( !onFinish )
+		return;
+	restrictRange = restrictRange.isValid() ? sanitizeRange( restrictRange.normalized() )
+											: getDocRange();
+	if ( !mSearchPool )
+		mSearchPool = ThreadPool::createUnique( 1 );
+
+	auto lines = std::make_shared<std::vector<TextDocumentLine>>( mLines );
+	String nonWordChars( mNonWordChars );
+	Uint64 changeId = getCurrentChangeId();
+
+	mSearchPool->run(
+		[lines, nonWordChars, text, caseSensitive, wholeWord, type, restrictRange, changeId,
+		 onFinish] {
+			std::vector<TextRange> matches;
+			findAllInLines( *lines, nonWordChars, text, caseSensitive, wholeWord, type,
+							restrictRange, matches );
+			onFinish( std::move( matches ), changeId );
+		},
+		[] {} );
+}
+
+int TextDocument::replaceAll( const String& text, const String& replace,
+							  const bool& caseSensitive, const bool& wholeWord,
+							  const FindReplaceType& type, TextRange restrictRange ) {
+	std::vector<TextRange> matches(
+		findAll( text, caseSensitive, wholeWord, type, restrictRange ) );
+	if ( matches.empty() )
+		return 0;
+
+	// Rebuild the text between the first and the last line with matches, excluding the last line
+	// break, and replace it at once.
+	Int64 firstLine = matches.front().start().line();
+	Int64 lastLine = matches.back().start().line();
+	TextRange range( {firstLine, 0}, {lastLine, (Int64)mLines[lastLine].size() - 1} );
+	String newText;
+	size_t match = 0;
+
+	for ( Int64 i = firstLine; i <= lastLine; i++ ) {
+		const String& lineText = mLines[i].getText();
+		size_t col = 0;
+		for ( ; match < matches.size() && matches[match].start().line() == i; match++ ) {
+			newText.append( lineText, col, matches[match].start().column() - col );
+			newText.append( replace );
+			col = matches[match].end().column();
+		}
+		newText.append( lineText, col,
+						i == lastLine ? lineText.size() - 1 - col : String::InvalidPos );
+	}
+
+	TextRange selection = getSelection();
+	size_t lineCount = mLines.size();
+	Time time = mTimer.getElapsedTime();
+	UndoStackContainer& undoStack = mUndoStack.getUndoStackContainer();
+	mUndoStack.clearRedoStack();
+	mUndoStack.pushSelection( undoStack, selection, time );
+	mUndoStack.pushInsert( undoStack, getText( range ), range.start(), time );
+
+	std::vector<String> lines = newText.split( '\n', true );
+	for ( auto& line : lines )
+		line += '\n';
+	Int64 oldCount = lastLine - firstLine + 1;
+	Int64 newCount = lines.size();
+	for ( Int64 i = 0; i < eemin( oldCount, newCount ); i++ )
+		mLines[firstLine + i].setText( lines[i] );
+	if ( newCount > oldCount ) {
+		std::vector<TextDocumentLine> newLines( lines.begin() + oldCount, lines.end() );
+		mLines.insert( mLines.begin() + firstLine + oldCount,
+					   std::make_move_iterator( newLines.begin() ),
+					   std::make_move_iterator( newLines.end() ) );
+	} else if ( newCount < oldCount ) {
+		mLines.erase( mLines.begin() + firstLine + newCount, mLines.begin() + lastLine + 1 );
+	}
+
+	TextPosition end( firstLine + newCount - 1, (Int64)lines.back().size() - 1 );
+	mUndoStack.pushSelection( undoStack, selection, time );
+	mUndoStack.pushRemove( undoStack, {range.start(), end}, time );
+
+	for ( Int64 i = firstLine; i < firstLine + newCount; i++ )
+		notifyLineChanged( i );
+	notifyTextChanged();
+	if ( lineCount != mLines.size() )
+		notifyLineCountChanged( lineCount, mLines.size() );
+
+	setSelection( sanitizeRange( selection ) );
+
+	return (int)matches.size();
+}
+
 const Uint32& TextDocument::getPageSize() const {
 	return mPageSize;
 }
@@ -305,6 +305,16 @@ void UICodeEditor::scheduledUpdate( const Time& ) {
 
 	for ( auto& module : mModules )
 		module->update( this );
+
+	if ( hasFocus() && getUISceneNode()->getWindow()->hasFocus() )
+		mSceneNode->setUpdateDeadline( Seconds( 0.5f ) - mBlinkTimer.getElapsedTime() );
+
+	if ( mMouseDown || mHighlighter.getFirstInvalidLine() <= mHighlighter.getMaxWantedLine() )
+		mSceneNode->setUpdateDeadline( Time::Zero );
+
+	if ( mHorizontalScrollBarEnabled && hasFocus() && mLongestLineWidthDirty )
+		mSceneNode->setUpdateDeadline( mFindLongestLineWidthUpdateFrequency -
+									   mLongestLineWidthLastUpdate.getElapsedTime() );
 }
 
 void UICodeEditor::updateLongestLineWidth() {
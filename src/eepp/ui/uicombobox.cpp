@@ -80,6 +80,19 @@ void UIComboBox::loadFromXmlNode( const pugi::xml_node& node ) {
 	updateWidgets();
 }
 
+void UIComboBox::loadFromProperties( const std::vector<StyleSheetProperty>& properties ) {
+	beginAttributesTransaction();
+
+	UIWidget::loadFromProperties( properties );
+
+	if ( NULL != mDropDownList )
+		mDropDownList->loadFromProperties( properties );
+
+	endAttributesTransaction();
+
+	updateWidgets();
+}
+
 Uint32 UIComboBox::onMessage( const NodeMessage* Msg ) {
 	if ( Msg->getMsg() == NodeMessage::MouseClick && Msg->getSender() == mButton &&
 		 ( Msg->getFlags() & EE_BUTTON_LMASK && NULL != mDropDownList ) ) {
@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <eepp/core/string.hpp>
+#include <eepp/system/filesystem.hpp>
+#include <eepp/system/iostreamfile.hpp>
+#include <eepp/system/iostreammapped.hpp>
+#include <eepp/system/iostreammemory.hpp>
+#include <eepp/system/log.hpp>
+#include <eepp/ui/css/shorthanddefinition.hpp>
+#include <eepp/ui/css/stylesheetparser.hpp>
+#include <eepp/ui/css/stylesheetselectorrule.hpp>
+#include <eepp/ui/css/stylesheetspecification.hpp>
+#include <eepp/ui/uicompiledlayout.hpp>
+#include <eepp/ui/uiwidgetcreator.hpp>
+#include <pugixml/pugixml.hpp>
+
+namespace EE { namespace UI {
+
+#define EE_COMPILED_LAYOUT_MAGIC ( ( 'E' << 0 ) | ( 'E' << 8 ) | ( 'L' << 16 ) | ( 'C' << 24 ) )
+#define EE_COMPILED_LAYOUT_VERSION 1
+
+struct CompiledLayoutHeader {
+	Uint32 magic;
+	Uint32 version;
+	Uint64 sourceHash;
+	Uint32 stringCount;
+	Uint32 tagCount;
+	Uint32 nodeCount;
+	Uint32 attributeCount;
+};
+
+struct XmlStringWriter : pugi::xml_writer {
+	std::string result;
+
+	virtual void write( const void* data, size_t size ) {
+		result.append( static_cast<const char*>( data ), size );
+	}
+};
+
+static bool isWidgetTag( const std::string& tag ) {
+	return UIWidgetCreator::isWidgetRegistered( tag ) ||
+		   UIWidgetCreator::existsCustomWidgetCallback( tag );
+}
+
+static bool hasNonWidgetChildren( const pugi::xml_node& node ) {
+	for ( pugi::xml_node child = node.first_child(); child; child = child.next_sibling() ) {
+		if ( child.type() != pugi::node_element )
+			continue;
+
+		std::string tag( String::toLower( std::string( child.name() ) ) );
+
+		if ( tag != "style" && !isWidgetTag( tag ) )
+			return true;
+	}
+
+	return false;
+}
+
+Uint64 UICompiledLayout::hash( const void* data, const size_t& size ) {
+	// 64-bit FNV-1a
+	const Uint8* bytes = static_cast<const Uint8*>( data );
+	Uint64 hash = 14695981039346656037ULL;
+
+	for ( size_t i = 0; i < size; i++ ) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+UICompiledLayout::UICompiledLayout() : mSourceHash( 0 ) {}
+
+UICompiledLayout::~UICompiledLayout() {}
+
+void UICompiledLayout::clear() {
+	mSourceHash = 0;
+	mStrings.clear();
+	mTags.clear();
+	mNodes.clear();
+	mAttributes.clear();
+	mProperties.clear();
+	mStyleSheets.clear();
+	mXmlDocuments.clear();
+	mStringIndex.clear();
+}
+
+bool UICompiledLayout::isEmpty() const {
+	return mNodes.empty();
+}
+
+bool UICompiledLayout::compile( const pugi::xml_node& node, const Uint64& sourceHash ) {
+	clear();
+	mSourceHash = sourceHash;
+	compileNodes( node );
+	mStringIndex.clear();
+	resolve();
+	return !mNodes.empty();
+}
+
+bool UICompiledLayout::compileFromMemory( const void* buffer, const size_t& bufferSize ) {
+	pugi::xml_document doc;
+	pugi::xml_parse_result result = doc.load_buffer( buffer, bufferSize );
+
+	if ( !result ) {
+		Log::error( "UICompiledLayout: couldn't parse layout: %s (offset %d)",
+					result.description(), result.offset );
+		return false;
+	}
+
+	return compile( doc.first_child(), hash( buffer, bufferSize ) );
+}
+
+bool UICompiledLayout::compileFromString( const std::string& layoutString ) {
+	return compileFromMemory( layoutString.c_str(), layoutString.size() );
+}
+
+Uint32 UICompiledLayout::compileNodes( const pugi::xml_node& node ) {
+	Uint32 count = 0;
+
+	for ( pugi::xml_node xml = node; xml; xml = xml.next_sibling() ) {
+		if ( xml.type() != pugi::node_element )
+			continue;
+
+		std::string tag( String::toLower( std::string( xml.name() ) ) );
+
+		if ( tag == "style" ) {
+			mNodes.push_back( {Style, addString( xml.text().as_string() ), 0, 0, 0} );
+			count++;
+		} else if ( isWidgetTag( tag ) ) {
+			if ( hasNonWidgetChildren( xml ) ) {
+				XmlStringWriter writer;
+				xml.print( writer, "", pugi::format_raw );
+				mNodes.push_back( {Xml, addString( writer.result ), 0, 0, 0} );
+				count++;
+				continue;
+			}
+
+			size_t index = mNodes.size();
+			Uint32 attributeStart = mAttributes.size();
+
+			for ( pugi::xml_attribute attr = xml.first_attribute(); attr;
+				  attr = attr.next_attribute() ) {
+				std::string name( String::toLower( String::trim( std::string( attr.name() ) ) ) );
+				String::HashType id = String::hash( name );
+
+				if ( NULL == StyleSheetSpecification::instance()->getProperty( id ) &&
+					 NULL == StyleSheetSpecification::instance()->getShorthand( id ) ) {
+					Log::warning( "Property %s is not defined!", name.c_str() );
+					continue;
+				}
+
+				mAttributes.push_back( {id, addString( attr.value() )} );
+			}
+
+			mNodes.push_back( {Widget, addTag( tag ), 0, attributeStart,
+							   (Uint32)( mAttributes.size() - attributeStart )} );
+			count++;
+
+			if ( xml.first_child() )
+				mNodes[index].childCount = compileNodes( xml.first_child() );
+		}
+	}
+
+	return count;
+}
+
+Uint32 UICompiledLayout::addString( const std::string& str ) {
+	auto it = mStringIndex.find( str );
+
+	if ( it != mStringIndex.end() )
+		return it->second;
+
+	Uint32 index = mStrings.size();
+	mStrings.push_back( str );
+	mStringIndex[str] = index;
+	return index;
+}
+
+Uint32 UICompiledLayout::addTag( const std::string& tag ) {
+	auto it = std::find( mTags.begin(), mTags.end(), tag );
+
+	if ( it != mTags.end() )
+		return it - mTags.begin();
+
+	mTags.push_back( tag );
+	return mTags.size() - 1;
+}
+
+void UICompiledLayout::resolve() {
+	StyleSheetSpecification* specification = StyleSheetSpecification::instance();
+
+	for ( size_t i = 0; i < mNodes.size(); i++ ) {
+		const Node& node = mNodes[i];
+
+		switch ( node.type ) {
+			case Widget: {
+				std::vector<StyleSheetProperty>& properties = mProperties[i];
+
+				for ( Uint32 a = 0; a < node.attributeCount; a++ ) {
+					const Attribute& attribute = mAttributes[node.attributeStart + a];
+					const std::string& value = mStrings[attribute.value];
+					const PropertyDefinition* definition =
+						specification->getProperty( attribute.propertyId );
+					const ShorthandDefinition* shorthand =
+						NULL == definition ? specification->getShorthand( attribute.propertyId )
+										   : NULL;
+
+					if ( NULL != definition ) {
+						// Same as the inline attributes from XML: the value is not trimmed.
+						properties.emplace_back( definition->getName(), value, false,
+												 StyleSheetSelectorRule::SpecificityInline );
+					} else if ( NULL != shorthand ) {
+						auto expanded = shorthand->parse( value );
+						properties.insert( properties.end(), expanded.begin(), expanded.end() );
+					}
+				}
+				break;
+			}
+			case Style: {
+				CSS::StyleSheetParser parser;
+
+				if ( parser.loadFromString( mStrings[node.id] ) )
+					mStyleSheets[i] = parser.getStyleSheet();
+				break;
+			}
+			case Xml: {
+				std::unique_ptr<pugi::xml_document> doc( new pugi::xml_document() );
+
+				if ( doc->load_string( mStrings[node.id].c_str() ) )
+					mXmlDocuments[i] = std::move( doc );
+				break;
+			}
+		}
+	}
+}
+
+bool UICompiledLayout::loadFromStream( IOStream& stream ) {
+	clear();
+
+	if ( !stream.isOpen() )
+		return false;
+
+	CompiledLayoutHeader header;
+
+	if ( stream.read( (char*)&header, sizeof( header ) ) != sizeof( header ) ||
+		 header.magic != EE_COMPILED_LAYOUT_MAGIC ||
+		 header.version != EE_COMPILED_LAYOUT_VERSION )
+		return false;
+
+	ios_size size = stream.getSize();
+
+	if ( header.stringCount > size || header.tagCount > size ||
+		 (ios_size)( header.nodeCount * sizeof( Node ) ) > size ||
+		 (ios_size)( header.attributeCount * sizeof( Attribute ) ) > size )
+		return false;
+
+	mSourceHash = header.sourceHash;
+	mStrings.resize( header.stringCount );
+
+	for ( auto& str : mStrings ) {
+		Uint32 length = 0;
+
+		if ( stream.read( (char*)&length, sizeof( length ) ) != sizeof( length ) ||
+			 length > size ) {
+			clear();
+			return false;
+		}
+
+		str.resize( length );
+
+		if ( length > 0 && stream.read( &str[0], length ) != length ) {
+			clear();
+			return false;
+		}
+	}
+
+	mTags.resize( header.tagCount );
+
+	for ( auto& tag : mTags ) {
+		Uint32 stringIndex = 0;
+
+		if ( stream.read( (char*)&stringIndex, sizeof( stringIndex ) ) != sizeof( stringIndex ) ||
+			 stringIndex >= mStrings.size() ) {
+			clear();
+			return false;
+		}
+
+		tag = mStrings[stringIndex];
+	}
+
+	mNodes.resize( header.nodeCount );
+	mAttributes.resize( header.attributeCount );
+	ios_size nodesSize = mNodes.size() * sizeof( Node );
+	ios_size attributesSize = mAttributes.size() * sizeof( Attribute );
+
+	if ( ( nodesSize > 0 && stream.read( (char*)&mNodes[0], nodesSize ) != nodesSize ) ||
+		 ( attributesSize > 0 &&
+		   stream.read( (char*)&mAttributes[0], attributesSize ) != attributesSize ) ) {
+		clear();
+		return false;
+	}
+
+	for ( const auto& node : mNodes ) {
+		bool valid = node.type == Widget
+						 ? node.id < mTags.size() &&
+							   node.attributeStart + node.attributeCount <= mAttributes.size()
+						 : node.id < mStrings.size();
+
+		if ( !valid ) {
+			clear();
+			return false;
+		}
+	}
+
+	for ( const auto& attribute : mAttributes ) {
+		if ( attribute.value >= mStrings.size() ) {
+			clear();
+			return false;
+		}
+	}
+
+	resolve();
+
+	return true;
+}
+
+bool UICompiledLayout::loadFromFile( const std::string& path ) {
+	if ( !FileSystem::fileExists( path ) )
+		return false;
+
+	IOStreamMapped file( path, IOStreamMapped::AccessHint::WillNeed );
+	return NULL != file.getData() && loadFromMemory( file.getData(), file.getSize() );
+}
+
+bool UICompiledLayout::loadFromMemory( const void* buffer, const size_t& bufferSize ) {
+	IOStreamMemory stream( static_cast<const char*>( buffer ), bufferSize );
+	return loadFromStream( stream );
+}
+
+bool UICompiledLayout::save( IOStream& stream ) const {
+	if ( !stream.isOpen() )
+		return false;
+
+	// The tag names are stored in the string table and referenced by index.
+	std::vector<std::string> strings( mStrings );
+	std::vector<Uint32> tagStrings;
+
+	for ( const auto& tag : mTags ) {
+		auto it = std::find( strings.begin(), strings.end(), tag );
+
+		if ( it == strings.end() ) {
+			tagStrings.push_back( strings.size() );
+			strings.push_back( tag );
+		} else {
+			tagStrings.push_back( it - strings.begin() );
+		}
+	}
+
+	CompiledLayoutHeader header;
+	header.magic = EE_COMPILED_LAYOUT_MAGIC;
+	header.version = EE_COMPILED_LAYOUT_VERSION;
+	header.sourceHash = mSourceHash;
+	header.stringCount = strings.size();
+	header.tagCount = mTags.size();
+	header.nodeCount = mNodes.size();
+	header.attributeCount = mAttributes.size();
+
+	stream.write( (const char*)&header, sizeof( header ) );
+
+	for ( const auto& str : strings ) {
+		Uint32 length = str.size();
+		stream.write( (const char*)&length, sizeof( length ) );
+		stream.write( str.c_str(), length );
+	}
+
+	if ( !tagStrings.empty() )
+		stream.write( (const char*)&tagStrings[0], tagStrings.size() * sizeof( Uint32 ) );
+
+	if ( !mNodes.empty() )
+		stream.write( (const char*)&mNodes[0], mNodes.size() * sizeof( Node ) );
+
+	if ( !mAttributes.empty() )
+		stream.write( (const char*)&mAttributes[0], mAttributes.size() * sizeof( Attribute ) );
+
+	return true;
+}
+
+bool UICompiledLayout::saveToFile( const std::string& path ) const {
+	IOStreamFile stream( path, "wb" );
+	return save( stream );
+}
+
+const Uint64& UICompiledLayout::getSourceHash() const {
+	return mSourceHash;
+}
+
+const std::vector<UICompiledLayout::Node>& UICompiledLayout::getNodes() const {
+	return mNodes;
+}
+
+const std::vector<std::string>& UICompiledLayout::getTags() const {
+	return mTags;
+}
+
+const std::vector<StyleSheetProperty>&
+UICompiledLayout::getProperties( const size_t& nodeIndex ) const {
+	static const std::vector<StyleSheetProperty> empty;
+	auto it = mProperties.find( nodeIndex );
+	return it != mProperties.end() ? it->second : empty;
+}
+
+const CSS::StyleSheet& UICompiledLayout::getStyleSheet( const size_t& nodeIndex ) const {
+	static const CSS::StyleSheet empty;
+	auto it = mStyleSheets.find( nodeIndex );
+	return it != mStyleSheets.end() ? it->second : empty;
+}
+
+pugi::xml_node UICompiledLayout::getXmlNode( const size_t& nodeIndex ) const {
+	auto it = mXmlDocuments.find( nodeIndex );
+	return it != mXmlDocuments.end() ? it->second->first_child() : pugi::xml_node();
+}
+
+size_t UICompiledLayout::skipNode( size_t nodeIndex ) const {
+	Uint32 childCount = mNodes[nodeIndex++].childCount;
+
+	for ( Uint32 i = 0; i < childCount && nodeIndex < mNodes.size(); i++ )
+		nodeIndex = skipNode( nodeIndex );
+
+	return nodeIndex;
+}
+
+}} // namespace EE::UI
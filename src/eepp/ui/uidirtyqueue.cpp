@@ -0,0 +1,113 @@
+#include <eepp/scene/node.hpp>
+#include <eepp/ui/uidirtyqueue.hpp>
+
+namespace EE { namespace UI { namespace Private {
+
+UIDirtyQueue::UIDirtyQueue( bool layoutChain ) :
+	mLayoutChain( layoutChain ), mFlushing( false ), mStats() {}
+
+bool UIDirtyQueue::insert( Node* node, bool flag ) {
+	mStats.requested++;
+
+	if ( mEntries.count( node ) > 0 )
+		return false;
+
+	Uint32 depth;
+
+	if ( isCovered( node, mEntries, &depth ) )
+		return false;
+
+	mEntries[node] = {depth, flag, false};
+
+	if ( depth >= mLevels.size() )
+		mLevels.resize( depth + 1 );
+
+	mLevels[depth].push_back( node );
+	mStats.queued++;
+
+	return true;
+}
+
+void UIDirtyQueue::erase( Node* node ) {
+	mEntries.erase( node );
+
+	if ( mFlushing )
+		mFlushEntries.erase( node );
+}
+
+bool UIDirtyQueue::empty() const {
+	return mEntries.empty();
+}
+
+void UIDirtyQueue::flush( const FlushCallback& callback ) {
+	if ( mEntries.empty() || mFlushing )
+		return;
+
+	mFlushing = true;
+	mFlushEntries.swap( mEntries );
+	mFlushLevels.swap( mLevels );
+
+	for ( Uint32 depth = 0; depth < mFlushLevels.size(); depth++ ) {
+		// The callback can queue nodes in mLevels, but never in the levels being flushed.
+		std::vector<Node*>& level = mFlushLevels[depth];
+
+		for ( size_t i = 0; i < level.size(); i++ ) {
+			Node* node = level[i];
+			auto it = mFlushEntries.find( node );
+
+			// Removed, or removed and queued again in another depth or already visited.
+			if ( it == mFlushEntries.end() || it->second.depth != depth || it->second.done )
+				continue;
+
+			it->second.done = true;
+
+			// The entries above have been flushed already but they are kept until the end, so the
+			// nodes queued before an ancestor can still find it.
+			if ( isCovered( node, mFlushEntries ) )
+				continue;
+
+			mStats.processed++;
+			callback( node, it->second.flag );
+		}
+
+		level.clear();
+	}
+
+	mFlushEntries.clear();
+	mFlushing = false;
+}
+
+const UISceneNode::InvalidationStats& UIDirtyQueue::getStats() const {
+	return mStats;
+}
+
+void UIDirtyQueue::resetStats() {
+	mStats = UISceneNode::InvalidationStats();
+}
+
+bool UIDirtyQueue::isCovered( Node* node, const EntryMap& entries, Uint32* depth ) const {
+	bool chain = true;
+	Uint32 level = 0;
+
+	for ( Node* parent = node->getParent(); NULL != parent; parent = parent->getParent() ) {
+		if ( chain ) {
+			if ( mLayoutChain && !parent->isLayout() ) {
+				chain = false;
+
+				if ( NULL == depth )
+					return false;
+			} else if ( entries.count( parent ) > 0 ) {
+				return true;
+			}
+		}
+
+		level++;
+	}
+
+	if ( NULL != depth )
+		*depth = level;
+
+	return false;
+}
+
+}}} // namespace EE::UI::Private
@@ -0,0 +1,67 @@
+#ifndef EE_UI_UIDIRTYQUEUE_HPP
+#define EE_UI_UIDIRTYQUEUE_HPP
+
+#include <eepp/ui/uiscenenode.hpp>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace EE { namespace UI { namespace Private {
+
+/** @brief Set of nodes waiting for a style or layout update, ordered by their depth in the tree.
+**	A node is not queued when an ancestor already is, and a queued node is skipped by the flush
+**	when an ancestor was queued after it, since updating the ancestor updates the whole subtree.
+**	Finding the covering ancestor only walks up the parents of the node, so queueing doesn't
+**	depend on the number of queued nodes. */
+class EE_API UIDirtyQueue {
+  public:
+	typedef std::function<void( Node*, bool )> FlushCallback;
+
+	/** @param layoutChain If true a node is only covered by the ancestors reached through a chain
+	**	of layouts, since UILayout::updateLayoutTree only walks the layouts children. */
+	explicit UIDirtyQueue( bool layoutChain = false );
+
+	/** @param flag Value passed to the flush callback, it's ignored if the node is already queued
+	**	@return False if the node or an ancestor was already queued */
+	bool insert( Node* node, bool flag = false );
+
+	/** @brief Removes a node, it's never dereferenced afterwards so it can be used from the
+	**	destructor of the node. */
+	void erase( Node* node );
+
+	bool empty() const;
+
+	/** @brief Calls the callback for every queued node not covered by an ancestor, parents first.
+	**	The queue is emptied before, so the nodes queued by the callback are processed by the next
+	**	flush. */
+	void flush( const FlushCallback& callback );
+
+	const UISceneNode::InvalidationStats& getStats() const;
+
+	void resetStats();
+
+  protected:
+	struct Entry {
+		Uint32 depth;
+		bool flag;
+		bool done; ///< Already visited by the flush, a node can be listed twice in the same depth
+	};
+
+	typedef std::unordered_map<Node*, Entry> EntryMap;
+
+	bool mLayoutChain;
+	bool mFlushing;
+	EntryMap mEntries;
+	EntryMap mFlushEntries; ///< Nodes being flushed, checked by the nodes queued before them
+	std::vector<std::vector<Node*>> mLevels; ///< Queued nodes by depth, it can list removed nodes
+	std::vector<std::vector<Node*>> mFlushLevels;
+	UISceneNode::InvalidationStats mStats;
+
+	/** @return True if an ancestor of the node is in the entries
+	**	@param depth Set to the depth of the node if it isn't covered */
+	bool isCovered( Node* node, const EntryMap& entries, Uint32* depth = NULL ) const;
+};
+
+}}} // namespace EE::UI::Private
+
+#endif
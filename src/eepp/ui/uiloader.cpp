@@ -62,8 +62,10 @@ void UILoader::draw() {
 }
 
 void UILoader::scheduledUpdate( const Time& time ) {
-	if ( mVisible && isMeOrParentTreeVisible() && mAnimationSpeed != 0.f )
+	if ( mVisible && isMeOrParentTreeVisible() && mAnimationSpeed != 0.f ) {
 		invalidateDraw();
+		mSceneNode->setUpdateDeadline( Time::Zero );
+	}
 
 	if ( mIndeterminate ) {
 		mArcAngle += time.asMilliseconds() * mAnimationSpeed * mOp;
@@ -647,6 +647,8 @@ void UIMenu::scheduledUpdate( const Time& ) {
 		mInactiveTime.restart();
 	if ( mInactiveTime.getElapsedTime() > Seconds( 1 ) )
 		hide();
+	else
+		mSceneNode->setUpdateDeadline( Seconds( 1 ) - mInactiveTime.getElapsedTime() );
 }
 
 bool UIMenu::isChildOfMeOrSubMenu( Node* node ) {
@@ -104,8 +104,12 @@ void UIProgressBar::scheduledUpdate( const Time& time ) {
 	if ( mOffset.y > rSize.getHeight() || mOffset.y < -rSize.getHeight() )
 		mOffset.y = 0.f;
 
-	if ( offset != mOffset )
+	if ( offset != mOffset ) {
 		invalidateDraw();
+
+		if ( mVisible && isMeOrParentTreeVisible() )
+			mSceneNode->setUpdateDeadline( Time::Zero );
+	}
 }
 
 void UIProgressBar::setTheme( UITheme* Theme ) {
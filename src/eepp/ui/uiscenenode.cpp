@@ -2,15 +2,20 @@
 #include <eepp/core/string.hpp>
 #include <eepp/graphics/fontmanager.hpp>
 #include <eepp/graphics/fonttruetype.hpp>
+#include <eepp/graphics/framebufferpool.hpp>
 #include <eepp/network/http.hpp>
 #include <eepp/network/uri.hpp>
 #include <eepp/scene/scenemanager.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/functionstring.hpp>
+#include <eepp/system/iostreammapped.hpp>
 #include <eepp/system/packmanager.hpp>
+#include <eepp/system/profiler.hpp>
 #include <eepp/system/virtualfilesystem.hpp>
 #include <eepp/ui/css/mediaquery.hpp>
 #include <eepp/ui/css/stylesheetparser.hpp>
+#include <eepp/ui/uicompiledlayout.hpp>
+#include <eepp/ui/uidirtyqueue.hpp>
 #include <eepp/ui/uieventdispatcher.hpp>
 #include <eepp/ui/uiiconthememanager.hpp>
 #include <eepp/ui/uilayout.hpp>
@@ -38,7 +43,12 @@ UISceneNode::UISceneNode( EE::Window::Window* window ) :
 	mUpdatingLayouts( false ),
 	mUIThemeManager( UIThemeManager::New() ),
 	mUIIconThemeManager( UIIconThemeManager::New()->setFallbackThemeManager( mUIThemeManager ) ),
-	mKeyBindings( mWindow->getInput() ) {
+	mFrameBufferPool( NULL ),
+	mLayoutCacheEnabled( false ),
+	mKeyBindings( mWindow->getInput() ),
+	mDirtyStyle( eeNew( Private::UIDirtyQueue, () ) ),
+	mDirtyStyleState( eeNew( Private::UIDirtyQueue, () ) ),
+	mDirtyLayouts( eeNew( Private::UIDirtyQueue, ( true ) ) ) {
 	// Reset size since the SceneNode already set it but needs to set the size from zero to emmit
 	// the required events to its childs.
 	mSize = Sizef();
@@ -62,6 +72,12 @@ UISceneNode::~UISceneNode() {
 	eeSAFE_DELETE( mUIThemeManager );
 	eeSAFE_DELETE( mUIIconThemeManager );
 
+	eeSAFE_DELETE( mFrameBufferPool );
+
+	eeSAFE_DELETE( mDirtyStyle );
+	eeSAFE_DELETE( mDirtyStyleState );
+	eeSAFE_DELETE( mDirtyLayouts );
+
 	for ( auto& font : mFontFaces ) {
 		FontManager::instance()->remove( font );
 	}
@@ -249,6 +265,141 @@ UIWidget* UISceneNode::loadLayoutNodes( pugi::xml_node node, Node* parent ) {
 	return widgets.empty() ? NULL : widgets[0];
 }
 
+size_t UISceneNode::loadCompiledNode( const UICompiledLayout& layout, size_t index, Node* parent,
+									  const std::vector<std::function<UIWidget*()>>& creators,
+									  std::vector<UIWidget*>* rootWidgets ) {
+	const UICompiledLayout::Node& node = layout.getNodes()[index];
+
+	switch ( node.type ) {
+		case UICompiledLayout::Style: {
+			combineStyleSheet( layout.getStyleSheet( index ), false );
+			return index + 1;
+		}
+		case UICompiledLayout::Xml: {
+			std::vector<UIWidget*> widgets = loadNode( layout.getXmlNode( index ), parent );
+
+			if ( NULL != rootWidgets )
+				rootWidgets->insert( rootWidgets->end(), widgets.begin(), widgets.end() );
+
+			return index + 1;
+		}
+		case UICompiledLayout::Widget:
+			break;
+	}
+
+	UIWidget* widget = creators[node.id] ? creators[node.id]() : NULL;
+
+	if ( NULL == widget )
+		return layout.skipNode( index );
+
+	if ( NULL != rootWidgets )
+		rootWidgets->push_back( widget );
+
+	widget->setParent( parent );
+	widget->loadFromProperties( layout.getProperties( index ) );
+
+	index++;
+
+	for ( Uint32 i = 0; i < node.childCount && index < layout.getNodes().size(); i++ )
+		index = loadCompiledNode( layout, index, widget, creators, NULL );
+
+	widget->onWidgetCreated();
+
+	return index;
+}
+
+UIWidget* UISceneNode::loadLayoutFromCompiled( const UICompiledLayout& layout, Node* parent ) {
+	Clock clock;
+	UISceneNode* prevUISceneNode = SceneManager::instance()->getUISceneNode();
+	SceneManager::instance()->setCurrentUISceneNode( this );
+	mIsLoading = true;
+
+	std::vector<std::function<UIWidget*()>> creators;
+	creators.reserve( layout.getTags().size() );
+
+	for ( const auto& tag : layout.getTags() )
+		creators.emplace_back( UIWidgetCreator::getWidgetCreator( tag ) );
+
+	std::vector<UIWidget*> widgets;
+	size_t index = 0;
+
+	while ( index < layout.getNodes().size() )
+		index = loadCompiledNode( layout, index, NULL != parent ? parent : this, creators,
+								  &widgets );
+
+	for ( auto& widget : widgets )
+		widget->reloadStyle( true, true, true );
+
+	mIsLoading = false;
+	SceneManager::instance()->setCurrentUISceneNode( prevUISceneNode );
+
+	if ( mVerbose ) {
+		Log::debug( "UISceneNode::loadLayoutFromCompiled loaded in: %.2f ms",
+					clock.getElapsedTime().asMilliseconds() );
+	}
+
+	return widgets.empty() ? NULL : widgets[0];
+}
+
+void UISceneNode::setLayoutCacheEnabled( bool enabled ) {
+	mLayoutCacheEnabled = enabled;
+
+	if ( !mLayoutCacheEnabled )
+		mLayoutCache.clear();
+}
+
+bool UISceneNode::isLayoutCacheEnabled() const {
+	return mLayoutCacheEnabled;
+}
+
+void UISceneNode::setLayoutCachePath( const std::string& path ) {
+	mLayoutCachePath = path;
+
+	if ( !mLayoutCachePath.empty() )
+		FileSystem::dirAddSlashAtEnd( mLayoutCachePath );
+}
+
+const std::string& UISceneNode::getLayoutCachePath() const {
+	return mLayoutCachePath;
+}
+
+void UISceneNode::clearLayoutCache() {
+	mLayoutCache.clear();
+}
+
+std::shared_ptr<UICompiledLayout> UISceneNode::getCompiledLayout( const void* buffer,
+																  const size_t& bufferSize ) {
+	Uint64 hash = UICompiledLayout::hash( buffer, bufferSize );
+	auto it = mLayoutCache.find( hash );
+
+	if ( it != mLayoutCache.end() )
+		return it->second;
+
+	std::shared_ptr<UICompiledLayout> layout( std::make_shared<UICompiledLayout>() );
+	std::string cachePath;
+
+	if ( !mLayoutCachePath.empty() ) {
+		cachePath = String::format( "%s%016llx.eelc", mLayoutCachePath.c_str(),
+									(unsigned long long)hash );
+
+		if ( layout->loadFromFile( cachePath ) && layout->getSourceHash() == hash ) {
+			mLayoutCache[hash] = layout;
+			return layout;
+		}
+	}
+
+	if ( !layout->compileFromMemory( buffer, bufferSize ) )
+		return nullptr;
+
+	if ( !cachePath.empty() &&
+		 ( FileSystem::isDirectory( mLayoutCachePath ) ||
+		   FileSystem::makeDir( mLayoutCachePath ) ) )
+		layout->saveToFile( cachePath );
+
+	mLayoutCache[hash] = layout;
+	return layout;
+}
+
 void UISceneNode::setStyleSheet( const CSS::StyleSheet& styleSheet ) {
 	mStyleSheet = styleSheet;
 	processStyleSheetAtRules( styleSheet );
@@ -303,7 +454,12 @@ void UISceneNode::reloadStyle( const bool& disableAnimations ) {
 }
 
 UIWidget* UISceneNode::loadLayoutFromFile( const std::string& layoutPath, Node* parent ) {
-	if ( FileSystem::fileExists( layoutPath ) ) {
+	if ( mLayoutCacheEnabled && FileSystem::fileExists( layoutPath ) ) {
+		IOStreamMapped file( layoutPath );
+
+		if ( NULL != file.getData() )
+			return loadLayoutFromMemory( file.getData(), file.getSize(), parent );
+	} else if ( FileSystem::fileExists( layoutPath ) ) {
 		pugi::xml_document doc;
 		pugi::xml_parse_result result = doc.load_file( layoutPath.c_str() );
 
@@ -327,6 +483,9 @@ UIWidget* UISceneNode::loadLayoutFromFile( const std::string& layoutPath, Node*
 }
 
 UIWidget* UISceneNode::loadLayoutFromString( const std::string& layoutString, Node* parent ) {
+	if ( mLayoutCacheEnabled )
+		return loadLayoutFromMemory( layoutString.c_str(), layoutString.size(), parent );
+
 	pugi::xml_document doc;
 	pugi::xml_parse_result result = doc.load_string( layoutString.c_str() );
 
@@ -342,6 +501,13 @@ UIWidget* UISceneNode::loadLayoutFromString( const std::string& layoutString, No
 }
 
 UIWidget* UISceneNode::loadLayoutFromMemory( const void* buffer, Int32 bufferSize, Node* parent ) {
+	if ( mLayoutCacheEnabled ) {
+		std::shared_ptr<UICompiledLayout> layout( getCompiledLayout( buffer, bufferSize ) );
+
+		if ( layout )
+			return loadLayoutFromCompiled( *layout, parent );
+	}
+
 	pugi::xml_document doc;
 	pugi::xml_parse_result result = doc.load_buffer( buffer, bufferSize );
 
@@ -364,6 +530,9 @@ UIWidget* UISceneNode::loadLayoutFromStream( IOStream& stream, Node* parent ) {
 	TScopedBuffer<char> scopedBuffer( bufferSize );
 	stream.read( scopedBuffer.get(), scopedBuffer.length() );
 
+	if ( mLayoutCacheEnabled )
+		return loadLayoutFromMemory( scopedBuffer.get(), scopedBuffer.length(), parent );
+
 	pugi::xml_document doc;
 	pugi::xml_parse_result result = doc.load_buffer( scopedBuffer.get(), scopedBuffer.length() );
 
@@ -467,7 +636,7 @@ void UISceneNode::update( const Time& elapsed ) {
 	// provokes the creation of dynamic elements. This is the case of the UIListBox for example
 	// that creates childs dynamically only when they are visible.
 	int invalidationDepth = 2;
-	while ( ( !mDirtyStyle.empty() || !mDirtyStyleState.empty() || !mDirtyLayouts.empty() ) &&
+	while ( ( !mDirtyStyle->empty() || !mDirtyStyleState->empty() || !mDirtyLayouts->empty() ) &&
 			invalidationDepth > 0 ) {
 		updateDirtyStyles();
 		updateDirtyStyleStates();
@@ -475,20 +644,25 @@ void UISceneNode::update( const Time& elapsed ) {
 		invalidationDepth--;
 	}
 
+	// Anything still dirty is processed in the next frame.
+	if ( !mDirtyStyle->empty() || !mDirtyStyleState->empty() || !mDirtyLayouts->empty() )
+		setUpdateDeadline( Time::Zero );
+
 	SceneManager::instance()->setCurrentUISceneNode( uiSceneNode );
 }
 
 void UISceneNode::onWidgetDelete( Node* node ) {
-	if ( node->isWidget() ) {
-		UIWidget* widget = node->asType<UIWidget>();
+	// The children of the scene node are deleted after its own destructor.
+	if ( NULL == mDirtyStyle )
+		return;
 
-		if ( node->isLayout() ) {
-			mDirtyLayouts.erase( node->asType<UILayout>() );
-		}
+	if ( node->isWidget() ) {
+		if ( node->isLayout() )
+			mDirtyLayouts->erase( node );
 
-		mDirtyStyle.erase( widget );
+		mDirtyStyle->erase( node );
 
-		mDirtyStyleState.erase( widget );
+		mDirtyStyleState->erase( node );
 	}
 }
 
@@ -500,6 +674,13 @@ UIThemeManager* UISceneNode::getUIThemeManager() const {
 	return mUIThemeManager;
 }
 
+FrameBufferPool* UISceneNode::getFrameBufferPool() {
+	if ( NULL == mFrameBufferPool )
+		mFrameBufferPool = FrameBufferPool::New();
+
+	return mFrameBufferPool;
+}
+
 UIWidget* UISceneNode::getRoot() const {
 	return mRoot;
 }
@@ -518,34 +699,7 @@ void UISceneNode::invalidateStyle( UIWidget* node ) {
 	if ( node->isClosing() )
 		return;
 
-	Node* itNode = NULL;
-
-	if ( mDirtyStyle.count( node ) > 0 )
-		return;
-
-	for ( auto& dirtyNode : mDirtyStyle ) {
-		if ( NULL != dirtyNode && dirtyNode->isParentOf( node ) ) {
-			return;
-		}
-	}
-
-	std::vector<std::unordered_set<UIWidget*>::iterator> itEraseList;
-
-	for ( auto it = mDirtyStyle.begin(); it != mDirtyStyle.end(); ++it ) {
-		itNode = *it;
-
-		if ( NULL != itNode && node->isParentOf( itNode ) ) {
-			itEraseList.push_back( it );
-		} else if ( NULL == itNode ) {
-			itEraseList.push_back( it );
-		}
-	}
-
-	for ( auto ite = itEraseList.begin(); ite != itEraseList.end(); ++ite ) {
-		mDirtyStyle.erase( *ite );
-	}
-
-	mDirtyStyle.insert( node );
+	mDirtyStyle->insert( node );
 }
 
 void UISceneNode::invalidateStyleState( UIWidget* node, bool disableCSSAnimations ) {
@@ -554,35 +708,7 @@ void UISceneNode::invalidateStyleState( UIWidget* node, bool disableCSSAnimation
 	if ( node->isClosing() )
 		return;
 
-	Node* itNode = NULL;
-
-	if ( mDirtyStyleState.count( node ) > 0 )
-		return;
-
-	for ( auto& dirtyNode : mDirtyStyleState ) {
-		if ( NULL != dirtyNode && dirtyNode->isParentOf( node ) ) {
-			return;
-		}
-	}
-
-	std::vector<std::unordered_set<UIWidget*>::iterator> itEraseList;
-
-	for ( auto it = mDirtyStyleState.begin(); it != mDirtyStyleState.end(); ++it ) {
-		itNode = *it;
-
-		if ( NULL != itNode && node->isParentOf( itNode ) ) {
-			itEraseList.push_back( it );
-		} else if ( NULL == itNode ) {
-			itEraseList.push_back( it );
-		}
-	}
-
-	for ( auto ite = itEraseList.begin(); ite != itEraseList.end(); ++ite ) {
-		mDirtyStyleState.erase( *ite );
-	}
-
-	mDirtyStyleState.insert( node );
-	mDirtyStyleStateCSSAnimations[node] = disableCSSAnimations;
+	mDirtyStyleState->insert( node, disableCSSAnimations );
 }
 
 void UISceneNode::invalidateLayout( UILayout* node ) {
@@ -591,37 +717,7 @@ void UISceneNode::invalidateLayout( UILayout* node ) {
 	if ( node->isClosing() )
 		return;
 
-	Node* itNode = NULL;
-
-	if ( mDirtyLayouts.count( node ) > 0 )
-		return;
-
-	if ( node->getParent()->isLayout() ) {
-		for ( auto& dirtyNode : mDirtyLayouts ) {
-			if ( NULL != dirtyNode && dirtyNode->isParentOf( node ) &&
-				 node->getParent()->isLayout() ) {
-				return;
-			}
-		}
-
-		std::vector<std::unordered_set<UILayout*>::iterator> itEraseList;
-
-		for ( auto it = mDirtyLayouts.begin(); it != mDirtyLayouts.end(); ++it ) {
-			itNode = *it;
-
-			if ( NULL != itNode && node->isParentOf( itNode ) && itNode->getParent()->isLayout() ) {
-				itEraseList.push_back( it );
-			} else if ( NULL == itNode ) {
-				itEraseList.push_back( it );
-			}
-		}
-
-		for ( auto ite = itEraseList.begin(); ite != itEraseList.end(); ++ite ) {
-			mDirtyLayouts.erase( *ite );
-		}
-	}
-
-	mDirtyLayouts.insert( node );
+	mDirtyLayouts->insert( node );
 }
 
 void UISceneNode::setIsLoading( bool isLoading ) {
@@ -629,25 +725,24 @@ void UISceneNode::setIsLoading( bool isLoading ) {
 }
 
 void UISceneNode::updateDirtyLayouts() {
-	if ( !mDirtyLayouts.empty() ) {
+	if ( !mDirtyLayouts->empty() ) {
+		EE_PROFILE_SCOPE( "UISceneNode::updateDirtyLayouts" );
 		mUpdatingLayouts = true;
 
-		for ( UILayout* layout : mDirtyLayouts ) {
-			layout->updateLayoutTree();
-		}
+		mDirtyLayouts->flush(
+			[]( Node* node, bool ) { node->asType<UILayout>()->updateLayoutTree(); } );
 
-		mDirtyLayouts.clear();
 		mUpdatingLayouts = false;
 	}
 }
 
 void UISceneNode::updateDirtyStyles() {
-	if ( !mDirtyStyle.empty() ) {
+	if ( !mDirtyStyle->empty() ) {
+		EE_PROFILE_SCOPE( "UISceneNode::updateDirtyStyles" );
 		Clock clock;
-		for ( auto& node : mDirtyStyle ) {
-			node->reloadStyle( true, false, false );
-		}
-		mDirtyStyle.clear();
+		mDirtyStyle->flush( []( Node* node, bool ) {
+			node->asType<UIWidget>()->reloadStyle( true, false, false );
+		} );
 
 		if ( mVerbose )
 			Log::info( "CSS Styles Reloaded in %.2f ms", clock.getElapsedTime().asMilliseconds() );
@@ -655,13 +750,12 @@ void UISceneNode::updateDirtyStyles() {
 }
 
 void UISceneNode::updateDirtyStyleStates() {
-	if ( !mDirtyStyleState.empty() ) {
+	if ( !mDirtyStyleState->empty() ) {
+		EE_PROFILE_SCOPE( "UISceneNode::updateDirtyStyleStates" );
 		Clock clock;
-		for ( auto& node : mDirtyStyleState ) {
-			node->reportStyleStateChangeRecursive( mDirtyStyleStateCSSAnimations[node] );
-		}
-		mDirtyStyleState.clear();
-		mDirtyStyleStateCSSAnimations.clear();
+		mDirtyStyleState->flush( []( Node* node, bool disableCSSAnimations ) {
+			node->asType<UIWidget>()->reportStyleStateChangeRecursive( disableCSSAnimations );
+		} );
 
 		if ( mVerbose )
 			Log::debug( "CSS Style State Invalidated, reapplied state in %.2f ms",
@@ -673,6 +767,24 @@ const bool& UISceneNode::isUpdatingLayouts() const {
 	return mUpdatingLayouts;
 }
 
+UISceneNode::InvalidationStats UISceneNode::getStyleInvalidationStats() const {
+	return mDirtyStyle->getStats();
+}
+
+UISceneNode::InvalidationStats UISceneNode::getStyleStateInvalidationStats() const {
+	return mDirtyStyleState->getStats();
+}
+
+UISceneNode::InvalidationStats UISceneNode::getLayoutInvalidationStats() const {
+	return mDirtyLayouts->getStats();
+}
+
+void UISceneNode::resetInvalidationStats() {
+	mDirtyStyle->resetStats();
+	mDirtyStyleState->resetStats();
+	mDirtyLayouts->resetStats();
+}
+
 UIIconThemeManager* UISceneNode::getUIIconThemeManager() const {
 	return mUIIconThemeManager;
 }
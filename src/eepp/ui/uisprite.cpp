@@ -81,6 +81,9 @@ void UISprite::scheduledUpdate( const Time& time ) {
 
 		if ( textureRegion != mSprite->getCurrentTextureRegion() )
 			invalidateDraw();
+
+		if ( mSprite->getAutoAnimate() && mVisible && isMeOrParentTreeVisible() )
+			mSceneNode->setUpdateDeadline( Time::Zero );
 	}
 }
 
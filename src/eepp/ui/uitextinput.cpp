@@ -89,6 +89,7 @@ void UITextInput::scheduledUpdate( const Time& time ) {
 		} else {
 			onMouseDown( getUISceneNode()->getEventDispatcher()->getMousePos(),
 						 getUISceneNode()->getEventDispatcher()->getPressTrigger() );
+			mSceneNode->setUpdateDeadline( Time::Zero );
 		}
 	}
 }
@@ -120,6 +121,8 @@ void UITextInput::updateWaitingCursor( const Time& time ) {
 			mWaitCursorTime = 0.f;
 			invalidateDraw();
 		}
+
+		mSceneNode->setUpdateDeadline( Milliseconds( 500.f - mWaitCursorTime ) );
 	}
 }
 
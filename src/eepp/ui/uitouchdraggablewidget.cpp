@@ -125,6 +125,9 @@ void UITouchDraggableWidget::scheduledUpdate( const Time& time ) {
 				onTouchDragValueChange( mTouchDragAcceleration );
 			}
 		}
+
+		if ( isTouchDragging() || mTouchDragAcceleration != Vector2f::Zero )
+			mSceneNode->setUpdateDeadline( Time::Zero );
 	}
 }
 
@@ -1,4 +1,10 @@
 #include <algorithm>
+#include <eepp/graphics/framebuffer.hpp>
+#include <eepp/graphics/framebufferpool.hpp>
+#include <eepp/graphics/globalbatchrenderer.hpp>
+#include <eepp/graphics/renderer/openglext.hpp>
+#include <eepp/graphics/renderer/renderer.hpp>
+#include <eepp/graphics/textureregion.hpp>
 #include <eepp/scene/actions/actions.hpp>
 #include <eepp/scene/scenemanager.hpp>
 #include <eepp/ui/css/shorthanddefinition.hpp>
@@ -35,6 +41,7 @@ UIWidget::UIWidget( const std::string& tag ) :
 	mTheme( NULL ),
 	mStyle( NULL ),
 	mTooltip( NULL ),
+	mRenderCache( NULL ),
 	mLayoutWeight( 0 ),
 	mLayoutGravity( 0 ),
 	mWidthPolicy( SizePolicy::WrapContent ),
@@ -60,6 +67,7 @@ UIWidget::UIWidget() : UIWidget( "widget" ) {}
 UIWidget::~UIWidget() {
 	if ( !SceneManager::instance()->isShootingDown() && NULL != mUISceneNode )
 		mUISceneNode->onWidgetDelete( this );
+	releaseRenderCache();
 	eeSAFE_DELETE( mStyle );
 	eeSAFE_DELETE( mTooltip );
 }
@@ -533,6 +541,9 @@ void UIWidget::onPositionChange() {
 }
 
 void UIWidget::onVisibilityChange() {
+	if ( !mVisible )
+		releaseRenderCache();
+
 	updateAnchorsDistances();
 	notifyLayoutAttrChange();
 	notifyLayoutAttrChangeParent();
@@ -1309,6 +1320,8 @@ std::string UIWidget::getPropertyString( const PropertyDefinition* propertyDef,
 			return getLayoutHeightPolicyString();
 		case PropertyId::Clip:
 			return isClipped() ? "true" : "false";
+		case PropertyId::RenderCache:
+			return isRenderCached() ? "true" : "false";
 		case PropertyId::BackgroundPositionX:
 			return getBackground()->getLayer( propertyIndex )->getPositionX();
 		case PropertyId::BackgroundPositionY:
@@ -1659,6 +1672,9 @@ bool UIWidget::applyProperty( const StyleSheetProperty& attribute ) {
 			else
 				clipDisable();
 			break;
+		case PropertyId::RenderCache:
+			setRenderCache( attribute.asBool() );
+			break;
 		case PropertyId::Rotation:
 			setRotation( attribute.asFloat() );
 			break;
@@ -1797,6 +1813,18 @@ void UIWidget::loadFromXmlNode( const pugi::xml_node& node ) {
 	endAttributesTransaction();
 }
 
+void UIWidget::loadFromProperties( const std::vector<StyleSheetProperty>& properties ) {
+	beginAttributesTransaction();
+
+	for ( const auto& property : properties ) {
+		if ( NULL != mStyle )
+			mStyle->setStyleSheetProperty( property );
+		applyProperty( property );
+	}
+
+	endAttributesTransaction();
+}
+
 std::string UIWidget::getLayoutWidthPolicyString() const {
 	SizePolicy rules = getLayoutWidthPolicy();
 
@@ -1943,6 +1971,174 @@ UIWidget* UIWidget::getNextTabWidget() const {
 	return NULL;
 }
 
+void UIWidget::setRenderCache( bool enabled ) {
+	if ( enabled == isRenderCached() )
+		return;
+
+	writeNodeFlag( NODE_FLAG_RENDER_CACHE, enabled ? 1 : 0 );
+
+	if ( !enabled )
+		releaseRenderCache();
+
+	updateDrawInvalidator( true );
+	invalidateDraw();
+}
+
+bool UIWidget::isRenderCached() const {
+	return 0 != ( mNodeFlags & NODE_FLAG_RENDER_CACHE );
+}
+
+bool UIWidget::isDrawInvalidator() const {
+	return isRenderCached();
+}
+
+void UIWidget::invalidate( Node* invalidator ) {
+	if ( !isRenderCached() ) {
+		UINode::invalidate( invalidator );
+		return;
+	}
+
+	if ( mVisible && mAlpha != 0.f ) {
+		writeNodeFlag( NODE_FLAG_VIEW_DIRTY, 1 );
+
+		if ( NULL != mNodeDrawInvalidator )
+			mNodeDrawInvalidator->invalidate( invalidator );
+	}
+}
+
+void UIWidget::nodeDraw() {
+	if ( !isRenderCached() || isRotated() || isScaled() ) {
+		UINode::nodeDraw();
+		return;
+	}
+
+	if ( !mVisible )
+		return;
+
+	if ( mNodeFlags & NODE_FLAG_POSITION_DIRTY )
+		updateScreenPos();
+
+	if ( mNodeFlags & NODE_FLAG_POLYGON_DIRTY )
+		updateWorldPolygon();
+
+	if ( !mWorldBounds.intersect( mSceneNode->getWorldBounds() ) )
+		return;
+
+	// If the pool can't provide a frame buffer the widget is drawn as usual.
+	if ( !updateRenderCache() ) {
+		UINode::nodeDraw();
+		return;
+	}
+
+	drawRenderCache();
+
+	drawHighlightFocus();
+
+	drawOverNode();
+
+	updateDebugData();
+
+	drawBox();
+}
+
+bool UIWidget::updateRenderCache() {
+	Sizei size( mSize.ceil().asInt() );
+
+	if ( NULL == mUISceneNode || size.getWidth() <= 0 || size.getHeight() <= 0 )
+		return false;
+
+	if ( NULL != mRenderCache && ( mRenderCache->getWidth() < size.getWidth() ||
+								   mRenderCache->getHeight() < size.getHeight() ) )
+		releaseRenderCache();
+
+	if ( NULL == mRenderCache ) {
+		mRenderCache = mUISceneNode->getFrameBufferPool()->acquire( size );
+
+		if ( NULL == mRenderCache )
+			return false;
+
+		mNodeFlags |= NODE_FLAG_VIEW_DIRTY;
+	}
+
+	if ( !( mNodeFlags & NODE_FLAG_VIEW_DIRTY ) )
+		return true;
+
+	GlobalBatchRenderer::instance()->draw();
+
+	// The clipping of the parents is in screen coordinates, it must not affect the frame buffer.
+	ClippingMask* clippingMask = GLi->getClippingMask();
+	std::list<Rectf> planes( clippingMask->getPlanesClipped() );
+	std::list<Rectf> scissors( clippingMask->getScissorsClipped() );
+
+	if ( !planes.empty() ) {
+		clippingMask->setPlanesClipped( std::list<Rectf>() );
+		GLi->clip2DPlaneDisable();
+	}
+
+	if ( !scissors.empty() ) {
+		clippingMask->setScissorsClipped( std::list<Rectf>() );
+		GLi->disable( GL_SCISSOR_TEST );
+	}
+
+	mRenderCache->bind();
+
+	mRenderCache->clear();
+
+	GLi->pushMatrix();
+	GLi->translatef( -mScreenPos.x, -mScreenPos.y, 0.f );
+
+	mSceneNode->pushCullRect( Rectf( mScreenPos, mSize ), false );
+
+	clipStart();
+
+	draw();
+
+	drawChilds();
+
+	if ( 0.f != mAlpha )
+		drawForeground();
+
+	clipEnd();
+
+	drawBorder();
+
+	mSceneNode->popCullRect();
+
+	GlobalBatchRenderer::instance()->draw();
+
+	GLi->popMatrix();
+
+	mRenderCache->unbind();
+
+	if ( !scissors.empty() )
+		clippingMask->setScissorsClipped( scissors );
+
+	if ( !planes.empty() )
+		clippingMask->setPlanesClipped( planes );
+
+	writeNodeFlag( NODE_FLAG_VIEW_DIRTY, 0 );
+
+	return true;
+}
+
+void UIWidget::drawRenderCache() {
+	Rect r( 0, 0, eeceil( mSize.getWidth() ), eeceil( mSize.getHeight() ) );
+	TextureRegion textureRegion( mRenderCache->getTexture()->getTextureId(), r,
+								 r.getSize().asFloat() );
+	textureRegion.draw( mScreenPos.x, mScreenPos.y );
+}
+
+void UIWidget::releaseRenderCache() {
+	if ( NULL == mRenderCache )
+		return;
+
+	if ( NULL != mUISceneNode && NULL != mUISceneNode->mFrameBufferPool &&
+		 !SceneManager::instance()->isShootingDown() )
+		mUISceneNode->mFrameBufferPool->release( mRenderCache );
+
+	mRenderCache = NULL;
+}
+
 void UIWidget::onTabPress() {
 	if ( !isTabStop() ) {
 		Node* node = getNextTabWidget();
@@ -118,6 +118,26 @@ UIWidget* UIWidgetCreator::createFromName( std::string widgetName ) {
 	return NULL;
 }
 
+UIWidgetCreator::RegisterWidgetCb UIWidgetCreator::getWidgetCreator( std::string widgetName ) {
+	createBaseWidgetList();
+
+	String::toLowerInPlace( widgetName );
+
+	auto registered = registeredWidget.find( widgetName );
+
+	if ( registered != registeredWidget.end() )
+		return registered->second;
+
+	auto custom = widgetCallback.find( widgetName );
+
+	if ( custom != widgetCallback.end() ) {
+		CustomWidgetCb cb( custom->second );
+		return [cb, widgetName]() { return cb( widgetName ); };
+	}
+
+	return RegisterWidgetCb();
+}
+
 void UIWidgetCreator::addCustomWidgetCallback( std::string widgetName,
 											   const UIWidgetCreator::CustomWidgetCb& cb ) {
 	widgetCallback[String::toLower( widgetName )] = cb;
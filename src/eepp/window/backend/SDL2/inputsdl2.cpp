@@ -10,7 +10,9 @@
 namespace EE { namespace Window { namespace Backend { namespace SDL2 {
 
 InputSDL::InputSDL( EE::Window::Window* window ) :
-	Input( window, eeNew( JoystickManagerSDL, () ) ), mDPIScale( 1.f ) {
+	Input( window, eeNew( JoystickManagerSDL, () ) ),
+	mDPIScale( 1.f ),
+	mWakeUpEventType( SDL_RegisterEvents( 1 ) ) {
 #if defined( EE_X11_PLATFORM )
 	mMouseSpeed = 1.75f;
 #endif
@@ -42,6 +44,16 @@ void InputSDL::waitEvent( const Time& timeout ) {
 		mQueuedEvents.emplace_back( SDLEvent );
 }
 
+void InputSDL::wakeUp() {
+	if ( (Uint32)-1 == mWakeUpEventType )
+		return;
+
+	SDL_Event SDLEvent;
+	SDL_zero( SDLEvent );
+	SDLEvent.type = mWakeUpEventType;
+	SDL_PushEvent( &SDLEvent );
+}
+
 bool InputSDL::grabInput() {
 	return ( SDL_GetWindowGrab( static_cast<WindowSDL*>( mWindow )->GetSDLWindow() ) == SDL_TRUE )
 			   ? true
@@ -393,7 +405,10 @@ void InputSDL::sendEvent( const SDL_Event& SDLEvent ) {
 			break;
 		}
 		default: {
-			if ( SDLEvent.type >= SDL_USEREVENT && SDLEvent.type < SDL_LASTEVENT ) {
+			if ( SDLEvent.type == mWakeUpEventType ) {
+				// Only used to wake up waitEvent.
+				event.Type = InputEvent::NoEvent;
+			} else if ( SDLEvent.type >= SDL_USEREVENT && SDLEvent.type < SDL_LASTEVENT ) {
 				event.Type = InputEvent::EventUser + SDLEvent.type - SDL_USEREVENT;
 				event.user.type = event.Type;
 				event.user.code = SDLEvent.user.code;
@@ -18,6 +18,8 @@ class EE_API InputSDL : public Input {
 
 	void waitEvent( const Time& timeout = Time::Zero );
 
+	void wakeUp();
+
 	bool grabInput();
 
 	void grabInput( const bool& Grab );
@@ -45,6 +47,7 @@ class EE_API InputSDL : public Input {
   protected:
 	friend class WindowSDL;
 	Float mDPIScale;
+	Uint32 mWakeUpEventType;
 	std::vector<SDL_Event> mQueuedEvents;
 
 	InputSDL( EE::Window::Window* window );
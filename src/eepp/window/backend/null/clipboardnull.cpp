@@ -0,0 +1,23 @@
+#include <eepp/window/backend/null/clipboardnull.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+ClipboardNull::ClipboardNull( EE::Window::Window* window ) : Clipboard( window ) {}
+
+ClipboardNull::~ClipboardNull() {}
+
+void ClipboardNull::init() {}
+
+void ClipboardNull::setText( const std::string& Text ) {
+	mText = Text;
+}
+
+std::string ClipboardNull::getText() {
+	return mText;
+}
+
+String ClipboardNull::getWideText() {
+	return String::fromUtf8( mText );
+}
+
+}}}} // namespace EE::Window::Backend::Null
@@ -0,0 +1,32 @@
+#ifndef EE_WINDOWCCLIPBOARDNULL_HPP
+#define EE_WINDOWCCLIPBOARDNULL_HPP
+
+#include <eepp/window/base.hpp>
+#include <eepp/window/clipboard.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+/** @brief Clipboard of the null backend, the text is only shared inside the process. */
+class EE_API ClipboardNull : public Clipboard {
+  public:
+	virtual ~ClipboardNull();
+
+	std::string getText();
+
+	String getWideText();
+
+	void setText( const std::string& Text );
+
+  protected:
+	friend class WindowNull;
+
+	std::string mText;
+
+	ClipboardNull( EE::Window::Window* window );
+
+	void init();
+};
+
+}}}} // namespace EE::Window::Backend::Null
+
+#endif
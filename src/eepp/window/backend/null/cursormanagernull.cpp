@@ -0,0 +1,56 @@
+#include <eepp/window/backend/null/cursormanagernull.hpp>
+#include <eepp/window/backend/null/cursornull.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+CursorManagerNull::CursorManagerNull( EE::Window::Window* window ) : CursorManager( window ) {}
+
+Cursor* CursorManagerNull::create( Texture* tex, const Vector2i& hotspot,
+								   const std::string& name ) {
+	return eeNew( CursorNull, ( tex, hotspot, name, mWindow ) );
+}
+
+Cursor* CursorManagerNull::create( Image* img, const Vector2i& hotspot, const std::string& name ) {
+	return eeNew( CursorNull, ( img, hotspot, name, mWindow ) );
+}
+
+Cursor* CursorManagerNull::create( const std::string& path, const Vector2i& hotspot,
+								   const std::string& name ) {
+	return eeNew( CursorNull, ( path, hotspot, name, mWindow ) );
+}
+
+void CursorManagerNull::set( Cursor* cursor ) {
+	if ( NULL != cursor && cursor != mCurrent ) {
+		mCurrent = cursor;
+		mCurSysCursor = false;
+		mSysCursor = Cursor::SysCursorNone;
+	}
+}
+
+void CursorManagerNull::set( Cursor::SysType syscurid ) {
+	if ( syscurid != mSysCursor ) {
+		mCurrent = NULL;
+		mCurSysCursor = true;
+		mSysCursor = syscurid;
+	}
+}
+
+void CursorManagerNull::show() {
+	setVisible( true );
+}
+
+void CursorManagerNull::hide() {
+	setVisible( false );
+}
+
+void CursorManagerNull::setVisible( bool visible ) {
+	mVisible = visible;
+}
+
+void CursorManagerNull::remove( Cursor* cursor, bool Delete ) {
+	CursorManager::remove( cursor, Delete );
+}
+
+void CursorManagerNull::reload() {}
+
+}}}} // namespace EE::Window::Backend::Null
@@ -0,0 +1,57 @@
+#include <eepp/window/backend/null/displaymanagernull.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+DisplayNull::DisplayNull( int index, const Sizei& resolution ) :
+	Display( index ), mResolution( resolution ) {}
+
+std::string DisplayNull::getName() {
+	return "Null";
+}
+
+Rect DisplayNull::getBounds() {
+	return Rect( 0, 0, mResolution.getWidth(), mResolution.getHeight() );
+}
+
+Rect DisplayNull::getUsableBounds() {
+	return getBounds();
+}
+
+Float DisplayNull::getDPI() {
+	return 96.f;
+}
+
+const int& DisplayNull::getIndex() const {
+	return index;
+}
+
+DisplayMode DisplayNull::getCurrentMode() {
+	return DisplayMode( mResolution.getWidth(), mResolution.getHeight(), 60, index );
+}
+
+DisplayMode DisplayNull::getClosestDisplayMode( DisplayMode ) {
+	return getCurrentMode();
+}
+
+const std::vector<DisplayMode>& DisplayNull::getModes() const {
+	if ( displayModes.empty() )
+		displayModes.push_back(
+			DisplayMode( mResolution.getWidth(), mResolution.getHeight(), 60, index ) );
+
+	return displayModes;
+}
+
+DisplayManagerNull::DisplayManagerNull( const Sizei& resolution ) : mResolution( resolution ) {}
+
+int DisplayManagerNull::getDisplayCount() {
+	return 1;
+}
+
+Display* DisplayManagerNull::getDisplayIndex( int index ) {
+	if ( displays.empty() )
+		displays.push_back( eeNew( DisplayNull, ( 0, mResolution ) ) );
+
+	return index == 0 ? displays[0] : NULL;
+}
+
+}}}} // namespace EE::Window::Backend::Null
@@ -0,0 +1,47 @@
+#ifndef EE_WINDOW_DISPLAYMANAGERNULL_HPP
+#define EE_WINDOW_DISPLAYMANAGERNULL_HPP
+
+#include <eepp/window/displaymanager.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+class EE_API DisplayNull : public Display {
+  public:
+	DisplayNull( int index, const Sizei& resolution );
+
+	std::string getName();
+
+	Rect getBounds();
+
+	Rect getUsableBounds();
+
+	Float getDPI();
+
+	const int& getIndex() const;
+
+	DisplayMode getCurrentMode();
+
+	DisplayMode getClosestDisplayMode( DisplayMode wantedMode );
+
+	const std::vector<DisplayMode>& getModes() const;
+
+  protected:
+	Sizei mResolution;
+};
+
+/** @brief A single virtual display with the resolution of the null window. */
+class EE_API DisplayManagerNull : public DisplayManager {
+  public:
+	DisplayManagerNull( const Sizei& resolution );
+
+	int getDisplayCount();
+
+	Display* getDisplayIndex( int index );
+
+  protected:
+	Sizei mResolution;
+};
+
+}}}} // namespace EE::Window::Backend::Null
+
+#endif
@@ -0,0 +1,111 @@
+#include <eepp/window/backend/null/inputnull.hpp>
+#include <eepp/window/backend/null/joystickmanagernull.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+InputNull::InputNull( EE::Window::Window* window ) :
+	Input( window, eeNew( JoystickManagerNull, () ) ), mWakeUp( false ), mMouseCaptured( false ) {}
+
+InputNull::~InputNull() {}
+
+void InputNull::update() {
+	std::vector<InputEvent> events;
+
+	{
+		std::lock_guard<std::mutex> lock( mQueueMutex );
+		events.swap( mQueuedEvents );
+		mWakeUp = false;
+	}
+
+	cleanStates();
+
+	for ( auto& event : events )
+		processEvent( &event );
+
+	InputEvent endProcessingEvent;
+	endProcessingEvent.Type = InputEvent::EventsSent;
+	processEvent( &endProcessingEvent );
+}
+
+void InputNull::waitEvent( const Time& timeout ) {
+	std::unique_lock<std::mutex> lock( mQueueMutex );
+	auto ready = [&] { return mWakeUp || !mQueuedEvents.empty(); };
+
+	if ( timeout == Time::Zero ) {
+		mQueueCond.wait( lock, ready );
+	} else {
+		mQueueCond.wait_for( lock, std::chrono::microseconds( timeout.asMicroseconds() ), ready );
+	}
+
+	mWakeUp = false;
+}
+
+void InputNull::wakeUp() {
+	{
+		std::lock_guard<std::mutex> lock( mQueueMutex );
+		mWakeUp = true;
+	}
+
+	mQueueCond.notify_all();
+}
+
+void InputNull::pushEvent( const InputEvent& event ) {
+	{
+		std::lock_guard<std::mutex> lock( mQueueMutex );
+		mQueuedEvents.push_back( event );
+	}
+
+	mQueueCond.notify_all();
+}
+
+bool InputNull::grabInput() {
+	return mInputGrabed;
+}
+
+void InputNull::grabInput( const bool& Grab ) {
+	mInputGrabed = Grab;
+}
+
+void InputNull::injectMousePos( const Uint16& x, const Uint16& y ) {
+	mMousePos = Vector2i( x, y );
+}
+
+Vector2i InputNull::queryMousePos() {
+	return mMousePos;
+}
+
+void InputNull::captureMouse( const bool& capture ) {
+	mMouseCaptured = capture;
+}
+
+bool InputNull::isMouseCaptured() const {
+	return mMouseCaptured;
+}
+
+std::string InputNull::getKeyName( const Keycode& ) const {
+	return std::string();
+}
+
+Keycode InputNull::getKeyFromName( const std::string& ) const {
+	return KEY_UNKNOWN;
+}
+
+std::string InputNull::getScancodeName( const Scancode& ) const {
+	return std::string();
+}
+
+Scancode InputNull::getScancodeFromName( const std::string& ) const {
+	return SCANCODE_UNKNOWN;
+}
+
+Keycode InputNull::getKeyFromScancode( const Scancode& ) const {
+	return KEY_UNKNOWN;
+}
+
+Scancode InputNull::getScancodeFromKey( const Keycode& ) const {
+	return SCANCODE_UNKNOWN;
+}
+
+void InputNull::init() {}
+
+}}}} // namespace EE::Window::Backend::Null
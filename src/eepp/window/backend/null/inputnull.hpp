@@ -0,0 +1,66 @@
+#ifndef EE_WINDOWCINPUTNULL_HPP
+#define EE_WINDOWCINPUTNULL_HPP
+
+#include <condition_variable>
+#include <eepp/window/input.hpp>
+#include <mutex>
+#include <vector>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+/** @brief Input of the null backend. There's no device to read from, the events are queued with
+ * pushEvent ( from any thread ) and sent to the window in the next update. */
+class EE_API InputNull : public Input {
+  public:
+	~InputNull();
+
+	void update();
+
+	void waitEvent( const Time& timeout = Time::Zero );
+
+	void wakeUp();
+
+	bool grabInput();
+
+	void grabInput( const bool& Grab );
+
+	void injectMousePos( const Uint16& x, const Uint16& y );
+
+	Vector2i queryMousePos();
+
+	void captureMouse( const bool& capture );
+
+	bool isMouseCaptured() const;
+
+	std::string getKeyName( const Keycode& keycode ) const;
+
+	Keycode getKeyFromName( const std::string& keycode ) const;
+
+	std::string getScancodeName( const Scancode& scancode ) const;
+
+	Scancode getScancodeFromName( const std::string& scancode ) const;
+
+	Keycode getKeyFromScancode( const Scancode& scancode ) const;
+
+	Scancode getScancodeFromKey( const Keycode& scancode ) const;
+
+	/** Queues an event to be sent in the next update. Can be called from any thread. */
+	void pushEvent( const InputEvent& event );
+
+  protected:
+	friend class WindowNull;
+
+	std::mutex mQueueMutex;
+	std::condition_variable mQueueCond;
+	std::vector<InputEvent> mQueuedEvents;
+	bool mWakeUp;
+	bool mMouseCaptured;
+
+	InputNull( EE::Window::Window* window );
+
+	void init();
+};
+
+}}}} // namespace EE::Window::Backend::Null
+
+#endif
@@ -0,0 +1,13 @@
+#include <eepp/window/backend/null/joystickmanagernull.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+JoystickManagerNull::JoystickManagerNull() : JoystickManager() {}
+
+JoystickManagerNull::~JoystickManagerNull() {}
+
+void JoystickManagerNull::update() {}
+
+void JoystickManagerNull::create( const Uint32& ) {}
+
+}}}} // namespace EE::Window::Backend::Null
@@ -0,0 +1,23 @@
+#ifndef EE_WINDOWCJOYSTICKMANAGERNULL_HPP
+#define EE_WINDOWCJOYSTICKMANAGERNULL_HPP
+
+#include <eepp/window/joystickmanager.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+/** @brief Joystick manager of the null backend, it never finds any joystick. */
+class EE_API JoystickManagerNull : public JoystickManager {
+  public:
+	JoystickManagerNull();
+
+	virtual ~JoystickManagerNull();
+
+	void update();
+
+  protected:
+	void create( const Uint32& index );
+};
+
+}}}} // namespace EE::Window::Backend::Null
+
+#endif
@@ -0,0 +1,134 @@
+#include <eepp/graphics/renderer/renderer.hpp>
+#include <eepp/system/log.hpp>
+#include <eepp/window/backend/null/clipboardnull.hpp>
+#include <eepp/window/backend/null/cursormanagernull.hpp>
+#include <eepp/window/backend/null/inputnull.hpp>
+#include <eepp/window/backend/null/windownull.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+WindowNull::WindowNull( WindowSettings Settings, ContextSettings Context ) :
+	Window( Settings, Context, eeNew( ClipboardNull, ( this ) ), eeNew( InputNull, ( this ) ),
+			eeNew( CursorManagerNull, ( this ) ) ) {
+	create( Settings, Context );
+}
+
+WindowNull::~WindowNull() {}
+
+bool WindowNull::create( WindowSettings Settings, ContextSettings Context ) {
+	if ( mWindow.Created )
+		return false;
+
+	mWindow.WindowConfig = Settings;
+	mWindow.ContextConfig = Context;
+	mWindow.ContextConfig.Version = GLv_null;
+	mWindow.ContextConfig.SharedGLContext = false;
+	mWindow.DesktopResolution = Sizei( Settings.Width, Settings.Height );
+	mWindow.WindowSize = Sizei( mWindow.WindowConfig.Width, mWindow.WindowConfig.Height );
+	mLastWindowedSize = mWindow.WindowSize;
+
+	if ( NULL == Renderer::existsSingleton() ) {
+		Renderer::createSingleton( GLv_null );
+		Renderer::instance()->init();
+	}
+
+	getMainContext();
+
+	createView();
+
+	setup2D( false );
+
+	mWindow.Created = true;
+
+	reinterpret_cast<ClipboardNull*>( mClipboard )->init();
+
+	reinterpret_cast<InputNull*>( mInput )->init();
+
+	mCursorManager->set( Cursor::SysArrow );
+
+	logSuccessfulInit( "Null" );
+
+	return true;
+}
+
+void WindowNull::toggleFullscreen() {
+	setSize( mWindow.WindowConfig.Width, mWindow.WindowConfig.Height, !isWindowed() );
+}
+
+void WindowNull::setTitle( const std::string& title ) {
+	mWindow.WindowConfig.Title = title;
+}
+
+bool WindowNull::setIcon( const std::string& Path ) {
+	mWindow.WindowConfig.Icon = Path;
+	return false;
+}
+
+bool WindowNull::isActive() {
+	return true;
+}
+
+bool WindowNull::isVisible() {
+	return true;
+}
+
+bool WindowNull::hasFocus() {
+	return true;
+}
+
+bool WindowNull::hasInputFocus() {
+	return true;
+}
+
+bool WindowNull::hasMouseFocus() {
+	return true;
+}
+
+void WindowNull::setSize( Uint32 width, Uint32 height, bool windowed ) {
+	if ( !width || !height ) {
+		width = mWindow.DesktopResolution.getWidth();
+		height = mWindow.DesktopResolution.getHeight();
+	}
+
+	if ( windowed )
+		mWindow.WindowConfig.Style &= ~WindowStyle::Fullscreen;
+	else
+		mWindow.WindowConfig.Style |= WindowStyle::Fullscreen;
+
+	onWindowResize( width, height );
+}
+
+std::vector<DisplayMode> WindowNull::getDisplayModes() const {
+	std::vector<DisplayMode> modes;
+	modes.push_back( DisplayMode( mWindow.DesktopResolution.getWidth(),
+								  mWindow.DesktopResolution.getHeight(), 60, 0 ) );
+	return modes;
+}
+
+void WindowNull::setGamma( Float, Float, Float ) {}
+
+eeWindowHandle WindowNull::getWindowHandler() {
+	return 0;
+}
+
+void WindowNull::swapBuffers() {}
+
+void WindowNull::onWindowResize( Uint32 width, Uint32 height ) {
+	if ( width == mWindow.WindowConfig.Width && height == mWindow.WindowConfig.Height )
+		return;
+
+	mWindow.WindowConfig.Width = width;
+	mWindow.WindowConfig.Height = height;
+	mWindow.WindowSize = Sizei( width, height );
+
+	if ( isWindowed() )
+		mLastWindowedSize = Sizei( width, height );
+
+	mDefaultView.reset( Rectf( 0, 0, mWindow.WindowConfig.Width, mWindow.WindowConfig.Height ) );
+
+	setup2D( false );
+
+	sendVideoResizeCb();
+}
+
+}}}} // namespace EE::Window::Backend::Null
@@ -0,0 +1,51 @@
+#ifndef EE_WINDOWCWINDOWNULL_HPP
+#define EE_WINDOWCWINDOWNULL_HPP
+
+#include <eepp/window/window.hpp>
+
+namespace EE { namespace Window { namespace Backend { namespace Null {
+
+/** @brief A window without a native window nor a graphics context. Renders with the null
+ * renderer, so the engine, the scene graph and the UI can run headless ( tests, benchmarks and
+ * servers ). Input events can be injected with InputNull::pushEvent. */
+class EE_API WindowNull : public Window {
+  public:
+	WindowNull( WindowSettings Settings, ContextSettings Context );
+
+	virtual ~WindowNull();
+
+	bool create( WindowSettings Settings, ContextSettings Context );
+
+	void toggleFullscreen();
+
+	void setTitle( const std::string& title );
+
+	bool setIcon( const std::string& Path );
+
+	bool isActive();
+
+	bool isVisible();
+
+	bool hasFocus();
+
+	bool hasInputFocus();
+
+	bool hasMouseFocus();
+
+	void setSize( Uint32 width, Uint32 height, bool windowed );
+
+	std::vector<DisplayMode> getDisplayModes() const;
+
+	void setGamma( Float Red, Float Green, Float Blue );
+
+	eeWindowHandle getWindowHandler();
+
+  protected:
+	void swapBuffers();
+
+	void onWindowResize( Uint32 width, Uint32 height );
+};
+
+}}}} // namespace EE::Window::Backend::Null
+
+#endif
@@ -22,6 +22,8 @@
 #include <eepp/window/backend.hpp>
 #include <eepp/window/backend/SDL2/backendsdl2.hpp>
 #include <eepp/window/backend/SDL2/platformhelpersdl2.hpp>
+#include <eepp/window/backend/null/displaymanagernull.hpp>
+#include <eepp/window/backend/null/windownull.hpp>
 #include <eepp/window/engine.hpp>
 
 #if EE_PLATFORM == EE_PLATFORM_ANDROID
@@ -143,6 +145,11 @@ EE::Window::Window* Engine::createSDL2Window( const WindowSettings& Settings,
 #endif
 }
 
+EE::Window::Window* Engine::createNullWindow( const WindowSettings& Settings,
+											  const ContextSettings& Context ) {
+	return eeNew( Backend::Null::WindowNull, ( Settings, Context ) );
+}
+
 EE::Window::Window* Engine::createDefaultWindow( const WindowSettings& Settings,
 												 const ContextSettings& Context ) {
 #if DEFAULT_BACKEND == BACKEND_SDL2
@@ -160,6 +167,9 @@ EE::Window::Window* Engine::createWindow( WindowSettings Settings, ContextSettin
 	}
 
 	switch ( Settings.Backend ) {
+		case WindowBackend::Null:
+			window = createNullWindow( Settings, Context );
+			break;
 		case WindowBackend::Default:
 		default:
 			window = createDefaultWindow( Settings, Context );
@@ -267,6 +277,8 @@ WindowSettings Engine::createWindowSettings( IniFile* ini, std::string iniKeyNam
 
 	if ( "sdl2" == backend )
 		winBackend = WindowBackend::SDL2;
+	else if ( "null" == backend )
+		winBackend = WindowBackend::Null;
 
 	Uint32 Style = WindowStyle::Titlebar;
 
@@ -381,9 +393,15 @@ PlatformHelper* Engine::getPlatformHelper() {
 
 DisplayManager* Engine::getDisplayManager() {
 	if ( NULL == mDisplayManager ) {
+		if ( NULL != mWindow &&
+			 WindowBackend::Null == mWindow->getWindowInfo()->WindowConfig.Backend ) {
+			mDisplayManager = eeNew( Backend::Null::DisplayManagerNull,
+									 ( mWindow->getWindowInfo()->DesktopResolution ) );
+		} else {
 #if DEFAULT_BACKEND == BACKEND_SDL2
-		mDisplayManager = eeNew( Backend::SDL2::DisplayManagerSDL2, () );
+			mDisplayManager = eeNew( Backend::SDL2::DisplayManagerSDL2, () );
 #endif
+		}
 	}
 
 	return mDisplayManager;
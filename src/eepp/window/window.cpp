@@ -4,6 +4,7 @@
 #include <eepp/graphics/renderer/renderer.hpp>
 #include <eepp/graphics/texturefactory.hpp>
 #include <eepp/system/filesystem.hpp>
+#include <eepp/system/profiler.hpp>
 #include <eepp/version.hpp>
 #include <eepp/window/clipboard.hpp>
 #include <eepp/window/cursormanager.hpp>
@@ -206,7 +207,8 @@ void Window::setup2D( const bool& KeepView ) {
 
 	BlendMode::setMode( BlendAlpha, true );
 
-	if ( GLv_3CP != GLi->version() && GLv_3 != GLi->version() && GLv_ES2 != GLi->version() ) {
+	if ( GLv_3CP != GLi->version() && GLv_3 != GLi->version() && GLv_ES2 != GLi->version() &&
+		 !GLi->isNullRenderer() ) {
 #if !defined( EE_GLES2 ) || defined( EE_GLES_BOTH )
 		glTexEnvi( GL_POINT_SPRITE, GL_COORD_REPLACE, GL_TRUE );
 #endif
@@ -237,6 +239,10 @@ RGB Window::getClearColor() const {
 bool Window::takeScreenshot( std::string filepath, const Image::SaveType& Format ) {
 	GlobalBatchRenderer::instance()->draw();
 
+	// Nothing is rasterized without a graphics context
+	if ( GLi->isNullRenderer() )
+		return false;
+
 	bool CreateNewFile = false;
 	std::string File, Ext;
 
@@ -381,8 +387,14 @@ void Window::clear() {
 }
 
 void Window::display( bool clear ) {
+	EE_PROFILE_SCOPE( "Window::display" );
+
 	GlobalBatchRenderer::instance()->draw();
 
+	GLi->endFrame();
+
+	TextureFactory::instance()->endFrame();
+
 	swapBuffers();
 
 	if ( mCurrentView->isDirty() )
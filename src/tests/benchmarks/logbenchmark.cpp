@@ -0,0 +1,89 @@
+#include "../unit_tests/unittest.hpp"
+#include <iostream>
+
+static const int LogThreads = 16;
+static const int MessagesPerThread = 20000;
+
+struct LogBenchmarkResult {
+	Float seconds;
+	Uint64 dropped;
+	Uint64 lines;
+};
+
+static LogBenchmarkResult runLogThreads( bool async, LogQueuePolicy policy ) {
+	std::string directory( UnitTest::tempPath( "log-benchmark/" ) );
+	std::string path( directory + "log.log" );
+
+	FileSystem::makeDir( directory );
+	FileSystem::fileRemove( path );
+
+	// The messages go to a live written file, the console output would measure the terminal.
+	Log::destroySingleton();
+	Log* log = Log::create( LogLevel::Info, false, false );
+	log->save( directory );
+	log->setLiveWrite( true );
+	log->setMaxBufferSize( 1024 * 1024 );
+	log->setAsyncQueuePolicy( policy );
+	log->setAsync( async );
+
+	std::vector<Thread*> threads;
+	Clock clock;
+
+	for ( int t = 0; t < LogThreads; t++ ) {
+		threads.push_back( eeNew( Thread, ( [t]() {
+			for ( int i = 0; i < MessagesPerThread; i++ )
+				Log::info( "benchmark message %d from thread %d", i, t );
+		} ) ) );
+		threads.back()->launch();
+	}
+
+	for ( auto& thread : threads )
+		eeSAFE_DELETE( thread );
+
+	log->flush();
+
+	LogBenchmarkResult result;
+	result.seconds = clock.getElapsedTime().asSeconds();
+	result.dropped = log->getDroppedCount();
+
+	Log::destroySingleton();
+
+	std::string data;
+	FileSystem::fileGet( path, data );
+	result.lines = 0;
+
+	for ( size_t pos = data.find( "benchmark message" ); pos != std::string::npos;
+		  pos = data.find( "benchmark message", pos + 1 ) )
+		result.lines++;
+
+	FileSystem::fileRemove( path );
+
+	Log::create( LogLevel::Warning, true, false );
+
+	return result;
+}
+
+static void printLogResult( const char* name, const LogBenchmarkResult& result ) {
+	Uint64 total = LogThreads * MessagesPerThread;
+
+	std::cout << "\t" << name << ": " << (Uint64)( total / result.seconds ) << " messages/s, "
+			  << result.dropped << " dropped" << std::endl;
+}
+
+TEST_CASE( log_threads_benchmark ) {
+	const Uint64 total = LogThreads * MessagesPerThread;
+
+	LogBenchmarkResult sync = runLogThreads( false, LogQueuePolicy::Block );
+	printLogResult( "sync", sync );
+	CHECK_EQ( sync.lines, total );
+
+	LogBenchmarkResult blocking = runLogThreads( true, LogQueuePolicy::Block );
+	printLogResult( "async, blocking", blocking );
+	CHECK_EQ( blocking.lines, total );
+	CHECK_EQ( blocking.dropped, 0u );
+
+	// Every message is either written or counted as dropped.
+	LogBenchmarkResult dropping = runLogThreads( true, LogQueuePolicy::Drop );
+	printLogResult( "async, dropping", dropping );
+	CHECK_EQ( dropping.lines + dropping.dropped, total );
+}
@@ -0,0 +1,235 @@
+#include "../unit_tests/unittest.hpp"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+// Holds loopback connections in a SocketPoller and measures the time from a send to the wake-up of
+// the poller with the receiving socket. The open files limit must allow two descriptors per
+// connection.
+static const size_t PollerConnections = 256;
+
+TEST_CASE( socket_poller_benchmark ) {
+	TcpListener listener;
+
+	if ( listener.listen( Socket::AnyPort, IpAddress::LocalHost ) != Socket::Done )
+		return;
+
+	std::vector<std::unique_ptr<TcpSocket>> clients;
+	std::vector<std::unique_ptr<TcpSocket>> servers;
+	SocketPoller poller;
+	Clock clock;
+
+	for ( size_t i = 0; i < PollerConnections; i++ ) {
+		std::unique_ptr<TcpSocket> client( new TcpSocket() );
+		std::unique_ptr<TcpSocket> server( new TcpSocket() );
+
+		if ( client->connect( IpAddress::LocalHost, listener.getLocalPort() ) != Socket::Done ||
+			 listener.accept( *server ) != Socket::Done )
+			break;
+
+		poller.add( *server, SocketPoller::Read, (void*)i );
+		clients.emplace_back( std::move( client ) );
+		servers.emplace_back( std::move( server ) );
+	}
+
+	CHECK_EQ( servers.size(), PollerConnections );
+
+	std::cout << "\t" << servers.size() << " connections, "
+			  << ( poller.getMode() == SocketPoller::EdgeTriggered ? "edge" : "level" )
+			  << "-triggered: connected in " << clock.getElapsedTime().asMilliseconds() << " ms"
+			  << std::endl;
+
+	if ( servers.empty() )
+		return;
+
+	const size_t samples = 10000;
+	std::vector<Int64> latencies;
+	size_t misses = 0;
+	char byte = 0;
+	size_t received;
+
+	for ( size_t i = 0; i < samples; i++ ) {
+		size_t index = ( i * 7919 ) % servers.size();
+
+		clock.restart();
+		clients[index]->send( &byte, 1 );
+		poller.wait( Seconds( 1 ) );
+		latencies.push_back( clock.getElapsedTime().asMicroseconds() );
+
+		if ( poller.getEvents().size() != 1 || poller.getEvents()[0].userData != (void*)index )
+			misses++;
+
+		servers[index]->receive( &byte, 1, received );
+	}
+
+	std::sort( latencies.begin(), latencies.end() );
+
+	Int64 total = 0;
+	for ( const auto& latency : latencies )
+		total += latency;
+
+	std::cout << "\twake-up latency: " << total / (Int64)samples << " us average, "
+			  << latencies[samples / 2] << " us median, " << latencies[samples * 99 / 100]
+			  << " us p99, " << latencies.back() << " us max" << std::endl;
+
+	// Every send wakes up the poller with the socket that received it, and only with it.
+	CHECK_EQ( misses, 0u );
+
+	for ( size_t i = 0; i < servers.size(); i++ )
+		poller.setTimeout( *servers[i], Milliseconds( 100 ) );
+
+	size_t timeouts = 0;
+	clock.restart();
+
+	while ( timeouts < servers.size() && clock.getElapsedTime() < Seconds( 5 ) ) {
+		poller.wait( Seconds( 1 ) );
+		timeouts += poller.getEvents().size();
+	}
+
+	std::cout << "\t" << timeouts << " timeouts of 100 ms expired in "
+			  << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+
+	CHECK_EQ( timeouts, servers.size() );
+}
+
+// Sends small state-sync packets over loopback TCP, one send per packet and coalesced by the send
+// queue, and over UDP, one datagram per send and in batches. Every send call maps to a single
+// system call on blocking sockets, so the syscalls per message are counted from the calls.
+static const size_t PacketMessages = 200000;
+static const size_t PacketBatchSize = 64;
+
+static void fillStatePacket( Packet& packet, Uint32 id ) {
+	packet << id << 1.f << 2.f << 3.f << 0.5f << 0.25f << (Uint8)1;
+}
+
+TEST_CASE( packet_io_benchmark ) {
+	PacketPool pool;
+
+	for ( int coalesce = 0; coalesce < 2; coalesce++ ) {
+		TcpListener listener;
+		TcpSocket client;
+		TcpSocket server;
+
+		if ( listener.listen( Socket::AnyPort, IpAddress::LocalHost ) != Socket::Done ||
+			 client.connect( IpAddress::LocalHost, listener.getLocalPort() ) != Socket::Done ||
+			 listener.accept( server ) != Socket::Done )
+			return;
+
+		size_t receivedCount = 0;
+		Thread receiver( [&] {
+			Packet* packet = pool.acquire();
+
+			while ( receivedCount < PacketMessages && server.receive( *packet ) == Socket::Done )
+				receivedCount++;
+
+			pool.release( packet );
+		} );
+
+		Clock clock;
+		size_t calls = 0;
+		Packet* packet = pool.acquire();
+		receiver.launch();
+
+		for ( size_t i = 0; i < PacketMessages; i++ ) {
+			packet->clear();
+			fillStatePacket( *packet, i );
+
+			if ( coalesce ) {
+				client.queue( *packet );
+
+				if ( ( i + 1 ) % PacketBatchSize == 0 || i + 1 == PacketMessages ) {
+					client.flush();
+					calls++;
+				}
+			} else {
+				client.send( *packet );
+				calls++;
+			}
+		}
+
+		receiver.wait();
+		pool.release( packet );
+
+		Float seconds = clock.getElapsedTime().asSeconds();
+		std::cout << "\tTCP " << ( coalesce ? "send queue" : "send per packet" ) << ": "
+				  << (Uint64)( receivedCount / seconds ) << " messages/s, "
+				  << (Float)calls / PacketMessages << " send syscalls/message" << std::endl;
+
+		CHECK_EQ( receivedCount, PacketMessages );
+	}
+
+	// UDP sends a batch and then drains it, so no datagram is dropped by a full receive buffer.
+	for ( int batched = 0; batched < 2; batched++ ) {
+		UdpSocket sender;
+		UdpSocket receiver;
+
+		if ( receiver.bind( Socket::AnyPort, IpAddress::LocalHost ) != Socket::Done )
+			return;
+
+		receiver.setReceiveTimeout( 0, Milliseconds( 200 ) );
+
+		std::vector<UdpSocket::Datagram> outgoing( PacketBatchSize );
+		std::vector<UdpSocket::Datagram> incoming( PacketBatchSize );
+
+		for ( size_t b = 0; b < PacketBatchSize; b++ ) {
+			outgoing[b].packet = pool.acquire();
+			outgoing[b].remoteAddress = IpAddress::LocalHost;
+			outgoing[b].remotePort = receiver.getLocalPort();
+			incoming[b].packet = pool.acquire();
+		}
+
+		size_t sendCalls = 0;
+		size_t receiveCalls = 0;
+		size_t receivedCount = 0;
+		Clock clock;
+
+		for ( size_t i = 0; i < PacketMessages; i += PacketBatchSize ) {
+			size_t count = eemin( PacketBatchSize, PacketMessages - i );
+			size_t pending = count;
+			std::size_t done;
+
+			for ( size_t b = 0; b < count; b++ ) {
+				outgoing[b].packet->clear();
+				fillStatePacket( *outgoing[b].packet, i + b );
+			}
+
+			if ( batched ) {
+				sender.send( outgoing.data(), count, done );
+				sendCalls++;
+			} else {
+				for ( size_t b = 0; b < count; b++, sendCalls++ )
+					sender.send( *outgoing[b].packet, outgoing[b].remoteAddress,
+								 outgoing[b].remotePort );
+			}
+
+			while ( pending > 0 ) {
+				Socket::Status status =
+					batched ? receiver.receive( incoming.data(), pending, done )
+							: receiver.receive( *incoming[0].packet, incoming[0].remoteAddress,
+												incoming[0].remotePort );
+				receiveCalls++;
+
+				if ( status != Socket::Done )
+					break;
+
+				done = batched ? done : 1;
+				pending -= done;
+				receivedCount += done;
+			}
+		}
+
+		Float seconds = clock.getElapsedTime().asSeconds();
+
+		for ( size_t b = 0; b < PacketBatchSize; b++ ) {
+			pool.release( outgoing[b].packet );
+			pool.release( incoming[b].packet );
+		}
+
+		std::cout << "\tUDP " << ( batched ? "batched" : "one datagram per call" ) << ": "
+				  << (Uint64)( receivedCount / seconds ) << " messages/s, "
+				  << (Float)( sendCalls + receiveCalls ) / PacketMessages << " syscalls/message"
+				  << std::endl;
+
+		CHECK_EQ( receivedCount, PacketMessages );
+	}
+}
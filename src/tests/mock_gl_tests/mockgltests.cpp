@@ -0,0 +1,201 @@
+// GLEW must be included before any other GL header.
+#include <eepp/graphics/renderer/openglext.hpp>
+
+#include "../unit_tests/unittest.hpp"
+#include <cstring>
+
+// The GL entry points loaded by GLEW are function pointers, so the tests replace them with mocks
+// that count the calls and run without a GL context. Core GL 1.1 functions like glBlendFunc aren't
+// loaded by GLEW, the state filtered for them is checked with the frame stats of a null renderer.
+#ifdef EE_GLEW_AVAILABLE
+
+struct MockGLCalls {
+	int uniforms;
+	int useProgram;
+	int uniformLocations;
+	GLuint program;
+};
+
+static MockGLCalls sCalls;
+
+static const char* sActiveUniforms[] = {"uColor", "uMatrix", "uPlanes[0]"};
+
+static void GLAPIENTRY mock_glUniform1i( GLint, GLint ) {
+	sCalls.uniforms++;
+}
+
+static void GLAPIENTRY mock_glUniform1f( GLint, GLfloat ) {
+	sCalls.uniforms++;
+}
+
+static void GLAPIENTRY mock_glUniform4f( GLint, GLfloat, GLfloat, GLfloat, GLfloat ) {
+	sCalls.uniforms++;
+}
+
+static void GLAPIENTRY mock_glUniformMatrix4fv( GLint, GLsizei, GLboolean, const GLfloat* ) {
+	sCalls.uniforms++;
+}
+
+static void GLAPIENTRY mock_glUseProgram( GLuint program ) {
+	sCalls.useProgram++;
+	sCalls.program = program;
+}
+
+// Every program gets the same handle, as GL does when it reuses the handle of a deleted one.
+static GLuint GLAPIENTRY mock_glCreateProgram() {
+	return 7;
+}
+
+static void GLAPIENTRY mock_glDeleteProgram( GLuint ) {}
+
+static void GLAPIENTRY mock_glLinkProgram( GLuint ) {}
+
+static void GLAPIENTRY mock_glGetProgramiv( GLuint, GLenum name, GLint* value ) {
+	if ( name == GL_LINK_STATUS )
+		*value = GL_TRUE;
+	else if ( name == GL_ACTIVE_UNIFORMS )
+		*value = eeARRAY_SIZE( sActiveUniforms );
+	else if ( name == GL_ACTIVE_UNIFORM_MAX_LENGTH )
+		*value = 32;
+	else
+		*value = 0;
+}
+
+static void GLAPIENTRY mock_glGetActiveUniform( GLuint, GLuint index, GLsizei, GLsizei* length,
+												GLint* size, GLenum* type, GLchar* name ) {
+	strcpy( name, sActiveUniforms[index] );
+	*length = strlen( sActiveUniforms[index] );
+	*size = 1;
+	*type = GL_FLOAT;
+}
+
+static GLint GLAPIENTRY mock_glGetUniformLocation( GLuint, const GLchar* name ) {
+	sCalls.uniformLocations++;
+
+	for ( size_t i = 0; i < eeARRAY_SIZE( sActiveUniforms ); i++ )
+		if ( strcmp( name, sActiveUniforms[i] ) == 0 )
+			return i * 4;
+
+	return -1;
+}
+
+static void installMockGL() {
+	memset( &sCalls, 0, sizeof( sCalls ) );
+	glUniform1i = mock_glUniform1i;
+	glUniform1f = mock_glUniform1f;
+	glUniform4f = mock_glUniform4f;
+	glUniformMatrix4fv = mock_glUniformMatrix4fv;
+	glUseProgram = mock_glUseProgram;
+	glCreateProgram = mock_glCreateProgram;
+	glDeleteProgram = mock_glDeleteProgram;
+	glLinkProgram = mock_glLinkProgram;
+	glGetProgramiv = mock_glGetProgramiv;
+	glGetActiveUniform = mock_glGetActiveUniform;
+	glGetUniformLocation = mock_glGetUniformLocation;
+}
+
+// A GL renderer that reports every extension, so the programs use the mocked entry points.
+class MockGLRenderer : public RendererGL {
+  public:
+	MockGLRenderer() { mExtensions = 0xFFFFFFFF; }
+
+	void setNullRenderer( bool nullRenderer ) { mNullRenderer = nullRenderer; }
+};
+
+TEST_CASE( mockGLUniformLocations ) {
+	installMockGL();
+	MockGLRenderer* renderer = eeNew( MockGLRenderer, () );
+	ShaderProgram* program = ShaderProgram::New( std::vector<Shader*>(), "mock" );
+	CHECK( program->isValid() );
+
+	// The locations are read from the active uniforms when the program links, array uniforms are
+	// found by their base name too.
+	int lookups = sCalls.uniformLocations;
+	CHECK_EQ( program->getUniformLocation( "uColor" ), 0 );
+	CHECK_EQ( program->getUniformLocation( "uPlanes" ), 8 );
+	CHECK_EQ( program->getUniformLocation( "uPlanes[0]" ), 8 );
+	CHECK_EQ( sCalls.uniformLocations, lookups );
+	CHECK( !program->setUniform( "uMissing", 1.f ) );
+
+	eeSAFE_DELETE( program );
+	eeSAFE_DELETE( renderer );
+}
+
+TEST_CASE( mockGLFilteredUniforms ) {
+	installMockGL();
+	MockGLRenderer* renderer = eeNew( MockGLRenderer, () );
+	ShaderProgram* program = ShaderProgram::New( std::vector<Shader*>(), "mock" );
+	float matrix[16] = {1.f};
+
+	program->setUniform( "uColor", 1.f, 2.f, 3.f, 4.f );
+	program->setUniform( "uColor", 1.f, 2.f, 3.f, 4.f );
+	CHECK_EQ( sCalls.uniforms, 1 );
+
+	program->setUniform( "uColor", 1.f, 2.f, 3.f, 5.f );
+	CHECK_EQ( sCalls.uniforms, 2 );
+
+	program->setUniformMatrix( "uMatrix", matrix );
+	program->setUniformMatrix( "uMatrix", matrix );
+	CHECK_EQ( sCalls.uniforms, 3 );
+	CHECK_EQ( renderer->getFrameStats().uniformUploads, 3u );
+	CHECK_EQ( renderer->getFrameStats().filteredUniforms, 2u );
+
+	// The values are uploaded again once the copy is dropped.
+	program->invalidateUniforms();
+	program->setUniformMatrix( "uMatrix", matrix );
+	CHECK_EQ( sCalls.uniforms, 4 );
+
+	eeSAFE_DELETE( program );
+	eeSAFE_DELETE( renderer );
+}
+
+TEST_CASE( mockGLFilteredPrograms ) {
+	installMockGL();
+	MockGLRenderer* renderer = eeNew( MockGLRenderer, () );
+	ShaderProgram* program = ShaderProgram::New( std::vector<Shader*>(), "mock" );
+
+	program->bind();
+	program->bind();
+	CHECK_EQ( sCalls.useProgram, 1 );
+	CHECK_EQ( renderer->getFrameStats().filteredStateChanges, 1u );
+
+	program->unbind();
+	CHECK_EQ( sCalls.useProgram, 2 );
+	CHECK_EQ( sCalls.program, 0u );
+
+	program->bind();
+	CHECK_EQ( sCalls.useProgram, 3 );
+
+	// A new program with the handle of a deleted one must be bound again.
+	eeSAFE_DELETE( program );
+	program = ShaderProgram::New( std::vector<Shader*>(), "mock" );
+	program->bind();
+	CHECK_EQ( sCalls.useProgram, 4 );
+	CHECK_EQ( sCalls.program, 7u );
+
+	eeSAFE_DELETE( program );
+	eeSAFE_DELETE( renderer );
+}
+
+TEST_CASE( mockGLFilteredBlendFunc ) {
+	installMockGL();
+	MockGLRenderer* renderer = eeNew( MockGLRenderer, () );
+	renderer->setNullRenderer( true );
+
+	renderer->blendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+	renderer->blendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+	CHECK_EQ( renderer->getFrameStats().blendChanges, 1u );
+	CHECK_EQ( renderer->getFrameStats().filteredStateChanges, 1u );
+
+	renderer->blendFunc( GL_ONE, GL_ONE );
+	CHECK_EQ( renderer->getFrameStats().blendChanges, 2u );
+
+	// The state is sent again once the renderer forgets it.
+	renderer->invalidateStateCache();
+	renderer->blendFunc( GL_ONE, GL_ONE );
+	CHECK_EQ( renderer->getFrameStats().blendChanges, 3u );
+
+	eeSAFE_DELETE( renderer );
+}
+
+#endif
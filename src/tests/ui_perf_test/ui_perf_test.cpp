@@ -1,4 +1,14 @@
 #include <eepp/ee.hpp>
+#include <eepp/maps/gameobjectvirtual.hpp>
+#include <eepp/maps/tilemaplayer.hpp>
+
+#if defined( EE_PLATFORM_POSIX ) && EE_PLATFORM != EE_PLATFORM_EMSCRIPTEN && \
+	EE_PLATFORM != EE_PLATFORM_MACOSX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <random>
 
 using namespace EE::UI::Abstract;
 
@@ -103,6 +113,621 @@ class TestModel : public Model {
 
 EE::Window::Window* win = NULL;
 
+// Render cache benchmark, enabled with the --cached-panels argument.
+bool cachedPanelsBenchmark = false;
+std::vector<UIWidget*> cachedPanels;
+Clock benchmarkClock;
+Uint32 benchmarkFrames = 0;
+bool layoutBenchmark = false;
+bool actionsBenchmark = false;
+bool hoverBenchmark = false;
+bool invalidationBenchmark = false;
+// Texture memory budget in KiB, set with the --texture-budget=<KiB> argument.
+size_t textureBudget = 0;
+bool mapBenchmark = false;
+bool headless = false;
+
+void createCachedPanels( Node* parent ) {
+	UIGridLayout* grid = UIGridLayout::New();
+	grid->setColumnMode( UIGridLayout::Size )
+		->setRowMode( UIGridLayout::Size )
+		->setColumnWidth( 128 )
+		->setRowHeight( 96 );
+	grid->setLayoutSizePolicy( SizePolicy::MatchParent, SizePolicy::MatchParent );
+	grid->setParent( parent );
+
+	for ( int i = 0; i < 50; i++ ) {
+		UILinearLayout* panel = UILinearLayout::NewVertical();
+		panel->setLayoutSizePolicy( SizePolicy::MatchParent, SizePolicy::MatchParent );
+		panel->setBackgroundColor( Color( 0x33, 0x33, 0x33 ) );
+		panel->setParent( grid );
+
+		for ( int row = 0; row < 2; row++ )
+			UITextView::New()
+				->setText( String::format( "Panel %d - Row %d", i, row ) )
+				->setLayoutSizePolicy( SizePolicy::MatchParent, SizePolicy::WrapContent )
+				->setParent( panel );
+
+		UICheckBox::New()
+			->setText( "Checkbox" )
+			->setLayoutSizePolicy( SizePolicy::MatchParent, SizePolicy::WrapContent )
+			->setParent( panel );
+		UIPushButton::New()
+			->setText( "PushButton" )
+			->setLayoutSizePolicy( SizePolicy::MatchParent, SizePolicy::WrapContent )
+			->setParent( panel );
+
+		panel->setRenderCache( true );
+		cachedPanels.push_back( panel );
+	}
+}
+
+// Layout loading benchmark, enabled with the --layout-benchmark argument.
+// Compares loading a big layout from XML against loading it from its compiled form.
+void runLayoutBenchmark( UISceneNode* uiSceneNode ) {
+	std::string layout( "<vbox id='benchmark_root' layout_width='match_parent' "
+						"layout_height='match_parent' visible='false'>"
+						"<style>.bench_panel { padding: 2dp; } .bench_panel TextView { "
+						"color: #ccc; }</style>" );
+
+	for ( int i = 0; i < 500; i++ ) {
+		layout += String::format(
+			"<hbox class='bench_panel' layout_width='match_parent' layout_height='wrap_content' "
+			"margin='2dp 4dp'>"
+			"<TextView text='Panel %d' layout_width='wrap_content' layout_height='wrap_content' />"
+			"<CheckBox text='Check' layout_width='wrap_content' layout_height='wrap_content' />"
+			"<PushButton text='Button %d' layout_width='0' layout_weight='1' "
+			"layout_height='wrap_content' />"
+			"<ListBox layout_width='64dp' layout_height='32dp'><item>A</item><item>B</item>"
+			"</ListBox></hbox>",
+			i, i );
+	}
+
+	layout += "</vbox>";
+
+	const int iterations = 10;
+	Clock clock;
+
+	for ( int i = 0; i < iterations; i++ )
+		uiSceneNode->loadLayoutFromString( layout )->close();
+
+	Float xmlTime = clock.getElapsedTime().asMilliseconds() / iterations;
+
+	uiSceneNode->setLayoutCacheEnabled( true );
+	clock.restart();
+	uiSceneNode->loadLayoutFromString( layout )->close();
+	Float compileTime = clock.getElapsedTime().asMilliseconds();
+	clock.restart();
+
+	for ( int i = 0; i < iterations; i++ )
+		uiSceneNode->loadLayoutFromString( layout )->close();
+
+	Float compiledTime = clock.getElapsedTime().asMilliseconds() / iterations;
+	uiSceneNode->setLayoutCacheEnabled( false );
+
+	std::cout << "Layout load (" << layout.size() << " bytes): XML " << xmlTime
+			  << " ms, first compiled load " << compileTime << " ms, compiled " << compiledTime
+			  << " ms" << std::endl;
+}
+
+// Action manager benchmark, enabled with the --actions-benchmark argument.
+// Runs 100k simultaneous Move, Fade and Sequence actions over 10k nodes.
+void runActionsBenchmark( UISceneNode* uiSceneNode ) {
+	UIWidget* container = UIWidget::New();
+	container->setParent( uiSceneNode->getRoot() )->setVisible( false );
+
+	std::vector<UIWidget*> nodes;
+	ActionManager* actionManager = uiSceneNode->getActionManager();
+	Clock clock;
+
+	for ( int i = 0; i < 10000; i++ ) {
+		UIWidget* node = UIWidget::New();
+		node->setParent( container );
+		nodes.push_back( node );
+
+		for ( int a = 0; a < 10; a++ ) {
+			Time duration( Seconds( 1 + a % 3 ) );
+
+			switch ( a % 3 ) {
+				case 0:
+					node->runAction( Actions::Move::New( {0, 0}, {100, 100}, duration ) );
+					break;
+				case 1:
+					node->runAction( Actions::Fade::New( 255, 0, duration ) );
+					break;
+				default:
+					node->runAction( Actions::Sequence::New(
+						Actions::Move::New( {0, 0}, {50, 50}, duration ),
+						Actions::Fade::New( 0, 255, duration ) ) );
+					break;
+			}
+		}
+	}
+
+	Float addTime = clock.getElapsedTime().asMilliseconds();
+	size_t count = actionManager->count();
+	clock.restart();
+
+	for ( int i = 0; i < 60; i++ )
+		actionManager->update( Milliseconds( 16 ) );
+
+	Float updateTime = clock.getElapsedTime().asMilliseconds() / 60;
+	clock.restart();
+
+	for ( auto* node : nodes )
+		node->removeActionsByTag( 0 );
+
+	Float removeTime = clock.getElapsedTime().asMilliseconds();
+
+	std::cout << "Actions (" << count << "): add " << addTime << " ms, update " << updateTime
+			  << " ms/frame, remove " << removeTime << " ms" << std::endl;
+
+	container->close();
+}
+
+// Hover benchmark, enabled with the --hover-benchmark argument.
+// Resolves the node under the cursor over a grid of 20k widgets, with the cursor still, where the
+// event dispatcher skips the search, and with the cursor moving over the grid.
+void runHoverBenchmark( UISceneNode* uiSceneNode ) {
+	UIWidget* container = UIWidget::New();
+	container->setParent( uiSceneNode->getRoot() );
+	container->setPixelsSize( 1000, 500 );
+
+	for ( int i = 0; i < 20000; i++ ) {
+		UIWidget* widget = UIWidget::New();
+		widget->setParent( container );
+		widget->setPixelsPosition( i % 200 * 5, i / 200 * 5 );
+		widget->setPixelsSize( 4, 4 );
+	}
+
+	const int frames = 600;
+	Clock clock;
+	uiSceneNode->overFind( Vector2f( 1, 1 ) );
+	Float buildTime = clock.getElapsedTime().asMilliseconds();
+	EventDispatcher* eventDispatcher = uiSceneNode->getEventDispatcher();
+	clock.restart();
+
+	for ( int i = 0; i < frames; i++ )
+		eventDispatcher->update( Milliseconds( 16 ) );
+
+	Int64 idleTime = clock.getElapsedTime().asMicroseconds() / frames;
+	Uint64 hits = 0;
+	clock.restart();
+
+	for ( int i = 0; i < frames; i++ ) {
+		if ( uiSceneNode->overFind( Vector2f( i * 7 % 1000, i * 3 % 500 ) ) != container )
+			hits++;
+	}
+
+	Int64 movingTime = clock.getElapsedTime().asMicroseconds() / frames;
+
+	std::cout << "Hover (" << container->getChildCount() << " widgets): first search "
+			  << buildTime << " ms, idle " << idleTime << " us/frame, moving " << movingTime
+			  << " us/frame, " << hits << " widgets hit" << std::endl;
+
+	container->close();
+}
+
+// Invalidation benchmark, enabled with the --invalidation-benchmark argument.
+// Invalidates the style and the style state of 50k widgets in random order and flushes them.
+static void printInvalidationStats( const char* name, Float invalidateTime, Float flushTime,
+									const UISceneNode::InvalidationStats& stats ) {
+	std::cout << name << ": invalidate " << invalidateTime << " ms, flush " << flushTime
+			  << " ms, " << stats.requested << " requested, " << stats.queued << " queued, "
+			  << stats.processed << " processed" << std::endl;
+}
+
+void runInvalidationBenchmark( UISceneNode* uiSceneNode ) {
+	UIWidget* container = UIWidget::New();
+	container->setParent( uiSceneNode->getRoot() );
+	std::vector<UIWidget*> widgets;
+
+	for ( int i = 0; i < 20; i++ ) {
+		UIWidget* group = UIWidget::New();
+		group->setParent( container );
+		widgets.push_back( group );
+
+		for ( int j = 0; j < 50; j++ ) {
+			UIWidget* row = UIWidget::New();
+			row->setParent( group );
+			widgets.push_back( row );
+
+			for ( int k = 0; k < 49; k++ ) {
+				UIWidget* widget = UIWidget::New();
+				widget->setParent( row );
+				widgets.push_back( widget );
+			}
+		}
+	}
+
+	uiSceneNode->updateDirtyStyles();
+	uiSceneNode->updateDirtyStyleStates();
+	uiSceneNode->resetInvalidationStats();
+
+	std::shuffle( widgets.begin(), widgets.end(), std::mt19937( 1 ) );
+
+	Clock clock;
+	for ( auto& widget : widgets )
+		uiSceneNode->invalidateStyle( widget );
+	Float invalidateTime = clock.getElapsedTime().asMilliseconds();
+	clock.restart();
+	uiSceneNode->updateDirtyStyles();
+	printInvalidationStats( "Styles", invalidateTime, clock.getElapsedTime().asMilliseconds(),
+							uiSceneNode->getStyleInvalidationStats() );
+
+	clock.restart();
+	for ( auto& widget : widgets )
+		uiSceneNode->invalidateStyleState( widget );
+	invalidateTime = clock.getElapsedTime().asMilliseconds();
+	clock.restart();
+	uiSceneNode->updateDirtyStyleStates();
+	printInvalidationStats( "Style states", invalidateTime, clock.getElapsedTime().asMilliseconds(),
+							uiSceneNode->getStyleStateInvalidationStats() );
+
+	container->close();
+}
+
+// File reading benchmark, enabled with the --io-benchmark[=path] argument.
+// Reads a large file with the stdio stream, the mapped view and the read-ahead stream, cold (after
+// dropping the file from the page cache, where supported) and warm.
+static Uint64 sumBytes( const char* data, size_t size ) {
+	Uint64 sum = 0;
+	for ( size_t i = 0; i < size; i++ )
+		sum += (Uint8)data[i];
+	return sum;
+}
+
+static void dropFileCache( const std::string& path ) {
+#if defined( EE_PLATFORM_POSIX ) && EE_PLATFORM != EE_PLATFORM_EMSCRIPTEN && \
+	EE_PLATFORM != EE_PLATFORM_MACOSX
+	int fd = open( path.c_str(), O_RDONLY );
+	if ( -1 != fd ) {
+		posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED );
+		close( fd );
+	}
+#endif
+}
+
+static Uint64 readStream( IOStream& stream ) {
+	std::vector<char> buffer( EE_1MB );
+	Uint64 sum = 0;
+	ios_size count;
+	while ( ( count = stream.read( buffer.data(), buffer.size() ) ) > 0 )
+		sum += sumBytes( buffer.data(), count );
+	return sum;
+}
+
+void runIOBenchmark( std::string path ) {
+	bool temporary = path.empty();
+
+	if ( temporary ) {
+		path = Sys::getTempPath() + "eepp_io_benchmark.bin";
+		std::vector<Uint8> data( 128 * EE_1MB );
+		for ( size_t i = 0; i < data.size(); i++ )
+			data[i] = (Uint8)( i * 2654435761u >> 24 );
+		FileSystem::fileWrite( path, data );
+	}
+
+	std::vector<std::pair<std::string, std::function<Uint64()>>> readers = {
+		{ "IOStreamFile", [&]() {
+			 IOStreamFile stream( path );
+			 return readStream( stream );
+		 } },
+		{ "IOStreamMapped", [&]() {
+			 IOStreamMapped stream( path );
+			 return sumBytes( stream.getData(), stream.getSize() );
+		 } },
+		{ "IOStreamReadAhead", [&]() {
+			 IOStreamReadAhead stream( IOStreamFile::New( path ), true );
+			 return readStream( stream );
+		 } },
+		{ "FileSystem::fileGet", [&]() {
+			 ScopedBuffer buffer;
+			 FileSystem::fileGet( path, buffer );
+			 return sumBytes( (const char*)buffer.get(), buffer.length() );
+		 } } };
+
+	std::cout << "File read (" << FileSystem::fileSize( path ) << " bytes):" << std::endl;
+
+	for ( auto& reader : readers ) {
+		dropFileCache( path );
+		Clock clock;
+		Uint64 sum = reader.second();
+		Float cold = clock.getElapsedTime().asMilliseconds();
+		clock.restart();
+		reader.second();
+		Float warm = clock.getElapsedTime().asMilliseconds();
+		std::cout << "  " << reader.first << ": cold " << cold << " ms, warm " << warm
+				  << " ms (sum " << sum << ")" << std::endl;
+	}
+
+	if ( temporary )
+		FileSystem::fileRemove( path );
+}
+
+// Texture packer benchmark, enabled with the --texture-packer-benchmark[=count] argument.
+// Packs the same set of random sized images ( with transparent borders ) with every heuristic.
+void runTexturePackerBenchmark( size_t count ) {
+	std::vector<std::unique_ptr<Image>> images;
+	Uint32 seed = 1;
+	auto random = [&seed]( Uint32 max ) {
+		seed = seed * 1664525u + 1013904223u;
+		return ( seed >> 8 ) % max;
+	};
+
+	for ( size_t i = 0; i < count; i++ ) {
+		Uint32 width = 8 + random( 120 );
+		Uint32 height = 8 + random( 120 );
+		Uint32 border = random( 4 );
+		images.emplace_back( std::make_unique<Image>( width, height, 4 ) );
+		images.back()->fillWithColor( Color::Transparent );
+		for ( Uint32 y = border; y < height - border; y++ )
+			for ( Uint32 x = border; x < width - border; x++ )
+				images.back()->setPixel( x, y, Color::White );
+	}
+
+	std::vector<std::pair<std::string, TexturePacker::PackingHeuristic>> heuristics = {
+		{ "Guillotine", TexturePacker::PackingHeuristic::Guillotine },
+		{ "MaxRects BSSF", TexturePacker::PackingHeuristic::MaxRectsBestShortSideFit },
+		{ "MaxRects BLSF", TexturePacker::PackingHeuristic::MaxRectsBestLongSideFit },
+		{ "MaxRects BAF", TexturePacker::PackingHeuristic::MaxRectsBestAreaFit },
+		{ "MaxRects BL", TexturePacker::PackingHeuristic::MaxRectsBottomLeft },
+		{ "Skyline BL", TexturePacker::PackingHeuristic::SkylineBottomLeft } };
+
+	std::cout << "Texture packing (" << count << " images):" << std::endl;
+
+	for ( auto& heuristic : heuristics ) {
+		for ( bool trim : { false, true } ) {
+			TexturePacker packer( 4096, 4096, 1, true, false, 2 );
+			packer.setPackingHeuristic( heuristic.second );
+			packer.setTrimTransparentBorders( trim );
+			for ( size_t i = 0; i < images.size(); i++ )
+				packer.addImage( images[i].get(), String::toString( i ) );
+			Clock clock;
+			packer.packTextures();
+			std::cout << "  " << heuristic.first << ( trim ? " (trimmed): " : ": " )
+					  << clock.getElapsedTime().asMilliseconds() << " ms, " << packer.getWidth()
+					  << "x" << packer.getHeight() << ", occupancy "
+					  << packer.getOccupancy() * 100.f << "%" << std::endl;
+		}
+	}
+}
+
+// Writes a chunked map of size x size tiles with one tiled layer, the chunks repeat a few
+// patterns of tiles so the file is generated quickly.
+static void writeChunkedMap( const std::string& path, Uint32 size, Uint32 chunkSize ) {
+	const Uint32 patterns = 8;
+	Uint32 chunksPerSide = size / chunkSize;
+	Uint32 chunkCount = chunksPerSide * chunksPerSide;
+	std::vector<std::string> chunks( patterns );
+
+	for ( Uint32 p = 0; p < patterns; p++ ) {
+		std::vector<Uint16> tiles( chunkSize * chunkSize );
+		for ( size_t i = 0; i < tiles.size(); i++ )
+			tiles[i] = ( i * ( p + 1 ) / 7 + p ) % 3 == 0 ? 0 : 1 + ( i + p ) % 4;
+		IOStreamMemory src( (const char*)tiles.data(), tiles.size() * sizeof( Uint16 ) );
+		IOStreamString dst;
+		Compression::compress( dst, src );
+		chunks[p] = dst.getStream();
+	}
+
+	sMapHdr mapHdr;
+	memset( &mapHdr, 0, sizeof( sMapHdr ) );
+	mapHdr.Magic = EE_MAP_CHUNKED_MAGIC;
+	mapHdr.SizeX = mapHdr.SizeY = size;
+	mapHdr.TileSizeX = mapHdr.TileSizeY = 32;
+	mapHdr.MaxLayers = mapHdr.LayerCount = 1;
+	mapHdr.BaseColor = Color::White.getValue();
+
+	sLayerHdr layerHdr;
+	memset( &layerHdr, 0, sizeof( sLayerHdr ) );
+	layerHdr.Type = MAP_LAYER_TILED;
+	layerHdr.Flags = LAYER_FLAG_VISIBLE;
+
+	std::vector<sMapTileGOHdr> tileTypes( 4 );
+	for ( Uint32 i = 0; i < tileTypes.size(); i++ )
+		tileTypes[i] = { String::hash( "BenchmarkTile" ), i, 0 };
+
+	sMapChunkedHdr chunkedHdr;
+	chunkedHdr.Version = MAP_CHUNKED_VERSION;
+	chunkedHdr.ChunkSize = chunkSize;
+	chunkedHdr.ChunkCountX = chunkedHdr.ChunkCountY = chunksPerSide;
+	chunkedHdr.TileTypeCount = tileTypes.size();
+	chunkedHdr.IndexSize = sizeof( Uint16 );
+	chunkedHdr.TileTypesOffset = sizeof( sMapHdr ) + sizeof( sMapChunkedHdr ) + sizeof( sLayerHdr );
+	chunkedHdr.ChunkIndexOffset =
+		chunkedHdr.TileTypesOffset + sizeof( sMapTileGOHdr ) * tileTypes.size();
+
+	std::vector<sMapChunkHdr> index( chunkCount );
+	Uint64 offset = chunkedHdr.ChunkIndexOffset + sizeof( sMapChunkHdr ) * chunkCount;
+	for ( Uint32 i = 0; i < chunkCount; i++ ) {
+		const std::string& chunk = chunks[i % patterns];
+		index[i] = { offset, (Uint32)chunk.size(), MAP_CHUNK_FLAG_COMPRESSED };
+		offset += chunk.size();
+	}
+
+	IOStreamFile file( path, "wb" );
+	file.write( (const char*)&mapHdr, sizeof( sMapHdr ) );
+	file.write( (const char*)&chunkedHdr, sizeof( sMapChunkedHdr ) );
+	file.write( (const char*)&layerHdr, sizeof( sLayerHdr ) );
+	file.write( (const char*)tileTypes.data(), sizeof( sMapTileGOHdr ) * tileTypes.size() );
+	file.write( (const char*)index.data(), sizeof( sMapChunkHdr ) * chunkCount );
+	for ( Uint32 i = 0; i < chunkCount; i++ )
+		file.write( chunks[i % patterns].data(), chunks[i % patterns].size() );
+}
+
+// Map benchmark, enabled with the --map-benchmark argument.
+// Opens a streamed 16k x 16k map and pans over it, and compares the plain and chunked formats
+// loading a 1024 x 1024 map.
+void runMapBenchmark() {
+	std::string path( Sys::getTempPath() + "eepp_map_benchmark.eem" );
+	Clock clock;
+
+	writeChunkedMap( path, 16384, 64 );
+
+	std::cout << "Map streaming (16384x16384 tiles, " << FileSystem::fileSize( path )
+			  << " bytes, written in " << clock.getElapsedTime().asMilliseconds()
+			  << " ms):" << std::endl;
+
+	{
+		clock.restart();
+		TileMap map;
+		map.loadFromFile( path );
+		std::cout << "  open: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+
+		clock.restart();
+		map.waitForChunks();
+		std::cout << "  first view: " << clock.getElapsedTime().asMilliseconds() << " ms, "
+				  << map.getLoadedChunkCount() << " chunks loaded" << std::endl;
+
+		const int steps = 200;
+		Clock panClock;
+		for ( int i = 0; i < steps; i++ ) {
+			map.move( -256, -192 );
+			map.waitForChunks();
+		}
+		std::cout << "  pan " << steps << " views: "
+				  << panClock.getElapsedTime().asMilliseconds() / steps << " ms per view, "
+				  << map.getLoadedChunkCount() << " chunks loaded" << std::endl;
+	}
+
+	FileSystem::fileRemove( path );
+
+	std::string plainPath( Sys::getTempPath() + "eepp_map_benchmark_plain.eem" );
+	std::string chunkedPath( Sys::getTempPath() + "eepp_map_benchmark_chunked.eem" );
+
+	{
+		TileMap map;
+		map.create( Sizei( 1024, 1024 ), 1, Sizei( 32, 32 ), 0 );
+		TileMapLayer* layer =
+			static_cast<TileMapLayer*>( map.addLayer( MAP_LAYER_TILED, LAYER_FLAG_VISIBLE, "" ) );
+		for ( Int32 y = 0; y < 1024; y++ )
+			for ( Int32 x = 0; x < 1024; x++ )
+				if ( ( x + y ) % 3 )
+					layer->addGameObject( eeNew( GameObjectVirtual,
+												 ( ( x ^ y ) % 4, layer, 0,
+												   String::hash( "BenchmarkTile" ) ) ),
+										  Vector2i( x, y ) );
+		map.saveToFile( plainPath );
+		map.saveToFileChunked( chunkedPath );
+	}
+
+	std::cout << "Map loading (1024x1024 tiles):" << std::endl;
+
+	for ( const auto& file : { plainPath, chunkedPath } ) {
+		clock.restart();
+		TileMap map;
+		map.loadFromFile( file );
+		map.waitForChunks();
+		std::cout << "  " << ( map.isChunked() ? "chunked" : "plain" ) << " ("
+				  << FileSystem::fileSize( file ) << " bytes): "
+				  << clock.getElapsedTime().asMilliseconds() << " ms to the first view"
+				  << std::endl;
+		FileSystem::fileRemove( file );
+	}
+}
+
+// Transform benchmark, enabled with the --transform-benchmark argument.
+// Builds a 10k nodes tree, 20 nested containers with 500 children each, and animates the root and
+// a container in the middle. Each frame reads the world bounds of every node, as drawing and
+// hit-testing do, and counts the transform updates that it needed.
+static void readWorldBounds( Node* node, Float& sum ) {
+	sum += node->getWorldBounds().Left;
+
+	for ( Node* child = node->getFirstChild(); NULL != child; child = child->getNextNode() )
+		readWorldBounds( child, sum );
+}
+
+void runTransformBenchmark() {
+	Node* root = Node::New();
+	root->setSize( 1000, 1000 );
+	std::vector<Node*> containers;
+	Node* parent = root;
+	size_t count = 1;
+
+	for ( int level = 0; level < 20; level++ ) {
+		Node* container = Node::New();
+		container->setParent( parent );
+		container->setPosition( 2, 2 );
+		container->setSize( 500, 500 );
+		containers.push_back( container );
+		count++;
+
+		for ( int i = 0; i < 500; i++ ) {
+			Node* leaf = Node::New();
+			leaf->setParent( container );
+			leaf->setPosition( i % 50 * 10, i / 50 * 10 );
+			leaf->setSize( 8, 8 );
+			count++;
+		}
+
+		parent = container;
+	}
+
+	Float sum = 0;
+	readWorldBounds( root, sum );
+
+	auto run = [&]( const std::string& name, const std::function<void( int )>& animate ) {
+		const int frames = 60;
+		Uint64 updates = Node::getTransformUpdateCount();
+		Clock clock;
+
+		for ( int frame = 0; frame < frames; frame++ ) {
+			animate( frame );
+			readWorldBounds( root, sum );
+		}
+
+		std::cout << "Transforms (" << count << " nodes), " << name << ": "
+				  << ( Node::getTransformUpdateCount() - updates ) / frames << " updates/frame, "
+				  << clock.getElapsedTime().asMicroseconds() / frames << " us/frame" << std::endl;
+	};
+
+	run( "idle", []( int ) {} );
+	run( "move root", [&]( int frame ) { root->setPosition( frame + 1, 0 ); } );
+	run( "rotate root", [&]( int frame ) { root->setRotation( frame + 1 ); } );
+	root->setRotation( 0 );
+	run( "move middle container",
+		 [&]( int frame ) { containers[10]->setPosition( frame + 3, 2 ); } );
+
+	eeDelete( root );
+}
+
+// Text document search benchmark, enabled with the --text-replace-benchmark argument.
+// Searches and replaces 200k matches in a 100k lines document, and compares it with replacing
+// match by match.
+void runTextReplaceBenchmark() {
+	String text;
+	for ( int i = 0; i < 100000; i++ )
+		text += "Hello world, hello document\n";
+
+	TextDocument doc( false );
+	doc.insert( {0, 0}, text );
+
+	Clock clock;
+	size_t count = doc.findAll( "hello", false ).size();
+	std::cout << "Text find all (" << count
+			  << " matches): " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+
+	clock.restart();
+	count = doc.replaceAll( "hello", "bye", false );
+	Float replaceTime = clock.getElapsedTime().asMilliseconds();
+	clock.restart();
+	doc.undo();
+	std::cout << "Text replace all (" << count << " matches): " << replaceTime << " ms, undo "
+			  << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+
+	// Replacing one match at a time is too slow to run on the whole document.
+	TextDocument small( false );
+	small.insert( {0, 0}, text.substr( 0, text.size() / 100 ) );
+	TextPosition from;
+	count = 0;
+	clock.restart();
+	while ( ( from = small.replace( "hello", "bye", from, false ) ).isValid() )
+		count++;
+	std::cout << "Text replace one by one (" << count
+			  << " matches): " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+}
+
 void mainLoop() {
 	win->getInput()->update();
 
@@ -125,9 +750,54 @@ void mainLoop() {
 		uiSceneNode->setDrawDebugData( !uiSceneNode->getDrawDebugData() );
 	}
 
+	if ( win->getInput()->isKeyUp( KEY_F9 ) ) {
+		const RendererFrameStats& stats = GLi->getLastFrameStats();
+		std::cout << "Last frame: " << stats.drawCalls << " draw calls, " << stats.vertices
+				  << " vertices, " << stats.bytesUploaded << " bytes uploaded, "
+				  << stats.textureBinds << " texture binds, " << stats.shaderChanges
+				  << " shader changes, " << stats.stateChanges << " state changes" << std::endl;
+		std::cout << "Uniforms: " << stats.uniformUploads << " uploaded, "
+				  << stats.filteredUniforms << " filtered; " << stats.filteredStateChanges
+				  << " redundant state changes filtered" << std::endl;
+
+		const TextureCacheStats& texStats = TextureFactory::instance()->getCacheStats();
+		std::cout << "Textures: " << texStats.hits << " hits, " << texStats.misses << " misses, "
+				  << texStats.evictions << " evictions ( " << texStats.evictedBytes
+				  << " bytes ), " << texStats.reloads << " reloads, " << texStats.failedReloads
+				  << " failed reloads, " << texStats.placeholderBinds << " placeholder binds"
+				  << std::endl;
+	}
+
+	if ( cachedPanelsBenchmark && win->getInput()->isKeyUp( KEY_F10 ) ) {
+		bool enabled = !cachedPanels.front()->isRenderCached();
+
+		for ( auto* panel : cachedPanels )
+			panel->setRenderCache( enabled );
+
+		std::cout << "Render cache " << ( enabled ? "enabled" : "disabled" ) << std::endl;
+	}
+
 	// Update the UI scene.
 	SceneManager::instance()->update();
 
+	if ( cachedPanelsBenchmark ) {
+		// Redraw every frame and report the average frame time every 300 frames.
+		win->clear();
+		SceneManager::instance()->draw();
+		win->display();
+
+		if ( ++benchmarkFrames == 300 ) {
+			const RendererFrameStats& stats = GLi->getLastFrameStats();
+			std::cout << "Average frame time: "
+					  << benchmarkClock.getElapsedTime().asMilliseconds() / benchmarkFrames
+					  << " ms, " << stats.drawCalls << " draw calls, " << stats.vertices
+					  << " vertices" << std::endl;
+			benchmarkFrames = 0;
+			benchmarkClock.restart();
+		}
+		return;
+	}
+
 	// Check if the UI has been invalidated ( needs redraw ).
 	if ( SceneManager::instance()->getUISceneNode()->invalidated() ) {
 		win->clear();
@@ -142,10 +812,57 @@ void mainLoop() {
 }
 
 EE_MAIN_FUNC int main( int argc, char* argv[] ) {
-	win = Engine::instance()->createWindow( WindowSettings( 1024, 768, "eepp - UI Perf Test" ),
-											ContextSettings( true ) );
+	for ( int i = 1; i < argc; i++ )
+		if ( std::string( argv[i] ) == "--cached-panels" )
+			cachedPanelsBenchmark = true;
+		else if ( std::string( argv[i] ) == "--layout-benchmark" )
+			layoutBenchmark = true;
+		else if ( std::string( argv[i] ) == "--actions-benchmark" )
+			actionsBenchmark = true;
+		else if ( std::string( argv[i] ) == "--hover-benchmark" )
+			hoverBenchmark = true;
+		else if ( std::string( argv[i] ) == "--invalidation-benchmark" )
+			invalidationBenchmark = true;
+		else if ( String::startsWith( std::string( argv[i] ), "--io-benchmark" ) ) {
+			std::string arg( argv[i] );
+			size_t pos = arg.find( '=' );
+			runIOBenchmark( pos != std::string::npos ? arg.substr( pos + 1 ) : "" );
+			return EXIT_SUCCESS;
+		} else if ( String::startsWith( std::string( argv[i] ), "--texture-packer-benchmark" ) ) {
+			std::string arg( argv[i] );
+			size_t pos = arg.find( '=' );
+			runTexturePackerBenchmark(
+				pos != std::string::npos ? std::strtoul( arg.c_str() + pos + 1, NULL, 10 ) : 1000 );
+			return EXIT_SUCCESS;
+		} else if ( std::string( argv[i] ) == "--transform-benchmark" ) {
+			runTransformBenchmark();
+			return EXIT_SUCCESS;
+		} else if ( std::string( argv[i] ) == "--text-replace-benchmark" ) {
+			runTextReplaceBenchmark();
+			return EXIT_SUCCESS;
+		} else if ( std::string( argv[i] ) == "--map-benchmark" ) {
+			mapBenchmark = true;
+		} else if ( std::string( argv[i] ) == "--headless" ) {
+			headless = true;
+		} else if ( String::startsWith( std::string( argv[i] ), "--texture-budget=" ) ) {
+			textureBudget = std::strtoul( argv[i] + strlen( "--texture-budget=" ), NULL, 10 );
+		}
+
+	win = Engine::instance()->createWindow(
+		WindowSettings( 1024, 768, "eepp - UI Perf Test", WindowStyle::Default,
+						headless ? WindowBackend::Null : WindowBackend::Default ),
+		ContextSettings( true ) );
 
 	if ( win->isOpen() ) {
+		if ( textureBudget > 0 )
+			TextureFactory::instance()->setMemoryBudget( textureBudget * 1024 );
+
+		if ( mapBenchmark ) {
+			runMapBenchmark();
+			Engine::destroySingleton();
+			return EXIT_SUCCESS;
+		}
+
 		FileSystem::changeWorkingDirectory( Sys::getProcessPath() );
 		PixelDensity::setPixelDensity(
 			Engine::instance()->getDisplayManager()->getDisplayIndex( 0 )->getPixelDensity() );
@@ -189,6 +906,21 @@ EE_MAIN_FUNC int main( int argc, char* argv[] ) {
 			->setDefaultFont( font )
 			->add( theme );
 
+		if ( cachedPanelsBenchmark )
+			createCachedPanels( uiSceneNode->getRoot() );
+
+		if ( layoutBenchmark )
+			runLayoutBenchmark( uiSceneNode );
+
+		if ( actionsBenchmark )
+			runActionsBenchmark( uiSceneNode );
+
+		if ( hoverBenchmark )
+			runHoverBenchmark( uiSceneNode );
+
+		if ( invalidationBenchmark )
+			runInvalidationBenchmark( uiSceneNode );
+
 		auto* vlay = UILinearLayout::NewVertical();
 		vlay->setLayoutSizePolicy( SizePolicy::MatchParent, SizePolicy::MatchParent );
 
@@ -0,0 +1,86 @@
+#include "httptestserver.hpp"
+
+// The stand-in server has two resources: one that is fresh for an hour, and one that must be
+// revalidated on every request and answers 304 when its ETag matches.
+struct HttpCacheServerStats {
+	std::atomic<Uint64> requests;
+	std::atomic<Uint64> bodyBytesSent;
+	std::atomic<Uint64> notModified;
+};
+
+static void serveHttp( TcpSocket& socket, const std::string& request, const std::string& body,
+					   HttpCacheServerStats& stats ) {
+	stats.requests++;
+
+	std::string path( request.substr( 4, request.find( ' ', 4 ) - 4 ) );
+	bool revalidate = path == "/dynamic";
+	std::string etag( revalidate ? "\"dynamic-1\"" : "\"static-1\"" );
+	std::string response;
+
+	if ( revalidate &&
+		 String::toLower( request ).find( "if-none-match: " + etag ) != std::string::npos ) {
+		response = "HTTP/1.1 304 Not Modified\r\nETag: " + etag +
+				   "\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n";
+		stats.notModified++;
+	} else {
+		response = "HTTP/1.1 200 OK\r\nETag: " + etag + "\r\nCache-Control: " +
+				   ( revalidate ? "no-cache" : "max-age=3600" ) +
+				   "\r\nContent-Length: " + String::toString( body.size() ) +
+				   "\r\nConnection: close\r\n\r\n" + body;
+		stats.bodyBytesSent += body.size();
+	}
+
+	socket.send( response.c_str(), response.size() );
+}
+
+static bool fetch( Http& http, const std::string& path, const std::string& body ) {
+	Http::Response response = http.sendRequest( Http::Request( path ) );
+	return response.getStatus() == Http::Response::Ok && response.getBody() == body;
+}
+
+TEST_CASE( httpCacheRevalidation ) {
+	const std::string body( 256 * 1024, 'x' );
+	HttpCacheServerStats stats;
+	stats.requests = 0;
+	stats.bodyBytesSent = 0;
+	stats.notModified = 0;
+	UnitTest::HttpTestServer server( [&]( TcpSocket& socket, const std::string& request ) {
+		serveHttp( socket, request, body, stats );
+	} );
+	CHECK( server.isListening() );
+
+	Http http( "localhost", server.getPort() );
+
+	// Without a cache every request downloads the body again.
+	CHECK( fetch( http, "/dynamic", body ) );
+	CHECK( fetch( http, "/dynamic", body ) );
+	CHECK_EQ( stats.bodyBytesSent, body.size() * 2 );
+	CHECK_EQ( stats.notModified, 0u );
+
+	HttpCache cache( UnitTest::tempPath( "http-cache" ) );
+	cache.clear();
+	Http::setCache( &cache );
+
+	// A resource that must be revalidated is downloaded once, and then answered with a 304 that
+	// sends no body.
+	stats.bodyBytesSent = 0;
+	CHECK( fetch( http, "/dynamic", body ) );
+	CHECK_EQ( stats.bodyBytesSent, body.size() );
+	CHECK( fetch( http, "/dynamic", body ) );
+	CHECK_EQ( stats.notModified, 1u );
+	CHECK_EQ( stats.bodyBytesSent, body.size() );
+
+	HttpCache::Stats cacheStats = cache.getStats();
+	CHECK_EQ( cacheStats.revalidations, 1u );
+	CHECK_EQ( cacheStats.bytesSaved, body.size() );
+
+	// A fresh resource is served from the cache without any request.
+	CHECK( fetch( http, "/static", body ) );
+	Uint64 requests = stats.requests;
+	CHECK( fetch( http, "/static", body ) );
+	CHECK_EQ( stats.requests, requests );
+	CHECK_EQ( cache.getStats().hits, 1u );
+
+	Http::setCache( NULL );
+	cache.clear();
+}
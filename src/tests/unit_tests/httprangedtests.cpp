@@ -0,0 +1,210 @@
+#include "httptestserver.hpp"
+
+// Local stand-in HTTP server that paces every response, so a download can be cancelled in the
+// middle. "/file" accepts ranges and has an ETag, "/novalidator" accepts ranges without an ETag
+// or Last-Modified, and "/norange" doesn't accept ranges.
+class RangedTestServer {
+  public:
+	std::atomic<Uint64> bodyBytesSent;
+	std::atomic<Uint64> requests;
+
+	explicit RangedTestServer( const std::string& body ) :
+		bodyBytesSent( 0 ),
+		requests( 0 ),
+		mBody( body ),
+		mServer( [this]( TcpSocket& socket, const std::string& request ) {
+			serveRequest( socket, request );
+		} ) {}
+
+	bool isListening() const { return mServer.isListening(); }
+
+	unsigned short getPort() const { return mServer.getPort(); }
+
+  protected:
+	std::string mBody;
+	// The last member, so it stops serving before the rest is destroyed.
+	UnitTest::HttpTestServer mServer;
+
+	void serveRequest( TcpSocket& socket, const std::string& request ) {
+		requests++;
+
+		std::string lower( String::toLower( request ) );
+		bool head = String::startsWith( request, "HEAD " );
+		bool ranges = lower.find( " /norange " ) == std::string::npos;
+		bool validator = lower.find( " /novalidator " ) == std::string::npos;
+		Uint64 start = 0, end = mBody.size() - 1;
+		size_t rangePos = lower.find( "range: bytes=" );
+		bool partial = false;
+
+		if ( ranges && rangePos != std::string::npos ) {
+			unsigned long long from, to;
+
+			if ( sscanf( lower.c_str() + rangePos, "range: bytes=%llu-%llu", &from, &to ) == 2 &&
+				 from <= to && to < mBody.size() ) {
+				start = from;
+				end = to;
+				partial = true;
+			}
+		}
+
+		std::string response( partial ? "HTTP/1.1 206 Partial Content\r\n"
+									  : "HTTP/1.1 200 OK\r\n" );
+		response += "Content-Length: " + String::toString( end - start + 1 ) + "\r\n";
+		response += "Connection: close\r\n";
+
+		if ( validator )
+			response += "ETag: \"ranged-1\"\r\n";
+
+		if ( ranges )
+			response += "Accept-Ranges: bytes\r\n";
+
+		if ( partial )
+			response += String::format( "Content-Range: bytes %llu-%llu/%llu\r\n",
+										(unsigned long long)start, (unsigned long long)end,
+										(unsigned long long)mBody.size() );
+
+		response += "\r\n";
+
+		if ( socket.send( response.c_str(), response.size() ) != Socket::Done || head )
+			return;
+
+		const Uint64 chunk = 64 * 1024;
+
+		for ( Uint64 pos = start; pos <= end && mServer.isRunning(); pos += chunk ) {
+			Uint64 length = eemin<Uint64>( chunk, end + 1 - pos );
+
+			if ( socket.send( mBody.c_str() + pos, length ) != Socket::Done )
+				break;
+
+			bodyBytesSent += length;
+			Sys::sleep( Milliseconds( 5 ) );
+		}
+	}
+};
+
+static std::string makeRangedBody() {
+	std::string body( 4 * 1024 * 1024, '\0' );
+	Uint32 seed = 1;
+
+	for ( auto& c : body ) {
+		seed = seed * 1664525 + 1013904223;
+		c = (char)( seed >> 24 );
+	}
+
+	return body;
+}
+
+static Http::RangedDownloadOptions makeRangedOptions( const std::string& body ) {
+	Http::RangedDownloadOptions options;
+	options.connections = 4;
+	options.md5 = MD5::fromString( body ).toHexString();
+	return options;
+}
+
+// Downloads until half of the file is received, the progress is kept in the state file.
+static Http::Response downloadHalf( Http& http, const std::string& uri, const std::string& path,
+									const Http::RangedDownloadOptions& options, Uint64 size ) {
+	Http::Request request( uri );
+	request.setProgressCallback( [size]( const Http&, const Http::Request&, const Http::Response&,
+										 const Http::Request::Status&, std::size_t,
+										 std::size_t currentBytes ) {
+		return currentBytes < size / 2;
+	} );
+	return http.downloadRangedRequest( request, path, options );
+}
+
+TEST_CASE( httpRangedDownload ) {
+	const std::string body( makeRangedBody() );
+	RangedTestServer server( body );
+
+	CHECK( server.isListening() );
+
+	std::string path( UnitTest::tempPath( "ranged-download" ) );
+	Http::RangedDownloadOptions options( makeRangedOptions( body ) );
+	Http http( "localhost", server.getPort() );
+	FileSystem::fileRemove( path );
+
+	Http::Response response = http.downloadRangedRequest( Http::Request( "/file" ), path, options );
+	CHECK_EQ( response.getStatus(), Http::Response::Ok );
+	CHECK_EQ( MD5::fromFile( path ).toHexString(), options.md5 );
+	CHECK( !FileSystem::fileExists( path + ".download" ) );
+
+	// The HEAD probe and one request per part.
+	CHECK_EQ( server.requests, options.connections + 1 );
+	CHECK_EQ( server.bodyBytesSent, body.size() );
+
+	FileSystem::fileRemove( path );
+}
+
+TEST_CASE( httpRangedDownloadResume ) {
+	const std::string body( makeRangedBody() );
+	RangedTestServer server( body );
+
+	CHECK( server.isListening() );
+
+	std::string path( UnitTest::tempPath( "ranged-download" ) );
+	Http::RangedDownloadOptions options( makeRangedOptions( body ) );
+	Http http( "localhost", server.getPort() );
+	FileSystem::fileRemove( path );
+
+	Http::Response partial = downloadHalf( http, "/file", path, options, body.size() );
+	CHECK( partial.getStatus() != Http::Response::Ok );
+	CHECK( FileSystem::fileExists( path + ".download" ) );
+
+	// Only the parts that were not received are downloaded again.
+	Uint64 sent = server.bodyBytesSent;
+	Http::Response response = http.downloadRangedRequest( Http::Request( "/file" ), path, options );
+	CHECK_EQ( response.getStatus(), Http::Response::Ok );
+	CHECK_EQ( MD5::fromFile( path ).toHexString(), options.md5 );
+	CHECK( !FileSystem::fileExists( path + ".download" ) );
+	CHECK( server.bodyBytesSent - sent < body.size() );
+
+	FileSystem::fileRemove( path );
+}
+
+TEST_CASE( httpRangedDownloadWithoutValidator ) {
+	const std::string body( makeRangedBody() );
+	RangedTestServer server( body );
+
+	CHECK( server.isListening() );
+
+	std::string path( UnitTest::tempPath( "ranged-download" ) );
+	Http::RangedDownloadOptions options( makeRangedOptions( body ) );
+	Http http( "localhost", server.getPort() );
+	FileSystem::fileRemove( path );
+
+	Http::Response partial = downloadHalf( http, "/novalidator", path, options, body.size() );
+	CHECK( partial.getStatus() != Http::Response::Ok );
+
+	// Nothing tells that the remote file is the same, so the download starts over.
+	Uint64 sent = server.bodyBytesSent;
+	Http::Response response =
+		http.downloadRangedRequest( Http::Request( "/novalidator" ), path, options );
+	CHECK_EQ( response.getStatus(), Http::Response::Ok );
+	CHECK_EQ( MD5::fromFile( path ).toHexString(), options.md5 );
+	CHECK( server.bodyBytesSent - sent >= body.size() );
+
+	FileSystem::fileRemove( path );
+}
+
+TEST_CASE( httpRangedDownloadWithoutRanges ) {
+	const std::string body( makeRangedBody() );
+	RangedTestServer server( body );
+
+	CHECK( server.isListening() );
+
+	std::string path( UnitTest::tempPath( "ranged-download" ) );
+	Http::RangedDownloadOptions options( makeRangedOptions( body ) );
+	Http http( "localhost", server.getPort() );
+	FileSystem::fileRemove( path );
+
+	// The file is downloaded with a single stream after the HEAD probe.
+	Http::Response response =
+		http.downloadRangedRequest( Http::Request( "/norange" ), path, options );
+	CHECK_EQ( response.getStatus(), Http::Response::Ok );
+	CHECK_EQ( MD5::fromFile( path ).toHexString(), options.md5 );
+	CHECK_EQ( server.requests, 2u );
+	CHECK_EQ( server.bodyBytesSent, body.size() );
+
+	FileSystem::fileRemove( path );
+}
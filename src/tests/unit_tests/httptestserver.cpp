@@ -0,0 +1,63 @@
+#include "httptestserver.hpp"
+#include <list>
+
+namespace UnitTest {
+
+HttpTestServer::HttpTestServer( const RequestHandler& handler ) :
+	mHandler( handler ),
+	mRunning( true ),
+	mListening( mListener.listen( Socket::AnyPort, IpAddress::LocalHost ) == Socket::Done ),
+	mThread( [this] { serve(); } ) {
+	if ( mListening )
+		mThread.launch();
+}
+
+HttpTestServer::~HttpTestServer() {
+	if ( !mListening )
+		return;
+
+	// Wake up the server so it sees that it must stop.
+	mRunning = false;
+	TcpSocket wakeUp;
+	wakeUp.connect( IpAddress::LocalHost, mListener.getLocalPort() );
+	wakeUp.disconnect();
+	mThread.wait();
+}
+
+void HttpTestServer::serve() {
+	std::list<std::pair<Thread*, TcpSocket*>> connections;
+
+	while ( mRunning ) {
+		TcpSocket* socket = eeNew( TcpSocket, () );
+
+		if ( mListener.accept( *socket ) != Socket::Done || !mRunning ) {
+			eeDelete( socket );
+			break;
+		}
+
+		Thread* thread = eeNew( Thread, ( [this, socket] {
+			std::string request;
+			char buffer[4096];
+			std::size_t received;
+
+			while ( request.find( "\r\n\r\n" ) == std::string::npos &&
+					socket->receive( buffer, sizeof( buffer ), received ) == Socket::Done )
+				request.append( buffer, received );
+
+			if ( !request.empty() )
+				mHandler( *socket, request );
+
+			socket->disconnect();
+		} ) );
+		thread->launch();
+		connections.push_back( std::make_pair( thread, socket ) );
+	}
+
+	for ( auto& connection : connections ) {
+		connection.first->wait();
+		eeDelete( connection.first );
+		eeDelete( connection.second );
+	}
+}
+
+} // namespace UnitTest
@@ -0,0 +1,40 @@
+#ifndef EE_HTTPTESTSERVER_HPP
+#define EE_HTTPTESTSERVER_HPP
+
+#include "unittest.hpp"
+#include <atomic>
+
+namespace UnitTest {
+
+/** Local stand-in HTTP server listening on a free port of the loopback address. Every connection
+ * is served in its own thread: the request headers are read and passed to the handler, which
+ * sends the response. The connection is closed after the handler returns. */
+class HttpTestServer {
+  public:
+	typedef std::function<void( TcpSocket& socket, const std::string& request )> RequestHandler;
+
+	explicit HttpTestServer( const RequestHandler& handler );
+
+	/** Stops accepting connections and waits until every connection is served. */
+	~HttpTestServer();
+
+	bool isListening() const { return mListening; }
+
+	/** False once the server is stopping, handlers that send in parts stop sending. */
+	bool isRunning() const { return mRunning; }
+
+	unsigned short getPort() const { return mListener.getLocalPort(); }
+
+  protected:
+	RequestHandler mHandler;
+	std::atomic<bool> mRunning;
+	TcpListener mListener;
+	bool mListening;
+	Thread mThread;
+
+	void serve();
+};
+
+} // namespace UnitTest
+
+#endif
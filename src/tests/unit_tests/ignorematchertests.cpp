@@ -0,0 +1,99 @@
+#include "unittest.hpp"
+#include "../../tools/codeeditor/ignorematcher.hpp"
+
+bool gitignore_glob_match( const std::string& text, const std::string& glob,
+						   bool caseInsensitive );
+
+// Exposes the parsed patterns, to match them one by one as the matcher did before the tables.
+class GitIgnoreMatcherTest : public GitIgnoreMatcher {
+  public:
+	explicit GitIgnoreMatcherTest( const std::string& rootPath ) : GitIgnoreMatcher( rootPath ) {}
+
+	// Every pattern in order, and a negation only counts when it's the pattern that follows the
+	// first match.
+	bool referenceMatch( const std::string& value ) const {
+		for ( size_t i = 0; i < mPatterns.size(); i++ ) {
+			if ( gitignore_glob_match( value, mPatterns[i].first, false ) )
+				return !( i + 1 < mPatterns.size() && mPatterns[i + 1].second &&
+						  gitignore_glob_match( value, mPatterns[i + 1].first, false ) );
+		}
+
+		return false;
+	}
+};
+
+static const char* IgnorePatterns[] = {
+	"build", "/build", "src/build", "/src/build", "build/", "*.o", "*.tar.gz", "*.", "*.log",
+	"!keep.o", "!/build", "!important.log", "doc/**/*.md", "**/tmp", "a?c", "[abc].txt",
+	"[!a]*.txt", "\\#file", "#comment", "*", "/", "node_modules", "/src/*.cpp", "src/", "./x",
+	"out", "!out", ".git", "tmp/", "a/b/c", "/a/b", "**/*.o", "!src/*.o", "main.o\r", "  ",
+	"*.tmp ",
+};
+
+static const char* IgnorePaths[] = {
+	"build", "src/build", "./build", "/build", "lib/build", "main.o", "src/main.o", "keep.o",
+	"src/keep.o", "archive.tar.gz", "archive.gz", "file.", "debug.log", "important.log", "doc/x.md",
+	"doc/a/b.md", "tmp", "a/tmp", "a/tmp/b", "abc", "a/abc", "a.txt", "d.txt", "#file", ".git",
+	"src/main.cpp", "src/sub/main.cpp", "out", "x", "./x", "node_modules", "a/node_modules",
+	"a/b/c", "a/b", "x/a/b", "./src/build", ".hidden.o", "src", "", "a/b/c/d.o",
+};
+
+TEST_CASE( ignoreMatcherCorpus ) {
+	const size_t patternsCount = sizeof( IgnorePatterns ) / sizeof( IgnorePatterns[0] );
+	const size_t pathsCount = sizeof( IgnorePaths ) / sizeof( IgnorePaths[0] );
+	std::string directory( UnitTest::tempPath( "ignore-matcher/" ) );
+	FileSystem::makeDir( directory );
+
+	size_t checked = 0;
+	size_t mismatches = 0;
+	Uint32 seed = 1;
+
+	// Random .gitignore files built from the patterns, each path must get the same verdict from
+	// the compiled tables as from matching every pattern.
+	for ( int file = 0; file < 500; file++ ) {
+		std::string gitignore;
+		seed = seed * 1664525 + 1013904223;
+		size_t lines = 1 + ( seed >> 16 ) % 12;
+
+		for ( size_t line = 0; line < lines; line++ ) {
+			seed = seed * 1664525 + 1013904223;
+			gitignore += IgnorePatterns[( seed >> 16 ) % patternsCount];
+			gitignore += "\n";
+		}
+
+		FileSystem::fileWrite( directory + ".gitignore", (const Uint8*)gitignore.c_str(),
+							   gitignore.size() );
+
+		GitIgnoreMatcherTest matcher( directory );
+		CHECK( matcher.canMatch() );
+
+		for ( size_t i = 0; i < pathsCount; i++ ) {
+			if ( matcher.match( IgnorePaths[i] ) != matcher.referenceMatch( IgnorePaths[i] ) )
+				mismatches++;
+			checked++;
+		}
+	}
+
+	CHECK_EQ( checked, 500 * pathsCount );
+	CHECK_EQ( mismatches, 0u );
+
+	FileSystem::fileRemove( directory + ".gitignore" );
+}
+
+TEST_CASE( ignoreMatcherNegation ) {
+	std::string directory( UnitTest::tempPath( "ignore-matcher/" ) );
+	std::string gitignore( "*.o\n!keep.o\nbuild\n" );
+	FileSystem::makeDir( directory );
+	FileSystem::fileWrite( directory + ".gitignore", (const Uint8*)gitignore.c_str(),
+						   gitignore.size() );
+
+	IgnoreMatcherManager manager( directory );
+	CHECK( manager.foundMatch() );
+	CHECK( manager.match( "src/main.o" ) );
+	CHECK( !manager.match( "src/keep.o" ) );
+	CHECK( manager.match( "src/build" ) );
+	CHECK( manager.match( ".git" ) );
+	CHECK( !manager.match( "src/main.cpp" ) );
+
+	FileSystem::fileRemove( directory + ".gitignore" );
+}
@@ -0,0 +1,148 @@
+#include "unittest.hpp"
+#include <eepp/system/iostreamreadahead.hpp>
+
+// Writes a file of the given size with a pattern that differs on every chunk boundary.
+static std::string makeStreamFile( const std::string& name, size_t size ) {
+	std::string path( UnitTest::tempPath( name ) );
+	std::vector<Uint8> data( size );
+
+	for ( size_t i = 0; i < size; i++ )
+		data[i] = (Uint8)( i * 7 + i / 251 );
+
+	FileSystem::fileWrite( path, data.data(), (Uint32)data.size() );
+	return path;
+}
+
+static bool matchesFile( const char* data, size_t offset, size_t size ) {
+	for ( size_t i = 0; i < size; i++ ) {
+		size_t pos = offset + i;
+
+		if ( (Uint8)data[i] != (Uint8)( pos * 7 + pos / 251 ) )
+			return false;
+	}
+
+	return true;
+}
+
+TEST_CASE( iostreamMappedReads ) {
+	std::string path( makeStreamFile( "mapped", 10000 ) );
+	IOStreamMapped stream( path );
+	char buffer[4000];
+
+	CHECK( stream.isOpen() );
+	CHECK_EQ( stream.getSize(), 10000 );
+	CHECK( NULL != stream.getData() && matchesFile( stream.getData(), 0, 10000 ) );
+
+	CHECK_EQ( stream.read( buffer, sizeof( buffer ) ), 4000 );
+	CHECK( matchesFile( buffer, 0, 4000 ) );
+	CHECK_EQ( stream.tell(), 4000 );
+
+	// A read past the end returns what is left, and nothing once at the end.
+	stream.seek( 8000 );
+	CHECK_EQ( stream.read( buffer, sizeof( buffer ) ), 2000 );
+	CHECK( matchesFile( buffer, 8000, 2000 ) );
+	CHECK_EQ( stream.read( buffer, sizeof( buffer ) ), 0 );
+	CHECK_EQ( stream.tell(), 10000 );
+
+	// A seek past the end stops at the end.
+	CHECK_EQ( stream.seek( 20000 ), 10000 );
+	CHECK_EQ( stream.read( buffer, 1 ), 0 );
+
+	CHECK_EQ( stream.seek( 100 ), 100 );
+	CHECK_EQ( stream.read( buffer, 10 ), 10 );
+	CHECK( matchesFile( buffer, 100, 10 ) );
+
+	stream.close();
+	FileSystem::fileRemove( path );
+}
+
+TEST_CASE( iostreamMappedEmptyFile ) {
+	std::string path( makeStreamFile( "mapped-empty", 0 ) );
+	IOStreamMapped stream( path );
+	char buffer[16];
+
+	CHECK( stream.isOpen() );
+	CHECK_EQ( stream.getSize(), 0 );
+	CHECK( NULL == stream.getData() );
+	CHECK_EQ( stream.read( buffer, sizeof( buffer ) ), 0 );
+	CHECK_EQ( stream.seek( 10 ), 0 );
+
+	stream.close();
+	FileSystem::fileRemove( path );
+
+	IOStreamMapped missing( path );
+	CHECK( !missing.isOpen() );
+	CHECK( NULL == missing.getData() );
+	CHECK_EQ( missing.read( buffer, sizeof( buffer ) ), 0 );
+	CHECK_EQ( missing.tell(), -1 );
+}
+
+TEST_CASE( iostreamReadAheadReads ) {
+	std::string path( makeStreamFile( "read-ahead", 10000 ) );
+	IOStreamReadAhead* stream = IOStreamReadAhead::New( path, 1024, 2 );
+	char buffer[4000];
+	size_t total = 0;
+	ios_size count;
+
+	CHECK( stream->isOpen() );
+	CHECK_EQ( stream->getSize(), 10000 );
+
+	// Reads that don't line up with the chunks, the last one is short.
+	while ( ( count = stream->read( buffer, 700 ) ) > 0 ) {
+		CHECK( matchesFile( buffer, total, count ) );
+		total += count;
+	}
+
+	CHECK_EQ( total, 10000u );
+	CHECK_EQ( stream->tell(), 10000 );
+	CHECK_EQ( stream->read( buffer, sizeof( buffer ) ), 0 );
+
+	// Seeking back restarts the read-ahead from the new position.
+	CHECK_EQ( stream->seek( 100 ), 100 );
+	CHECK_EQ( stream->read( buffer, 3000 ), 3000 );
+	CHECK( matchesFile( buffer, 100, 3000 ) );
+
+	// A seek inside the current chunk, and one past the chunks read ahead.
+	CHECK_EQ( stream->seek( 3050 ), 3050 );
+	CHECK_EQ( stream->read( buffer, 100 ), 100 );
+	CHECK( matchesFile( buffer, 3050, 100 ) );
+	CHECK_EQ( stream->seek( 8500 ), 8500 );
+	CHECK_EQ( stream->read( buffer, sizeof( buffer ) ), 1500 );
+	CHECK( matchesFile( buffer, 8500, 1500 ) );
+
+	// A seek past the end stops at the end.
+	CHECK_EQ( stream->seek( 20000 ), 10000 );
+	CHECK_EQ( stream->read( buffer, 1 ), 0 );
+	CHECK_EQ( stream->seek( 0 ), 0 );
+	CHECK_EQ( stream->read( buffer, 10 ), 10 );
+	CHECK( matchesFile( buffer, 0, 10 ) );
+
+	eeSAFE_DELETE( stream );
+	FileSystem::fileRemove( path );
+}
+
+TEST_CASE( iostreamReadAheadSource ) {
+	std::string path( makeStreamFile( "read-ahead-source", 5000 ) );
+	char buffer[5000];
+
+	// The source stream is read from its current position.
+	IOStreamFile* file = IOStreamFile::New( path, "rb" );
+	file->seek( 1000 );
+	IOStreamReadAhead* stream = IOStreamReadAhead::New( file, true, 512, 1 );
+	CHECK_EQ( stream->tell(), 1000 );
+	CHECK_EQ( stream->read( buffer, sizeof( buffer ) ), 4000 );
+	CHECK( matchesFile( buffer, 1000, 4000 ) );
+	eeSAFE_DELETE( stream );
+
+	std::string emptyPath( makeStreamFile( "read-ahead-empty", 0 ) );
+	stream = IOStreamReadAhead::New( emptyPath );
+	CHECK( stream->isOpen() );
+	CHECK_EQ( stream->getSize(), 0 );
+	CHECK_EQ( stream->read( buffer, sizeof( buffer ) ), 0 );
+	CHECK_EQ( stream->seek( 10 ), 0 );
+	CHECK_EQ( stream->read( buffer, sizeof( buffer ) ), 0 );
+	eeSAFE_DELETE( stream );
+
+	FileSystem::fileRemove( path );
+	FileSystem::fileRemove( emptyPath );
+}
@@ -0,0 +1,279 @@
+#include "unittest.hpp"
+
+static std::vector<Uint8> makePackContent( size_t size, Uint32 seed ) {
+	std::vector<Uint8> data( size );
+
+	// Runs of repeated bytes, so deflate has something to compress.
+	for ( size_t i = 0; i < size; i++ ) {
+		if ( i % 16 == 0 )
+			seed = seed * 1664525 + 1013904223;
+		data[i] = (Uint8)( seed >> 24 );
+	}
+
+	return data;
+}
+
+static Uint32 packCrc32( const std::vector<Uint8>& data ) {
+	Uint32 crc = 0xFFFFFFFF;
+
+	for ( Uint8 byte : data ) {
+		crc ^= byte;
+
+		for ( int k = 0; k < 8; k++ )
+			crc = ( crc >> 1 ) ^ ( 0xEDB88320 & ( 0 - ( crc & 1 ) ) );
+	}
+
+	return ~crc;
+}
+
+static void writeLE16( std::vector<Uint8>& out, Uint16 value ) {
+	out.push_back( (Uint8)value );
+	out.push_back( (Uint8)( value >> 8 ) );
+}
+
+static void writeLE32( std::vector<Uint8>& out, Uint32 value ) {
+	writeLE16( out, (Uint16)value );
+	writeLE16( out, (Uint16)( value >> 16 ) );
+}
+
+typedef std::vector<std::pair<std::string, std::vector<Uint8>>> PackFiles;
+
+// Writes a zip file with every file stored uncompressed, libzip always deflates the files it adds.
+// The first byte of the corrupted file is changed after its CRC is computed.
+static void writeStoredZip( const std::string& path, const PackFiles& files,
+							const std::string& corrupted = "" ) {
+	std::vector<Uint8> zip;
+	std::vector<Uint8> directory;
+
+	for ( const auto& file : files ) {
+		Uint32 crc = packCrc32( file.second );
+		Uint32 offset = (Uint32)zip.size();
+		Uint32 size = (Uint32)file.second.size();
+
+		writeLE32( zip, 0x04034b50 );
+		writeLE16( zip, 20 );
+		writeLE16( zip, 0 );
+		writeLE16( zip, 0 ); // Stored
+		writeLE16( zip, 0 );
+		writeLE16( zip, 0x21 );
+		writeLE32( zip, crc );
+		writeLE32( zip, size );
+		writeLE32( zip, size );
+		writeLE16( zip, (Uint16)file.first.size() );
+		writeLE16( zip, 0 );
+		zip.insert( zip.end(), file.first.begin(), file.first.end() );
+		size_t data = zip.size();
+		zip.insert( zip.end(), file.second.begin(), file.second.end() );
+
+		if ( file.first == corrupted && size > 0 )
+			zip[data] ^= 0xFF;
+
+		writeLE32( directory, 0x02014b50 );
+		writeLE16( directory, 20 );
+		writeLE16( directory, 20 );
+		writeLE16( directory, 0 );
+		writeLE16( directory, 0 );
+		writeLE16( directory, 0 );
+		writeLE16( directory, 0x21 );
+		writeLE32( directory, crc );
+		writeLE32( directory, size );
+		writeLE32( directory, size );
+		writeLE16( directory, (Uint16)file.first.size() );
+		writeLE16( directory, 0 );
+		writeLE16( directory, 0 );
+		writeLE16( directory, 0 );
+		writeLE16( directory, 0 );
+		writeLE32( directory, 0 );
+		writeLE32( directory, offset );
+		directory.insert( directory.end(), file.first.begin(), file.first.end() );
+	}
+
+	Uint32 directoryOffset = (Uint32)zip.size();
+	zip.insert( zip.end(), directory.begin(), directory.end() );
+	writeLE32( zip, 0x06054b50 );
+	writeLE16( zip, 0 );
+	writeLE16( zip, 0 );
+	writeLE16( zip, (Uint16)files.size() );
+	writeLE16( zip, (Uint16)files.size() );
+	writeLE32( zip, (Uint32)directory.size() );
+	writeLE32( zip, directoryOffset );
+	writeLE16( zip, 0 );
+
+	FileSystem::fileWrite( path, zip );
+}
+
+static PackFiles makePackFiles() {
+	PackFiles files;
+	files.push_back( std::make_pair( "a.txt", makePackContent( 1000, 1 ) ) );
+	files.push_back( std::make_pair( "dir/b.bin", makePackContent( 70000, 2 ) ) );
+	files.push_back( std::make_pair( "dir/c.bin", makePackContent( 3, 3 ) ) );
+	return files;
+}
+
+static bool readStream( IOStream* stream, ios_size position, const std::vector<Uint8>& expected,
+						size_t size ) {
+	std::vector<Uint8> data( size );
+	return stream->seek( position ) == position &&
+		   stream->read( (char*)data.data(), size ) == (ios_size)size &&
+		   0 == memcmp( data.data(), expected.data() + position, size );
+}
+
+TEST_CASE( zipMappedStoredEntries ) {
+	std::string path( UnitTest::tempPath( "stored.zip" ) );
+	PackFiles files( makePackFiles() );
+	writeStoredZip( path, files );
+
+	Zip zip;
+	CHECK( zip.open( path ) );
+
+	// The entries are found by name in the index, in the order of the central directory.
+	for ( size_t i = 0; i < files.size(); i++ )
+		CHECK_EQ( zip.exists( files[i].first ), (Int32)i );
+	CHECK_EQ( zip.exists( "missing" ), -1 );
+	CHECK_EQ( zip.exists( "A.txt" ), -1 );
+	CHECK_EQ( zip.exists( "dir" ), -1 );
+
+	for ( const auto& file : files ) {
+		const Uint8* view = NULL;
+		size_t size = 0;
+		CHECK( zip.getFileView( file.first, view, size ) );
+		CHECK( size == file.second.size() && 0 == memcmp( view, file.second.data(), size ) );
+
+		std::vector<Uint8> data;
+		CHECK( zip.extractFileToMemory( file.first, data ) );
+		CHECK( data == file.second );
+
+		ScopedBuffer buffer;
+		CHECK( zip.extractFileToMemory( file.first, buffer ) );
+		CHECK( buffer.length() == file.second.size() &&
+			   0 == memcmp( buffer.get(), file.second.data(), buffer.length() ) );
+	}
+
+	const std::vector<Uint8>& big = files[1].second;
+	IOStream* stream = zip.getFileStream( "dir/b.bin" );
+	CHECK_EQ( stream->getSize(), (ios_size)big.size() );
+	CHECK( readStream( stream, 60000, big, 10000 ) );
+	CHECK( readStream( stream, 10, big, 5000 ) );
+	eeSAFE_DELETE( stream );
+
+	const Uint8* view = NULL;
+	size_t size = 0;
+	std::vector<Uint8> data;
+	CHECK( !zip.getFileView( "missing", view, size ) );
+	CHECK( !zip.extractFileToMemory( "missing", data ) );
+
+	zip.close();
+	FileSystem::fileRemove( path );
+}
+
+TEST_CASE( zipMappedCorruptedEntry ) {
+	std::string path( UnitTest::tempPath( "corrupted.zip" ) );
+	PackFiles files( makePackFiles() );
+	writeStoredZip( path, files, "dir/b.bin" );
+
+	Zip zip;
+	CHECK( zip.open( path ) );
+
+	// Reading the mapped entry checks its CRC, the zero-copy view is returned as it is stored.
+	std::vector<Uint8> data;
+	ScopedBuffer buffer;
+	CHECK( !zip.extractFileToMemory( "dir/b.bin", data ) );
+	CHECK( !zip.extractFileToMemory( "dir/b.bin", buffer ) );
+	CHECK( zip.extractFileToMemory( "a.txt", data ) );
+	CHECK( data == files[0].second );
+
+	const Uint8* view = NULL;
+	size_t size = 0;
+	CHECK( zip.getFileView( "dir/b.bin", view, size ) );
+	CHECK_EQ( size, files[1].second.size() );
+
+	zip.close();
+	FileSystem::fileRemove( path );
+}
+
+TEST_CASE( zipMappedDeflatedEntries ) {
+	std::string path( UnitTest::tempPath( "deflated.zip" ) );
+	std::vector<Uint8> small( makePackContent( 5000, 4 ) );
+	std::vector<Uint8> big( makePackContent( 3 * 1024 * 1024 + 100, 5 ) );
+	FileSystem::fileRemove( path );
+
+	Zip zip;
+	CHECK( zip.create( path ) );
+	CHECK( zip.addFile( small, "small.bin" ) );
+	CHECK( zip.addFile( big, "big.bin" ) );
+	CHECK( zip.exists( "small.bin" ) != -1 );
+	CHECK( zip.exists( "big.bin" ) != -1 );
+
+	std::vector<Uint8> data;
+	CHECK( zip.extractFileToMemory( "small.bin", data ) );
+	CHECK( data == small );
+	CHECK( zip.extractFileToMemory( "big.bin", data ) );
+	CHECK( data == big );
+
+	// Deflated entries have no zero-copy view.
+	const Uint8* view = NULL;
+	size_t size = 0;
+	CHECK( !zip.getFileView( "big.bin", view, size ) );
+
+	// Seeking back resumes the inflate from the checkpoints.
+	IOStream* stream = zip.getFileStream( "big.bin" );
+	CHECK_EQ( stream->getSize(), (ios_size)big.size() );
+	CHECK( readStream( stream, 2500000, big, 600000 ) );
+	CHECK( readStream( stream, 1500000, big, 1000 ) );
+	CHECK( readStream( stream, 10, big, 1000 ) );
+	CHECK( readStream( stream, 3 * 1024 * 1024, big, 100 ) );
+	eeSAFE_DELETE( stream );
+
+	zip.close();
+	FileSystem::fileRemove( path );
+}
+
+TEST_CASE( pakIndexedEntries ) {
+	std::string path( UnitTest::tempPath( "entries.pak" ) );
+	std::string dest( UnitTest::tempPath( "extracted.bin" ) );
+	PackFiles files( makePackFiles() );
+	FileSystem::fileRemove( path );
+
+	Pak pak;
+	CHECK( pak.create( path ) );
+
+	for ( auto& file : files )
+		CHECK( pak.addFile( file.second, file.first ) );
+
+	pak.close();
+	CHECK( pak.open( path ) );
+
+	for ( size_t i = 0; i < files.size(); i++ )
+		CHECK_EQ( pak.exists( files[i].first ), (Int32)i );
+	CHECK_EQ( pak.exists( "missing" ), -1 );
+	CHECK_EQ( pak.exists( "dir" ), -1 );
+
+	for ( const auto& file : files ) {
+		const Uint8* view = NULL;
+		size_t size = 0;
+		CHECK( pak.getFileView( file.first, view, size ) );
+		CHECK( size == file.second.size() && 0 == memcmp( view, file.second.data(), size ) );
+
+		std::vector<Uint8> data;
+		CHECK( pak.extractFileToMemory( file.first, data ) );
+		CHECK( data == file.second );
+	}
+
+	// The file is extracted to the destination path.
+	FileSystem::fileRemove( dest );
+	CHECK( pak.extractFile( "dir/b.bin", dest ) );
+	ScopedBuffer extracted;
+	CHECK( FileSystem::fileGet( dest, extracted ) );
+	CHECK( extracted.length() == files[1].second.size() &&
+		   0 == memcmp( extracted.get(), files[1].second.data(), extracted.length() ) );
+	CHECK( !pak.extractFile( "missing", dest ) );
+
+	IOStream* stream = pak.getFileStream( "dir/b.bin" );
+	CHECK( readStream( stream, 65000, files[1].second, 5000 ) );
+	CHECK( readStream( stream, 0, files[1].second, 100 ) );
+	eeSAFE_DELETE( stream );
+
+	pak.close();
+	FileSystem::fileRemove( path );
+	FileSystem::fileRemove( dest );
+}
@@ -0,0 +1,226 @@
+// The TLS backend headers go before the eepp namespaces, OpenSSL declares a global SSL type.
+#if defined( EE_MBEDTLS )
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/net.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
+#include <mbedtls/x509_crt.h>
+#elif defined( EE_OPENSSL )
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#endif
+
+#include "unittest.hpp"
+
+// The tests run a local TLS server built with the same backend as the library, with a self-signed
+// certificate generated at start.
+#if defined( EE_MBEDTLS ) || defined( EE_OPENSSL )
+// The server side is driven by the backend directly, on the socket handle.
+class TLSServerSocket : public TcpSocket {
+  public:
+	using TcpSocket::getHandle;
+};
+
+#if defined( EE_MBEDTLS )
+static void serveTLS( TcpListener& listener, size_t connections ) {
+	mbedtls_entropy_context entropy;
+	mbedtls_ctr_drbg_context drbg;
+	mbedtls_pk_context key;
+	mbedtls_x509_crt cert;
+	mbedtls_x509write_cert writer;
+	mbedtls_mpi serial;
+	mbedtls_ssl_config config;
+	mbedtls_ssl_cache_context cache;
+	mbedtls_ssl_ticket_context ticket;
+	unsigned char der[4096];
+
+	mbedtls_entropy_init( &entropy );
+	mbedtls_ctr_drbg_init( &drbg );
+	mbedtls_pk_init( &key );
+	mbedtls_x509_crt_init( &cert );
+	mbedtls_x509write_crt_init( &writer );
+	mbedtls_mpi_init( &serial );
+	mbedtls_ssl_config_init( &config );
+	mbedtls_ssl_cache_init( &cache );
+	mbedtls_ssl_ticket_init( &ticket );
+
+	mbedtls_ctr_drbg_seed( &drbg, mbedtls_entropy_func, &entropy, NULL, 0 );
+	mbedtls_pk_setup( &key, mbedtls_pk_info_from_type( MBEDTLS_PK_ECKEY ) );
+	mbedtls_ecp_gen_key( MBEDTLS_ECP_DP_SECP256R1, mbedtls_pk_ec( key ), mbedtls_ctr_drbg_random,
+						 &drbg );
+
+	mbedtls_mpi_lset( &serial, 1 );
+	mbedtls_x509write_crt_set_version( &writer, MBEDTLS_X509_CRT_VERSION_3 );
+	mbedtls_x509write_crt_set_md_alg( &writer, MBEDTLS_MD_SHA256 );
+	mbedtls_x509write_crt_set_subject_key( &writer, &key );
+	mbedtls_x509write_crt_set_issuer_key( &writer, &key );
+	mbedtls_x509write_crt_set_subject_name( &writer, "CN=localhost" );
+	mbedtls_x509write_crt_set_issuer_name( &writer, "CN=localhost" );
+	mbedtls_x509write_crt_set_serial( &writer, &serial );
+	mbedtls_x509write_crt_set_validity( &writer, "20200101000000", "20991231235959" );
+
+	// The certificate is written at the end of the buffer.
+	int size = mbedtls_x509write_crt_der( &writer, der, sizeof( der ), mbedtls_ctr_drbg_random,
+										  &drbg );
+
+	if ( size > 0 )
+		mbedtls_x509_crt_parse_der( &cert, der + sizeof( der ) - size, size );
+
+	mbedtls_ssl_config_defaults( &config, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+								 MBEDTLS_SSL_PRESET_DEFAULT );
+	mbedtls_ssl_conf_rng( &config, mbedtls_ctr_drbg_random, &drbg );
+	mbedtls_ssl_conf_own_cert( &config, &cert, &key );
+	mbedtls_ssl_conf_session_cache( &config, &cache, mbedtls_ssl_cache_get,
+									mbedtls_ssl_cache_set );
+	mbedtls_ssl_ticket_setup( &ticket, mbedtls_ctr_drbg_random, &drbg, MBEDTLS_CIPHER_AES_256_GCM,
+							  86400 );
+	mbedtls_ssl_conf_session_tickets_cb( &config, mbedtls_ssl_ticket_write,
+										 mbedtls_ssl_ticket_parse, &ticket );
+
+	for ( size_t i = 0; i < connections; i++ ) {
+		TLSServerSocket socket;
+
+		if ( listener.accept( socket ) != Socket::Done )
+			break;
+
+		mbedtls_net_context net;
+		mbedtls_ssl_context ssl;
+		int ret;
+
+		net.fd = (int)socket.getHandle();
+		mbedtls_ssl_init( &ssl );
+		mbedtls_ssl_setup( &ssl, &config );
+		mbedtls_ssl_set_bio( &ssl, &net, mbedtls_net_send, mbedtls_net_recv, NULL );
+
+		while ( ( ret = mbedtls_ssl_handshake( &ssl ) ) == MBEDTLS_ERR_SSL_WANT_READ ||
+				ret == MBEDTLS_ERR_SSL_WANT_WRITE )
+			;
+
+		if ( ret == 0 ) {
+			mbedtls_ssl_write( &ssl, (const unsigned char*)"k", 1 );
+			mbedtls_ssl_close_notify( &ssl );
+		}
+
+		mbedtls_ssl_free( &ssl );
+	}
+
+	mbedtls_ssl_ticket_free( &ticket );
+	mbedtls_ssl_cache_free( &cache );
+	mbedtls_ssl_config_free( &config );
+	mbedtls_mpi_free( &serial );
+	mbedtls_x509write_crt_free( &writer );
+	mbedtls_x509_crt_free( &cert );
+	mbedtls_pk_free( &key );
+	mbedtls_ctr_drbg_free( &drbg );
+	mbedtls_entropy_free( &entropy );
+}
+#elif defined( EE_OPENSSL )
+static void serveTLS( TcpListener& listener, size_t connections ) {
+	EVP_PKEY* key = NULL;
+	EVP_PKEY_CTX* keyCtx = EVP_PKEY_CTX_new_id( EVP_PKEY_EC, NULL );
+	EVP_PKEY_keygen_init( keyCtx );
+	EVP_PKEY_CTX_set_ec_paramgen_curve_nid( keyCtx, NID_X9_62_prime256v1 );
+	EVP_PKEY_keygen( keyCtx, &key );
+	EVP_PKEY_CTX_free( keyCtx );
+
+	X509* cert = X509_new();
+	X509_set_version( cert, 2 );
+	ASN1_INTEGER_set( X509_get_serialNumber( cert ), 1 );
+	X509_gmtime_adj( X509_get_notBefore( cert ), 0 );
+	X509_gmtime_adj( X509_get_notAfter( cert ), 86400 );
+	X509_set_pubkey( cert, key );
+	X509_NAME* name = X509_get_subject_name( cert );
+	X509_NAME_add_entry_by_txt( name, "CN", MBSTRING_ASC, (const unsigned char*)"localhost", -1,
+								-1, 0 );
+	X509_set_issuer_name( cert, name );
+	X509_sign( cert, key, EVP_sha256() );
+
+	// The server keeps its sessions in the default internal cache and issues session tickets.
+	SSL_CTX* ctx = SSL_CTX_new( SSLv23_server_method() );
+	SSL_CTX_use_certificate( ctx, cert );
+	SSL_CTX_use_PrivateKey( ctx, key );
+
+	for ( size_t i = 0; i < connections; i++ ) {
+		TLSServerSocket socket;
+
+		if ( listener.accept( socket ) != Socket::Done )
+			break;
+
+		::SSL* ssl = SSL_new( ctx );
+		SSL_set_fd( ssl, (int)socket.getHandle() );
+
+		if ( SSL_accept( ssl ) == 1 ) {
+			SSL_write( ssl, "k", 1 );
+			SSL_shutdown( ssl );
+		}
+
+		SSL_free( ssl );
+	}
+
+	SSL_CTX_free( ctx );
+	X509_free( cert );
+	EVP_PKEY_free( key );
+}
+#endif
+
+// Connects to the local server and reads the byte it answers after the handshake, so the session
+// tickets sent after the handshake are received too.
+static bool connectTLS( unsigned short port, bool& resumed ) {
+	SSLSocket socket( "localhost", false, false );
+	char byte;
+	std::size_t received;
+
+	bool connected = socket.connect( IpAddress::LocalHost, port ) == Socket::Done &&
+					 socket.receive( &byte, 1, received ) == Socket::Done;
+	resumed = socket.isSessionResumed();
+	socket.disconnect();
+
+	return connected;
+}
+
+TEST_CASE( sslSessionCacheResumption ) {
+	const size_t connections = 4;
+	TcpListener listener;
+
+	CHECK_EQ( listener.listen( Socket::AnyPort, IpAddress::LocalHost ), Socket::Done );
+
+	Thread server( [&] { serveTLS( listener, connections * 2 ); } );
+	server.launch();
+
+	SSLSessionCache* cache = SSLSessionCache::instance();
+	cache->clear();
+	cache->resetStats();
+
+	// The first connection negotiates the session that every following connection resumes.
+	for ( size_t i = 0; i < connections; i++ ) {
+		bool resumed;
+		CHECK( connectTLS( listener.getLocalPort(), resumed ) );
+		CHECK_EQ( resumed, i > 0 );
+	}
+
+	SSLHandshakeStats stats = cache->getStats();
+	CHECK_EQ( stats.fullHandshakes, 1u );
+	CHECK_EQ( stats.resumedHandshakes, connections - 1 );
+	CHECK_EQ( stats.failedHandshakes, 0u );
+
+	// Without the cache every connection does a full handshake.
+	cache->setEnabled( false );
+	cache->resetStats();
+
+	for ( size_t i = 0; i < connections; i++ ) {
+		bool resumed;
+		CHECK( connectTLS( listener.getLocalPort(), resumed ) );
+		CHECK( !resumed );
+	}
+
+	stats = cache->getStats();
+	CHECK_EQ( stats.fullHandshakes, connections );
+	CHECK_EQ( stats.resumedHandshakes, 0u );
+
+	cache->setEnabled( true );
+	cache->clear();
+	server.wait();
+}
+#endif
@@ -0,0 +1,80 @@
+#include "unittest.hpp"
+
+static bool connectPair( TcpListener& listener, TcpSocket& client, TcpSocket& server ) {
+	return listener.listen( Socket::AnyPort, IpAddress::LocalHost ) == Socket::Done &&
+		   client.connect( IpAddress::LocalHost, listener.getLocalPort() ) == Socket::Done &&
+		   listener.accept( server ) == Socket::Done;
+}
+
+// Sends only the size of a packet ( big endian ), as Packet framing does.
+static void sendFrameHeader( TcpSocket& socket, Uint32 size ) {
+	Uint8 header[4] = {(Uint8)( size >> 24 ), (Uint8)( size >> 16 ), (Uint8)( size >> 8 ),
+					   (Uint8)size};
+	socket.send( header, sizeof( header ) );
+}
+
+TEST_CASE( tcpSocketReceiveLargePacket ) {
+	TcpListener listener;
+	TcpSocket client;
+	TcpSocket server;
+
+	CHECK( connectPair( listener, client, server ) );
+
+	std::vector<Uint8> payload( 300 * 1024 );
+	for ( size_t i = 0; i < payload.size(); i++ )
+		payload[i] = (Uint8)( i * 31 );
+
+	Packet sent;
+	sent.append( payload.data(), payload.size() );
+
+	Thread sender( [&] { client.send( sent ); } );
+	sender.launch();
+
+	Packet received;
+	CHECK_EQ( server.receive( received ), Socket::Done );
+	CHECK_EQ( received.getDataSize(), payload.size() );
+	CHECK( received.getDataSize() == payload.size() &&
+		   0 == memcmp( received.getData(), payload.data(), payload.size() ) );
+
+	sender.wait();
+}
+
+TEST_CASE( tcpSocketReceiveTruncatedPacket ) {
+	TcpListener listener;
+	TcpSocket client;
+	TcpSocket server;
+
+	CHECK( connectPair( listener, client, server ) );
+
+	// A peer announcing a huge packet and closing must not make the receiver allocate it.
+	char data[16] = {};
+	sendFrameHeader( client, 0xFFFFFFF0 );
+	client.send( data, sizeof( data ) );
+	client.disconnect();
+
+	Packet received;
+	CHECK_EQ( server.receive( received ), Socket::Disconnected );
+	CHECK_EQ( received.getDataSize(), 0u );
+}
+
+TEST_CASE( tcpSocketMaxPacketSize ) {
+	TcpListener listener;
+	TcpSocket client;
+	TcpSocket server;
+
+	CHECK( connectPair( listener, client, server ) );
+
+	server.setMaxPacketSize( 1024 );
+
+	Packet small;
+	small << Uint32( 42 );
+	client.send( small );
+
+	Packet received;
+	CHECK_EQ( server.receive( received ), Socket::Done );
+
+	sendFrameHeader( client, 4096 );
+
+	CHECK_EQ( server.receive( received ), Socket::Error );
+	CHECK_EQ( server.getRemotePort(), 0 );
+}
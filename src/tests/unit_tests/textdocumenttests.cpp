@@ -0,0 +1,62 @@
+#include "unittest.hpp"
+
+using namespace EE::UI::Doc;
+
+static void loadText( TextDocument& doc, const std::string& text ) {
+	doc.loadFromMemory( reinterpret_cast<const Uint8*>( text.c_str() ), text.size() );
+}
+
+TEST_CASE( textDocumentFindAll ) {
+	TextDocument doc;
+	loadText( doc, "foo bar foo\nFOO foofoo\n" );
+
+	std::vector<TextRange> matches = doc.findAll( "foo" );
+	CHECK_EQ( matches.size(), 4u );
+
+	matches = doc.findAll( "foo", false );
+	CHECK_EQ( matches.size(), 5u );
+
+	matches = doc.findAll( "foo", true, true );
+	CHECK_EQ( matches.size(), 2u );
+}
+
+TEST_CASE( textDocumentFindAllLuaAnchored ) {
+	TextDocument doc;
+	loadText( doc, "foofoo foo\nbar foo\nfoo\n" );
+
+	// "^" anchors to the line start, never to the position after the previous match.
+	std::vector<TextRange> matches =
+		doc.findAll( "^foo", true, false, TextDocument::FindReplaceType::LuaPattern );
+	CHECK_EQ( matches.size(), 2u );
+
+	if ( matches.size() == 2 ) {
+		CHECK( matches[0] == TextRange( {0, 0}, {0, 3} ) );
+		CHECK( matches[1] == TextRange( {2, 0}, {2, 3} ) );
+	}
+
+	// A search starting after the line start can't match an anchored pattern on that line.
+	matches = doc.findAll( "^foo", true, false, TextDocument::FindReplaceType::LuaPattern,
+						   TextRange( {0, 1}, {2, 3} ) );
+	CHECK_EQ( matches.size(), 1u );
+
+	matches = doc.findAll( "foo$", true, false, TextDocument::FindReplaceType::LuaPattern );
+	CHECK_EQ( matches.size(), 3u );
+}
+
+TEST_CASE( textDocumentReplaceAllLuaCapture ) {
+	TextDocument doc;
+	loadText( doc, "ab cab ab\nxb\n" );
+
+	// The whole match is replaced, not the first capture.
+	int replaced =
+		doc.replaceAll( "(a)b", "X", true, false, TextDocument::FindReplaceType::LuaPattern );
+	CHECK_EQ( replaced, 3 );
+	CHECK( doc.line( 0 ).getText() == "X cX X\n" );
+	CHECK( doc.line( 1 ).getText() == "xb\n" );
+
+	loadText( doc, "ab\n" );
+	replaced =
+		doc.replaceAll( "^(a)b", "Y", true, false, TextDocument::FindReplaceType::LuaPattern );
+	CHECK_EQ( replaced, 1 );
+	CHECK( doc.line( 0 ).getText() == "Y\n" );
+}
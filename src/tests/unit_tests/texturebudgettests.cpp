@@ -0,0 +1,98 @@
+#include "unittest.hpp"
+
+// The budget is checked with the null window backend and renderer, the textures are accounted as
+// if they were uploaded but nothing is sent to a graphics library.
+static std::string makeBudgetTexture( const std::string& name ) {
+	std::string path( UnitTest::tempPath( name ) );
+	Image image( 64, 64, 4, Color::Red );
+	image.saveToFile( path, Image::SaveType::SAVE_TYPE_PNG );
+	return path;
+}
+
+static void bindTexture( Texture* texture ) {
+	TextureFactory::instance()->bind( texture, Texture::CoordinateType::Normalized, 0, true );
+}
+
+TEST_CASE( textureBudgetEviction ) {
+	CHECK( UnitTest::getNullWindow()->isOpen() && GLi->isNullRenderer() );
+
+	TextureFactory* factory = TextureFactory::instance();
+	std::vector<std::string> paths;
+	std::vector<Texture*> textures;
+
+	for ( int i = 0; i < 4; i++ ) {
+		paths.push_back( makeBudgetTexture( "budget-" + String::toString( i ) + ".png" ) );
+		textures.push_back( factory->getTexture( factory->loadFromFile( paths.back() ) ) );
+		CHECK( NULL != textures.back() && textures.back()->hasReloadSource() );
+	}
+
+	const Uint32 textureSize = textures[0]->getMemSize();
+	factory->resetCacheStats();
+	factory->endFrame();
+
+	// The textures drawn in the last frame stay, the least recently drawn are evicted.
+	factory->setMemoryBudget( factory->getTextureMemorySize() - textureSize * 2 );
+	bindTexture( textures[2] );
+	bindTexture( textures[3] );
+	factory->endFrame();
+
+	CHECK( textures[0]->isEvicted() && 0 == textures[0]->getHandle() );
+	CHECK( textures[1]->isEvicted() && 0 == textures[1]->getHandle() );
+	CHECK( !textures[2]->isEvicted() && !textures[3]->isEvicted() );
+	CHECK_EQ( factory->getCacheStats().evictions, 2u );
+	CHECK_EQ( factory->getCacheStats().evictedBytes, textureSize * 2u );
+	CHECK_EQ( factory->getCacheStats().hits, 2u );
+
+	// Without a placeholder an evicted texture is reloaded when binded.
+	factory->setMemoryBudget( 0 );
+	bindTexture( textures[0] );
+	CHECK( !textures[0]->isEvicted() && 0 != textures[0]->getHandle() );
+	CHECK_EQ( factory->getCacheStats().misses, 1u );
+	CHECK_EQ( factory->getCacheStats().reloads, 1u );
+
+	// With a placeholder it's decoded in the background, and the placeholder is drawn meanwhile.
+	Image placeholderImage( 4, 4, 4, Color::White );
+	Texture* placeholder = factory->getTexture(
+		factory->loadFromPixels( placeholderImage.getPixelsPtr(), 4, 4, 4 ) );
+	factory->setPlaceholderTexture( placeholder );
+	bindTexture( textures[1] );
+	CHECK_EQ( factory->getCacheStats().placeholderBinds, 1u );
+
+	for ( int i = 0; i < 1000 && textures[1]->isEvicted(); i++ ) {
+		Sys::sleep( Milliseconds( 1 ) );
+		factory->endFrame();
+	}
+
+	CHECK( !textures[1]->isEvicted() && 0 != textures[1]->getHandle() );
+	CHECK_EQ( factory->getCacheStats().reloads, 2u );
+	factory->setPlaceholderTexture( NULL );
+
+	// A failed reload is not tried again on every bind, but it's tried again later.
+	CHECK( factory->evict( textures[2] ) );
+	FileSystem::fileRemove( paths[2] );
+	bindTexture( textures[2] );
+	bindTexture( textures[2] );
+	CHECK( textures[2]->isEvicted() && textures[2]->hasReloadSource() );
+	CHECK_EQ( factory->getCacheStats().failedReloads, 1u );
+
+	makeBudgetTexture( "budget-2.png" );
+	factory->endFrame();
+	bindTexture( textures[2] );
+	CHECK( textures[2]->isEvicted() );
+
+	for ( int i = 0; i < 100 && textures[2]->isEvicted(); i++ ) {
+		factory->endFrame();
+		bindTexture( textures[2] );
+	}
+
+	CHECK( !textures[2]->isEvicted() && 0 != textures[2]->getHandle() );
+	CHECK_EQ( factory->getCacheStats().failedReloads, 1u );
+	CHECK_EQ( factory->getCacheStats().reloads, 3u );
+
+	for ( auto& texture : textures )
+		factory->remove( texture->getTextureId() );
+	factory->remove( placeholder->getTextureId() );
+
+	for ( auto& path : paths )
+		FileSystem::fileRemove( path );
+}
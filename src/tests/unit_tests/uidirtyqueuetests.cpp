@@ -0,0 +1,350 @@
+#include "unittest.hpp"
+#include "../../eepp/ui/uidirtyqueue.hpp"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace EE::UI::Private;
+
+static Uint32 nextRandom( Uint32& seed ) {
+	seed = seed * 1664525 + 1013904223;
+	return seed >> 16;
+}
+
+static Uint32 getDepth( Node* node ) {
+	Uint32 depth = 0;
+
+	for ( Node* parent = node->getParent(); NULL != parent; parent = parent->getParent() )
+		depth++;
+
+	return depth;
+}
+
+// The queue as it was before the buckets: every queued node is scanned with isParentOf. With the
+// layout chain an ancestor only covers the node if it and every node between them are layouts.
+class DirtyQueueReference {
+  public:
+	explicit DirtyQueueReference( bool layoutChain ) : mLayoutChain( layoutChain ) {}
+
+	bool insert( Node* node ) {
+		if ( mQueued.count( node ) > 0 || isCovered( node ) )
+			return false;
+
+		mQueued.insert( node );
+		return true;
+	}
+
+	void erase( Node* node ) { mQueued.erase( node ); }
+
+	std::set<Node*> getProcessed() const {
+		std::set<Node*> processed;
+
+		for ( auto& node : mQueued )
+			if ( !isCovered( node ) )
+				processed.insert( node );
+
+		return processed;
+	}
+
+	void clear() { mQueued.clear(); }
+
+  protected:
+	bool mLayoutChain;
+	std::set<Node*> mQueued;
+
+	bool isCovered( Node* node ) const {
+		for ( auto& queued : mQueued ) {
+			if ( queued == node || !queued->isParentOf( node ) )
+				continue;
+
+			bool chain = true;
+
+			for ( Node* parent = node->getParent(); mLayoutChain && parent != queued;
+				  parent = parent->getParent() )
+				chain = chain && parent->isLayout();
+
+			if ( chain && ( !mLayoutChain || queued->isLayout() ) )
+				return true;
+		}
+
+		return false;
+	}
+};
+
+static Node* newNode( Node* parent, bool layout ) {
+	Node* node = Node::New();
+	node->writeNodeFlag( NODE_FLAG_LAYOUT, layout ? 1 : 0 );
+
+	if ( NULL != parent )
+		node->setParent( parent );
+
+	return node;
+}
+
+TEST_CASE( uiDirtyQueueRandomTrees ) {
+	Uint32 seed = 1;
+	size_t mismatches = 0;
+	size_t repeated = 0;
+	size_t unordered = 0;
+
+	// Random trees where nodes are queued in random order, and some are removed and deleted
+	// between the invalidations. The flush must process the same nodes as the reference, each
+	// one once and parents first.
+	for ( int tree = 0; tree < 200; tree++ ) {
+		bool layoutChain = tree % 2 == 1;
+		std::vector<Node*> nodes;
+		nodes.push_back( newNode( NULL, true ) );
+		size_t count = 20 + nextRandom( seed ) % 200;
+
+		for ( size_t i = 1; i < count; i++ )
+			nodes.push_back( newNode( nodes[nextRandom( seed ) % nodes.size()],
+									  nextRandom( seed ) % 3 != 0 ) );
+
+		UIDirtyQueue queue( layoutChain );
+		DirtyQueueReference reference( layoutChain );
+
+		for ( int round = 0; round < 3; round++ ) {
+			Uint64 requested = 0;
+			Uint64 queued = 0;
+			size_t operations = 1 + nextRandom( seed ) % ( nodes.size() * 2 );
+
+			for ( size_t i = 0; i < operations; i++ ) {
+				Node* node = nodes[nextRandom( seed ) % nodes.size()];
+
+				// Removes the subtree of the node, the queue must not read the deleted nodes.
+				if ( node != nodes[0] && nextRandom( seed ) % 20 == 0 ) {
+					auto kept = [&]( Node* child ) {
+						return child != node && !node->isParentOf( child );
+					};
+					auto removed = std::stable_partition( nodes.begin(), nodes.end(), kept );
+
+					for ( auto it = removed; it != nodes.end(); ++it ) {
+						queue.erase( *it );
+						reference.erase( *it );
+					}
+
+					nodes.erase( removed, nodes.end() );
+					eeDelete( node );
+					continue;
+				}
+
+				requested++;
+				bool inserted = queue.insert( node );
+
+				if ( inserted != reference.insert( node ) )
+					mismatches++;
+
+				if ( inserted )
+					queued++;
+			}
+
+			std::set<Node*> expected( reference.getProcessed() );
+			std::map<Node*, int> processed;
+			Uint32 lastDepth = 0;
+
+			queue.flush( [&]( Node* node, bool ) {
+				Uint32 depth = getDepth( node );
+
+				if ( depth < lastDepth )
+					unordered++;
+
+				lastDepth = depth;
+				processed[node]++;
+			} );
+
+			for ( auto& node : processed )
+				if ( node.second > 1 )
+					repeated++;
+
+			if ( processed.size() != expected.size() )
+				mismatches++;
+
+			for ( auto& node : expected )
+				if ( processed.count( node ) == 0 )
+					mismatches++;
+
+			CHECK( queue.empty() );
+			CHECK_EQ( queue.getStats().requested, requested );
+			CHECK_EQ( queue.getStats().queued, queued );
+			CHECK_EQ( queue.getStats().processed, processed.size() );
+			reference.clear();
+			queue.resetStats();
+		}
+
+		eeDelete( nodes[0] );
+	}
+
+	CHECK_EQ( mismatches, 0u );
+	CHECK_EQ( repeated, 0u );
+	CHECK_EQ( unordered, 0u );
+}
+
+TEST_CASE( uiDirtyQueueEraseDuringFlush ) {
+	Node* root = newNode( NULL, false );
+	Node* a = newNode( root, false );
+	Node* b = newNode( root, false );
+	Node* a1 = newNode( a, false );
+	Node* b1 = newNode( b, false );
+	Node* b2 = newNode( b1, false );
+
+	UIDirtyQueue queue;
+	CHECK( queue.insert( b2 ) );
+	CHECK( queue.insert( a1 ) );
+	CHECK( queue.insert( b1 ) );
+	CHECK( queue.insert( a ) );
+	CHECK( !queue.insert( a1 ) );
+
+	// A node erased by the callback is not processed, and a node queued by the callback is left
+	// for the next flush even if its depth wasn't flushed yet.
+	std::vector<Node*> processed;
+	queue.flush( [&]( Node* node, bool ) {
+		processed.push_back( node );
+
+		if ( node == a ) {
+			queue.erase( b1 );
+			CHECK( queue.insert( b ) );
+		}
+	} );
+
+	CHECK_EQ( processed.size(), 2u );
+	CHECK( processed[0] == a && processed[1] == b2 );
+	CHECK( !queue.empty() );
+
+	processed.clear();
+	queue.flush( [&]( Node* node, bool ) { processed.push_back( node ); } );
+	CHECK( processed.size() == 1 && processed[0] == b );
+	CHECK( queue.empty() );
+
+	UISceneNode::InvalidationStats stats = queue.getStats();
+	CHECK_EQ( stats.requested, 6u );
+	CHECK_EQ( stats.queued, 5u );
+	CHECK_EQ( stats.processed, 3u );
+
+	// The flag of the first request is kept.
+	bool flag = false;
+	CHECK( queue.insert( a1, true ) );
+	CHECK( !queue.insert( a1, false ) );
+	queue.flush( [&]( Node*, bool nodeFlag ) { flag = nodeFlag; } );
+	CHECK( flag );
+
+	eeDelete( root );
+}
+
+TEST_CASE( uiDirtyQueueLayoutChain ) {
+	// root > layout > innerLayout > widget > widgetLayout > child
+	Node* root = newNode( NULL, false );
+	Node* layout = newNode( root, true );
+	Node* innerLayout = newNode( layout, true );
+	Node* widget = newNode( innerLayout, false );
+	Node* widgetLayout = newNode( widget, true );
+	Node* child = newNode( widgetLayout, true );
+
+	// A layout only updates the layouts reached through other layouts, the chain stops at the
+	// widget.
+	UIDirtyQueue layouts( true );
+	CHECK( layouts.insert( layout ) );
+	CHECK( !layouts.insert( innerLayout ) );
+	CHECK( !layouts.insert( widget ) );
+	CHECK( layouts.insert( widgetLayout ) );
+	CHECK( !layouts.insert( child ) );
+
+	std::vector<Node*> processed;
+	layouts.flush( [&]( Node* node, bool ) { processed.push_back( node ); } );
+	CHECK( processed.size() == 2 && processed[0] == layout && processed[1] == widgetLayout );
+
+	// Queued before the ancestor, the node is still processed when the chain is broken, and it's
+	// skipped when it isn't.
+	processed.clear();
+	CHECK( layouts.insert( child ) );
+	CHECK( layouts.insert( innerLayout ) );
+	CHECK( layouts.insert( layout ) );
+	layouts.flush( [&]( Node* node, bool ) { processed.push_back( node ); } );
+	CHECK( processed.size() == 2 && processed[0] == layout && processed[1] == child );
+
+	// Styles have no chain, any queued ancestor covers the node.
+	UIDirtyQueue styles;
+	processed.clear();
+	CHECK( styles.insert( child ) );
+	CHECK( styles.insert( layout ) );
+	CHECK( !styles.insert( widgetLayout ) );
+	styles.flush( [&]( Node* node, bool ) { processed.push_back( node ); } );
+	CHECK( processed.size() == 1 && processed[0] == layout );
+
+	eeDelete( root );
+}
+
+TEST_CASE( uiDirtyQueueWidgetsStress ) {
+	CHECK( UnitTest::getNullWindow()->isOpen() );
+
+	UISceneNode* sceneNode = UISceneNode::New();
+	SceneManager::instance()->add( sceneNode );
+
+	// 20 groups of 50 rows of 49 widgets, 50k widgets invalidated in random order.
+	UIWidget* container = UIWidget::New();
+	container->setParent( sceneNode->getRoot() );
+	std::vector<UIWidget*> widgets;
+
+	for ( int i = 0; i < 20; i++ ) {
+		UIWidget* group = UIWidget::New();
+		group->setParent( container );
+		widgets.push_back( group );
+
+		for ( int j = 0; j < 50; j++ ) {
+			UIWidget* row = UIWidget::New();
+			row->setParent( group );
+			widgets.push_back( row );
+
+			for ( int k = 0; k < 49; k++ ) {
+				UIWidget* widget = UIWidget::New();
+				widget->setParent( row );
+				widgets.push_back( widget );
+			}
+		}
+	}
+
+	sceneNode->updateDirtyStyles();
+	sceneNode->updateDirtyStyleStates();
+	sceneNode->resetInvalidationStats();
+	std::shuffle( widgets.begin(), widgets.end(), std::mt19937( 1 ) );
+
+	// A widget is queued unless its group or row was invalidated before it.
+	std::set<Node*> invalidated;
+	Uint64 expectedQueued = 0;
+
+	for ( auto& widget : widgets ) {
+		bool covered = false;
+
+		for ( Node* parent = widget->getParent(); parent != container;
+			  parent = parent->getParent() )
+			covered = covered || invalidated.count( parent ) > 0;
+
+		if ( !covered )
+			expectedQueued++;
+
+		invalidated.insert( widget );
+	}
+
+	for ( auto& widget : widgets )
+		sceneNode->invalidateStyle( widget );
+
+	UISceneNode::InvalidationStats stats = sceneNode->getStyleInvalidationStats();
+	CHECK_EQ( stats.requested, widgets.size() );
+	CHECK_EQ( stats.queued, expectedQueued );
+
+	sceneNode->updateDirtyStyles();
+	CHECK_EQ( sceneNode->getStyleInvalidationStats().processed, 20u );
+
+	for ( auto& widget : widgets )
+		sceneNode->invalidateStyleState( widget );
+
+	stats = sceneNode->getStyleStateInvalidationStats();
+	CHECK_EQ( stats.requested, widgets.size() );
+	CHECK_EQ( stats.queued, expectedQueued );
+
+	sceneNode->updateDirtyStyleStates();
+	CHECK_EQ( sceneNode->getStyleStateInvalidationStats().processed, 20u );
+
+	SceneManager::instance()->remove( sceneNode );
+	eeDelete( sceneNode );
+}
@@ -0,0 +1,86 @@
+#include "unittest.hpp"
+#include <iostream>
+
+namespace UnitTest {
+
+struct Test {
+	const char* name;
+	TestFunc func;
+};
+
+static std::vector<Test>& getTests() {
+	static std::vector<Test> tests;
+	return tests;
+}
+
+static int sFailures = 0;
+
+Registrar::Registrar( const char* name, TestFunc func ) {
+	getTests().push_back( {name, func} );
+}
+
+void fail( const char* expr, const char* file, int line ) {
+	std::cout << "\t" << file << ":" << line << ": check failed: " << expr << std::endl;
+	sFailures++;
+}
+
+std::string tempPath( const std::string& name ) {
+	return Sys::getTempPath() + "eepp-test-" + name;
+}
+
+EE::Window::Window* getNullWindow() {
+	static EE::Window::Window* window = NULL;
+
+	if ( NULL == window )
+		window = Engine::instance()->createWindow(
+			WindowSettings( 320, 240, "Unit Tests", WindowStyle::Default, WindowBackend::Null ),
+			ContextSettings() );
+
+	return window;
+}
+
+} // namespace UnitTest
+
+using namespace UnitTest;
+
+// Runs every test, or only the ones whose name starts with one of the arguments.
+// The exit code is the number of tests that failed.
+EE_MAIN_FUNC int main( int argc, char* argv[] ) {
+	Log::create( LogLevel::Warning, true, false );
+
+	int failedTests = 0;
+	int ranTests = 0;
+
+	for ( auto& test : getTests() ) {
+		bool selected = argc < 2;
+
+		for ( int i = 1; i < argc && !selected; i++ )
+			selected = String::startsWith( std::string( test.name ), std::string( argv[i] ) );
+
+		if ( !selected )
+			continue;
+
+		int failures = sFailures;
+		Clock clock;
+
+		std::cout << test.name << std::endl;
+
+		test.func();
+
+		ranTests++;
+
+		if ( sFailures != failures )
+			failedTests++;
+
+		std::cout << ( sFailures != failures ? "FAILED " : "OK " ) << test.name << " ("
+				  << clock.getElapsedTime().asMilliseconds() << " ms)" << std::endl;
+	}
+
+	std::cout << ranTests - failedTests << " of " << ranTests << " tests passed" << std::endl;
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return eemin( failedTests, 125 );
+}
@@ -0,0 +1,41 @@
+#ifndef EE_UNITTEST_HPP
+#define EE_UNITTEST_HPP
+
+#include <eepp/ee.hpp>
+#include <functional>
+
+namespace UnitTest {
+
+typedef std::function<void()> TestFunc;
+
+/** Adds a test to the list run by main, TEST_CASE does it for static functions. */
+struct Registrar {
+	Registrar( const char* name, TestFunc func );
+};
+
+/** Records a failed check, the test keeps running. */
+void fail( const char* expr, const char* file, int line );
+
+/** Path of a scratch file or directory inside the temporary directory. */
+std::string tempPath( const std::string& name );
+
+/** Window of the null backend for the tests that need a renderer, it's created by the first test
+ * that asks for it and destroyed with the engine at exit. */
+EE::Window::Window* getNullWindow();
+
+} // namespace UnitTest
+
+#define TEST_CASE( name )                                        \
+	static void name();                                          \
+	static UnitTest::Registrar name##_registrar( #name, &name ); \
+	static void name()
+
+#define CHECK( expr )                                    \
+	do {                                                 \
+		if ( !( expr ) )                                 \
+			UnitTest::fail( #expr, __FILE__, __LINE__ ); \
+	} while ( 0 )
+
+#define CHECK_EQ( a, b ) CHECK( ( a ) == ( b ) )
+
+#endif
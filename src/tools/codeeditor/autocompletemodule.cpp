@@ -37,21 +37,26 @@ AutoCompleteModule::~AutoCompleteModule() {
 			editor.first->removeEventListener( listener );
 		editor.first->unregisterModule( this );
 	}
+	mDocSymbols.clear();
 }
 
 void AutoCompleteModule::onRegister( UICodeEditor* editor ) {
 	Lock l( mDocMutex );
 	std::vector<Uint32> listeners;
-	listeners.push_back( editor->addEventListener( Event::OnDocumentLoaded,
-												   [&]( const Event* ) { mDirty = true; } ) );
+	listeners.push_back(
+		editor->addEventListener( Event::OnDocumentLoaded, [&, editor]( const Event* ) {
+			Lock l( mDocMutex );
+			auto docSymbols = mDocSymbols.find( editor->getDocumentRef().get() );
+			if ( docSymbols != mDocSymbols.end() )
+				docSymbols->second->setNeedsRebuild();
+			mDirty = true;
+		} ) );
 
 	listeners.push_back(
 		editor->addEventListener( Event::OnDocumentClosed, [&]( const Event* event ) {
 			Lock l( mDocMutex );
 			const DocEvent* docEvent = static_cast<const DocEvent*>( event );
-			TextDocument* doc = docEvent->getDoc();
-			mDocs.erase( doc );
-			mDocCache.erase( doc );
+			removeDocument( docEvent->getDoc() );
 			mDirty = true;
 		} ) );
 
@@ -60,8 +65,8 @@ void AutoCompleteModule::onRegister( UICodeEditor* editor ) {
 			TextDocument* oldDoc = mEditorDocs[editor];
 			TextDocument* newDoc = editor->getDocumentRef().get();
 			Lock l( mDocMutex );
-			mDocs.erase( oldDoc );
-			mDocCache.erase( oldDoc );
+			removeDocument( oldDoc );
+			addDocument( newDoc );
 			mEditorDocs[editor] = newDoc;
 			mDirty = true;
 		} ) );
@@ -73,25 +78,12 @@ void AutoCompleteModule::onRegister( UICodeEditor* editor ) {
 		} ) );
 
 	listeners.push_back(
-		editor->addEventListener( Event::OnDocumentSyntaxDefinitionChange, [&]( const Event* ev ) {
-			const DocSyntaxDefEvent* event = static_cast<const DocSyntaxDefEvent*>( ev );
-			std::string oldLang = event->getOldLang();
-			std::string newLang = event->getNewLang();
-#if AUTO_COMPLETE_THREADED
-			mPool->run(
-				[&, oldLang, newLang] {
-					updateLangCache( oldLang );
-					updateLangCache( newLang );
-				},
-				[] {} );
-#else
-			updateLangCache( oldLang );
-			updateLangCache( newLang );
-#endif
-		} ) );
+		editor->addEventListener( Event::OnDocumentSyntaxDefinitionChange,
+								  // The symbols are moved to the new language on the next update.
+								  [&]( const Event* ) { mDirty = true; } ) );
 
 	mEditors.insert( {editor, listeners} );
-	mDocs.insert( editor->getDocumentRef().get() );
+	addDocument( editor->getDocumentRef().get() );
 	mEditorDocs[editor] = editor->getDocumentRef().get();
 	mDirty = true;
 }
@@ -111,11 +103,20 @@ void AutoCompleteModule::onUnregister( UICodeEditor* editor ) {
 	for ( auto editor : mEditorDocs )
 		if ( editor.second == doc )
 			return;
-	mDocs.erase( doc );
-	mDocCache.erase( doc );
+	removeDocument( doc );
 	mDirty = true;
 }
 
+void AutoCompleteModule::addDocument( TextDocument* doc ) {
+	if ( mDocs.insert( doc ).second )
+		mDocSymbols[doc] = std::unique_ptr<DocSymbols>( new DocSymbols( this, doc ) );
+}
+
+void AutoCompleteModule::removeDocument( TextDocument* doc ) {
+	mDocs.erase( doc );
+	mDocSymbols.erase( doc );
+}
+
 bool AutoCompleteModule::onKeyDown( UICodeEditor* editor, const KeyEvent& event ) {
 	if ( !mSuggestions.empty() ) {
 		int max = eemin<int>( mSuggestionsMaxVisible, mSuggestions.size() );
@@ -185,43 +186,192 @@ bool AutoCompleteModule::onTextInput( UICodeEditor* editor, const TextInputEvent
 	return false;
 }
 
-void AutoCompleteModule::updateDocCache( TextDocument* doc ) {
-	Lock l( mDocMutex );
-	Clock clock;
-	auto docCache = mDocCache.find( doc );
-	if ( docCache == mDocCache.end() )
+AutoCompleteModule::DocSymbols::DocSymbols( AutoCompleteModule* module, TextDocument* doc ) :
+	mModule( module ), mDoc( doc ) {
+	mDoc->registerClient( this );
+}
+
+AutoCompleteModule::DocSymbols::~DocSymbols() {
+	if ( mDoc )
+		mDoc->unregisterClient( this );
+	countAllSymbols( false );
+}
+
+void AutoCompleteModule::DocSymbols::onDocumentLineCountChange( const size_t& lastCount,
+																const size_t& newCount ) {
+	LineChange change{true, (Int64)lastCount, (Int64)newCount};
+	if ( mBuild )
+		mPendingChanges.push_back( change );
+	else
+		applyChange( change );
+}
+
+void AutoCompleteModule::DocSymbols::onDocumentLineChanged( const Int64& lineIndex ) {
+	LineChange change{false, 0, lineIndex};
+	if ( mBuild )
+		mPendingChanges.push_back( change );
+	else
+		applyChange( change );
+}
+
+void AutoCompleteModule::DocSymbols::applyChange( const LineChange& change ) {
+	if ( !change.countChange ) {
+		mLastChangedLine = change.newCount;
+		mDirtyLines.insert( change.newCount );
 		return;
-	auto& cache = docCache->second;
-	cache.changeId = doc->getCurrentChangeId();
-	cache.symbols = getDocumentSymbols( doc );
-	std::string langName( doc->getSyntaxDefinition().getLanguageName() );
-	auto& lang = mLangCache[langName];
-	{
-		Lock l( mLangSymbolsMutex );
-		lang.clear();
-		for ( auto d : mDocCache ) {
-			if ( d.first->getSyntaxDefinition().getLanguageName() == langName )
-				lang.insert( d.second.symbols.begin(), d.second.symbols.end() );
+	}
+
+	if ( (Int64)mLines.size() != change.lastCount ) {
+		mNeedsRebuild = true;
+		return;
+	}
+
+	// Lines are inserted after the first line reported as changed (the inserted lines are
+	// reported too) and removed after the only line reported as changed.
+	Int64 delta = change.newCount - change.lastCount;
+	Int64 first = eemax<Int64>( 0, mLastChangedLine - eemax<Int64>( 0, delta ) );
+	Int64 at = eemin<Int64>( first + 1, mLines.size() );
+
+	if ( delta > 0 ) {
+		mLines.insert( mLines.begin() + at, delta, std::vector<std::string>() );
+		std::set<Int64> dirtyLines;
+		for ( auto line : mDirtyLines )
+			dirtyLines.insert( line >= at ? line + delta : line );
+		mDirtyLines.swap( dirtyLines );
+	} else {
+		Int64 end = eemin<Int64>( at - delta, mLines.size() );
+		for ( Int64 i = at; i < end; i++ )
+			countSymbols( mLines[i], false );
+		mLines.erase( mLines.begin() + at, mLines.begin() + end );
+		std::set<Int64> dirtyLines;
+		for ( auto line : mDirtyLines ) {
+			if ( line < at )
+				dirtyLines.insert( line );
+			else if ( line >= end )
+				dirtyLines.insert( line + delta );
 		}
+		mDirtyLines.swap( dirtyLines );
 	}
-	Log::debug( "Dictionary for %s updated in: %.2fms", doc->getFilename().c_str(),
-				clock.getElapsedTime().asMilliseconds() );
+
+	// Also rescan the lines around the change, in case the changed line was not the expected one.
+	for ( Int64 i = eemax<Int64>( 0, first - 1 );
+		  i <= eemin<Int64>( first + eemax<Int64>( 0, delta ) + 1, mLines.size() - 1 ); i++ )
+		mDirtyLines.insert( i );
 }
 
-void AutoCompleteModule::updateLangCache( const std::string& langName ) {
-	Clock clock;
-	auto& lang = mLangCache[langName];
-	Lock l( mLangSymbolsMutex );
-	Lock l2( mDocMutex );
-	lang.clear();
-	for ( auto d : mDocCache ) {
-		if ( d.first->getSyntaxDefinition().getLanguageName() == langName )
-			lang.insert( d.second.symbols.begin(), d.second.symbols.end() );
+void AutoCompleteModule::DocSymbols::countSymbols( const std::vector<std::string>& symbols,
+												   bool add ) {
+	if ( symbols.empty() )
+		return;
+	Lock l( mModule->mLangSymbolsMutex );
+	auto& lang = mModule->mLangCache[mLang];
+	for ( const auto& symbol : symbols ) {
+		if ( add ) {
+			lang[symbol]++;
+		} else {
+			auto it = lang.find( symbol );
+			if ( it != lang.end() && --it->second == 0 )
+				lang.erase( it );
+		}
 	}
-	Log::debug( "Lang dictionary for %s updated in: %.2fms", langName.c_str(),
+}
+
+void AutoCompleteModule::DocSymbols::countAllSymbols( bool add ) {
+	for ( const auto& line : mLines )
+		countSymbols( line, add );
+}
+
+void AutoCompleteModule::DocSymbols::startBuild() {
+	mNeedsRebuild = false;
+	mDirtyLines.clear();
+	mPendingChanges.clear();
+	mBuild = std::make_shared<SymbolsBuild>();
+	Int64 lc = mDoc->linesCount();
+	mBuild->text.reserve( lc );
+	for ( Int64 i = 0; i < lc; i++ )
+		mBuild->text.emplace_back( mDoc->line( i ).toUtf8() );
+
+	std::shared_ptr<SymbolsBuild> build( mBuild );
+	std::string pattern( mModule->mSymbolPattern );
+	auto run = [build, pattern] {
+		LuaPattern luaPattern( pattern );
+		build->lines.resize( build->text.size() );
+		for ( size_t i = 0; i < build->text.size(); i++ )
+			getLineSymbols( luaPattern, build->text[i], build->lines[i] );
+		build->text.clear();
+		build->done = true;
+	};
+#if AUTO_COMPLETE_THREADED
+	mModule->mPool->run( run, [] {} );
+#else
+	run();
+#endif
+}
+
+void AutoCompleteModule::DocSymbols::finishBuild() {
+	Clock clock;
+	countAllSymbols( false );
+	mLines.swap( mBuild->lines );
+	mBuild.reset();
+	countAllSymbols( true );
+
+	for ( const auto& change : mPendingChanges )
+		applyChange( change );
+	mPendingChanges.clear();
+
+	Log::debug( "Dictionary for %s updated in: %.2fms", mDoc->getFilename().c_str(),
 				clock.getElapsedTime().asMilliseconds() );
 }
 
+void AutoCompleteModule::DocSymbols::update() {
+	if ( !mDoc )
+		return;
+
+	if ( mBuild ) {
+		if ( !mBuild->done )
+			return;
+		finishBuild();
+	}
+
+	std::string lang( mDoc->getSyntaxDefinition().getLanguageName() );
+
+	if ( lang != mLang ) {
+		countAllSymbols( false );
+		mLang = lang;
+		countAllSymbols( true );
+	}
+
+	if ( mNeedsRebuild || mLines.size() != mDoc->linesCount() ) {
+		startBuild();
+		return;
+	}
+
+	if ( mDirtyLines.empty() )
+		return;
+
+	LuaPattern pattern( mModule->mSymbolPattern );
+	std::vector<std::string> symbols;
+	for ( auto line : mDirtyLines ) {
+		if ( line < 0 || line >= (Int64)mLines.size() )
+			continue;
+		symbols.clear();
+		getLineSymbols( pattern, mDoc->line( line ).toUtf8(), symbols );
+		countSymbols( mLines[line], false );
+		countSymbols( symbols, true );
+		mLines[line].swap( symbols );
+	}
+	mDirtyLines.clear();
+}
+
+void AutoCompleteModule::getLineSymbols( LuaPattern& pattern, const std::string& line,
+										 std::vector<std::string>& symbols ) {
+	for ( auto& match : pattern.gmatch( line ) ) {
+		std::string matchStr( match[0] );
+		if ( matchStr.size() >= 3 )
+			symbols.emplace_back( std::move( matchStr ) );
+	}
+}
+
 void AutoCompleteModule::pickSuggestion( UICodeEditor* editor ) {
 	mReplacing = true;
 	editor->getDocument().execute( "delete-to-previous-word" );
@@ -236,21 +386,32 @@ std::string AutoCompleteModule::getPartialSymbol( TextDocument* doc ) {
 	return doc->getText( {start, end} ).toUtf8();
 }
 
-void AutoCompleteModule::update( UICodeEditor* ) {
-	if ( mClock.getElapsedTime() >= mUpdateFreq || mDirty ) {
+void AutoCompleteModule::update( UICodeEditor* editor ) {
+	Lock l( mDocMutex );
+	bool updateAll = mClock.getElapsedTime() >= mUpdateFreq || mDirty;
+	bool building = false;
+	bool pending = false;
+
+	if ( updateAll ) {
 		mClock.restart();
 		mDirty = false;
-		Lock l( mDocMutex );
-		for ( auto& doc : mDocs ) {
-			if ( mDocCache[doc].changeId != doc->getCurrentChangeId() ) {
-#if AUTO_COMPLETE_THREADED
-				mPool->run( [&, doc] { updateDocCache( doc ); }, [] {} );
-#else
-				updateDocCache( doc );
-#endif
-			}
-		}
 	}
+
+	for ( auto& docSymbols : mDocSymbols ) {
+		// The finished builds are collected right away, not on the next periodic update.
+		if ( updateAll || docSymbols.second->isBuildDone() )
+			docSymbols.second->update();
+
+		building = building || docSymbols.second->isBuilding();
+		pending = pending || docSymbols.second->hasPendingChanges();
+	}
+
+	// The main loop sleeps until the next update deadline: poll the builds running in the worker
+	// and come back for the changes left to scan.
+	if ( building )
+		editor->getUISceneNode()->setUpdateDeadline( Milliseconds( 100 ) );
+	else if ( pending )
+		editor->getUISceneNode()->setUpdateDeadline( mUpdateFreq - mClock.getElapsedTime() );
 }
 
 void AutoCompleteModule::preDraw( UICodeEditor*, const Vector2f&, const Float&,
@@ -405,35 +566,25 @@ void AutoCompleteModule::resetSuggestions( UICodeEditor* editor ) {
 		editor->getUISceneNode()->setCursor( !editor->isLocked() ? Cursor::IBeam : Cursor::Arrow );
 }
 
-AutoCompleteModule::SymbolsList AutoCompleteModule::getDocumentSymbols( TextDocument* doc ) {
-	LuaPattern pattern( mSymbolPattern );
-	AutoCompleteModule::SymbolsList symbols;
-	Int64 lc = doc->linesCount();
-	if ( lc == 0 )
-		return symbols;
-	std::string current( getPartialSymbol( doc ) );
-	TextPosition end = doc->getSelection().end();
-	for ( Int64 i = 0; i < lc; i++ ) {
-		const auto& string = doc->line( i ).getText().toUtf8();
-		for ( auto& match : pattern.gmatch( string ) ) {
-			std::string matchStr( match[0] );
-			// Ignore the symbol if is actually the current symbol being written
-			if ( matchStr.size() < 3 || ( end.line() == i && current == matchStr ) )
-				continue;
-			symbols.insert( std::move( matchStr ) );
-		}
-	}
-	return symbols;
-}
-
 static std::vector<std::string> fuzzyMatchSymbols( const AutoCompleteModule::SymbolsList& symbols,
 												   const std::string& match, const size_t& max ) {
 	std::multimap<int, std::string, std::greater<int>> matchesMap;
 	std::vector<std::string> matches;
 	int score;
-	for ( const auto& symbol : symbols ) {
-		if ( ( score = String::fuzzyMatch( symbol, match ) ) > 0 ) {
-			matchesMap.insert( {score, symbol} );
+	// The symbols starting with the match are a range of the sorted symbols. The symbol equal to
+	// the match is the one being written.
+	for ( auto it = symbols.upper_bound( match );
+		  it != symbols.end() && String::startsWith( it->first, match ); ++it ) {
+		if ( ( score = String::fuzzyMatch( it->first, match ) ) > 0 )
+			matchesMap.insert( {score, it->first} );
+	}
+	// Only look for fuzzy matches in every symbol if there are not enough prefix matches.
+	if ( matchesMap.size() < max ) {
+		for ( const auto& symbol : symbols ) {
+			if ( String::startsWith( symbol.first, match ) )
+				continue;
+			if ( ( score = String::fuzzyMatch( symbol.first, match ) ) > 0 )
+				matchesMap.insert( {score, symbol.first} );
 		}
 	}
 	for ( auto& res : matchesMap ) {
@@ -443,28 +594,26 @@ static std::vector<std::string> fuzzyMatchSymbols( const AutoCompleteModule::Sym
 	return matches;
 }
 
-void AutoCompleteModule::runUpdateSuggestions( const std::string& symbol,
-											   const SymbolsList& symbols, UICodeEditor* editor ) {
+void AutoCompleteModule::runUpdateSuggestions( const std::string& symbol, const std::string& lang,
+											   UICodeEditor* editor ) {
 	Lock l( mLangSymbolsMutex );
 	Lock l2( mSuggestionsMutex );
-	mSuggestions = fuzzyMatchSymbols( symbols, symbol, mSuggestionsMaxVisible );
+	auto langSuggestions = mLangCache.find( lang );
+	if ( langSuggestions == mLangCache.end() )
+		return;
+	mSuggestions = fuzzyMatchSymbols( langSuggestions->second, symbol, mSuggestionsMaxVisible );
 	mSuggestionsEditor = editor;
 	editor->runOnMainThread( [editor] { editor->invalidateDraw(); } );
 }
 
 void AutoCompleteModule::updateSuggestions( const std::string& symbol, UICodeEditor* editor ) {
-	const std::string& lang = editor->getDocument().getSyntaxDefinition().getLanguageName();
-	auto langSuggestions = mLangCache.find( lang );
-	if ( langSuggestions == mLangCache.end() )
-		return;
-	auto& symbols = langSuggestions->second;
+	std::string lang( editor->getDocument().getSyntaxDefinition().getLanguageName() );
 	{
 #if AUTO_COMPLETE_THREADED
-		mPool->run(
-			[this, symbol, symbols, editor] { runUpdateSuggestions( symbol, symbols, editor ); },
-			[] {} );
+		mPool->run( [this, symbol, lang, editor] { runUpdateSuggestions( symbol, lang, editor ); },
+					[] {} );
 #else
-		runUpdateSuggestions( symbol, symbols, editor );
+		runUpdateSuggestions( symbol, lang, editor );
 #endif
 	}
 }
@@ -7,14 +7,22 @@
 #include <eepp/system/sys.hpp>
 #include <eepp/system/threadpool.hpp>
 #include <eepp/ui/uicodeeditor.hpp>
+#include <atomic>
+#include <map>
+#include <memory>
 #include <set>
+namespace EE { namespace System {
+class LuaPattern;
+}} // namespace EE::System
+
 using namespace EE;
 using namespace EE::System;
 using namespace EE::UI;
 
 class AutoCompleteModule : public UICodeEditorModule {
   public:
-	typedef std::unordered_set<std::string> SymbolsList;
+	// Sorted symbols with their number of occurrences.
+	typedef std::map<std::string, Uint32> SymbolsList;
 
 	AutoCompleteModule();
 
@@ -71,13 +79,75 @@ class AutoCompleteModule : public UICodeEditorModule {
 	bool mDirty{false};
 	bool mClosing{false};
 	bool mReplacing{false};
-	struct DocCache {
-		Uint64 changeId{static_cast<Uint64>( -1 )};
-		SymbolsList symbols;
+
+	struct SymbolsBuild {
+		std::vector<std::string> text;
+		std::vector<std::vector<std::string>> lines;
+		std::atomic<bool> done{false};
 	};
-	std::unordered_map<TextDocument*, DocCache> mDocCache;
+
+	// Symbols of every line of a document. Kept up to date from the document line changes, so
+	// only the modified lines are scanned again. The document is only scanned entirely when
+	// loaded, and that is done in a worker over a snapshot of the lines.
+	class DocSymbols : public TextDocument::Client {
+	  public:
+		DocSymbols( AutoCompleteModule* module, TextDocument* doc );
+
+		~DocSymbols();
+
+		void update();
+
+		void setNeedsRebuild() { mNeedsRebuild = true; }
+
+		bool isBuilding() const { return mBuild && !mBuild->done; }
+
+		bool isBuildDone() const { return mBuild && mBuild->done; }
+
+		bool hasPendingChanges() const {
+			return mDoc && ( mNeedsRebuild || !mDirtyLines.empty() ||
+							 mLines.size() != mDoc->linesCount() );
+		}
+
+		void onDocumentTextChanged() {}
+		void onDocumentUndoRedo( const TextDocument::UndoRedo& ) {}
+		void onDocumentCursorChange( const TextPosition& ) {}
+		void onDocumentSelectionChange( const TextRange& ) {}
+		void onDocumentLineCountChange( const size_t& lastCount, const size_t& newCount );
+		void onDocumentLineChanged( const Int64& lineIndex );
+		void onDocumentSaved() {}
+		void onDocumentClosed( TextDocument* ) { mDoc = nullptr; }
+
+	  protected:
+		struct LineChange {
+			bool countChange;
+			Int64 lastCount;
+			Int64 newCount; // Or the changed line index.
+		};
+
+		AutoCompleteModule* mModule;
+		TextDocument* mDoc;
+		std::string mLang;
+		std::vector<std::vector<std::string>> mLines;
+		std::set<Int64> mDirtyLines;
+		Int64 mLastChangedLine{0};
+		bool mNeedsRebuild{true};
+		std::shared_ptr<SymbolsBuild> mBuild;
+		// Changes received while a build is running, applied over the build result.
+		std::vector<LineChange> mPendingChanges;
+
+		void applyChange( const LineChange& change );
+
+		void startBuild();
+
+		void finishBuild();
+
+		void countSymbols( const std::vector<std::string>& symbols, bool add );
+
+		void countAllSymbols( bool add );
+	};
+
+	std::unordered_map<TextDocument*, std::unique_ptr<DocSymbols>> mDocSymbols;
 	std::unordered_map<std::string, SymbolsList> mLangCache;
-	SymbolsList mLangDirty;
 
 	int mSuggestionIndex{0};
 	std::vector<std::string> mSuggestions;
@@ -91,17 +161,18 @@ class AutoCompleteModule : public UICodeEditorModule {
 
 	void updateSuggestions( const std::string& symbol, UICodeEditor* editor );
 
-	SymbolsList getDocumentSymbols( TextDocument* );
+	static void getLineSymbols( LuaPattern& pattern, const std::string& line,
+								std::vector<std::string>& symbols );
 
-	void updateDocCache( TextDocument* doc );
+	void addDocument( TextDocument* doc );
+
+	void removeDocument( TextDocument* doc );
 
 	std::string getPartialSymbol( TextDocument* doc );
 
-	void runUpdateSuggestions( const std::string& symbol, const SymbolsList& symbols,
+	void runUpdateSuggestions( const std::string& symbol, const std::string& lang,
 							   UICodeEditor* editor );
 
-	void updateLangCache( const std::string& langName );
-
 	void pickSuggestion( UICodeEditor* editor );
 };
 
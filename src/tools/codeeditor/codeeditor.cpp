@@ -322,23 +322,12 @@ int App::replaceAll( SearchState& search, const String& replace ) {
 	if ( search.text.empty() )
 		return 0;
 
-	int count = 0;
 	search.editor->getDocument().setActiveClient( search.editor );
 	mLastSearch = search.text;
 	TextDocument& doc = search.editor->getDocument();
-	TextPosition found;
 	TextPosition startedPosition = doc.getSelection().start();
-	TextPosition from = doc.startOfDoc();
-	if ( search.range.isValid() )
-		from = search.range.normalized().start();
-	do {
-		found = doc.find( search.text, from, search.caseSensitive, search.range );
-		if ( found.isValid() ) {
-			doc.setSelection( { doc.positionOffset( found, search.text.size() ), found } );
-			from = doc.replaceSelection( replace );
-			count++;
-		}
-	} while ( found.isValid() );
+	int count = doc.replaceAll( search.text, replace, search.caseSensitive, false,
+								TextDocument::FindReplaceType::Normal, search.range );
 	doc.setSelection( startedPosition );
 	return count;
 }
@@ -895,7 +884,7 @@ void App::mainLoop() {
 		mConsole->draw( elapsed );
 		mWindow->display();
 	} else {
-		mWindow->getInput()->waitEvent( Milliseconds( mWindow->hasFocus() ? 16 : 100 ) );
+		SceneManager::instance()->waitForNextDeadline( mWindow );
 	}
 }
 
@@ -2397,6 +2386,8 @@ EE_MAIN_FUNC int main( int argc, char* argv[] ) {
 #else
 	Log::create( LogLevel::Debug, true, true );
 #endif
+	Log::instance()->setMaxBufferSize( 1024 * 1024 );
+	Log::instance()->setAsync( true );
 	args::ArgumentParser parser( "ecode" );
 	args::HelpFlag help( parser, "help", "Display this help menu", { 'h', "help" } );
 	args::Positional<std::string> file( parser, "file", "The file path" );
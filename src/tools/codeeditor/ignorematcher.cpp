@@ -174,30 +174,107 @@ bool GitIgnoreMatcher::parse() {
 		mPatterns.emplace_back( std::make_pair( pattern, negates ) );
 	}
 	mPatterns.emplace_back( std::make_pair( "/.git", false ) ); // Also ignore the .git folder
+	compile();
 	return !mPatterns.empty();
 }
 
-bool GitIgnoreMatcher::match( const std::string& value ) const {
+static bool isLiteral( const std::string& glob, size_t start = 0 ) {
+	return glob.find_first_of( "*?[\\", start ) == std::string::npos;
+}
+
+void GitIgnoreMatcher::compile() {
+	// emplace keeps the first index of every key.
 	for ( size_t i = 0; i < mPatterns.size(); i++ ) {
-		if ( gitignore_glob_match( value, mPatterns[i].first ) ) {
-			if ( mHasNegates ) {
-				for ( size_t n = i + 1; i < mPatterns.size(); i++ ) {
-					// Check if there's a positive negate after the match
-					if ( mPatterns[n].second && gitignore_glob_match( value, mPatterns[n].first ) )
-						return false;
-				}
+		const std::string& glob = mPatterns[i].first;
+
+		if ( glob.empty() ) {
+			mGlobs.push_back( i );
+		} else if ( isLiteral( glob ) ) {
+			// A glob without a / matches the basename, one starting with a / matches the path from
+			// the root and any other matches the whole path.
+			if ( glob.find( '/' ) == std::string::npos ) {
+				mBasenames.emplace( glob, i );
+			} else if ( glob[0] == '/' && glob.size() > 1 ) {
+				mRootedPaths.emplace( glob.substr( 1 ), i );
+			} else if ( glob[0] != '/' ) {
+				mPaths.emplace( glob, i );
+			} else {
+				mGlobs.push_back( i );
 			}
-			return true;
+		} else if ( glob.size() > 2 && glob[0] == '*' && glob[1] == '.' && isLiteral( glob, 1 ) &&
+					glob.find( '/' ) == std::string::npos ) {
+			mExtensions.emplace( glob.substr( 1 ), i );
+		} else {
+			mGlobs.push_back( i );
 		}
 	}
-	return false;
+}
+
+static void findIn( const std::unordered_map<std::string, size_t>& table, const std::string& key,
+					size_t& first ) {
+	auto it = table.find( key );
+	if ( it != table.end() && it->second < first )
+		first = it->second;
+}
+
+size_t GitIgnoreMatcher::findFirstMatch( const std::string& value ) const {
+	size_t first = mPatterns.size();
+	size_t sep = value.rfind( '/' );
+	std::string basename( sep != std::string::npos ? value.substr( sep + 1 ) : value );
+
+	if ( !mBasenames.empty() )
+		findIn( mBasenames, basename, first );
+
+	if ( !mExtensions.empty() ) {
+		for ( size_t dot = basename.find( '.' ); dot != std::string::npos;
+			  dot = basename.find( '.', dot + 1 ) )
+			findIn( mExtensions, basename.substr( dot ), first );
+	}
+
+	if ( !mRootedPaths.empty() ) {
+		// The same prefixes skipped by gitignore_glob_match for the globs starting with a /.
+		size_t start = 0;
+		while ( start + 1 < value.size() && value[start] == '.' && value[start + 1] == '/' )
+			start += 2;
+		if ( start < value.size() && value[start] == '/' )
+			start++;
+		findIn( mRootedPaths, value.substr( start ), first );
+	}
+
+	if ( !mPaths.empty() )
+		findIn( mPaths, value, first );
+
+	for ( size_t i : mGlobs ) {
+		if ( i >= first )
+			break;
+
+		if ( gitignore_glob_match( value, mPatterns[i].first ) )
+			return i;
+	}
+
+	return first;
+}
+
+bool GitIgnoreMatcher::match( const std::string& value ) const {
+	size_t i = findFirstMatch( value );
+
+	if ( i == mPatterns.size() )
+		return false;
+
+	// Only the pattern following the first match is checked for a negation.
+	if ( mHasNegates && i + 1 < mPatterns.size() && mPatterns[i + 1].second &&
+		 gitignore_glob_match( value, mPatterns[i + 1].first ) )
+		return false;
+
+	return true;
 }
 
 IgnoreMatcherManager::IgnoreMatcherManager( std::string rootPath ) {
 	FileSystem::dirAddSlashAtEnd( rootPath );
-	GitIgnoreMatcher git( rootPath );
-	if ( git.canMatch() )
-		mMatcher = std::make_unique<GitIgnoreMatcher>( rootPath );
+	// The patterns are parsed and compiled once per .gitignore found.
+	std::unique_ptr<GitIgnoreMatcher> git = std::make_unique<GitIgnoreMatcher>( rootPath );
+	if ( git->canMatch() )
+		mMatcher = std::move( git );
 }
 
 bool IgnoreMatcherManager::foundMatch() const {
@@ -2,7 +2,9 @@
 #define EE_TOOLS_IGNOREMATCHER_HPP
 
 #include <eepp/system/filesystem.hpp>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace EE;
@@ -37,7 +39,19 @@ class GitIgnoreMatcher : public IgnoreMatcher {
   protected:
 	bool parse() override;
 
+	/** Sorts the patterns by kind, so only the real globs are matched one by one. Each table
+	 * keeps the index of the first pattern with that key. */
+	void compile();
+
+	/** @return The index of the first pattern matching the value, or the patterns count */
+	size_t findFirstMatch( const std::string& value ) const;
+
 	std::vector<std::pair<std::string, bool>> mPatterns;
+	std::unordered_map<std::string, size_t> mBasenames;	  ///< Literal basenames: "build"
+	std::unordered_map<std::string, size_t> mExtensions;  ///< "*.o" patterns, keyed by ".o"
+	std::unordered_map<std::string, size_t> mRootedPaths; ///< Literal paths: "/src/build"
+	std::unordered_map<std::string, size_t> mPaths;		  ///< Literal paths: "src/build"
+	std::vector<size_t> mGlobs;
 	bool mHasNegates{false};
 };
 
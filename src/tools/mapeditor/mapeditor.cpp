@@ -1,5 +1,6 @@
 #include <eepp/graphics/fonttruetype.hpp>
 #include <eepp/maps/mapeditor/mapeditor.hpp>
+#include <eepp/maps/tilemap.hpp>
 #include <eepp/scene/scenemanager.hpp>
 #include <eepp/ui/uimessagebox.hpp>
 #include <eepp/ui/uiscenenode.hpp>
@@ -7,6 +8,7 @@
 #include <eepp/ui/uithememanager.hpp>
 #include <eepp/window/engine.hpp>
 #include <eepp/window/window.hpp>
+#include <iostream>
 
 using namespace EE;
 using namespace EE::Graphics;
@@ -73,6 +75,49 @@ void mainLoop() {
 	}
 }
 
+/** Converts a map to the chunked map format:
+ * eepp-mapeditor --convert <input map> <output map> [--chunk-size=N] [--no-compression]
+ * Maps that are already chunked keep their chunk size. */
+bool convertMap( int argc, char* argv[] ) {
+	std::string input( argv[2] );
+	std::string output( argv[3] );
+	Uint32 chunkSize = MAP_DEFAULT_CHUNK_SIZE;
+	bool compress = true;
+
+	for ( int i = 4; i < argc; i++ ) {
+		std::string arg( argv[i] );
+
+		if ( String::startsWith( arg, "--chunk-size=" ) )
+			String::fromString( chunkSize, arg.substr( strlen( "--chunk-size=" ) ) );
+		else if ( arg == "--no-compression" )
+			compress = false;
+	}
+
+	TileMap map;
+	Clock clock;
+
+	map.setChunkSize( chunkSize );
+
+	if ( !map.loadFromFile( input ) ) {
+		std::cerr << "Couldn't load the map " << input << std::endl;
+		return false;
+	}
+
+	Time loadTime = clock.getElapsed();
+
+	if ( !map.saveToFileChunked( output, compress ) ) {
+		std::cerr << "Couldn't save the map " << output << std::endl;
+		return false;
+	}
+
+	std::cout << "Converted " << input << " to " << output << " ( " << map.getSize().x << "x"
+			  << map.getSize().y << " tiles, " << map.getChunkSize() << "x" << map.getChunkSize()
+			  << " chunks ) load: " << loadTime.asMilliseconds()
+			  << " ms save: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+
+	return true;
+}
+
 EE_MAIN_FUNC int main( int argc, char* argv[] ) {
 	DisplayManager* displayManager = Engine::instance()->getDisplayManager();
 	displayManager->enableScreenSaver();
@@ -88,6 +133,16 @@ EE_MAIN_FUNC int main( int argc, char* argv[] ) {
 						WindowBackend::Default, 32, resPath + "assets/icon/ee.png", pixelDensity ),
 		ContextSettings( true, GLv_default, true, 24, 1, 0, false ) );
 
+	if ( win->isOpen() && argc >= 4 && std::string( argv[1] ) == "--convert" ) {
+		bool converted = convertMap( argc, argv );
+
+		Engine::destroySingleton();
+
+		MemoryManager::showResults();
+
+		return converted ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	if ( win->isOpen() ) {
 		PixelDensity::setPixelDensity( eemax( win->getScale(), pixelDensity ) );
 
@@ -2,6 +2,7 @@
 #include <eepp/graphics/pixeldensity.hpp>
 #include <eepp/graphics/textureatlasloader.hpp>
 #include <eepp/graphics/texturepacker.hpp>
+#include <eepp/system/clock.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <iostream>
 #include <map>
@@ -72,6 +73,25 @@ EE_MAIN_FUNC int main( int argc, char* argv[] ) {
 		"Texture filter to use with the texture atlas. Available filters: \"linear\" or "
 		"\"nearest\".",
 		{"texture-filter"}, textureFilterMap, Texture::Filter::Linear, args::Options::Single );
+	std::unordered_map<std::string, TexturePacker::PackingHeuristic> heuristicMap{
+		{"guillotine", TexturePacker::PackingHeuristic::Guillotine},
+		{"maxrects-bssf", TexturePacker::PackingHeuristic::MaxRectsBestShortSideFit},
+		{"maxrects-blsf", TexturePacker::PackingHeuristic::MaxRectsBestLongSideFit},
+		{"maxrects-baf", TexturePacker::PackingHeuristic::MaxRectsBestAreaFit},
+		{"maxrects-bl", TexturePacker::PackingHeuristic::MaxRectsBottomLeft},
+		{"skyline", TexturePacker::PackingHeuristic::SkylineBottomLeft}};
+	args::MapFlag<std::string, TexturePacker::PackingHeuristic> heuristic(
+		parser, "heuristic",
+		"Packing algorithm. Available algorithms: \"guillotine\", \"maxrects-bssf\", "
+		"\"maxrects-blsf\", \"maxrects-baf\", \"maxrects-bl\" and \"skyline\".",
+		{"heuristic"}, heuristicMap, TexturePacker::PackingHeuristic::Guillotine,
+		args::Options::Single );
+	args::ValueFlag<Uint32> threads(
+		parser, "threads",
+		"Number of threads used to decode and compose the images (0 uses one per CPU core).",
+		{"threads"}, 0, args::Options::Single );
+	args::Flag trim( parser, "trim", "Trim the transparent borders of the images.", {"trim"},
+					 args::Options::Single );
 
 	try {
 		parser.ParseCLI( argc, argv );
@@ -142,7 +162,11 @@ EE_MAIN_FUNC int main( int argc, char* argv[] ) {
 		TexturePacker tp( width.Get(), height.Get(), PixelDensity::toFloat( pixelDensity.Get() ),
 						  forcePow2.Get(), scalableSVG.Get(), pixelsBorder.Get(),
 						  textureFilter.Get(), allowChilds.Get() );
+		tp.setPackingHeuristic( heuristic.Get() );
+		tp.setThreadCount( threads.Get() );
+		tp.setTrimTransparentBorders( trim.Get() );
 		std::cout << "Packing directory: " << texturesPathSafe << std::endl;
+		Clock clock;
 		tp.addTexturesPath( texturesPathSafe );
 		for ( auto& image : imagesList ) {
 			tp.addImage( image.second.get(), image.first );
@@ -150,6 +174,8 @@ EE_MAIN_FUNC int main( int argc, char* argv[] ) {
 		if ( tp.packTextures() <= 0 ) {
 			goto exit_error;
 		}
+		std::cout << "Packed in " << clock.getElapsedTime().asMilliseconds()
+				  << " ms. Occupancy: " << tp.getOccupancy() * 100.f << "%" << std::endl;
 		std::string outputTexturePath( FileSystem::fileRemoveExtension( outputFile.Get() ) + "." +
 									   Image::saveTypeToExtension( saveType.Get() ) );
 		tp.save( outputTexturePath, saveType.Get(), saveExtensions.Get() );